@@ -0,0 +1,502 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+/**
+ * Benchmark y prueba del almacenamiento por arquetipos del ECS (ECS/World.h).
+ *
+ * Primero hace miles de operaciones aleatorias (crear y destruir entidades, anadir y quitar
+ * componentes) y comprueba tras cada una que todos los componentes conservan su valor, que los
+ * recorridos ven exactamente las entidades esperadas, que no se pierde ni se duplica ningun
+ * destructor y que los handles de entidades destruidas no llegan nunca a otra entidad, aunque su
+ * ranura se haya reutilizado o agotado sus generaciones. Despues compara, con 100K transforms, la ruta antigua (componentes en punteros
+ * compartidos y getComponent con dynamic_cast por entidad) con World::getComponent por entidad y
+ * con el barrido lineal de World::forEachChunk. Por ultimo mide solo la busqueda de un componente
+ * (getComponent y hasComponent) con dynamic_cast frente a ComponentTypeId: la mascara con la
+ * posicion por recuento de bits que usa Entity y la tabla de columnas del World.
+ *
+ * No forma parte del proyecto de Visual Studio; se compila aparte, por ejemplo en Linux:
+ *
+ *   g++ -std=c++17 -O2 -I IzzyEngine/Include IzzyEngine/Benchmarks/ArchetypeBenchmark.cpp -o archetypebench
+ *
+ * Termina con codigo 1 si alguna comprobacion falla.
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "ECS/World.h"
+#include "Utilities/Memory/TSharedPointer.h"
+#include "Utilities/Structures/TInlineArray.h"
+#include "Utilities/Vectors/Quaternion.h"
+
+using EngineUtilities::Matrix4x4;
+using EngineUtilities::Quaternion;
+using EngineUtilities::TSharedPointer;
+using EngineUtilities::Vector3;
+
+namespace {
+  volatile float g_sink;  ///< Evita que el compilador descarte los bucles medidos.
+  int g_liveTracked = 0;  ///< Objetos Tracked vivos (construidos menos destruidos).
+
+  template<typename Func>
+  double nsPerOp(size_t opsPerCall, int repetitions, Func func) {
+    func();  // Calentamiento.
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+      func();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() /
+           (static_cast<double>(opsPerCall) * repetitions);
+  }
+
+  /**
+   * @brief Base polimorfica como Component, para la ruta con dynamic_cast.
+   */
+  struct BenchComponent {
+    virtual ~BenchComponent() = default;
+    virtual void update(float deltaTime) = 0;
+  };
+
+  /**
+   * @brief Transform reducido: posicion, rotacion y escala que se componen en una matriz.
+   */
+  struct BenchTransform : BenchComponent {
+    Vector3 position;
+    Quaternion orientation;
+    Vector3 scale = Vector3(1.0f, 1.0f, 1.0f);
+    Matrix4x4 matrix;
+
+    void update(float deltaTime) override {
+      position.x += deltaTime;
+      matrix = EngineUtilities::composeTRS(position, orientation, scale);
+    }
+  };
+
+  /**
+   * @brief Otros componentes, para que la ruta antigua tenga que descartar candidatos.
+   */
+  struct BenchMesh : BenchComponent {
+    int meshIndex = 0;
+    void update(float) override {}
+  };
+
+  struct BenchLight : BenchComponent {
+    float intensity = 1.0f;
+    void update(float) override {}
+  };
+
+  struct BenchScript : BenchComponent {
+    int state = 0;
+    void update(float) override { ++state; }
+  };
+
+  struct BenchMissing : BenchComponent {
+    void update(float) override {}
+  };
+
+  /**
+   * @brief Componente que cuenta sus instancias vivas y guarda un valor para comprobarlo.
+   */
+  struct Tracked {
+    int value;
+    explicit Tracked(int v = 0) : value(v) { ++g_liveTracked; }
+    Tracked(const Tracked& other) : value(other.value) { ++g_liveTracked; }
+    Tracked& operator=(const Tracked& other) = default;
+    ~Tracked() { --g_liveTracked; }
+  };
+
+  struct Small { short value; };
+  struct alignas(32) Wide { double value; double padding[7]; };
+
+  /**
+   * @brief Entidad de la ruta antigua: componentes en punteros compartidos, busqueda con dynamic_cast.
+   */
+  struct LegacyEntity {
+    EngineUtilities::TInlineArray<TSharedPointer<BenchComponent>, 4> components;
+
+    template<typename T>
+    T* getComponent() {
+      for (auto& component : components) {
+        if (T* found = dynamic_cast<T*>(component.get())) {
+          return found;
+        }
+      }
+      return nullptr;
+    }
+
+    template<typename T>
+    bool hasComponent() { return getComponent<T>() != nullptr; }
+  };
+
+  /**
+   * @brief Entidad con la busqueda de Entity: componentes ordenados por ComponentTypeId y una mascara.
+   */
+  struct MaskedEntity {
+    EngineUtilities::TInlineArray<TSharedPointer<BenchComponent>, 4> components;
+    ComponentMask mask = 0;
+
+    template<typename T>
+    void addComponent(TSharedPointer<T> component) {
+      ComponentMask bit = componentBit<T>();
+      size_t slot = componentCount(mask & (bit - 1));
+      components.Add(TSharedPointer<BenchComponent>(component));
+      for (size_t i = components.Num() - 1; i > slot; --i) {
+        components[i].swap(components[i - 1]);
+      }
+      mask |= bit;
+    }
+
+    template<typename T>
+    T* getComponent() {
+      ComponentMask bit = componentBit<T>();
+      return (mask & bit) ? static_cast<T*>(components[componentCount(mask & (bit - 1))].get()) : nullptr;
+    }
+
+    template<typename T>
+    bool hasComponent() const { return (mask & componentBit<T>()) != 0; }
+  };
+
+  template<typename T>
+  TSharedPointer<T> makePooled() {
+    return EngineUtilities::MakeShared<T>(EngineUtilities::TSharedPool<T>::get());
+  }
+
+  /**
+   * @brief Mide getComponent y hasComponent por las tres rutas sobre las mismas entidades.
+   * @return false si las rutas no encuentran los mismos componentes.
+   */
+  bool lookupBenchmark(size_t count, int repetitions) {
+    // Los tipos se registran en un orden distinto al de insercion, para que el orden por indice importe.
+    ComponentTypeId<BenchScript>();
+    ComponentTypeId<BenchLight>();
+
+    std::vector<LegacyEntity> legacy(count);
+    std::vector<MaskedEntity> masked(count);
+    World world;
+    std::vector<EntityId> entities(count);
+    for (size_t i = 0; i < count; ++i) {
+      // El componente buscado (BenchScript) se anade el ultimo: el peor caso de la busqueda lineal.
+      TSharedPointer<BenchTransform> transform = makePooled<BenchTransform>();
+      TSharedPointer<BenchMesh> mesh = makePooled<BenchMesh>();
+      TSharedPointer<BenchLight> light = makePooled<BenchLight>();
+      TSharedPointer<BenchScript> script = makePooled<BenchScript>();
+      script->state = static_cast<int>(i);
+      legacy[i].components.Add(transform);
+      legacy[i].components.Add(mesh);
+      legacy[i].components.Add(light);
+      legacy[i].components.Add(script);
+      masked[i].addComponent(transform);
+      masked[i].addComponent(mesh);
+      masked[i].addComponent(light);
+      masked[i].addComponent(script);
+      entities[i] = world.createEntity();
+      world.addComponent<BenchTransform>(entities[i]);
+      world.addComponent<BenchMesh>(entities[i]);
+      world.addComponent<BenchLight>(entities[i]);
+      world.addComponent<BenchScript>(entities[i])->state = static_cast<int>(i);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+      if (masked[i].getComponent<BenchScript>() != legacy[i].getComponent<BenchScript>() ||
+          masked[i].getComponent<BenchLight>() != legacy[i].getComponent<BenchLight>() ||
+          world.getComponent<BenchScript>(entities[i])->state != static_cast<int>(i) ||
+          masked[i].hasComponent<BenchMissing>() || world.hasComponent<BenchMissing>(entities[i])) {
+        std::printf("Las busquedas no encuentran los mismos componentes en la entidad %zu\n", i);
+        return false;
+      }
+    }
+
+    long long sum = 0;
+    auto measure = [&](const char* name, auto lookup) {
+      double ns = nsPerOp(count, repetitions, [&] {
+        for (size_t i = 0; i < count; ++i) {
+          sum += lookup(i);
+        }
+      });
+      std::printf("  %-44s %7.2f ns\n", name, ns);
+      return ns;
+    };
+
+    std::printf("\nBuscar un componente en %zu entidades con 4 componentes (ns por busqueda):\n", count);
+    double legacyGet = measure("getComponent con dynamic_cast (ultimo)", [&](size_t i) {
+      return legacy[i].getComponent<BenchScript>()->state;
+    });
+    double maskedGet = measure("getComponent con mascara y recuento de bits", [&](size_t i) {
+      return masked[i].getComponent<BenchScript>()->state;
+    });
+    double worldGet = measure("World::getComponent", [&](size_t i) {
+      return world.getComponent<BenchScript>(entities[i])->state;
+    });
+    double legacyHas = measure("hasComponent con dynamic_cast (ausente)", [&](size_t i) {
+      return legacy[i].hasComponent<BenchMissing>() ? 1 : 0;
+    });
+    double maskedHas = measure("hasComponent con mascara (ausente)", [&](size_t i) {
+      return masked[i].hasComponent<BenchMissing>() ? 1 : 0;
+    });
+    double worldHas = measure("World::hasComponent (ausente)", [&](size_t i) {
+      return world.hasComponent<BenchMissing>(entities[i]) ? 1 : 0;
+    });
+    g_sink = static_cast<float>(sum);
+    std::printf("  getComponent x%.1f (mascara) x%.1f (World), hasComponent x%.1f (mascara) x%.1f (World)\n",
+                legacyGet / maskedGet, legacyGet / worldGet, legacyHas / maskedHas, legacyHas / worldHas);
+    return true;
+  }
+
+  /**
+   * @brief Operaciones aleatorias sobre un World contrastadas con un modelo simple.
+   */
+  bool stressTest() {
+    struct Expected {
+      bool alive = false;
+      int tracked = -1;  ///< -1 si no tiene el componente.
+      int small = -1;
+      int wide = -1;
+    };
+
+    bool ok = true;
+    {
+      World world;
+      std::vector<EntityId> ids;
+      std::vector<Expected> expected;
+      std::mt19937 rng(21);
+
+      auto check = [&](const char* step) {
+        size_t alive = 0, withTracked = 0, withSmallWide = 0;
+        for (size_t i = 0; i < ids.size(); ++i) {
+          const Expected& e = expected[i];
+          if (!e.alive) {
+            // Handle antiguo: su ranura puede estar ocupada por otra entidad, pero no debe llegar a ella.
+            if ((world.isAlive(ids[i]) || world.getComponent<Tracked>(ids[i]) || world.hasComponent<Small>(ids[i])) && ok) {
+              std::printf("  %s: el handle destruido %zu sigue dando acceso a una entidad\n", step, i);
+              ok = false;
+            }
+            continue;
+          }
+          ++alive;
+          Tracked* tracked = world.getComponent<Tracked>(ids[i]);
+          Small* small = world.getComponent<Small>(ids[i]);
+          Wide* wide = world.getComponent<Wide>(ids[i]);
+          bool good = (tracked ? tracked->value : -1) == e.tracked &&
+                      (small ? small->value : -1) == e.small &&
+                      (wide ? static_cast<int>(wide->value) : -1) == e.wide &&
+                      (reinterpret_cast<uintptr_t>(wide) % alignof(Wide)) == 0;
+          withTracked += e.tracked >= 0 ? 1 : 0;
+          withSmallWide += (e.small >= 0 && e.wide >= 0) ? 1 : 0;
+          if (!good && ok) {
+            std::printf("  %s: la entidad %zu no tiene los componentes esperados\n", step, i);
+            ok = false;
+          }
+        }
+        size_t seenTracked = 0, seenSmallWide = 0;
+        world.each<Tracked>([&](Tracked&) { ++seenTracked; });
+        world.forEachChunk<Small, Wide>([&](size_t count, const EntityId* entities, Small* small, Wide*) {
+          for (size_t i = 0; i < count; ++i) {
+            ok = ok && world.getComponent<Small>(entities[i]) == &small[i];
+          }
+          seenSmallWide += count;
+        });
+        if ((alive != world.entityCount() || seenTracked != withTracked || seenSmallWide != withSmallWide ||
+             g_liveTracked != static_cast<int>(withTracked)) && ok) {
+          std::printf("  %s: los recorridos o los contadores no cuadran\n", step);
+          ok = false;
+        }
+      };
+
+      for (int step = 0; step < 20000 && ok; ++step) {
+        size_t i = ids.empty() ? 0 : rng() % ids.size();
+        switch (rng() % 8) {
+        case 0:
+        case 1:
+          // El modelo se indexa por posicion en ids: un identificador reciclado ocupa otra posicion.
+          ids.push_back(world.createEntity());
+          expected.resize(ids.size());
+          expected.back() = Expected();
+          expected.back().alive = true;
+          break;
+        case 2:
+          // Destruir con un handle antiguo no debe hacer nada.
+          if (!ids.empty()) {
+            world.destroyEntity(ids[i]);
+            expected[i] = Expected();
+          }
+          break;
+        case 3:
+          if (!ids.empty()) {
+            Tracked* tracked = world.addComponent<Tracked>(ids[i], step);
+            if (expected[i].alive) {
+              expected[i].tracked = step;
+            }
+            else if (tracked && ok) {
+              std::printf("  addComponent con un handle destruido devuelve un componente\n");
+              ok = false;
+            }
+          }
+          break;
+        case 4:
+          if (!ids.empty() && expected[i].alive) {
+            world.addComponent<Small>(ids[i], Small{ static_cast<short>(step % 30000) });
+            expected[i].small = step % 30000;
+          }
+          break;
+        case 5:
+          if (!ids.empty() && expected[i].alive) {
+            Wide wide = {};
+            wide.value = step;
+            world.addComponent<Wide>(ids[i], wide);
+            expected[i].wide = step;
+          }
+          break;
+        case 6:
+          if (!ids.empty() && expected[i].alive) {
+            world.removeComponent<Tracked>(ids[i]);
+            expected[i].tracked = -1;
+          }
+          break;
+        default:
+          if (!ids.empty() && expected[i].alive) {
+            world.removeComponent<Wide>(ids[i]);
+            expected[i].wide = -1;
+          }
+          break;
+        }
+        if (step % 97 == 0) {
+          check("operacion aleatoria");
+        }
+      }
+      check("final");
+      std::printf("  %zu entidades vivas en %zu arquetipos tras 20000 operaciones\n",
+                  world.entityCount(), world.archetypeCount());
+    }
+    if (g_liveTracked != 0 && ok) {
+      std::printf("  al destruir el World quedan %d componentes sin destruir\n", g_liveTracked);
+      ok = false;
+    }
+    return ok;
+  }
+
+  /**
+   * @brief Una misma ranura reutilizada hasta agotar sus generaciones.
+   */
+  bool generationTest() {
+    World world;
+    EntityId keep = world.createEntity();
+    world.addComponent<Small>(keep, Small{ 7 });
+    std::vector<EntityId> old;
+    for (uint32_t i = 0; i <= MaxEntityGeneration; ++i) {
+      EntityId entity = world.createEntity();
+      if (entityIndex(entity) != 1 || entityGeneration(entity) != i) {
+        std::printf("  la ranura no se reutiliza con la generacion siguiente (%u)\n", i);
+        return false;
+      }
+      world.addComponent<Small>(entity, Small{ 1 });
+      world.destroyEntity(entity);
+      old.push_back(entity);
+    }
+    // Agotada, la ranura se retira: la siguiente entidad usa otra y ningun handle antiguo revive.
+    EntityId fresh = world.createEntity();
+    bool ok = entityIndex(fresh) == 2 && world.entityCount() == 2 && !world.isAlive(InvalidEntityId) &&
+              world.getComponent<Small>(keep) && world.getComponent<Small>(keep)->value == 7;
+    for (EntityId entity : old) {
+      ok = ok && !world.isAlive(entity) && !world.getComponent<Small>(entity);
+    }
+    if (!ok) {
+      std::printf("  una ranura sin generaciones libres no se retira correctamente\n");
+    }
+    return ok;
+  }
+}
+
+int main() {
+  std::printf("Archetype ECS benchmark (chunks de %zu bytes)\n\n", ArchetypeChunk::Size);
+
+  std::printf("Prueba aleatoria:\n");
+  if (!stressTest() || !generationTest()) {
+    return 1;
+  }
+
+  const size_t count = 100000;
+  const int repetitions = 50;
+
+  // Ruta antigua: cada entidad guarda sus componentes como punteros compartidos de pools.
+  std::vector<LegacyEntity> legacy(count);
+  for (LegacyEntity& entity : legacy) {
+    entity.components.Add(EngineUtilities::MakeShared<BenchTransform>(EngineUtilities::TSharedPool<BenchTransform>::get()));
+    entity.components.Add(EngineUtilities::MakeShared<BenchMesh>(EngineUtilities::TSharedPool<BenchMesh>::get()));
+  }
+
+  World world;
+  std::vector<EntityId> entities(count);
+  for (EntityId& entity : entities) {
+    entity = world.createEntity();
+    world.addComponent<BenchTransform>(entity);
+    world.addComponent<BenchMesh>(entity);
+  }
+
+  double legacyNs = nsPerOp(count, repetitions, [&] {
+    for (LegacyEntity& entity : legacy) {
+      entity.getComponent<BenchTransform>()->update(0.001f);
+    }
+    g_sink = legacy.back().getComponent<BenchTransform>()->matrix.m[3][0];
+  });
+  double lookupNs = nsPerOp(count, repetitions, [&] {
+    for (EntityId entity : entities) {
+      world.getComponent<BenchTransform>(entity)->update(0.001f);
+    }
+    g_sink = world.getComponent<BenchTransform>(entities.back())->matrix.m[3][0];
+  });
+  double sweepNs = nsPerOp(count, repetitions, [&] {
+    world.forEachChunk<BenchTransform>([](size_t n, const EntityId*, BenchTransform* transforms) {
+      for (size_t i = 0; i < n; ++i) {
+        transforms[i].update(0.001f);
+      }
+    });
+    g_sink = world.getComponent<BenchTransform>(entities.back())->matrix.m[3][0];
+  });
+
+  // Las rutas del World se midieron dos veces: su transform debe haber avanzado el doble.
+  float legacyX = legacy[count / 2].getComponent<BenchTransform>()->position.x;
+  float worldX = world.getComponent<BenchTransform>(entities[count / 2])->position.x;
+  if (std::fabs(legacyX * 2.0f - worldX) > 1.0e-4f) {
+    std::printf("Las rutas no aplicaron las mismas actualizaciones (%f, %f)\n", legacyX, worldX);
+    return 1;
+  }
+
+  std::printf("\nActualizar %zu transforms (ns por transform):\n", count);
+  std::printf("  getComponent con dynamic_cast     %7.2f ns\n", legacyNs);
+  std::printf("  World::getComponent por entidad   %7.2f ns  (x%.2f)\n", lookupNs, legacyNs / lookupNs);
+  std::printf("  World::forEachChunk               %7.2f ns  (x%.2f)\n", sweepNs, legacyNs / sweepNs);
+
+  if (!lookupBenchmark(count, repetitions)) {
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,262 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+/**
+ * Benchmark de precision y rendimiento de las funciones trascendentes de EngineMath.h y
+ * EngineMathSIMD.h frente a <cmath>.
+ *
+ * No forma parte del proyecto de Visual Studio; se compila aparte, por ejemplo en Linux:
+ *
+ *   g++ -std=c++17 -O2 -I IzzyEngine/Include IzzyEngine/Benchmarks/EngineMathBenchmark.cpp -o mathbench
+ *   g++ -std=c++17 -O2 -mavx2 -mfma -I IzzyEngine/Include IzzyEngine/Benchmarks/EngineMathBenchmark.cpp -o mathbench
+ *
+ * La precision se mide en ULP frente a la funcion en double de <cmath> redondeada a float.
+ * El rendimiento se mide en ns por elemento sobre un arreglo de entradas aleatorias.
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Utilities/Utilities/EngineMathSIMD.h"
+
+namespace {
+
+  /**
+   * @brief Distancia en ULP entre dos floats (0 si ambos son NaN).
+   */
+  double ulpDistance(float value, double reference) {
+    float expected = static_cast<float>(reference);
+    if (std::isnan(value) || std::isnan(expected)) {
+      return std::isnan(value) && std::isnan(expected) ? 0.0 : 1.0e9;
+    }
+    if (std::isinf(expected) || std::isinf(value)) {
+      return value == expected ? 0.0 : 1.0e9;
+    }
+    // Tamano de un ULP en la magnitud de la referencia; para referencias en 0 se usa el minimo normal.
+    double magnitude = std::fabs(reference);
+    int exponent;
+    std::frexp(magnitude < 1.17549435e-38 ? 1.17549435e-38 : magnitude, &exponent);
+    double ulp = std::ldexp(1.0, exponent - 24);
+    return std::fabs(static_cast<double>(value) - reference) / ulp;
+  }
+
+  struct AccuracyResult {
+    double maxUlp = 0.0;
+    double avgUlp = 0.0;
+    float worstInput = 0.0f;
+  };
+
+  template<typename Engine, typename Reference>
+  AccuracyResult measureAccuracy(const std::vector<float>& inputs, Engine engine, Reference reference) {
+    AccuracyResult result;
+    double total = 0.0;
+    for (float x : inputs) {
+      double error = ulpDistance(engine(x), reference(static_cast<double>(x)));
+      total += error;
+      if (error > result.maxUlp) {
+        result.maxUlp = error;
+        result.worstInput = x;
+      }
+    }
+    result.avgUlp = total / static_cast<double>(inputs.size());
+    return result;
+  }
+
+  /**
+   * @brief Precision de una funcion de arreglo (SIMD) comparando elemento a elemento.
+   */
+  template<typename ArrayFunc, typename Reference>
+  AccuracyResult measureArrayAccuracy(const std::vector<float>& inputs, ArrayFunc func, Reference reference) {
+    std::vector<float> out(inputs.size());
+    func(inputs.data(), out.data(), inputs.size());
+    AccuracyResult result;
+    double total = 0.0;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      double error = ulpDistance(out[i], reference(static_cast<double>(inputs[i])));
+      total += error;
+      if (error > result.maxUlp) {
+        result.maxUlp = error;
+        result.worstInput = inputs[i];
+      }
+    }
+    result.avgUlp = total / static_cast<double>(inputs.size());
+    return result;
+  }
+
+  volatile float g_sink;  ///< Evita que el compilador descarte los bucles medidos.
+
+  template<typename ArrayFunc>
+  double measureNsPerElement(const std::vector<float>& inputs, ArrayFunc func, int repetitions) {
+    std::vector<float> out(inputs.size());
+    func(inputs.data(), out.data(), inputs.size());  // Calentamiento.
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+      func(inputs.data(), out.data(), inputs.size());
+      g_sink = out[r % out.size()];
+    }
+    auto end = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    return ns / (static_cast<double>(inputs.size()) * repetitions);
+  }
+
+  std::vector<float> uniformInputs(float low, float high, size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(low, high);
+    std::vector<float> values(count);
+    for (float& v : values) {
+      v = dist(rng);
+    }
+    return values;
+  }
+
+  /**
+   * @brief Entradas con exponente uniforme, para cubrir log y sqrt en todo su rango.
+   */
+  std::vector<float> logUniformInputs(float lowExp, float highExp, size_t count, uint32_t seed) {
+    std::vector<float> exponents = uniformInputs(lowExp, highExp, count, seed);
+    for (float& v : exponents) {
+      v = std::exp2(v);
+    }
+    return exponents;
+  }
+
+  void printAccuracy(const char* name, const char* range, const AccuracyResult& result) {
+    std::printf("  %-22s %-18s max %8.2f ULP  avg %6.3f ULP  (peor x = %.9g)\n",
+                name, range, result.maxUlp, result.avgUlp, result.worstInput);
+  }
+
+  void printSpeed(const char* name, double engineNs, double stdNs) {
+    std::printf("  %-22s engine %7.3f ns/elem  std %7.3f ns/elem  (x%.2f)\n",
+                name, engineNs, stdNs, stdNs / engineNs);
+  }
+
+  template<float (*Func)(float)>
+  void scalarArray(const float* in, float* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = Func(in[i]);
+    }
+  }
+
+  float stdSin(float x) { return std::sin(x); }
+  float stdCos(float x) { return std::cos(x); }
+  float stdExp(float x) { return std::exp(x); }
+  float stdLog(float x) { return std::log(x); }
+  float stdSqrt(float x) { return std::sqrt(x); }
+
+  double refSin(double x) { return std::sin(x); }
+  double refCos(double x) { return std::cos(x); }
+  double refExp(double x) { return std::exp(x); }
+  double refLog(double x) { return std::log(x); }
+  double refSqrt(double x) { return std::sqrt(x); }
+}
+
+int main() {
+  namespace EM = EngineUtilities;
+  const size_t accuracyCount = 1u << 20;
+  const size_t speedCount = 4096;  // Cabe en L1/L2: se mide el calculo, no la memoria.
+  const int repetitions = 2000;
+
+  std::printf("EngineMath benchmark (SSE2 %d, AVX2 %d, FMA %d)\n\n",
+              ENGINE_MATH_SSE2, ENGINE_MATH_AVX2, ENGINE_MATH_FMA);
+
+  std::vector<float> smallAngles = uniformInputs(-EM::PI, EM::PI, accuracyCount, 1);
+  std::vector<float> mediumAngles = uniformInputs(-8192.0f, 8192.0f, accuracyCount, 2);
+  std::vector<float> largeAngles = uniformInputs(-1.0e8f, 1.0e8f, accuracyCount, 3);
+  std::vector<float> expInputs = uniformInputs(-87.0f, 88.0f, accuracyCount, 4);
+  std::vector<float> positiveInputs = logUniformInputs(-125.0f, 127.0f, accuracyCount, 5);
+
+  std::printf("Precision frente a <cmath> en double:\n");
+  printAccuracy("sin", "[-pi, pi]", measureAccuracy(smallAngles, EM::sin, refSin));
+  printAccuracy("sin", "[-8192, 8192]", measureAccuracy(mediumAngles, EM::sin, refSin));
+  printAccuracy("sin", "[-1e8, 1e8]", measureAccuracy(largeAngles, EM::sin, refSin));
+  printAccuracy("cos", "[-pi, pi]", measureAccuracy(smallAngles, EM::cos, refCos));
+  printAccuracy("cos", "[-8192, 8192]", measureAccuracy(mediumAngles, EM::cos, refCos));
+  printAccuracy("cos", "[-1e8, 1e8]", measureAccuracy(largeAngles, EM::cos, refCos));
+  printAccuracy("exp", "[-87, 88]", measureAccuracy(expInputs, EM::exp, refExp));
+  printAccuracy("log", "[2^-125, 2^127]", measureAccuracy(positiveInputs, EM::log, refLog));
+  printAccuracy("sqrt", "[2^-125, 2^127]", measureAccuracy(positiveInputs, EM::sqrt, refSqrt));
+  printAccuracy("sinArray (SIMD)", "[-pi, pi]", measureArrayAccuracy(smallAngles, EM::sinArray, refSin));
+  printAccuracy("cosArray (SIMD)", "[-pi, pi]", measureArrayAccuracy(smallAngles, EM::cosArray, refCos));
+  // Fuera de [-pi, pi] la version SIMD garantiza error absoluto, no relativo: se reporta aparte.
+  {
+    std::vector<float> out(mediumAngles.size());
+    EM::sinArray(mediumAngles.data(), out.data(), mediumAngles.size());
+    double maxAbs = 0.0;
+    for (size_t i = 0; i < out.size(); ++i) {
+      maxAbs = std::fmax(maxAbs, std::fabs(out[i] - std::sin(static_cast<double>(mediumAngles[i]))));
+    }
+    std::printf("  %-22s %-18s max error absoluto %.3g\n", "sinArray (SIMD)", "[-8192, 8192]", maxAbs);
+  }
+
+  std::printf("\nRendimiento (%zu elementos x %d repeticiones):\n", speedCount, repetitions);
+  std::vector<float> angles(mediumAngles.begin(), mediumAngles.begin() + speedCount);
+  std::vector<float> exps(expInputs.begin(), expInputs.begin() + speedCount);
+  std::vector<float> positives(positiveInputs.begin(), positiveInputs.begin() + speedCount);
+
+  printSpeed("sin",
+             measureNsPerElement(angles, scalarArray<EM::sin>, repetitions),
+             measureNsPerElement(angles, scalarArray<stdSin>, repetitions));
+  printSpeed("cos",
+             measureNsPerElement(angles, scalarArray<EM::cos>, repetitions),
+             measureNsPerElement(angles, scalarArray<stdCos>, repetitions));
+  printSpeed("exp",
+             measureNsPerElement(exps, scalarArray<EM::exp>, repetitions),
+             measureNsPerElement(exps, scalarArray<stdExp>, repetitions));
+  printSpeed("log",
+             measureNsPerElement(positives, scalarArray<EM::log>, repetitions),
+             measureNsPerElement(positives, scalarArray<stdLog>, repetitions));
+  printSpeed("sqrt",
+             measureNsPerElement(positives, scalarArray<EM::sqrt>, repetitions),
+             measureNsPerElement(positives, scalarArray<stdSqrt>, repetitions));
+  printSpeed("sinArray (SIMD)",
+             measureNsPerElement(angles, EM::sinArray, repetitions),
+             measureNsPerElement(angles, scalarArray<stdSin>, repetitions));
+  printSpeed("cosArray (SIMD)",
+             measureNsPerElement(angles, EM::cosArray, repetitions),
+             measureNsPerElement(angles, scalarArray<stdCos>, repetitions));
+  {
+    std::vector<float> outSin(speedCount), outCos(speedCount);
+    auto engineSinCos = [&](const float* in, float* out, size_t count) {
+      EM::sincosArray(in, out, outCos.data(), count);
+    };
+    auto stdSinCos = [&](const float* in, float* out, size_t count) {
+      for (size_t i = 0; i < count; ++i) {
+        out[i] = std::sin(in[i]);
+        outCos[i] = std::cos(in[i]);
+      }
+    };
+    printSpeed("sincosArray (SIMD)",
+               measureNsPerElement(angles, engineSinCos, repetitions),
+               measureNsPerElement(angles, stdSinCos, repetitions));
+  }
+  return 0;
+}
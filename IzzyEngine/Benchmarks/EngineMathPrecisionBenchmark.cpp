@@ -0,0 +1,178 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+/**
+ * Prueba y benchmark de las politicas de precision (EngineMathPrecision.h).
+ *
+ * Para cada politica y funcion mide el error maximo frente a la version en double de <cmath> y lo
+ * compara con el presupuesto que declara la politica; si alguno se supera, el programa termina con
+ * codigo 1. Despues mide el tiempo por llamada de cada version.
+ *
+ * No forma parte del proyecto de Visual Studio; se compila aparte, por ejemplo en Linux:
+ *
+ *   g++ -std=c++17 -O2 -I IzzyEngine/Include IzzyEngine/Benchmarks/EngineMathPrecisionBenchmark.cpp -o precbench
+ *   g++ -std=c++17 -O2 -mavx2 -mfma -I IzzyEngine/Include IzzyEngine/Benchmarks/EngineMathPrecisionBenchmark.cpp -o precbench
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "Utilities/Utilities/EngineMathPrecision.h"
+
+namespace EM = EngineUtilities;
+namespace Precision = EngineUtilities::Precision;
+
+namespace {
+
+  volatile float g_sink;  ///< Evita que el compilador descarte los bucles medidos.
+  bool g_failed = false;
+
+  /**
+   * @brief Valores repartidos uniformemente en [lo, hi].
+   */
+  std::vector<float> linearRange(float lo, float hi, size_t count) {
+    std::vector<float> values(count);
+    for (size_t i = 0; i < count; ++i) {
+      values[i] = static_cast<float>(lo + (hi - lo) * (static_cast<double>(i) / (count - 1)));
+    }
+    return values;
+  }
+
+  /**
+   * @brief Valores repartidos geometricamente en [lo, hi] (lo > 0).
+   */
+  std::vector<float> geometricRange(double lo, double hi, size_t count) {
+    std::vector<float> values(count);
+    for (size_t i = 0; i < count; ++i) {
+      values[i] = static_cast<float>(lo * std::pow(hi / lo, static_cast<double>(i) / (count - 1)));
+    }
+    return values;
+  }
+
+  enum class ErrorKind {
+    Relative,        ///< |error| / |referencia|
+    Absolute,        ///< |error|
+    RelativeAboveOne ///< |error| / max(1, |referencia|)
+  };
+
+  template<typename Func, typename Reference>
+  double maxError(const std::vector<float>& inputs, ErrorKind kind, Func func, Reference reference) {
+    double result = 0.0;
+    for (float x : inputs) {
+      double expected = reference(static_cast<double>(x));
+      double error = std::fabs(static_cast<double>(func(x)) - expected);
+      if (kind == ErrorKind::Relative) {
+        error /= std::fabs(expected);
+      }
+      else if (kind == ErrorKind::RelativeAboveOne) {
+        error /= std::fmax(1.0, std::fabs(expected));
+      }
+      result = std::fmax(result, error);
+    }
+    return result;
+  }
+
+  template<typename Func>
+  double nsPerCall(const std::vector<float>& inputs, Func func) {
+    const int repetitions = 20;
+    float sum = 0.0f;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+      for (float x : inputs) {
+        sum += func(x);
+      }
+    }
+    auto end = std::chrono::steady_clock::now();
+    g_sink = sum;
+    return std::chrono::duration<double, std::nano>(end - start).count() /
+           (static_cast<double>(inputs.size()) * repetitions);
+  }
+
+  /**
+   * @brief Mide error y tiempo de una funcion para las tres politicas.
+   */
+  template<typename Exact, typename Fast, typename Fastest, typename Reference>
+  void check(const char* name, const std::vector<float>& inputs, ErrorKind kind, Reference reference,
+             float exactBudget, float fastBudget, float fastestBudget,
+             Exact exact, Fast fast, Fastest fastest) {
+    double errors[3] = { maxError(inputs, kind, exact, reference),
+                         maxError(inputs, kind, fast, reference),
+                         maxError(inputs, kind, fastest, reference) };
+    float budgets[3] = { exactBudget, fastBudget, fastestBudget };
+    double times[3] = { nsPerCall(inputs, exact), nsPerCall(inputs, fast), nsPerCall(inputs, fastest) };
+    const char* policies[3] = { "Exact", "Fast", "Fastest" };
+    for (int p = 0; p < 3; ++p) {
+      bool ok = errors[p] <= budgets[p];
+      g_failed = g_failed || !ok;
+      std::printf("  %-12s %-8s error %9.3g  presupuesto %8.2g  %-5s %6.2f ns\n",
+                  p == 0 ? name : "", policies[p], errors[p], budgets[p], ok ? "ok" : "FALLA", times[p]);
+    }
+  }
+}
+
+#define EM_POLICY_LAMBDAS(function)                                       \
+  [](float x) { return EM::function<Precision::Exact>(x); },              \
+  [](float x) { return EM::function<Precision::Fast>(x); },               \
+  [](float x) { return EM::function<Precision::Fastest>(x); }
+
+#define EM_BUDGETS(member) \
+  Precision::Exact::member, Precision::Fast::member, Precision::Fastest::member
+
+int main() {
+  const size_t count = 1 << 20;
+  std::printf("Precision policies (SSE2 %d)\n\n", ENGINE_MATH_SSE2);
+
+  std::vector<float> positive = geometricRange(1.0e-30, 1.0e30, count);
+  std::vector<float> exponents2 = linearRange(-126.0f, 127.0f, count);
+  std::vector<float> exponents = linearRange(-87.0f, 88.0f, count);
+  std::vector<float> logInputs = geometricRange(1.0e-37, 1.0e37, count);
+  std::vector<float> angles = linearRange(-1000.0f, 1000.0f, count);
+
+  auto relative = ErrorKind::Relative;
+  check("inverseSqrt", positive, relative, [](double x) { return 1.0 / std::sqrt(x); },
+        EM_BUDGETS(SQRT_ERROR), EM_POLICY_LAMBDAS(inverseSqrt));
+  check("sqrt", positive, relative, [](double x) { return std::sqrt(x); },
+        EM_BUDGETS(SQRT_ERROR), EM_POLICY_LAMBDAS(sqrt));
+  check("exp2", exponents2, relative, [](double x) { return std::exp2(x); },
+        EM_BUDGETS(EXP_ERROR), EM_POLICY_LAMBDAS(exp2));
+  check("exp", exponents, relative, [](double x) { return std::exp(x); },
+        EM_BUDGETS(EXP_ERROR), EM_POLICY_LAMBDAS(exp));
+  check("log2", logInputs, ErrorKind::RelativeAboveOne, [](double x) { return std::log2(x); },
+        EM_BUDGETS(LOG_ERROR), EM_POLICY_LAMBDAS(log2));
+  check("log", logInputs, ErrorKind::RelativeAboveOne, [](double x) { return std::log(x); },
+        EM_BUDGETS(LOG_ERROR), EM_POLICY_LAMBDAS(log));
+  check("sin", angles, ErrorKind::Absolute, [](double x) { return std::sin(x); },
+        EM_BUDGETS(TRIG_ERROR), EM_POLICY_LAMBDAS(sin));
+  check("cos", angles, ErrorKind::Absolute, [](double x) { return std::cos(x); },
+        EM_BUDGETS(TRIG_ERROR), EM_POLICY_LAMBDAS(cos));
+
+  std::printf("\n%s\n", g_failed ? "FALLA: alguna funcion supera su presupuesto de error" : "Todos los presupuestos se cumplen");
+  return g_failed ? 1 : 0;
+}
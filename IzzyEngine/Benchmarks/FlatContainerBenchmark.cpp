@@ -0,0 +1,334 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+/**
+ * Benchmark y prueba de TFlatMap y TFlatSet frente a TMap, TSet, std::map y std::set.
+ *
+ * Primero repite la misma secuencia aleatoria de Add, Emplace, operator[], Remove y Find sobre un
+ * TFlatMap y un std::map (y de Add, Remove y Contains sobre un TFlatSet y un std::set), con claves
+ * enteras y con cadenas buscadas como const char*, y comprueba que dan las mismas respuestas y que
+ * el recorrido sale en el mismo orden. Tambien comprueba Build con claves repetidas (gana el ultimo
+ * par). Despues mide, con tablas pequenas (8 y 32 elementos) y medianas (256 y 1024), buscar claves
+ * (la mitad presentes) y construir la tabla entera.
+ *
+ * No forma parte del proyecto de Visual Studio; se compila aparte, por ejemplo en Linux:
+ *
+ *   g++ -std=c++17 -O2 -I IzzyEngine/Include IzzyEngine/Benchmarks/FlatContainerBenchmark.cpp -o flatbench
+ *
+ * Termina con codigo 1 si alguna comprobacion falla.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "Utilities/Structures/TFlatMap.h"
+#include "Utilities/Structures/TFlatSet.h"
+#include "Utilities/Structures/TMap.h"
+#include "Utilities/Structures/TSet.h"
+
+using EngineUtilities::TArray;
+using EngineUtilities::TFlatMap;
+using EngineUtilities::TFlatSet;
+using EngineUtilities::TMap;
+using EngineUtilities::TSet;
+
+namespace {
+
+  volatile size_t g_sink;  ///< Evita que el compilador descarte los bucles medidos.
+
+  const size_t Sizes[] = { 8, 32, 256, 1024 };
+
+  std::string keyName(int key) {
+    return "ranura del material " + std::to_string(key);
+  }
+
+  template<typename K>
+  bool sameContents(const TFlatMap<K, int>& flat, const std::map<K, int, std::less<>>& reference) {
+    if (flat.Num() != reference.size()) {
+      return false;
+    }
+    auto expected = reference.begin();
+    for (auto entry : flat) {
+      if (entry.Key != expected->first || entry.Value != expected->second) {
+        return false;
+      }
+      ++expected;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Operaciones aleatorias sobre TFlatMap y std::map con claves del rango [0, range).
+   *
+   * @param makeKey Convierte el entero aleatorio en la clave (int o std::string).
+   * @param lookup Convierte la clave en lo que se pasa a Find y Remove (la misma clave o un const char*).
+   */
+  template<typename K, typename MakeKey, typename Lookup>
+  bool mapDifferential(const char* name, int range, MakeKey makeKey, Lookup lookup) {
+    std::mt19937 rng(static_cast<unsigned>(range));
+    TFlatMap<K, int> flat;
+    std::map<K, int, std::less<>> reference;
+    for (int step = 0; step < range * 20; ++step) {
+      K key = makeKey(static_cast<int>(rng() % range));
+      int value = static_cast<int>(rng() % 1000);
+      bool agrees = true;
+      switch (rng() % 5) {
+        case 0:
+          flat.Add(key, value);
+          reference[key] = value;
+          break;
+        case 1:
+          agrees = flat.Emplace(key, value) == reference.emplace(key, value).first->second;
+          break;
+        case 2:
+          agrees = (flat[key] += value) == (reference[key] += value);
+          break;
+        case 3:
+          agrees = flat.Remove(lookup(key)) == (reference.erase(key) == 1);
+          break;
+        default: {
+          const int* found = flat.Find(lookup(key));
+          auto expected = reference.find(key);
+          agrees = (found == nullptr) == (expected == reference.end()) && (!found || *found == expected->second);
+          break;
+        }
+      }
+      if (!agrees || !sameContents(flat, reference)) {
+        std::printf("  TFlatMap (%s, %d claves posibles) difiere de std::map en el paso %d\n", name, range, step);
+        return false;
+      }
+    }
+
+    // Build con claves repetidas: gana el ultimo par de cada clave.
+    TArray<typename TFlatMap<K, int>::Pair> pairs;
+    reference.clear();
+    for (int i = 0; i < range * 2; ++i) {
+      K key = makeKey(static_cast<int>(rng() % range));
+      pairs.Add(typename TFlatMap<K, int>::Pair(key, i));
+      reference[key] = i;
+    }
+    flat.Build(std::move(pairs));
+    if (!sameContents(flat, reference)) {
+      std::printf("  TFlatMap::Build (%s, %d claves posibles) difiere de std::map\n", name, range);
+      return false;
+    }
+    return true;
+  }
+
+  bool setDifferential(int range) {
+    std::mt19937 rng(static_cast<unsigned>(range) + 1);
+    TFlatSet<int> flat;
+    std::set<int> reference;
+    for (int step = 0; step < range * 20; ++step) {
+      int key = static_cast<int>(rng() % range);
+      bool agrees;
+      switch (rng() % 3) {
+        case 0: agrees = flat.Add(key) == reference.insert(key).second; break;
+        case 1: agrees = flat.Remove(key) == (reference.erase(key) == 1); break;
+        default: agrees = flat.Contains(key) == (reference.count(key) == 1); break;
+      }
+      if (!agrees || flat.Num() != reference.size() ||
+          !std::equal(flat.begin(), flat.end(), reference.begin())) {
+        std::printf("  TFlatSet (%d claves posibles) difiere de std::set en el paso %d\n", range, step);
+        return false;
+      }
+    }
+
+    TArray<int> keys;
+    reference.clear();
+    for (int i = 0; i < range * 2; ++i) {
+      keys.Add(static_cast<int>(rng() % range));
+      reference.insert(keys[keys.Num() - 1]);
+    }
+    flat.Build(std::move(keys));
+    if (flat.Num() != reference.size() || !std::equal(flat.begin(), flat.end(), reference.begin())) {
+      std::printf("  TFlatSet::Build (%d claves posibles) difiere de std::set\n", range);
+      return false;
+    }
+    return true;
+  }
+
+  bool differentialTest() {
+    for (int range : { 1, 2, 7, 16, 64, 300 }) {
+      if (!mapDifferential<int>("int", range, [](int k) { return k; }, [](const int& k) { return k; }) ||
+          !mapDifferential<std::string>("std::string", range, keyName, [](const std::string& k) { return k.c_str(); }) ||
+          !setDifferential(range)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  template<typename Func>
+  double nsPerOp(size_t opsPerCall, int repetitions, Func func) {
+    func();  // Calentamiento.
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+      func();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() /
+           (static_cast<double>(opsPerCall) * repetitions);
+  }
+
+  /**
+   * @brief Claves de la tabla (size claves distintas) y consultas (la mitad presentes), desordenadas.
+   */
+  void makeKeys(size_t size, std::vector<int>& keys, std::vector<int>& queries) {
+    std::mt19937 rng(static_cast<unsigned>(size));
+    keys.clear();
+    queries.clear();
+    // Las claves pares estan en la tabla; las impares no.
+    for (size_t i = 0; i < size; ++i) {
+      keys.push_back(static_cast<int>(2 * i));
+    }
+    std::shuffle(keys.begin(), keys.end(), rng);
+    for (size_t i = 0; i < 4096; ++i) {
+      queries.push_back(static_cast<int>(rng() % (2 * size)));
+    }
+  }
+
+  /**
+   * @brief Mide Find y la construccion de la tabla para cada tamano, con claves int o std::string.
+   */
+  template<typename K, typename MakeKey>
+  void measureMap(const char* name, MakeKey makeKey) {
+    std::printf("\nMapa %s (ns por busqueda, la mitad presentes; ns por elemento al construir):\n", name);
+    for (size_t size : Sizes) {
+      std::vector<int> keyIds, queryIds;
+      makeKeys(size, keyIds, queryIds);
+      std::vector<K> keys, queries;
+      for (int id : keyIds) keys.push_back(makeKey(id));
+      for (int id : queryIds) queries.push_back(makeKey(id));
+
+      TArray<typename TFlatMap<K, int>::Pair> pairs;
+      for (size_t i = 0; i < size; ++i) pairs.Add(typename TFlatMap<K, int>::Pair(keys[i], int(i)));
+      TFlatMap<K, int> flat;
+      flat.Build(std::move(pairs));
+      TMap<K, int> hashed;
+      std::map<K, int, std::less<>> ordered;
+      for (size_t i = 0; i < size; ++i) {
+        hashed.Add(keys[i], int(i));
+        ordered.emplace(keys[i], int(i));
+      }
+
+      int repetitions = 200;
+      double flatFind = nsPerOp(queries.size(), repetitions, [&] {
+        size_t sum = 0;
+        for (const K& query : queries) { const int* v = flat.Find(query); sum += v ? *v : 0; }
+        g_sink = sum;
+      });
+      double hashedFind = nsPerOp(queries.size(), repetitions, [&] {
+        size_t sum = 0;
+        for (const K& query : queries) { const int* v = hashed.Find(query); sum += v ? *v : 0; }
+        g_sink = sum;
+      });
+      double orderedFind = nsPerOp(queries.size(), repetitions, [&] {
+        size_t sum = 0;
+        for (const K& query : queries) { auto it = ordered.find(query); sum += it != ordered.end() ? it->second : 0; }
+        g_sink = sum;
+      });
+
+      int buildRepetitions = static_cast<int>(200000 / size);
+      double flatBuild = nsPerOp(size, buildRepetitions, [&] {
+        TArray<typename TFlatMap<K, int>::Pair> input;
+        input.Reserve(size);
+        for (size_t i = 0; i < size; ++i) input.Add(typename TFlatMap<K, int>::Pair(keys[i], int(i)));
+        TFlatMap<K, int> map;
+        map.Build(std::move(input));
+        g_sink = map.Num();
+      });
+      double hashedBuild = nsPerOp(size, buildRepetitions, [&] {
+        TMap<K, int> map;
+        for (size_t i = 0; i < size; ++i) map.Add(keys[i], int(i));
+        g_sink = map.Num();
+      });
+      double orderedBuild = nsPerOp(size, buildRepetitions, [&] {
+        std::map<K, int, std::less<>> map;
+        for (size_t i = 0; i < size; ++i) map.emplace(keys[i], int(i));
+        g_sink = map.size();
+      });
+
+      std::printf("  %5zu  Find   TFlatMap %7.2f  TMap %7.2f  std::map %7.2f\n", size, flatFind, hashedFind, orderedFind);
+      std::printf("         Build  TFlatMap %7.2f  TMap %7.2f  std::map %7.2f\n", flatBuild, hashedBuild, orderedBuild);
+    }
+  }
+
+  void measureSet() {
+    std::printf("\nConjunto int (ns por Contains, la mitad presentes):\n");
+    for (size_t size : Sizes) {
+      std::vector<int> keys, queries;
+      makeKeys(size, keys, queries);
+      TArray<int> input;
+      for (int key : keys) input.Add(key);
+      TFlatSet<int> flat;
+      flat.Build(std::move(input));
+      TSet<int> hashed;
+      std::set<int> ordered(keys.begin(), keys.end());
+      for (int key : keys) hashed.Add(key);
+
+      int repetitions = 200;
+      double flatContains = nsPerOp(queries.size(), repetitions, [&] {
+        size_t found = 0;
+        for (int query : queries) found += flat.Contains(query);
+        g_sink = found;
+      });
+      double hashedContains = nsPerOp(queries.size(), repetitions, [&] {
+        size_t found = 0;
+        for (int query : queries) found += hashed.Contains(query);
+        g_sink = found;
+      });
+      double orderedContains = nsPerOp(queries.size(), repetitions, [&] {
+        size_t found = 0;
+        for (int query : queries) found += ordered.count(query);
+        g_sink = found;
+      });
+      std::printf("  %5zu  TFlatSet %7.2f  TSet %7.2f  std::set %7.2f\n", size, flatContains, hashedContains, orderedContains);
+    }
+  }
+}
+
+int main() {
+  std::printf("Flat container benchmark\n\n");
+  std::printf("Pruebas:\n");
+  if (!differentialTest()) {
+    return 1;
+  }
+  std::printf("  TFlatMap y TFlatSet coinciden con std::map y std::set (int y std::string, Build con repetidas)\n");
+
+  measureMap<int>("int", [](int id) { return id; });
+  measureMap<std::string>("std::string", keyName);
+  measureSet();
+  return 0;
+}
@@ -0,0 +1,130 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+/**
+ * Benchmark del descarte por frustum: 1M de cajas contra el frustum de una camara, con
+ * Frustum::intersects caja por caja (escalar, AoS) frente a cullAABBs (8 cajas por iteracion, SoA).
+ *
+ * No forma parte del proyecto de Visual Studio; se compila aparte, por ejemplo en Linux:
+ *
+ *   g++ -std=c++17 -O2 -I IzzyEngine/Include IzzyEngine/Benchmarks/FrustumCullingBenchmark.cpp -o cullbench
+ *   g++ -std=c++17 -O2 -mavx2 -mfma -I IzzyEngine/Include IzzyEngine/Benchmarks/FrustumCullingBenchmark.cpp -o cullbench
+ *
+ * Antes de medir comprueba que las dos versiones marcan las mismas cajas como visibles.
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Utilities/Bounds/Frustum.h"
+
+using EngineUtilities::AABB;
+using EngineUtilities::Frustum;
+using EngineUtilities::Matrix4x4;
+using EngineUtilities::Vector3;
+using EngineUtilities::Vector3x8;
+
+namespace {
+
+  volatile size_t g_sink;  ///< Evita que el compilador descarte los bucles medidos.
+
+  template<typename Func>
+  double nsPerOp(size_t opsPerCall, int repetitions, Func func) {
+    func();  // Calentamiento.
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+      func();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() /
+           (static_cast<double>(opsPerCall) * repetitions);
+  }
+
+  /**
+   * @brief Cuenta las cajas visibles con la prueba escalar, guardando un byte por caja.
+   */
+  size_t scalarCull(const Frustum& frustum, const std::vector<AABB>& boxes, std::vector<uint8_t>& visible) {
+    size_t count = 0;
+    for (size_t i = 0; i < boxes.size(); ++i) {
+      visible[i] = frustum.intersects(boxes[i]) ? 1 : 0;
+      count += visible[i];
+    }
+    return count;
+  }
+}
+
+int main() {
+  std::mt19937 rng(11);
+  const size_t boxCount = 1000000;
+  const int repetitions = 50;
+
+  std::printf("Frustum culling benchmark (SSE2 %d, AVX2 %d, FMA %d), %zu cajas\n\n",
+              ENGINE_MATH_SSE2, ENGINE_MATH_AVX2, ENGINE_MATH_FMA, boxCount);
+
+  // Camara en (0, 0, -50) mirando a +z, 90 grados de campo de vision y plano lejano a 200.
+  Matrix4x4 view = Matrix4x4::translation(0.0f, 0.0f, 50.0f);
+  Matrix4x4 projection = Matrix4x4::perspectiveLH(0.2f, 0.2f, 0.1f, 200.0f);
+  Frustum frustum = Frustum::fromViewProjection(view * projection);
+
+  // Cajas repartidas en un cubo de 400 de lado: cerca del 18% queda dentro del frustum.
+  std::uniform_real_distribution<float> position(-200.0f, 200.0f);
+  std::uniform_real_distribution<float> size(0.1f, 4.0f);
+  std::vector<AABB> boxes(boxCount);
+  for (AABB& box : boxes) {
+    box = AABB::fromCenterExtents(Vector3(position(rng), position(rng), position(rng)),
+                                  Vector3(size(rng), size(rng), size(rng)));
+  }
+
+  std::vector<Vector3x8> centers(Vector3x8::blocksFor(boxCount)), extents(centers.size());
+  EngineUtilities::packAABBs(boxes.data(), boxCount, centers.data(), extents.data());
+
+  std::vector<uint8_t> scalarVisible(boxCount), masks(centers.size());
+  size_t scalarCount = scalarCull(frustum, boxes, scalarVisible);
+  size_t simdCount = EngineUtilities::cullAABBs(frustum, centers.data(), extents.data(), boxCount, masks.data());
+  size_t mismatches = 0;
+  for (size_t i = 0; i < boxCount; ++i) {
+    bool simd = ((masks[i / Vector3x8::Width] >> (i % Vector3x8::Width)) & 1u) != 0;
+    mismatches += simd != (scalarVisible[i] != 0) ? 1 : 0;
+  }
+  std::printf("Visibles: escalar %zu, cullAABBs %zu, discrepancias %zu\n\n", scalarCount, simdCount, mismatches);
+
+  double scalarNs = nsPerOp(boxCount, repetitions, [&] {
+    g_sink = scalarCull(frustum, boxes, scalarVisible);
+  });
+  double simdNs = nsPerOp(boxCount, repetitions, [&] {
+    g_sink = EngineUtilities::cullAABBs(frustum, centers.data(), extents.data(), boxCount, masks.data());
+  });
+  std::printf("Rendimiento por caja:\n");
+  std::printf("  %-30s engine %7.3f ns  escalar %7.3f ns  (x%.2f)\n",
+              "cullAABBs (SoA x8)", simdNs, scalarNs, scalarNs / simdNs);
+  std::printf("  %-30s %.1f M cajas/s\n", "cullAABBs", 1000.0 / simdNs);
+  return 0;
+}
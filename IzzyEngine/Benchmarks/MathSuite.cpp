@@ -0,0 +1,1020 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+/**
+ * Suite de benchmark y prueba diferencial de la biblioteca matematica: EngineMath.h (escalar y
+ * SIMD), Vector2/3/4, Vector3x8, Vector3d, Matrix2x2/3x3/4x4, Quaternion y transformPositions.
+ *
+ * Cada operacion se compara con la misma cuenta hecha en long double y se reporta el error en ULP
+ * (maximo y medio), junto con ns por operacion y millones de operaciones por segundo. Cada operacion
+ * tiene un limite de ULP; si alguna lo supera el programa termina con codigo 1. Para las
+ * operaciones con cancelacion (productos punto, determinantes, inversas...) el ULP se mide respecto
+ * a la escala de los terminos sumados y no del resultado, indicado en la columna "escala".
+ *
+ * Opciones:
+ *   --save <archivo>     guarda los resultados como base de comparacion.
+ *   --compare <archivo>  compara con una base guardada: marca las operaciones mas de un 15% mas
+ *                        lentas o con mas error; termina con codigo 2 si hay alguna mas lenta.
+ *
+ * No forma parte del proyecto de Visual Studio; Benchmarks/Makefile la compila con y sin SIMD
+ * (make -C IzzyEngine/Benchmarks check). A mano, por ejemplo:
+ *
+ *   g++ -std=c++17 -O2 -I IzzyEngine/Include IzzyEngine/Benchmarks/MathSuite.cpp -o mathsuite
+ *   g++ -std=c++17 -O2 -mavx2 -mfma -I IzzyEngine/Include IzzyEngine/Benchmarks/MathSuite.cpp -o mathsuite
+ *   g++ -std=c++17 -O2 -DENGINE_MATH_DISABLE_SIMD -I IzzyEngine/Include IzzyEngine/Benchmarks/MathSuite.cpp -o mathsuite
+ */
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Utilities/Utilities/EngineMathSIMD.h"
+#include "Utilities/Utilities/EngineMathTables.h"
+#include "Utilities/Vectors/Vector2.h"
+#include "Utilities/Vectors/Vector4.h"
+#include "Utilities/Vectors/Vector3d.h"
+#include "Utilities/Vectors/Vector3x8.h"
+#include "Utilities/Vectors/Quaternion.h"
+#include "Utilities/Matrix/Matrix2x2.h"
+#include "Utilities/Matrix/Matrix3x3.h"
+#include "Utilities/Matrix/Matrix4x4.h"
+#include "Utilities/Bounds/VertexTransform.h"
+
+namespace EM = EngineUtilities;
+using EM::Matrix2x2;
+using EM::Matrix3x3;
+using EM::Matrix4x4;
+using EM::Quaternion;
+using EM::Vector2;
+using EM::Vector3;
+using EM::Vector3x8;
+using EM::Vector4;
+
+namespace {
+
+  using Real = long double;
+
+#if ENGINE_MATH_AVX2
+  const char* const SIMD_PATH = "AVX2";
+#elif ENGINE_MATH_SSE2
+  const char* const SIMD_PATH = "SSE2";
+#else
+  const char* const SIMD_PATH = "escalar";
+#endif
+  const char* const SCALAR_PATH = "escalar";
+
+  volatile float g_sink;  ///< Evita que el compilador descarte los bucles medidos.
+
+  /**
+   * @brief Tamano de un ULP de float en la magnitud de reference (2^-149 por debajo de FLT_MIN).
+   */
+  Real ulpSize(Real reference) {
+    Real magnitude = std::fabs(reference);
+    if (magnitude < FLT_MIN) {
+      return std::ldexp(static_cast<Real>(1), -149);
+    }
+    int exponent;
+    std::frexp(magnitude, &exponent);  // magnitude = m 2^exponent con m en [0.5, 1)
+    return std::ldexp(static_cast<Real>(1), exponent - 24);
+  }
+
+  /**
+   * @brief Error de value en ULP, medidos en la magnitud max(|reference|, scale).
+   */
+  double ulpError(float value, Real reference, Real scale = 0) {
+    Real magnitude = std::max(std::fabs(reference), scale);
+    return static_cast<double>(std::fabs(static_cast<Real>(value) - reference) / ulpSize(magnitude));
+  }
+
+  struct UlpStats {
+    double max = 0.0;
+    double sum = 0.0;
+    size_t count = 0;
+
+    void add(double ulp) {
+      max = std::max(max, ulp);
+      sum += ulp;
+      ++count;
+    }
+
+    double average() const {
+      return count > 0 ? sum / count : 0.0;
+    }
+  };
+
+  struct Result {
+    std::string name;
+    std::string path;
+    const char* scale;
+    double ns;
+    UlpStats ulp;
+    double budget;
+  };
+
+  std::vector<Result> g_results;
+
+  void record(const char* name, const char* path, const char* scale, double ns, const UlpStats& ulp, double budget) {
+    g_results.push_back({ name, path, scale, ns, ulp, budget });
+  }
+
+  /**
+   * @brief Mejor tiempo por operacion de nueve tandas de al menos 4 ms cada una.
+   */
+  template<typename Func>
+  double measureNs(size_t opsPerCall, Func func) {
+    using Clock = std::chrono::steady_clock;
+    func();  // Calentamiento.
+    double best = 1e300;
+    for (int run = 0; run < 9; ++run) {
+      size_t calls = 0;
+      double elapsed = 0.0;
+      auto start = Clock::now();
+      do {
+        func();
+        ++calls;
+        elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+      } while (elapsed < 4.0e6);
+      best = std::min(best, elapsed / (static_cast<double>(calls) * opsPerCall));
+    }
+    return best;
+  }
+
+  //--------------------------------------------------------------------------------------------
+  // Datos de entrada
+  //--------------------------------------------------------------------------------------------
+
+  std::mt19937 g_rng(2024);
+  const size_t SAMPLES = 1 << 16;
+
+  std::vector<float> uniformInputs(float lo, float hi, size_t count = SAMPLES) {
+    std::uniform_real_distribution<float> dist(lo, hi);
+    std::vector<float> values(count);
+    for (float& v : values) v = dist(g_rng);
+    return values;
+  }
+
+  /**
+   * @brief Valores positivos repartidos geometricamente en [lo, hi].
+   */
+  std::vector<float> geometricInputs(double lo, double hi, size_t count = SAMPLES) {
+    std::uniform_real_distribution<double> dist(std::log(lo), std::log(hi));
+    std::vector<float> values(count);
+    for (float& v : values) v = static_cast<float>(std::exp(dist(g_rng)));
+    return values;
+  }
+
+  Vector3 randomVector3(float range) {
+    std::uniform_real_distribution<float> dist(-range, range);
+    return Vector3(dist(g_rng), dist(g_rng), dist(g_rng));
+  }
+
+  Quaternion randomRotation() {
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+    return Quaternion(dist(g_rng), dist(g_rng), dist(g_rng), dist(g_rng)).normalize();
+  }
+
+  //--------------------------------------------------------------------------------------------
+  // Referencias en long double
+  //--------------------------------------------------------------------------------------------
+
+  struct RealMatrix {
+    int n;
+    Real m[4][4];
+  };
+
+  template<typename Matrix>
+  RealMatrix toReal(const Matrix& matrix, int n) {
+    RealMatrix result{ n, {} };
+    for (int i = 0; i < n; ++i)
+      for (int j = 0; j < n; ++j) result.m[i][j] = matrix.m[i][j];
+    return result;
+  }
+
+  RealMatrix multiply(const RealMatrix& a, const RealMatrix& b) {
+    RealMatrix result{ a.n, {} };
+    for (int i = 0; i < a.n; ++i)
+      for (int j = 0; j < a.n; ++j)
+        for (int k = 0; k < a.n; ++k) result.m[i][j] += a.m[i][k] * b.m[k][j];
+    return result;
+  }
+
+  /**
+   * @brief Suma de |a_ik b_kj|: la escala de cada elemento del producto.
+   */
+  RealMatrix multiplyScale(const RealMatrix& a, const RealMatrix& b) {
+    RealMatrix result{ a.n, {} };
+    for (int i = 0; i < a.n; ++i)
+      for (int j = 0; j < a.n; ++j)
+        for (int k = 0; k < a.n; ++k) result.m[i][j] += std::fabs(a.m[i][k] * b.m[k][j]);
+    return result;
+  }
+
+  /**
+   * @brief Determinante por cofactores; con absolute = true suma |terminos| (la escala).
+   */
+  Real determinant(const RealMatrix& a, bool absolute) {
+    if (a.n == 1) return absolute ? std::fabs(a.m[0][0]) : a.m[0][0];
+    Real result = 0;
+    for (int c = 0; c < a.n; ++c) {
+      RealMatrix minor{ a.n - 1, {} };
+      for (int i = 1; i < a.n; ++i)
+        for (int j = 0, k = 0; j < a.n; ++j)
+          if (j != c) minor.m[i - 1][k++] = a.m[i][j];
+      Real term = a.m[0][c] * determinant(minor, absolute);
+      if (absolute) result += std::fabs(term);
+      else result += (c % 2 == 0) ? term : -term;
+    }
+    return result;
+  }
+
+  /**
+   * @brief Inversa por Gauss-Jordan con pivoteo parcial.
+   */
+  RealMatrix inverse(const RealMatrix& matrix) {
+    int n = matrix.n;
+    Real a[4][8] = {};
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) a[i][j] = matrix.m[i][j];
+      a[i][n + i] = 1;
+    }
+    for (int col = 0; col < n; ++col) {
+      int pivot = col;
+      for (int r = col + 1; r < n; ++r)
+        if (std::fabs(a[r][col]) > std::fabs(a[pivot][col])) pivot = r;
+      for (int j = 0; j < 2 * n; ++j) std::swap(a[col][j], a[pivot][j]);
+      Real inv = 1 / a[col][col];
+      for (int j = 0; j < 2 * n; ++j) a[col][j] *= inv;
+      for (int r = 0; r < n; ++r) {
+        if (r == col) continue;
+        Real f = a[r][col];
+        for (int j = 0; j < 2 * n; ++j) a[r][j] -= f * a[col][j];
+      }
+    }
+    RealMatrix result{ n, {} };
+    for (int i = 0; i < n; ++i)
+      for (int j = 0; j < n; ++j) result.m[i][j] = a[i][n + j];
+    return result;
+  }
+
+  Real maxAbs(const RealMatrix& a) {
+    Real result = 0;
+    for (int i = 0; i < a.n; ++i)
+      for (int j = 0; j < a.n; ++j) result = std::max(result, std::fabs(a.m[i][j]));
+    return result;
+  }
+
+  /**
+   * @brief Agrega el error de cada elemento de value frente a reference con la escala dada.
+   */
+  template<typename Matrix>
+  void addMatrixError(UlpStats& stats, const Matrix& value, const RealMatrix& reference, const RealMatrix* elementScale,
+                      Real globalScale = 0) {
+    for (int i = 0; i < reference.n; ++i)
+      for (int j = 0; j < reference.n; ++j)
+        stats.add(ulpError(value.m[i][j], reference.m[i][j],
+                           std::max(globalScale, elementScale ? elementScale->m[i][j] : Real(0))));
+  }
+
+  template<typename Matrix>
+  Matrix randomMatrix(int n, bool diagonallyDominant) {
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    Matrix result;
+    for (int i = 0; i < n; ++i)
+      for (int j = 0; j < n; ++j) result.m[i][j] = dist(g_rng) + (diagonallyDominant && i == j ? 4.0f : 0.0f);
+    return result;
+  }
+
+  /**
+   * @brief Matriz afin: rotacion, escala no uniforme y traslacion.
+   */
+  Matrix4x4 randomAffine() {
+    std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+    return EM::composeTRS(randomVector3(100.0f), randomRotation(), Vector3(scale(g_rng), scale(g_rng), scale(g_rng)));
+  }
+
+  struct RealQuaternion {
+    Real w, x, y, z;
+  };
+
+  RealQuaternion toReal(const Quaternion& q) {
+    return { q.w, q.x, q.y, q.z };
+  }
+
+  RealQuaternion multiply(const RealQuaternion& a, const RealQuaternion& b) {
+    return { a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+             a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+             a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+             a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w };
+  }
+
+  void addQuaternionError(UlpStats& stats, const Quaternion& value, const RealQuaternion& reference, Real scale) {
+    stats.add(ulpError(value.w, reference.w, scale));
+    stats.add(ulpError(value.x, reference.x, scale));
+    stats.add(ulpError(value.y, reference.y, scale));
+    stats.add(ulpError(value.z, reference.z, scale));
+  }
+
+  /**
+   * @brief Matriz de rotacion en long double con la misma formula que Quaternion::toMatrix.
+   */
+  RealMatrix rotationMatrix(const RealQuaternion& q) {
+    RealMatrix r{ 4, {} };
+    r.m[0][0] = 1 - 2 * (q.y * q.y + q.z * q.z);
+    r.m[0][1] = 2 * (q.x * q.y + q.w * q.z);
+    r.m[0][2] = 2 * (q.x * q.z - q.w * q.y);
+    r.m[1][0] = 2 * (q.x * q.y - q.w * q.z);
+    r.m[1][1] = 1 - 2 * (q.x * q.x + q.z * q.z);
+    r.m[1][2] = 2 * (q.y * q.z + q.w * q.x);
+    r.m[2][0] = 2 * (q.x * q.z + q.w * q.y);
+    r.m[2][1] = 2 * (q.y * q.z - q.w * q.x);
+    r.m[2][2] = 1 - 2 * (q.x * q.x + q.y * q.y);
+    r.m[3][3] = 1;
+    return r;
+  }
+
+  //--------------------------------------------------------------------------------------------
+  // EngineMath.h
+  //--------------------------------------------------------------------------------------------
+
+  template<typename Func, typename Reference>
+  void unaryTest(const char* name, const std::vector<float>& inputs, double budget, Func func, Reference reference) {
+    std::vector<float> out(inputs.size());
+    UlpStats stats;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      Real expected = reference(static_cast<Real>(inputs[i]));
+      if (std::isfinite(expected)) {
+        stats.add(ulpError(func(inputs[i]), expected));
+      }
+    }
+    double ns = measureNs(inputs.size(), [&] {
+      for (size_t i = 0; i < inputs.size(); ++i) out[i] = func(inputs[i]);
+      g_sink = out.back();
+    });
+    record(name, SCALAR_PATH, "resultado", ns, stats, budget);
+  }
+
+  /**
+   * @brief Funciones de arreglo (sinArray...) frente a la referencia elemento a elemento.
+   */
+  template<typename Func, typename Reference>
+  void arrayTest(const char* name, const std::vector<float>& inputs, double budget, Func func, Reference reference) {
+    std::vector<float> out(inputs.size());
+    func(inputs.data(), out.data(), inputs.size());
+    UlpStats stats;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      stats.add(ulpError(out[i], reference(static_cast<Real>(inputs[i]))));
+    }
+    double ns = measureNs(inputs.size(), [&] {
+      func(inputs.data(), out.data(), inputs.size());
+      g_sink = out.back();
+    });
+    record(name, SIMD_PATH, "resultado", ns, stats, budget);
+  }
+
+  void testEngineMath() {
+    std::vector<float> positive = geometricInputs(1e-30, 1e30);
+    std::vector<float> angles = uniformInputs(-1000.0f, 1000.0f);
+    std::vector<float> unit = uniformInputs(-1.0f, 1.0f);
+
+    unaryTest("sqrt", positive, 1.5, [](float x) { return EM::sqrt(x); }, [](Real x) { return std::sqrt(x); });
+    unaryTest("sin", angles, 1.5, [](float x) { return EM::sin(x); }, [](Real x) { return std::sin(x); });
+    unaryTest("cos", angles, 2.0, [](float x) { return EM::cos(x); }, [](Real x) { return std::cos(x); });
+    unaryTest("tan", uniformInputs(-1.5f, 1.5f), 4.0, [](float x) { return EM::tan(x); }, [](Real x) { return std::tan(x); });
+    unaryTest("asin", unit, 3.0, [](float x) { return EM::asin(x); }, [](Real x) { return std::asin(x); });
+    unaryTest("acos", unit, 2.0, [](float x) { return EM::acos(x); }, [](Real x) { return std::acos(x); });
+    unaryTest("atan", uniformInputs(-100.0f, 100.0f), 3.5, [](float x) { return EM::atan(x); }, [](Real x) { return std::atan(x); });
+    unaryTest("exp", uniformInputs(-87.0f, 88.0f), 1.5, [](float x) { return EM::exp(x); }, [](Real x) { return std::exp(x); });
+    unaryTest("log", geometricInputs(1e-37, 1e37), 1.5, [](float x) { return EM::log(x); }, [](Real x) { return std::log(x); });
+    unaryTest("log10", geometricInputs(1e-37, 1e37), 2.5, [](float x) { return EM::log10(x); }, [](Real x) { return std::log10(x); });
+    std::vector<float> hyperbolic = uniformInputs(-10.0f, 10.0f);
+    // sinh y tanh restan exponenciales: cerca de 0 el error relativo crece por cancelacion.
+    unaryTest("sinh", hyperbolic, 768.0, [](float x) { return EM::sinh(x); }, [](Real x) { return std::sinh(x); });
+    unaryTest("cosh", hyperbolic, 3.0, [](float x) { return EM::cosh(x); }, [](Real x) { return std::cosh(x); });
+    unaryTest("tanh", hyperbolic, 768.0, [](float x) { return EM::tanh(x); }, [](Real x) { return std::tanh(x); });
+
+    // atan2 con pares de puntos en todos los cuadrantes.
+    {
+      std::vector<float> ys = uniformInputs(-100.0f, 100.0f), xs = uniformInputs(-100.0f, 100.0f), out(SAMPLES);
+      UlpStats stats;
+      for (size_t i = 0; i < SAMPLES; ++i) {
+        stats.add(ulpError(EM::atan2(ys[i], xs[i]), std::atan2(static_cast<Real>(ys[i]), static_cast<Real>(xs[i]))));
+      }
+      double ns = measureNs(SAMPLES, [&] {
+        for (size_t i = 0; i < SAMPLES; ++i) out[i] = EM::atan2(ys[i], xs[i]);
+        g_sink = out.back();
+      });
+      record("atan2", SCALAR_PATH, "resultado", ns, stats, 3.5);
+    }
+
+    // La tabla interpolada tiene error absoluto; se mide en la escala de 1 y en [-2 PI, 2 PI], donde la
+    // reduccion de rango en float no agrega error propio.
+    {
+      std::vector<float> turns = uniformInputs(-2.0f * EM::PI, 2.0f * EM::PI), out(SAMPLES);
+      UlpStats stats;
+      for (size_t i = 0; i < SAMPLES; ++i) {
+        stats.add(ulpError(EM::tableSin(turns[i]), std::sin(static_cast<Real>(turns[i])), 1));
+      }
+      double ns = measureNs(SAMPLES, [&] {
+        for (size_t i = 0; i < SAMPLES; ++i) out[i] = EM::tableSin(turns[i]);
+        g_sink = out.back();
+      });
+      record("tableSin", SCALAR_PATH, "1", ns, stats, 64.0);
+    }
+
+    // La reduccion de rango en float de las versiones SIMD pierde digitos relativos cerca de los
+    // ceros de sin/cos cuando |x| es grande; el limite refleja ese comportamiento en [-1000, 1000].
+    arrayTest("sinArray", angles, 64.0, [](const float* in, float* out, size_t n) { EM::sinArray(in, out, n); },
+              [](Real x) { return std::sin(x); });
+    arrayTest("cosArray", angles, 64.0, [](const float* in, float* out, size_t n) { EM::cosArray(in, out, n); },
+              [](Real x) { return std::cos(x); });
+  }
+
+  //--------------------------------------------------------------------------------------------
+  // Vectores
+  //--------------------------------------------------------------------------------------------
+
+  void testVectors() {
+    const size_t n = SAMPLES;
+    std::vector<Vector3> a(n), b(n), out3(n);
+    std::vector<float> outF(n);
+    for (size_t i = 0; i < n; ++i) {
+      a[i] = randomVector3(100.0f);
+      b[i] = randomVector3(100.0f);
+    }
+
+    // Vector2
+    {
+      std::vector<Vector2> v(n), out(n);
+      for (size_t i = 0; i < n; ++i) v[i] = Vector2(a[i].x, a[i].y);
+      UlpStats magnitude, normalize;
+      for (size_t i = 0; i < n; ++i) {
+        Real len = std::sqrt(static_cast<Real>(v[i].x) * v[i].x + static_cast<Real>(v[i].y) * v[i].y);
+        magnitude.add(ulpError(v[i].magnitude(), len));
+        Vector2 u = v[i].normalize();
+        normalize.add(ulpError(u.x, v[i].x / len, 1));
+        normalize.add(ulpError(u.y, v[i].y / len, 1));
+      }
+      record("Vector2::magnitude", SCALAR_PATH, "resultado", measureNs(n, [&] {
+        for (size_t i = 0; i < n; ++i) outF[i] = v[i].magnitude();
+        g_sink = outF.back();
+      }), magnitude, 1.5);
+      record("Vector2::normalize", SCALAR_PATH, "1", measureNs(n, [&] {
+        for (size_t i = 0; i < n; ++i) out[i] = v[i].normalize();
+        g_sink = out.back().x;
+      }), normalize, 2.0);
+    }
+
+    // Vector3
+    {
+      UlpStats dot, cross, magnitude, normalize;
+      for (size_t i = 0; i < n; ++i) {
+        Real ax = a[i].x, ay = a[i].y, az = a[i].z, bx = b[i].x, by = b[i].y, bz = b[i].z;
+        dot.add(ulpError(a[i].dot(b[i]), ax * bx + ay * by + az * bz,
+                         std::fabs(ax * bx) + std::fabs(ay * by) + std::fabs(az * bz)));
+        Vector3 c = a[i].cross(b[i]);
+        cross.add(ulpError(c.x, ay * bz - az * by, std::fabs(ay * bz) + std::fabs(az * by)));
+        cross.add(ulpError(c.y, az * bx - ax * bz, std::fabs(az * bx) + std::fabs(ax * bz)));
+        cross.add(ulpError(c.z, ax * by - ay * bx, std::fabs(ax * by) + std::fabs(ay * bx)));
+        Real len = std::sqrt(ax * ax + ay * ay + az * az);
+        magnitude.add(ulpError(a[i].magnitude(), len));
+        Vector3 u = a[i].normalize();
+        normalize.add(ulpError(u.x, ax / len, 1));
+        normalize.add(ulpError(u.y, ay / len, 1));
+        normalize.add(ulpError(u.z, az / len, 1));
+      }
+      record("Vector3::dot", SCALAR_PATH, "terminos", measureNs(n, [&] {
+        for (size_t i = 0; i < n; ++i) outF[i] = a[i].dot(b[i]);
+        g_sink = outF.back();
+      }), dot, 2.0);
+      record("Vector3::cross", SCALAR_PATH, "terminos", measureNs(n, [&] {
+        for (size_t i = 0; i < n; ++i) out3[i] = a[i].cross(b[i]);
+        g_sink = out3.back().x;
+      }), cross, 1.5);
+      record("Vector3::magnitude", SCALAR_PATH, "resultado", measureNs(n, [&] {
+        for (size_t i = 0; i < n; ++i) outF[i] = a[i].magnitude();
+        g_sink = outF.back();
+      }), magnitude, 2.0);
+      record("Vector3::normalize", SCALAR_PATH, "1", measureNs(n, [&] {
+        for (size_t i = 0; i < n; ++i) out3[i] = a[i].normalize();
+        g_sink = out3.back().x;
+      }), normalize, 2.0);
+    }
+
+    // Vector4 (SSE2 cuando esta disponible)
+    {
+      std::vector<Vector4> v(n), w(n), out(n);
+      std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+      for (size_t i = 0; i < n; ++i) {
+        v[i] = Vector4(a[i].x, a[i].y, a[i].z, dist(g_rng));
+        w[i] = Vector4(b[i].x, b[i].y, b[i].z, dist(g_rng));
+      }
+      UlpStats dot, magnitude, normalize;
+      for (size_t i = 0; i < n; ++i) {
+        const float* p = &v[i].x;
+        const float* q = &w[i].x;
+        Real sum = 0, scale = 0, lengthSq = 0;
+        for (int k = 0; k < 4; ++k) {
+          sum += static_cast<Real>(p[k]) * q[k];
+          scale += std::fabs(static_cast<Real>(p[k]) * q[k]);
+          lengthSq += static_cast<Real>(p[k]) * p[k];
+        }
+        dot.add(ulpError(v[i].dot(w[i]), sum, scale));
+        Real len = std::sqrt(lengthSq);
+        magnitude.add(ulpError(v[i].magnitude(), len));
+        Vector4 u = v[i].normalize();
+        const float* r = &u.x;
+        for (int k = 0; k < 4; ++k) normalize.add(ulpError(r[k], p[k] / len, 1));
+      }
+      const char* path = ENGINE_MATH_SSE2 ? "SSE2" : SCALAR_PATH;
+      record("Vector4::dot", path, "terminos", measureNs(n, [&] {
+        for (size_t i = 0; i < n; ++i) outF[i] = v[i].dot(w[i]);
+        g_sink = outF.back();
+      }), dot, 2.5);
+      record("Vector4::magnitude", path, "resultado", measureNs(n, [&] {
+        for (size_t i = 0; i < n; ++i) outF[i] = v[i].magnitude();
+        g_sink = outF.back();
+      }), magnitude, 2.0);
+      record("Vector4::normalize", path, "1", measureNs(n, [&] {
+        for (size_t i = 0; i < n; ++i) out[i] = v[i].normalize();
+        g_sink = out.back().x;
+      }), normalize, 2.0);
+    }
+
+    // Vector3x8: los mismos calculos en lotes SoA
+    {
+      size_t blocks = Vector3x8::blocksFor(n);
+      std::vector<Vector3x8> pa(blocks), pb(blocks), pout(blocks);
+      EM::packVector3x8(a.data(), n, pa.data());
+      EM::packVector3x8(b.data(), n, pb.data());
+      std::vector<float> lanes(blocks * Vector3x8::Width);
+
+      UlpStats dot, cross, length, normalize;
+      EM::dotBatch(pa.data(), pb.data(), lanes.data(), blocks);
+      for (size_t i = 0; i < n; ++i) {
+        Real ax = a[i].x, ay = a[i].y, az = a[i].z, bx = b[i].x, by = b[i].y, bz = b[i].z;
+        dot.add(ulpError(lanes[i], ax * bx + ay * by + az * bz,
+                         std::fabs(ax * bx) + std::fabs(ay * by) + std::fabs(az * bz)));
+      }
+      EM::crossBatch(pa.data(), pb.data(), pout.data(), blocks);
+      for (size_t i = 0; i < n; ++i) {
+        Real ax = a[i].x, ay = a[i].y, az = a[i].z, bx = b[i].x, by = b[i].y, bz = b[i].z;
+        Vector3 c = pout[i / Vector3x8::Width].get(i % Vector3x8::Width);
+        cross.add(ulpError(c.x, ay * bz - az * by, std::fabs(ay * bz) + std::fabs(az * by)));
+        cross.add(ulpError(c.y, az * bx - ax * bz, std::fabs(az * bx) + std::fabs(ax * bz)));
+        cross.add(ulpError(c.z, ax * by - ay * bx, std::fabs(ax * by) + std::fabs(ay * bx)));
+      }
+      EM::lengthBatch(pa.data(), lanes.data(), blocks);
+      EM::normalizeBatch(pa.data(), pout.data(), blocks);
+      for (size_t i = 0; i < n; ++i) {
+        Real ax = a[i].x, ay = a[i].y, az = a[i].z;
+        Real len = std::sqrt(ax * ax + ay * ay + az * az);
+        length.add(ulpError(lanes[i], len));
+        Vector3 u = pout[i / Vector3x8::Width].get(i % Vector3x8::Width);
+        normalize.add(ulpError(u.x, ax / len, 1));
+        normalize.add(ulpError(u.y, ay / len, 1));
+        normalize.add(ulpError(u.z, az / len, 1));
+      }
+      record("dotBatch", SIMD_PATH, "terminos", measureNs(n, [&] {
+        EM::dotBatch(pa.data(), pb.data(), lanes.data(), blocks);
+        g_sink = lanes.back();
+      }), dot, 2.0);
+      record("crossBatch", SIMD_PATH, "terminos", measureNs(n, [&] {
+        EM::crossBatch(pa.data(), pb.data(), pout.data(), blocks);
+        g_sink = pout.back().x[0];
+      }), cross, 1.5);
+      record("lengthBatch", SIMD_PATH, "resultado", measureNs(n, [&] {
+        EM::lengthBatch(pa.data(), lanes.data(), blocks);
+        g_sink = lanes.back();
+      }), length, 2.0);
+      record("normalizeBatch", SIMD_PATH, "1", measureNs(n, [&] {
+        EM::normalizeBatch(pa.data(), pout.data(), blocks);
+        g_sink = pout.back().x[0];
+      }), normalize, 2.0);
+    }
+  }
+
+  //--------------------------------------------------------------------------------------------
+  // Posiciones de mundo en double
+  //--------------------------------------------------------------------------------------------
+
+  void testWorldPositions() {
+    const size_t n = SAMPLES;
+    std::uniform_real_distribution<double> coordinate(-1.0e6, 1.0e6);
+    std::vector<EM::Vector3d> positions(n);
+    for (EM::Vector3d& p : positions) p = EM::Vector3d(coordinate(g_rng), coordinate(g_rng), coordinate(g_rng));
+    EM::Vector3d origin(123456.789, -2345.5, 999999.125);
+    std::vector<Vector3> out(n);
+
+    // La resta se redondea a double y luego a float: a lo sumo un pelo mas de medio ULP.
+    UlpStats stats;
+    EM::rebasePositions(positions.data(), origin, out.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+      stats.add(ulpError(out[i].x, static_cast<Real>(positions[i].x) - origin.x));
+      stats.add(ulpError(out[i].y, static_cast<Real>(positions[i].y) - origin.y));
+      stats.add(ulpError(out[i].z, static_cast<Real>(positions[i].z) - origin.z));
+    }
+    record("rebasePositions", ENGINE_MATH_AVX2 ? "AVX" : SIMD_PATH, "resultado", measureNs(n, [&] {
+      EM::rebasePositions(positions.data(), origin, out.data(), n);
+      g_sink = out.back().x;
+    }), stats, 0.51);
+  }
+
+  //--------------------------------------------------------------------------------------------
+  // Matrices
+  //--------------------------------------------------------------------------------------------
+
+  /**
+   * @brief Producto, determinante e inversa de una matriz cuadrada de tamano n.
+   */
+  template<typename Matrix>
+  void testSquareMatrix(const char* prefix, int n, const char* multiplyPath, double multiplyBudget,
+                        double determinantBudget, double inverseBudget) {
+    const size_t count = 4096;
+    std::vector<Matrix> a(count), b(count), out(count);
+    std::vector<float> outF(count);
+    for (size_t i = 0; i < count; ++i) {
+      a[i] = randomMatrix<Matrix>(n, true);
+      b[i] = randomMatrix<Matrix>(n, false);
+    }
+    UlpStats multiply, det, inv;
+    for (size_t i = 0; i < count; ++i) {
+      RealMatrix ra = toReal(a[i], n), rb = toReal(b[i], n);
+      RealMatrix scale = multiplyScale(ra, rb);
+      addMatrixError(multiply, a[i] * b[i], ::multiply(ra, rb), &scale);
+      det.add(ulpError(a[i].determinant(), determinant(ra, false), determinant(ra, true)));
+      RealMatrix reference = inverse(ra);
+      addMatrixError(inv, a[i].inverse(), reference, nullptr, maxAbs(reference));
+    }
+    std::string name = prefix;
+    record((name + " operator*").c_str(), multiplyPath, "terminos", measureNs(count, [&] {
+      for (size_t i = 0; i < count; ++i) out[i] = a[i] * b[i];
+      g_sink = out.back().m[0][0];
+    }), multiply, multiplyBudget);
+    record((name + "::determinant").c_str(), SCALAR_PATH, "terminos", measureNs(count, [&] {
+      for (size_t i = 0; i < count; ++i) outF[i] = a[i].determinant();
+      g_sink = outF.back();
+    }), det, determinantBudget);
+    record((name + "::inverse").c_str(), SCALAR_PATH, "max |inv|", measureNs(count, [&] {
+      for (size_t i = 0; i < count; ++i) out[i] = a[i].inverse();
+      g_sink = out.back().m[0][0];
+    }), inv, inverseBudget);
+  }
+
+  void testMatrix4x4Transforms() {
+    const size_t count = 4096;
+    std::vector<Matrix4x4> affine(count), out(count);
+    for (Matrix4x4& m : affine) m = randomAffine();
+
+    UlpStats inverseAffine;
+    for (size_t i = 0; i < count; ++i) {
+      RealMatrix reference = inverse(toReal(affine[i], 4));
+      addMatrixError(inverseAffine, affine[i].inverseAffine(), reference, nullptr, maxAbs(reference));
+    }
+    record("Matrix4x4::inverseAffine", ENGINE_MATH_SSE2 ? "SSE2" : SCALAR_PATH, "max |inv|", measureNs(count, [&] {
+      for (size_t i = 0; i < count; ++i) out[i] = affine[i].inverseAffine();
+      g_sink = out.back().m[0][0];
+    }), inverseAffine, 8.0);
+
+    // Transformacion de puntos: una matriz, muchos puntos.
+    const Matrix4x4& matrix = affine[0];
+    RealMatrix rm = toReal(matrix, 4);
+    const size_t n = SAMPLES;
+    std::vector<Vector3> points(n), outPoints(n);
+    for (Vector3& p : points) p = randomVector3(100.0f);
+    size_t blocks = Vector3x8::blocksFor(n);
+    std::vector<Vector3x8> packed(blocks), packedOut(blocks);
+    EM::packVector3x8(points.data(), n, packed.data());
+
+    auto addPointError = [&](UlpStats& stats, const Vector3& value, const Vector3& p) {
+      Real in[4] = { p.x, p.y, p.z, 1 };
+      const float* v = &value.x;
+      for (int j = 0; j < 3; ++j) {
+        Real sum = 0, scale = 0;
+        for (int k = 0; k < 4; ++k) {
+          sum += in[k] * rm.m[k][j];
+          scale += std::fabs(in[k] * rm.m[k][j]);
+        }
+        stats.add(ulpError(v[j], sum, scale));
+      }
+    };
+
+    UlpStats single, aos, soa;
+    matrix.TransformPoints(points.data(), outPoints.data(), n);
+    matrix.TransformPoints(packed.data(), packedOut.data(), blocks);
+    for (size_t i = 0; i < n; ++i) {
+      addPointError(single, matrix.transformPoint(points[i]), points[i]);
+      addPointError(aos, outPoints[i], points[i]);
+      addPointError(soa, packedOut[i / Vector3x8::Width].get(i % Vector3x8::Width), points[i]);
+    }
+    record("Matrix4x4::transformPoint", SCALAR_PATH, "terminos", measureNs(n, [&] {
+      for (size_t i = 0; i < n; ++i) outPoints[i] = matrix.transformPoint(points[i]);
+      g_sink = outPoints.back().x;
+    }), single, 2.0);
+    record("TransformPoints (AoS)", ENGINE_MATH_SSE2 ? "SSE2" : SCALAR_PATH, "terminos", measureNs(n, [&] {
+      matrix.TransformPoints(points.data(), outPoints.data(), n);
+      g_sink = outPoints.back().x;
+    }), aos, 2.0);
+    record("TransformPoints (SoA x8)", SIMD_PATH, "terminos", measureNs(n, [&] {
+      matrix.TransformPoints(packed.data(), packedOut.data(), blocks);
+      g_sink = packedOut.back().x[0];
+    }), soa, 2.0);
+
+    // Kernel de vertices intercalados: aqui con Vector3 contiguos (stride de 12 bytes).
+    UlpStats positions;
+    EM::AABB bounds = EM::transformPositions(matrix, &points[0].x, sizeof(Vector3), n, outPoints.data());
+    EM::AABB expected;
+    for (size_t i = 0; i < n; ++i) {
+      addPointError(positions, outPoints[i], points[i]);
+      expected.expand(outPoints[i]);
+    }
+    // La caja debe ser exactamente la de las posiciones escritas.
+    if (std::memcmp(&bounds, &expected, sizeof(EM::AABB)) != 0) {
+      positions.add(1e30);
+    }
+    record("transformPositions", SIMD_PATH, "terminos", measureNs(n, [&] {
+      g_sink = EM::transformPositions(matrix, &points[0].x, sizeof(Vector3), n, outPoints.data()).maxCorner.x;
+    }), positions, 2.0);
+  }
+
+  //--------------------------------------------------------------------------------------------
+  // Quaternion
+  //--------------------------------------------------------------------------------------------
+
+  void testQuaternion() {
+    const size_t n = SAMPLES;
+    std::vector<Quaternion> a(n), b(n), out(n);
+    std::vector<Vector3> vectors(n), outVectors(n);
+    std::vector<Vector3> euler(n);
+    std::vector<float> ts = uniformInputs(0.0f, 1.0f, n);
+    for (size_t i = 0; i < n; ++i) {
+      a[i] = randomRotation();
+      b[i] = randomRotation();
+      vectors[i] = randomVector3(100.0f);
+      euler[i] = randomVector3(3.0f);
+    }
+
+    UlpStats product, normalize, rotate, toMatrix, fromEuler, slerp, nlerp;
+    for (size_t i = 0; i < n; ++i) {
+      RealQuaternion ra = toReal(a[i]), rb = toReal(b[i]);
+      // Cuaterniones unitarios: cada componente del producto es una suma de terminos de magnitud <= 1.
+      addQuaternionError(product, a[i] * b[i], multiply(ra, rb), 1);
+
+      Quaternion unnormalized(a[i].w * 3.0f, a[i].x * 3.0f, a[i].y * 3.0f, a[i].z * 3.0f);
+      RealQuaternion ru = toReal(unnormalized);
+      Real length = std::sqrt(ru.w * ru.w + ru.x * ru.x + ru.y * ru.y + ru.z * ru.z);
+      addQuaternionError(normalize, unnormalized.normalize(), { ru.w / length, ru.x / length, ru.y / length, ru.z / length }, 1);
+
+      RealMatrix rotation = rotationMatrix(ra);
+      Vector3 rotated = a[i].rotate(vectors[i]);
+      Real v[3] = { vectors[i].x, vectors[i].y, vectors[i].z };
+      Real vLength = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+      const float* r = &rotated.x;
+      for (int j = 0; j < 3; ++j) {
+        Real sum = 0;
+        for (int k = 0; k < 3; ++k) sum += v[k] * rotation.m[k][j];
+        rotate.add(ulpError(r[j], sum, vLength));
+      }
+      addMatrixError(toMatrix, a[i].toMatrix(), rotation, nullptr, 1);
+
+      Real sp = std::sin(static_cast<Real>(euler[i].x) / 2), cp = std::cos(static_cast<Real>(euler[i].x) / 2);
+      Real sy = std::sin(static_cast<Real>(euler[i].y) / 2), cy = std::cos(static_cast<Real>(euler[i].y) / 2);
+      Real sr = std::sin(static_cast<Real>(euler[i].z) / 2), cr = std::cos(static_cast<Real>(euler[i].z) / 2);
+      addQuaternionError(fromEuler, Quaternion::fromEuler(euler[i]),
+                         { cr * cp * cy + sr * sp * sy, cr * sp * cy + sr * cp * sy,
+                           cr * cp * sy - sr * sp * cy, sr * cp * cy - cr * sp * sy }, 1);
+
+      Real cosTheta = ra.w * rb.w + ra.x * rb.x + ra.y * rb.y + ra.z * rb.z;
+      Real sign = cosTheta < 0 ? -1 : 1;
+      cosTheta = std::fabs(cosTheta);
+      Real t = ts[i];
+      if (cosTheta < static_cast<Real>(0.9995)) {
+        Real theta = std::acos(cosTheta);
+        Real ta = std::sin((1 - t) * theta) / std::sin(theta);
+        Real tb = std::sin(t * theta) / std::sin(theta) * sign;
+        addQuaternionError(slerp, Quaternion::slerp(a[i], b[i], ts[i]),
+                           { ra.w * ta + rb.w * tb, ra.x * ta + rb.x * tb, ra.y * ta + rb.y * tb, ra.z * ta + rb.z * tb }, 1);
+      }
+      RealQuaternion blend = { ra.w * (1 - t) + rb.w * t * sign, ra.x * (1 - t) + rb.x * t * sign,
+                               ra.y * (1 - t) + rb.y * t * sign, ra.z * (1 - t) + rb.z * t * sign };
+      Real blendLength = std::sqrt(blend.w * blend.w + blend.x * blend.x + blend.y * blend.y + blend.z * blend.z);
+      addQuaternionError(nlerp, Quaternion::nlerp(a[i], b[i], ts[i]),
+                         { blend.w / blendLength, blend.x / blendLength, blend.y / blendLength, blend.z / blendLength }, 1);
+    }
+
+    record("Quaternion operator*", SCALAR_PATH, "1", measureNs(n, [&] {
+      for (size_t i = 0; i < n; ++i) out[i] = a[i] * b[i];
+      g_sink = out.back().w;
+    }), product, 2.0);
+    record("Quaternion::normalize", SCALAR_PATH, "1", measureNs(n, [&] {
+      for (size_t i = 0; i < n; ++i) out[i] = a[i].normalize();
+      g_sink = out.back().w;
+    }), normalize, 2.0);
+    record("Quaternion::rotate", SCALAR_PATH, "|v|", measureNs(n, [&] {
+      for (size_t i = 0; i < n; ++i) outVectors[i] = a[i].rotate(vectors[i]);
+      g_sink = outVectors.back().x;
+    }), rotate, 10.0);
+    std::vector<Matrix4x4> matrices(n);
+    record("Quaternion::toMatrix", SCALAR_PATH, "1", measureNs(n, [&] {
+      for (size_t i = 0; i < n; ++i) matrices[i] = a[i].toMatrix();
+      g_sink = matrices.back().m[0][0];
+    }), toMatrix, 4.0);
+    record("Quaternion::fromEuler", SCALAR_PATH, "1", measureNs(n, [&] {
+      for (size_t i = 0; i < n; ++i) out[i] = Quaternion::fromEuler(euler[i]);
+      g_sink = out.back().w;
+    }), fromEuler, 4.0);
+    record("Quaternion::slerp", SCALAR_PATH, "1", measureNs(n, [&] {
+      for (size_t i = 0; i < n; ++i) out[i] = Quaternion::slerp(a[i], b[i], ts[i]);
+      g_sink = out.back().w;
+    }), slerp, 16.0);
+    record("Quaternion::nlerp", SCALAR_PATH, "1", measureNs(n, [&] {
+      for (size_t i = 0; i < n; ++i) out[i] = Quaternion::nlerp(a[i], b[i], ts[i]);
+      g_sink = out.back().w;
+    }), nlerp, 4.0);
+
+    // Versiones en lote
+    UlpStats nlerpBatchStats, composeStats;
+    EM::nlerpBatch(a.data(), b.data(), 0.3f, out.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+      RealQuaternion ra = toReal(a[i]), rb = toReal(b[i]);
+      Real sign = (ra.w * rb.w + ra.x * rb.x + ra.y * rb.y + ra.z * rb.z) < 0 ? -1 : 1;
+      Real t = static_cast<Real>(0.3f);
+      RealQuaternion blend = { ra.w * (1 - t) + rb.w * t * sign, ra.x * (1 - t) + rb.x * t * sign,
+                               ra.y * (1 - t) + rb.y * t * sign, ra.z * (1 - t) + rb.z * t * sign };
+      Real length = std::sqrt(blend.w * blend.w + blend.x * blend.x + blend.y * blend.y + blend.z * blend.z);
+      addQuaternionError(nlerpBatchStats, out[i], { blend.w / length, blend.x / length, blend.y / length, blend.z / length }, 1);
+    }
+    record("nlerpBatch", ENGINE_MATH_SSE2 ? "SSE2" : SCALAR_PATH, "1", measureNs(n, [&] {
+      EM::nlerpBatch(a.data(), b.data(), 0.3f, out.data(), n);
+      g_sink = out.back().w;
+    }), nlerpBatchStats, 4.0);
+
+    std::vector<Vector3> positions(n), scales(n);
+    std::uniform_real_distribution<float> scaleDist(0.5f, 2.0f);
+    for (size_t i = 0; i < n; ++i) {
+      positions[i] = randomVector3(100.0f);
+      scales[i] = Vector3(scaleDist(g_rng), scaleDist(g_rng), scaleDist(g_rng));
+    }
+    EM::composeTRSBatch(positions.data(), a.data(), scales.data(), matrices.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+      RealMatrix reference = rotationMatrix(toReal(a[i]));
+      Real s[3] = { scales[i].x, scales[i].y, scales[i].z };
+      for (int r = 0; r < 3; ++r)
+        for (int c = 0; c < 3; ++c) composeStats.add(ulpError(matrices[i].m[r][c], reference.m[r][c] * s[r], s[r]));
+      composeStats.add(ulpError(matrices[i].m[3][0], positions[i].x));
+      composeStats.add(ulpError(matrices[i].m[3][1], positions[i].y));
+      composeStats.add(ulpError(matrices[i].m[3][2], positions[i].z));
+    }
+    record("composeTRSBatch", ENGINE_MATH_SSE2 ? "SSE2" : SCALAR_PATH, "escala", measureNs(n, [&] {
+      EM::composeTRSBatch(positions.data(), a.data(), scales.data(), matrices.data(), n);
+      g_sink = matrices.back().m[0][0];
+    }), composeStats, 4.0);
+  }
+
+  //--------------------------------------------------------------------------------------------
+  // Base de comparacion
+  //--------------------------------------------------------------------------------------------
+
+  struct Baseline {
+    double ns;
+    double maxUlp;
+  };
+
+  std::string resultKey(const Result& r) {
+    return r.name + "|" + r.path;
+  }
+
+  bool saveBaseline(const char* file) {
+    std::ofstream out(file);
+    if (!out) return false;
+    for (const Result& r : g_results) {
+      out << resultKey(r) << '\t' << r.ns << '\t' << r.ulp.max << '\n';
+    }
+    return true;
+  }
+
+  bool loadBaseline(const char* file, std::map<std::string, Baseline>& baseline) {
+    std::ifstream in(file);
+    if (!in) return false;
+    std::string line;
+    while (std::getline(in, line)) {
+      std::istringstream fields(line);
+      std::string key;
+      Baseline entry;
+      if (std::getline(fields, key, '\t') && fields >> entry.ns >> entry.maxUlp) {
+        baseline[key] = entry;
+      }
+    }
+    return true;
+  }
+}
+
+int main(int argc, char** argv) {
+  const char* saveFile = nullptr;
+  const char* compareFile = nullptr;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--save") == 0 && i + 1 < argc) saveFile = argv[++i];
+    else if (std::strcmp(argv[i], "--compare") == 0 && i + 1 < argc) compareFile = argv[++i];
+    else {
+      std::fprintf(stderr, "Uso: %s [--save archivo] [--compare archivo]\n", argv[0]);
+      return 64;
+    }
+  }
+
+  std::map<std::string, Baseline> baseline;
+  if (compareFile && !loadBaseline(compareFile, baseline)) {
+    std::fprintf(stderr, "No se pudo leer la base %s\n", compareFile);
+    return 64;
+  }
+
+  std::printf("Math suite (SSE2 %d, AVX2 %d, FMA %d)\n\n", ENGINE_MATH_SSE2, ENGINE_MATH_AVX2, ENGINE_MATH_FMA);
+
+  testEngineMath();
+  testVectors();
+  testWorldPositions();
+  testSquareMatrix<Matrix2x2>("Matrix2x2", 2, SCALAR_PATH, 1.5, 1.5, 4.0);
+  testSquareMatrix<Matrix3x3>("Matrix3x3", 3, SCALAR_PATH, 2.0, 3.0, 8.0);
+  testSquareMatrix<Matrix4x4>("Matrix4x4", 4, ENGINE_MATH_SSE2 ? "SSE2" : SCALAR_PATH, 2.5, 5.0, 16.0);
+  testMatrix4x4Transforms();
+  testQuaternion();
+
+  const double slowdownLimit = 1.15;
+  int failures = 0;
+  int slower = 0;
+  std::vector<double> ratios;
+  std::printf("%-28s %-8s %10s %10s %9s %9s %9s %-9s %s\n",
+              "operacion", "ruta", "ns/op", "Mops/s", "ULP max", "ULP medio", "limite", "escala", compareFile ? "estado   vs base" : "estado");
+  for (const Result& r : g_results) {
+    bool ok = r.ulp.max <= r.budget;
+    failures += ok ? 0 : 1;
+    std::printf("%-28s %-8s %10.3f %10.1f %9.3g %9.3g %9.3g %-9s %-6s",
+                r.name.c_str(), r.path.c_str(), r.ns, 1000.0 / r.ns, r.ulp.max, r.ulp.average(), r.budget, r.scale,
+                ok ? "ok" : "FALLA");
+    if (compareFile) {
+      auto found = baseline.find(resultKey(r));
+      if (found == baseline.end()) {
+        std::printf("   (nueva)");
+      }
+      else {
+        double ratio = r.ns / found->second.ns;
+        bool isSlower = ratio > slowdownLimit;
+        bool lessAccurate = r.ulp.max > found->second.maxUlp * 1.01 + 1e-3;
+        slower += isSlower ? 1 : 0;
+        ratios.push_back(ratio);
+        std::printf("   %+6.1f%%%s%s", (ratio - 1.0) * 100.0, isSlower ? " LENTA" : "", lessAccurate ? " ULP+" : "");
+      }
+    }
+    std::printf("\n");
+  }
+
+  if (saveFile && !saveBaseline(saveFile)) {
+    std::fprintf(stderr, "No se pudo escribir la base %s\n", saveFile);
+  }
+
+  std::printf("\n%zu operaciones, %d fuera del limite de ULP", g_results.size(), failures);
+  if (compareFile) {
+    std::printf(", %d mas de un %.0f%% mas lentas que la base", slower, (slowdownLimit - 1.0) * 100.0);
+    if (!ratios.empty()) {
+      // Si casi todas las operaciones cambian a la vez, suele ser la maquina y no el codigo.
+      std::nth_element(ratios.begin(), ratios.begin() + ratios.size() / 2, ratios.end());
+      std::printf(" (cambio mediano %+.1f%%)", (ratios[ratios.size() / 2] - 1.0) * 100.0);
+    }
+  }
+  std::printf("\n");
+  if (failures > 0) return 1;
+  if (slower > 0) return 2;
+  return 0;
+}
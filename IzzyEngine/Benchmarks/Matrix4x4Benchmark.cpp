@@ -0,0 +1,259 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+/**
+ * Benchmark de Matrix4x4: multiplicacion, inversas y transformacion de puntos en lote, frente a
+ * las versiones escalares anteriores (copiadas aqui como referencia).
+ *
+ * No forma parte del proyecto de Visual Studio; se compila aparte, por ejemplo en Linux:
+ *
+ *   g++ -std=c++17 -O2 -I IzzyEngine/Include IzzyEngine/Benchmarks/Matrix4x4Benchmark.cpp -o matbench
+ *   g++ -std=c++17 -O2 -mavx2 -mfma -I IzzyEngine/Include IzzyEngine/Benchmarks/Matrix4x4Benchmark.cpp -o matbench
+ *
+ * Antes de medir comprueba que cada version coincide con la referencia escalar.
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Utilities/Matrix/Matrix4x4.h"
+
+using EngineUtilities::Matrix4x4;
+using EngineUtilities::Vector3;
+using EngineUtilities::Vector3x8;
+
+namespace {
+
+  volatile float g_sink;  ///< Evita que el compilador descarte los bucles medidos.
+
+  /**
+   * @brief Producto escalar de referencia: 64 multiplicaciones y sumas, como el operator* original.
+   */
+  Matrix4x4 scalarMultiply(const Matrix4x4& a, const Matrix4x4& b) {
+    Matrix4x4 result;
+    for (int i = 0; i < 4; ++i) {
+      for (int j = 0; j < 4; ++j) {
+        result.m[i][j] = a.m[i][0] * b.m[0][j] + a.m[i][1] * b.m[1][j] +
+                         a.m[i][2] * b.m[2][j] + a.m[i][3] * b.m[3][j];
+      }
+    }
+    return result;
+  }
+
+  /**
+   * @brief Inversa de referencia por eliminacion de Gauss-Jordan en double.
+   */
+  Matrix4x4 referenceInverse(const Matrix4x4& matrix) {
+    double a[4][8];
+    for (int i = 0; i < 4; ++i) {
+      for (int j = 0; j < 4; ++j) {
+        a[i][j] = matrix.m[i][j];
+        a[i][j + 4] = (i == j) ? 1.0 : 0.0;
+      }
+    }
+    for (int col = 0; col < 4; ++col) {
+      int pivot = col;
+      for (int r = col + 1; r < 4; ++r) {
+        if (std::fabs(a[r][col]) > std::fabs(a[pivot][col])) pivot = r;
+      }
+      for (int j = 0; j < 8; ++j) std::swap(a[col][j], a[pivot][j]);
+      double inv = 1.0 / a[col][col];
+      for (int j = 0; j < 8; ++j) a[col][j] *= inv;
+      for (int r = 0; r < 4; ++r) {
+        if (r == col) continue;
+        double f = a[r][col];
+        for (int j = 0; j < 8; ++j) a[r][j] -= f * a[col][j];
+      }
+    }
+    Matrix4x4 result;
+    for (int i = 0; i < 4; ++i) {
+      for (int j = 0; j < 4; ++j) {
+        result.m[i][j] = static_cast<float>(a[i][j + 4]);
+      }
+    }
+    return result;
+  }
+
+  float maxDifference(const Matrix4x4& a, const Matrix4x4& b) {
+    float result = 0.0f;
+    for (int i = 0; i < 4; ++i) {
+      for (int j = 0; j < 4; ++j) {
+        result = std::fmax(result, std::fabs(a.m[i][j] - b.m[i][j]));
+      }
+    }
+    return result;
+  }
+
+  /**
+   * @brief Matriz afin aleatoria: rotacion, escala no uniforme y traslacion.
+   */
+  Matrix4x4 randomAffine(std::mt19937& rng, bool rigid) {
+    std::uniform_real_distribution<float> angle(-3.0f, 3.0f);
+    std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+    std::uniform_real_distribution<float> offset(-100.0f, 100.0f);
+    float a = angle(rng), b = angle(rng);
+    float ca = std::cos(a), sa = std::sin(a), cb = std::cos(b), sb = std::sin(b);
+    Matrix4x4 rotation(ca, sa, 0, 0, -sa, ca, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1);
+    Matrix4x4 tilt(1, 0, 0, 0, 0, cb, sb, 0, 0, -sb, cb, 0, 0, 0, 0, 1);
+    float sx = rigid ? 1.0f : scale(rng), sy = rigid ? 1.0f : scale(rng), sz = rigid ? 1.0f : scale(rng);
+    Matrix4x4 scaling(sx, 0, 0, 0, 0, sy, 0, 0, 0, 0, sz, 0, 0, 0, 0, 1);
+    Matrix4x4 translation;
+    translation.m[3][0] = offset(rng);
+    translation.m[3][1] = offset(rng);
+    translation.m[3][2] = offset(rng);
+    return scalarMultiply(scalarMultiply(scalarMultiply(scaling, rotation), tilt), translation);
+  }
+
+  template<typename Func>
+  double nsPerOp(size_t opsPerCall, int repetitions, Func func) {
+    func();  // Calentamiento.
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+      func();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() /
+           (static_cast<double>(opsPerCall) * repetitions);
+  }
+
+  void printSpeed(const char* name, double engineNs, double scalarNs) {
+    std::printf("  %-30s engine %7.3f ns  escalar %7.3f ns  (x%.2f)\n",
+                name, engineNs, scalarNs, scalarNs / engineNs);
+  }
+}
+
+int main() {
+  std::mt19937 rng(7);
+  const size_t matrixCount = 1024;
+  const size_t pointCount = 4096;
+  const int repetitions = 2000;
+
+  std::printf("Matrix4x4 benchmark (SSE2 %d, AVX2 %d, FMA %d)\n\n",
+              ENGINE_MATH_SSE2, ENGINE_MATH_AVX2, ENGINE_MATH_FMA);
+
+  std::vector<Matrix4x4> affine(matrixCount), rigid(matrixCount), general(matrixCount), out(matrixCount);
+  std::uniform_real_distribution<float> element(-1.0f, 1.0f);
+  for (size_t i = 0; i < matrixCount; ++i) {
+    affine[i] = randomAffine(rng, false);
+    rigid[i] = randomAffine(rng, true);
+    for (int r = 0; r < 4; ++r) {
+      for (int c = 0; c < 4; ++c) {
+        general[i].m[r][c] = element(rng) + (r == c ? 4.0f : 0.0f);  // Diagonal dominante: invertible.
+      }
+    }
+  }
+
+  std::uniform_real_distribution<float> coordinate(-50.0f, 50.0f);
+  std::vector<Vector3> points(pointCount), pointsOut(pointCount), reference(pointCount);
+  for (Vector3& p : points) {
+    p = Vector3(coordinate(rng), coordinate(rng), coordinate(rng));
+  }
+  std::vector<Vector3x8> blocks(Vector3x8::blocksFor(pointCount)), blocksOut(blocks.size());
+  EngineUtilities::packVector3x8(points.data(), pointCount, blocks.data());
+
+  std::printf("Diferencias maximas frente a la referencia:\n");
+  float multiplyError = 0.0f, inverseError = 0.0f, affineError = 0.0f, rigidError = 0.0f;
+  for (size_t i = 0; i < matrixCount; ++i) {
+    Matrix4x4 product = general[i] * affine[i];
+    multiplyError = std::fmax(multiplyError, maxDifference(product, scalarMultiply(general[i], affine[i])));
+    inverseError = std::fmax(inverseError, maxDifference(general[i].inverse(), referenceInverse(general[i])));
+    affineError = std::fmax(affineError, maxDifference(affine[i].inverseAffine(), referenceInverse(affine[i])));
+    rigidError = std::fmax(rigidError, maxDifference(rigid[i].inverseRigid(), referenceInverse(rigid[i])));
+  }
+  std::printf("  operator*        %.3g\n", multiplyError);
+  std::printf("  inverse          %.3g\n", inverseError);
+  std::printf("  inverseAffine    %.3g\n", affineError);
+  std::printf("  inverseRigid     %.3g\n", rigidError);
+
+  const Matrix4x4& transform = affine[0];
+  float pointError = 0.0f, blockError = 0.0f;
+  transform.TransformPoints(points.data(), pointsOut.data(), pointCount);
+  transform.TransformPoints(blocks.data(), blocksOut.data(), blocks.size());
+  for (size_t i = 0; i < pointCount; ++i) {
+    Vector3 expected = transform.transformPoint(points[i]);
+    Vector3 fromBlock = blocksOut[i / Vector3x8::Width].get(i % Vector3x8::Width);
+    pointError = std::fmax(pointError, std::fabs(pointsOut[i].x - expected.x) +
+                           std::fabs(pointsOut[i].y - expected.y) + std::fabs(pointsOut[i].z - expected.z));
+    blockError = std::fmax(blockError, std::fabs(fromBlock.x - expected.x) +
+                           std::fabs(fromBlock.y - expected.y) + std::fabs(fromBlock.z - expected.z));
+  }
+  std::printf("  TransformPoints  %.3g (AoS)  %.3g (SoA)\n", pointError, blockError);
+
+  std::printf("\nRendimiento por operacion:\n");
+  printSpeed("operator*",
+             nsPerOp(matrixCount, repetitions / 10, [&] {
+               for (size_t i = 0; i < matrixCount; ++i) out[i] = general[i] * affine[i];
+               g_sink = out[matrixCount - 1].m[0][0];
+             }),
+             nsPerOp(matrixCount, repetitions / 10, [&] {
+               for (size_t i = 0; i < matrixCount; ++i) out[i] = scalarMultiply(general[i], affine[i]);
+               g_sink = out[matrixCount - 1].m[0][0];
+             }));
+  double generalNs = nsPerOp(matrixCount, repetitions / 10, [&] {
+    for (size_t i = 0; i < matrixCount; ++i) general[i].inverse(out[i]);
+    g_sink = out[matrixCount - 1].m[0][0];
+  });
+  double referenceNs = nsPerOp(matrixCount, repetitions / 10, [&] {
+    for (size_t i = 0; i < matrixCount; ++i) out[i] = referenceInverse(general[i]);
+    g_sink = out[matrixCount - 1].m[0][0];
+  });
+  printSpeed("inverse (vs Gauss-Jordan)", generalNs, referenceNs);
+  printSpeed("inverseAffine (vs inverse)",
+             nsPerOp(matrixCount, repetitions / 10, [&] {
+               for (size_t i = 0; i < matrixCount; ++i) out[i] = affine[i].inverseAffine();
+               g_sink = out[matrixCount - 1].m[0][0];
+             }),
+             generalNs);
+  printSpeed("inverseRigid (vs inverse)",
+             nsPerOp(matrixCount, repetitions / 10, [&] {
+               for (size_t i = 0; i < matrixCount; ++i) out[i] = rigid[i].inverseRigid();
+               g_sink = out[matrixCount - 1].m[0][0];
+             }),
+             generalNs);
+
+  double scalarPointNs = nsPerOp(pointCount, repetitions, [&] {
+    for (size_t i = 0; i < pointCount; ++i) pointsOut[i] = transform.transformPoint(points[i]);
+    g_sink = pointsOut[pointCount - 1].x;
+  });
+  printSpeed("TransformPoints (AoS)",
+             nsPerOp(pointCount, repetitions, [&] {
+               transform.TransformPoints(points.data(), pointsOut.data(), pointCount);
+               g_sink = pointsOut[pointCount - 1].x;
+             }),
+             scalarPointNs);
+  printSpeed("TransformPoints (SoA x8)",
+             nsPerOp(pointCount, repetitions, [&] {
+               transform.TransformPoints(blocks.data(), blocksOut.data(), blocks.size());
+               g_sink = blocksOut.back().x[0];
+             }),
+             scalarPointNs);
+  return 0;
+}
@@ -0,0 +1,298 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+/**
+ * Benchmark y prueba de MakeShared con pool (TSharedPool) frente a MakeShared en el heap.
+ *
+ * Primero crea un millon de componentes desde un pool, comprueba su contenido y los destruye en
+ * orden aleatorio; al repetirlo el pool debe reutilizar los mismos bloques sin crecer. Despues los
+ * destruye desde otros hilos (la memoria vuelve al pool a traves de la pila global) y comprueba lo
+ * mismo. Por ultimo mide con un millon de componentes: crear y destruir (en orden y en orden
+ * aleatorio), recorrerlos cuando se crearon intercalados con otras reservas, y crear en un hilo
+ * mientras otro destruye. Las mediciones usan un pool nuevo, no el global que ya desordenaron las
+ * pruebas: la lista libre es LIFO, asi que tras liberar en orden aleatorio las reservas siguientes
+ * tambien salen en orden aleatorio (la fila de orden aleatorio mide justo ese caso).
+ *
+ * No forma parte del proyecto de Visual Studio; se compila aparte, por ejemplo en Linux:
+ *
+ *   g++ -std=c++17 -O2 -pthread -I IzzyEngine/Include IzzyEngine/Benchmarks/PoolBenchmark.cpp -o poolbench
+ *
+ * Termina con codigo 1 si alguna comprobacion falla.
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Utilities/Memory/TSharedPointer.h"
+
+using EngineUtilities::MakeShared;
+using EngineUtilities::TSharedPointer;
+using EngineUtilities::TSharedPool;
+
+namespace {
+
+  volatile size_t g_sink;          ///< Evita que el compilador descarte los bucles medidos.
+  std::atomic<int> g_alive{ 0 };   ///< Componentes construidos y no destruidos.
+
+  const size_t ComponentCount = 1000000;
+
+  /**
+   * @brief Componente del tamano de un Transform (posicion, rotacion, escala y matriz).
+   */
+  struct Component {
+    float position[3];
+    float rotation[3];
+    float scale[3];
+    float matrix[16];
+    uint32_t id;
+
+    explicit Component(uint32_t inId) : position{ 1.0f, 2.0f, 3.0f }, rotation{}, scale{ 1.0f, 1.0f, 1.0f },
+                                        matrix{}, id(inId) {
+      g_alive.fetch_add(1, std::memory_order_relaxed);
+    }
+    ~Component() { g_alive.fetch_sub(1, std::memory_order_relaxed); }
+  };
+
+  using Pointer = TSharedPointer<Component>;
+
+  Pointer makeHeap(uint32_t id) { return MakeShared<Component>(id); }
+  Pointer makePooled(uint32_t id) { return MakeShared(TSharedPool<Component>::get(), id); }
+
+  bool contentsCorrect(const std::vector<Pointer>& components) {
+    for (size_t i = 0; i < components.size(); ++i) {
+      if (!components[i] || components[i]->id != i || components[i]->scale[2] != 1.0f) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Crea y destruye un millon de componentes del pool, en el mismo hilo y desde otros hilos.
+   */
+  bool poolTest() {
+    TSharedPool<Component>& pool = TSharedPool<Component>::get();
+    std::mt19937 rng(7);
+    std::vector<Pointer> components;
+    components.reserve(ComponentCount);
+    size_t capacity = 0;
+
+    for (int round = 0; round < 3; ++round) {
+      for (uint32_t i = 0; i < ComponentCount; ++i) {
+        components.push_back(makePooled(i));
+      }
+      if (!contentsCorrect(components) || g_alive.load() != int(ComponentCount)) {
+        std::printf("  los componentes del pool no conservan su contenido (ronda %d)\n", round);
+        return false;
+      }
+      if (round == 0) {
+        capacity = pool.capacity();
+      }
+      else if (pool.capacity() != capacity) {
+        std::printf("  el pool crece de %zu a %zu bloques en vez de reutilizar los liberados\n", capacity, pool.capacity());
+        return false;
+      }
+      std::shuffle(components.begin(), components.end(), rng);
+      components.clear();
+      if (g_alive.load() != 0) {
+        std::printf("  quedan %d componentes sin destruir\n", g_alive.load());
+        return false;
+      }
+    }
+
+    // Liberar desde otros hilos: al terminar, sus caches devuelven los bloques a la pila global.
+    for (int round = 0; round < 3; ++round) {
+      for (uint32_t i = 0; i < ComponentCount; ++i) {
+        components.push_back(makePooled(i));
+      }
+      if (!contentsCorrect(components) || pool.capacity() != capacity) {
+        std::printf("  tras liberar desde otros hilos el pool no reutiliza los bloques (ronda %d)\n", round);
+        return false;
+      }
+      const size_t Threads = 4;
+      std::vector<std::thread> workers;
+      for (size_t t = 0; t < Threads; ++t) {
+        workers.emplace_back([&, t] {
+          for (size_t i = t; i < components.size(); i += Threads) {
+            components[i] = Pointer();
+          }
+        });
+      }
+      for (std::thread& worker : workers) {
+        worker.join();
+      }
+      components.clear();
+      if (g_alive.load() != 0) {
+        std::printf("  quedan %d componentes sin destruir tras liberar desde otros hilos\n", g_alive.load());
+        return false;
+      }
+    }
+    return true;
+  }
+
+  template<typename Func>
+  double nsPerOp(size_t opsPerCall, int repetitions, Func func) {
+    func();  // Calentamiento.
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+      func();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() /
+           (static_cast<double>(opsPerCall) * repetitions);
+  }
+
+  void printRow(const char* operation, double heapNs, double poolNs) {
+    std::printf("  %-40s heap %8.2f ns  pool %8.2f ns  (x%.2f)\n", operation, heapNs, poolNs, heapNs / poolNs);
+  }
+
+  /**
+   * @brief Crea ComponentCount componentes y los destruye en el orden en que se crearon o en orden aleatorio.
+   */
+  template<typename Make>
+  double spawnDestroy(Make make, bool shuffled, int repetitions) {
+    std::vector<Pointer> components;
+    components.reserve(ComponentCount);
+    std::mt19937 rng(11);
+    return nsPerOp(ComponentCount, repetitions, [&] {
+      for (uint32_t i = 0; i < ComponentCount; ++i) {
+        components.push_back(make(i));
+      }
+      g_sink = components.size();
+      if (shuffled) {
+        std::shuffle(components.begin(), components.end(), rng);
+      }
+      components.clear();
+    });
+  }
+
+  /**
+   * @brief Recorre componentes creados intercalados con otras reservas del mismo tamano.
+   *
+   * Las otras reservas imitan al resto del motor pidiendo memoria a la vez: en el heap quedan entre
+   * los componentes, en el pool no.
+   */
+  template<typename Make>
+  double walk(Make make, int repetitions) {
+    std::vector<Pointer> components;
+    std::vector<std::string> noise;
+    components.reserve(ComponentCount);
+    noise.reserve(ComponentCount);
+    for (uint32_t i = 0; i < ComponentCount; ++i) {
+      components.push_back(make(i));
+      noise.emplace_back(sizeof(Component), 'x');
+    }
+    return nsPerOp(ComponentCount, repetitions, [&] {
+      float sum = 0.0f;
+      for (const Pointer& component : components) {
+        sum += component->position[0] + component->matrix[0];
+      }
+      g_sink = static_cast<size_t>(sum);
+    });
+  }
+
+  /**
+   * @brief Un hilo crea componentes en lotes y otro los destruye: todas las liberaciones cruzan de hilo.
+   */
+  template<typename Make>
+  double producerConsumer(Make make, int repetitions) {
+    const size_t BatchSize = 1024;
+    return nsPerOp(ComponentCount, repetitions, [&] {
+      std::mutex mutex;
+      std::condition_variable ready;
+      std::vector<std::vector<Pointer>> queue;
+      bool done = false;
+
+      std::thread consumer([&] {
+        std::vector<std::vector<Pointer>> taken;
+        while (true) {
+          {
+            std::unique_lock<std::mutex> lock(mutex);
+            ready.wait(lock, [&] { return done || !queue.empty(); });
+            if (queue.empty() && done) {
+              break;
+            }
+            taken.swap(queue);
+          }
+          taken.clear();  // Destruye los componentes fuera del mutex.
+        }
+      });
+
+      std::vector<Pointer> batch;
+      for (uint32_t i = 0; i < ComponentCount; ++i) {
+        batch.push_back(make(i));
+        if (batch.size() == BatchSize || i + 1 == ComponentCount) {
+          std::lock_guard<std::mutex> lock(mutex);
+          queue.push_back(std::move(batch));
+          batch.clear();
+          ready.notify_one();
+        }
+      }
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+        ready.notify_one();
+      }
+      consumer.join();
+    });
+  }
+}
+
+int main() {
+  std::printf("Pool benchmark\n\n");
+  std::printf("Pruebas:\n");
+  if (!poolTest()) {
+    return 1;
+  }
+  std::printf("  el pool conserva los componentes, los destruye todos y reutiliza los bloques (mismo hilo y otros hilos)\n");
+
+  std::printf("\n%zu componentes de %zu bytes:\n", ComponentCount, sizeof(Component));
+  {
+    TSharedPool<Component> pool;
+    auto makeFresh = [&](uint32_t id) { return MakeShared(pool, id); };
+    printRow("Crear y destruir", spawnDestroy(makeHeap, false, 5), spawnDestroy(makeFresh, false, 5));
+    printRow("Recorrer (creados entre otras reservas)", walk(makeHeap, 10), walk(makeFresh, 10));
+    printRow("Crear en un hilo y destruir en otro", producerConsumer(makeHeap, 3), producerConsumer(makeFresh, 3));
+    // Va la ultima: deja desordenadas las listas libres del pool y del heap.
+    printRow("Crear y destruir en orden aleatorio", spawnDestroy(makeHeap, true, 3), spawnDestroy(makeFresh, true, 3));
+  }
+
+  if (g_alive.load() != 0) {
+    std::printf("  quedan %d componentes sin destruir tras las mediciones\n", g_alive.load());
+    return 1;
+  }
+  return 0;
+}
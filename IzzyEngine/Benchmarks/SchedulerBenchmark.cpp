@@ -0,0 +1,278 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+/**
+ * Benchmark y prueba de ThreadPool, World::forEachChunkParallel y SystemScheduler.
+ *
+ * Comprueba que parallelFor cubre cada indice una sola vez (tambien anidado y con cero
+ * trabajadores), que el planificador deduce las dependencias de las lecturas y escrituras
+ * declaradas y que varios frames en paralelo dan exactamente el mismo resultado que en serie.
+ * Despues mide un frame con 100K entidades (animacion, transform, cajas y particulas) en un solo
+ * hilo y en todos los hilos del equipo.
+ *
+ * No forma parte del proyecto de Visual Studio; se compila aparte, por ejemplo en Linux:
+ *
+ *   g++ -std=c++17 -O2 -pthread -I IzzyEngine/Include IzzyEngine/Benchmarks/SchedulerBenchmark.cpp -o schedulerbench
+ *
+ * Termina con codigo 1 si alguna comprobacion falla.
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "ECS/System.h"
+#include "Utilities/Bounds/AABB.h"
+#include "Utilities/Vectors/Quaternion.h"
+
+using EngineUtilities::AABB;
+using EngineUtilities::Matrix4x4;
+using EngineUtilities::Quaternion;
+using EngineUtilities::ThreadPool;
+using EngineUtilities::Vector3;
+
+namespace {
+  struct Spin {
+    float angle = 0.0f;
+    float speed = 1.0f;
+  };
+
+  struct BenchTransform {
+    Vector3 position;
+    Quaternion orientation;
+    Vector3 scale = Vector3(1.0f, 1.0f, 1.0f);
+    Matrix4x4 matrix;
+  };
+
+  struct Bounds {
+    AABB local = AABB(Vector3(-0.5f, -0.5f, -0.5f), Vector3(0.5f, 0.5f, 0.5f));
+    AABB world;
+  };
+
+  struct Particle {
+    Vector3 position;
+    Vector3 velocity = Vector3(0.0f, 1.0f, 0.0f);
+  };
+
+  // Avanza el angulo y escribe la rotacion del transform.
+  class AnimationSystem : public System {
+  public:
+    AnimationSystem() { writes<Spin>(); writes<BenchTransform>(); }
+    const char* getName() const override { return "AnimationSystem"; }
+    void update(World& world, float deltaTime) override {
+      world.forEachChunkParallel<Spin, BenchTransform>([=](size_t count, const EntityId*, Spin* spins,
+                                                           BenchTransform* transforms) {
+        for (size_t i = 0; i < count; ++i) {
+          spins[i].angle += spins[i].speed * deltaTime;
+          transforms[i].orientation = Quaternion::fromEuler(Vector3(0.0f, spins[i].angle, 0.0f));
+        }
+      });
+    }
+  };
+
+  class TransformSystem : public System {
+  public:
+    TransformSystem() { writes<BenchTransform>(); }
+    const char* getName() const override { return "TransformSystem"; }
+    void update(World& world, float) override {
+      world.forEachChunkParallel<BenchTransform>([](size_t count, const EntityId*, BenchTransform* transforms) {
+        for (size_t i = 0; i < count; ++i) {
+          transforms[i].matrix = EngineUtilities::composeTRS(transforms[i].position, transforms[i].orientation,
+                                                             transforms[i].scale);
+        }
+      });
+    }
+  };
+
+  class BoundsSystem : public System {
+  public:
+    BoundsSystem() { reads<BenchTransform>(); writes<Bounds>(); }
+    const char* getName() const override { return "BoundsSystem"; }
+    void update(World& world, float) override {
+      world.forEachChunkParallel<BenchTransform, Bounds>([](size_t count, const EntityId*,
+                                                            BenchTransform* transforms, Bounds* bounds) {
+        for (size_t i = 0; i < count; ++i) {
+          bounds[i].world = bounds[i].local.transformed(transforms[i].matrix);
+        }
+      });
+    }
+  };
+
+  // No comparte datos con los demas: puede ejecutarse a la vez que cualquiera de ellos.
+  class ParticleSystem : public System {
+  public:
+    ParticleSystem() { writes<Particle>(); }
+    const char* getName() const override { return "ParticleSystem"; }
+    void update(World& world, float deltaTime) override {
+      world.forEachChunkParallel<Particle>([=](size_t count, const EntityId*, Particle* particles) {
+        for (size_t i = 0; i < count; ++i) {
+          particles[i].velocity.y -= 9.8f * deltaTime;
+          particles[i].position = particles[i].position + particles[i].velocity * deltaTime;
+        }
+      });
+    }
+  };
+
+  void registerSystems(SystemScheduler& scheduler) {
+    scheduler.addSystem<AnimationSystem>();
+    scheduler.addSystem<TransformSystem>();
+    scheduler.addSystem<BoundsSystem>();
+    scheduler.addSystem<ParticleSystem>();
+  }
+
+  void populate(World& world, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+      EntityId entity = world.createEntity();
+      float f = static_cast<float>(i);
+      world.addComponent<BenchTransform>(entity)->position = Vector3(f * 0.01f, f * 0.02f, -f * 0.03f);
+      world.addComponent<Bounds>(entity);
+      if (i % 2 == 0) {
+        world.addComponent<Spin>(entity)->speed = 0.5f + (i % 7) * 0.25f;
+      }
+      EntityId particle = world.createEntity();
+      world.addComponent<Particle>(particle)->position = Vector3(f, 0.0f, 0.0f);
+    }
+  }
+
+  bool threadPoolTest() {
+    bool ok = true;
+    for (unsigned workers : { 0u, 3u }) {
+      ThreadPool pool(workers);
+      for (size_t count : { size_t(0), size_t(1), size_t(7), size_t(1000), size_t(100003) }) {
+        std::vector<std::atomic<int>> hits(count);
+        pool.parallelFor(count, 16, [&](size_t begin, size_t end) {
+          for (size_t i = begin; i < end; ++i) {
+            hits[i].fetch_add(1, std::memory_order_relaxed);
+          }
+        });
+        for (size_t i = 0; i < count && ok; ++i) {
+          if (hits[i].load() != 1) {
+            std::printf("  parallelFor(%zu) con %u trabajadores visita %d veces el indice %zu\n",
+                        count, workers, hits[i].load(), i);
+            ok = false;
+          }
+        }
+      }
+
+      // parallelFor anidado: cada tarea espera a sus subtareas sin bloquear el pool.
+      std::atomic<long long> sum(0);
+      pool.parallelFor(64, 1, [&](size_t begin, size_t end) {
+        for (size_t outer = begin; outer < end; ++outer) {
+          pool.parallelFor(1000, 10, [&](size_t innerBegin, size_t innerEnd) {
+            long long local = 0;
+            for (size_t inner = innerBegin; inner < innerEnd; ++inner) {
+              local += static_cast<long long>(inner);
+            }
+            sum.fetch_add(local, std::memory_order_relaxed);
+          });
+        }
+      });
+      if (sum.load() != 64LL * (999LL * 1000LL / 2)) {
+        std::printf("  parallelFor anidado con %u trabajadores suma %lld\n", workers, sum.load());
+        ok = false;
+      }
+    }
+    return ok;
+  }
+
+  bool schedulerTest() {
+    ThreadPool pool(3);
+    SystemScheduler scheduler(pool);
+    registerSystems(scheduler);
+    World parallelWorld;
+    populate(parallelWorld, 5000);
+    for (int frame = 0; frame < 20; ++frame) {
+      scheduler.update(parallelWorld, 1.0f / 60.0f);
+    }
+
+    // Dependencias esperadas segun las lecturas y escrituras declaradas.
+    const std::vector<size_t> expected[] = { {}, { 0 }, { 0, 1 }, {} };
+    bool ok = true;
+    for (size_t i = 0; i < scheduler.getSystemCount(); ++i) {
+      if (scheduler.getDependencies(i) != expected[i]) {
+        std::printf("  %s no tiene las dependencias esperadas\n", scheduler.getSystem(i).getName());
+        ok = false;
+      }
+    }
+
+    // El mismo trabajo en serie, en el orden de registro, debe dar exactamente lo mismo.
+    ThreadPool serialPool(0);
+    SystemScheduler serial(serialPool);
+    registerSystems(serial);
+    World serialWorld;
+    populate(serialWorld, 5000);
+    for (int frame = 0; frame < 20; ++frame) {
+      serial.update(serialWorld, 1.0f / 60.0f);
+    }
+
+    std::vector<float> a, b;
+    parallelWorld.each<Bounds>([&](Bounds& bounds) { a.push_back(bounds.world.minCorner.x); a.push_back(bounds.world.maxCorner.z); });
+    parallelWorld.each<Particle>([&](Particle& particle) { a.push_back(particle.position.y); });
+    serialWorld.each<Bounds>([&](Bounds& bounds) { b.push_back(bounds.world.minCorner.x); b.push_back(bounds.world.maxCorner.z); });
+    serialWorld.each<Particle>([&](Particle& particle) { b.push_back(particle.position.y); });
+    if (a != b) {
+      std::printf("  el resultado en paralelo no coincide con el de la ejecucion en serie\n");
+      ok = false;
+    }
+    return ok;
+  }
+
+  double frameMs(ThreadPool& pool, size_t count, int frames) {
+    SystemScheduler scheduler(pool);
+    registerSystems(scheduler);
+    World world;
+    populate(world, count);
+    scheduler.update(world, 1.0f / 60.0f);  // Calentamiento.
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+      scheduler.update(world, 1.0f / 60.0f);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / frames;
+  }
+}
+
+int main() {
+  std::printf("System scheduler benchmark\n\n");
+  std::printf("Pruebas:\n");
+  if (!threadPoolTest() || !schedulerTest()) {
+    return 1;
+  }
+  std::printf("  ThreadPool y SystemScheduler correctos\n");
+
+  const size_t count = 100000;
+  ThreadPool serialPool(0);
+  double serialMs = frameMs(serialPool, count, 20);
+  ThreadPool& pool = ThreadPool::get();
+  double parallelMs = frameMs(pool, count, 20);
+  std::printf("\nFrame con %zu entidades (animacion, transform, cajas y particulas):\n", count);
+  std::printf("  1 hilo      %7.3f ms\n", serialMs);
+  std::printf("  %2u hilos    %7.3f ms  (x%.2f)\n", pool.threadCount(), parallelMs, serialMs / parallelMs);
+  return 0;
+}
@@ -0,0 +1,261 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+/**
+ * Benchmark y prueba de TSharedPointer con varios hilos.
+ *
+ * Varios hilos copian y destruyen a la vez punteros al mismo objeto, todos sobre el mismo bloque de
+ * control, y se compara con std::shared_ptr haciendo lo mismo. Despues de cada ronda comprueba que el
+ * recuento vuelve a 1 y que, al soltar la ultima referencia, el objeto se destruye exactamente una
+ * vez. Tambien lanza hilos que llaman a lock() sobre un TWeakPointer mientras otro suelta la ultima
+ * referencia fuerte: ninguno debe obtener un objeto ya destruido. Por ultimo compara, en un solo
+ * hilo, TLocalSharedPointer (recuento no atomico) con TSharedPointer y std::shared_ptr.
+ *
+ * No forma parte del proyecto de Visual Studio; se compila aparte, por ejemplo en Linux:
+ *
+ *   g++ -std=c++17 -O2 -pthread -I IzzyEngine/Include IzzyEngine/Benchmarks/SharedPointerBenchmark.cpp -o sharedbench
+ *
+ * Termina con codigo 1 si alguna comprobacion falla.
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "Utilities/Memory/TSharedPointer.h"
+#include "Utilities/Memory/TWeakPointer.h"
+
+using EngineUtilities::MakeLocalShared;
+using EngineUtilities::MakeShared;
+using EngineUtilities::TLocalSharedPointer;
+using EngineUtilities::TSharedPointer;
+using EngineUtilities::TWeakPointer;
+
+namespace {
+
+  volatile size_t g_sink;            ///< Evita que el compilador descarte los bucles medidos.
+  std::atomic<int> g_alive{ 0 };     ///< Objetos Tracked construidos y no destruidos.
+  std::atomic<int> g_destroyed{ 0 }; ///< Destructores de Tracked ejecutados.
+
+  /**
+   * @brief Objeto compartido; el destructor borra value para detectar lecturas tras destruirlo.
+   */
+  struct Tracked {
+    int value;
+
+    explicit Tracked(int inValue) : value(inValue) { g_alive.fetch_add(1); }
+    ~Tracked() {
+      value = -1;
+      g_alive.fetch_sub(1);
+      g_destroyed.fetch_add(1);
+    }
+  };
+
+  // Operaciones uniformes sobre los tres tipos de puntero.
+  int useCount(const TSharedPointer<Tracked>& p) { return p.useCount(); }
+  int useCount(const TLocalSharedPointer<Tracked>& p) { return p.useCount(); }
+  int useCount(const std::shared_ptr<Tracked>& p) { return static_cast<int>(p.use_count()); }
+
+  template<typename Pointer> Pointer makePointer(int value);
+  template<> TSharedPointer<Tracked> makePointer(int value) { return MakeShared<Tracked>(value); }
+  template<> TLocalSharedPointer<Tracked> makePointer(int value) { return MakeLocalShared<Tracked>(value); }
+  template<> std::shared_ptr<Tracked> makePointer(int value) { return std::make_shared<Tracked>(value); }
+
+  /**
+   * @brief Copia el puntero iterations veces en un anillo de 8 copias locales.
+   *
+   * Cada iteracion suelta la copia que habia en la casilla y copia el puntero en ella: una
+   * destruccion y una copia. Vaciar la casilla antes hace falta porque std::shared_ptr no toca el
+   * recuento al asignar un puntero que ya comparte bloque de control. El anillo impide que el
+   * compilador empareje el incremento con el decremento y elimine los dos.
+   *
+   * @return Suma de los valores leidos (para comprobar que el objeto sigue vivo).
+   */
+  template<typename Pointer>
+  size_t copyLoop(const Pointer& shared, size_t iterations) {
+    Pointer ring[8];
+    size_t sum = 0;
+    for (size_t i = 0; i < iterations; ++i) {
+      Pointer& slot = ring[i & 7];
+      slot = Pointer();
+      slot = shared;
+      sum += static_cast<size_t>(slot->value);
+    }
+    return sum;
+  }
+
+  /**
+   * @brief threads hilos ejecutan copyLoop sobre el mismo puntero.
+   *
+   * @param ok Se pone a false si la suma, el recuento final o el numero de destrucciones no cuadran.
+   * @return Nanosegundos por copia y destruccion, de pared (todos los hilos a la vez).
+   */
+  template<typename Pointer>
+  double contention(size_t threads, size_t iterations, bool& ok) {
+    const int Value = 7;
+    int destroyedBefore = g_destroyed.load();
+    Pointer shared = makePointer<Pointer>(Value);
+    std::vector<size_t> sums(threads, 0);
+    std::atomic<size_t> ready{ 0 };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+      workers.emplace_back([&, t] {
+        // Todos los hilos empiezan a la vez para que compitan por el mismo contador.
+        ready.fetch_add(1);
+        while (ready.load() < threads) { std::this_thread::yield(); }
+        sums[t] = copyLoop(shared, iterations);
+      });
+    }
+    for (std::thread& worker : workers) {
+      worker.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    for (size_t sum : sums) {
+      ok = ok && sum == iterations * Value;
+    }
+    ok = ok && useCount(shared) == 1;
+    shared = Pointer();
+    ok = ok && g_alive.load() == 0 && g_destroyed.load() == destroyedBefore + 1;
+    return std::chrono::duration<double, std::nano>(end - start).count() /
+           static_cast<double>(iterations);
+  }
+
+  /**
+   * @brief Hilos que llaman a lock() mientras el hilo principal suelta la ultima referencia fuerte.
+   */
+  bool weakLockTest(size_t threads) {
+    for (int round = 0; round < 200; ++round) {
+      int destroyedBefore = g_destroyed.load();
+      TSharedPointer<Tracked> shared = MakeShared<Tracked>(round);
+      TWeakPointer<Tracked> weak(shared);
+      std::atomic<bool> wrong{ false };
+      std::atomic<size_t> ready{ 0 };
+
+      std::vector<std::thread> workers;
+      for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+          ready.fetch_add(1);
+          while (true) {
+            TSharedPointer<Tracked> locked = weak.lock();
+            if (!locked) {
+              break;
+            }
+            if (locked->value != round) {
+              wrong = true;
+            }
+          }
+        });
+      }
+      while (ready.load() < threads) { std::this_thread::yield(); }
+      shared = TSharedPointer<Tracked>();
+      for (std::thread& worker : workers) {
+        worker.join();
+      }
+
+      if (wrong || !weak.expired() || g_alive.load() != 0 || g_destroyed.load() != destroyedBefore + 1) {
+        std::printf("  lock() durante la destruccion en la ronda %d: objeto destruido leido o destruido dos veces\n", round);
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Mide copyLoop en un solo hilo; comprueba tambien el recuento final.
+   */
+  template<typename Pointer>
+  double singleThread(size_t iterations, int repetitions, bool& ok) {
+    Pointer shared = makePointer<Pointer>(3);
+    copyLoop(shared, iterations);  // Calentamiento.
+    auto start = std::chrono::steady_clock::now();
+    size_t sum = 0;
+    for (int r = 0; r < repetitions; ++r) {
+      sum += copyLoop(shared, iterations);
+    }
+    auto end = std::chrono::steady_clock::now();
+    g_sink = sum;
+    ok = ok && sum == iterations * repetitions * 3 && useCount(shared) == 1;
+    shared = Pointer();
+    ok = ok && g_alive.load() == 0;
+    return std::chrono::duration<double, std::nano>(end - start).count() /
+           (static_cast<double>(iterations) * repetitions);
+  }
+}
+
+int main() {
+  size_t hardwareThreads = std::max<size_t>(2, std::thread::hardware_concurrency());
+  std::vector<size_t> threadCounts = { 1, 2, 4, 8 };
+  threadCounts.erase(std::remove_if(threadCounts.begin(), threadCounts.end(),
+                                    [&](size_t n) { return n > hardwareThreads; }),
+                     threadCounts.end());
+
+  std::printf("TSharedPointer benchmark\n\n");
+  std::printf("Pruebas:\n");
+  bool ok = true;
+  for (size_t threads : threadCounts) {
+    contention<TSharedPointer<Tracked>>(threads, 100000, ok);
+  }
+  if (!ok) {
+    std::printf("  copias concurrentes de TSharedPointer: el recuento o las destrucciones no cuadran\n");
+    return 1;
+  }
+  std::printf("  copias concurrentes: el recuento vuelve a 1 y el objeto se destruye una vez\n");
+  if (!weakLockTest(threadCounts.back())) {
+    return 1;
+  }
+  std::printf("  lock() concurrente con la destruccion nunca devuelve un objeto destruido\n");
+
+  const size_t Iterations = 1000000;
+  std::printf("\nCopiar y destruir el mismo puntero desde varios hilos (ns de pared por iteracion de cada hilo):\n");
+  for (size_t threads : threadCounts) {
+    double engine = contention<TSharedPointer<Tracked>>(threads, Iterations, ok);
+    double standard = contention<std::shared_ptr<Tracked>>(threads, Iterations, ok);
+    std::printf("  %zu hilos   TSharedPointer %7.2f ns  std::shared_ptr %7.2f ns  (x%.2f)\n",
+                threads, engine, standard, standard / engine);
+  }
+
+  std::printf("\nUn solo hilo:\n");
+  double local = singleThread<TLocalSharedPointer<Tracked>>(Iterations, 5, ok);
+  double atomic = singleThread<TSharedPointer<Tracked>>(Iterations, 5, ok);
+  double standard = singleThread<std::shared_ptr<Tracked>>(Iterations, 5, ok);
+  std::printf("  TLocalSharedPointer %7.2f ns  TSharedPointer %7.2f ns  std::shared_ptr %7.2f ns\n",
+              local, atomic, standard);
+
+  if (!ok) {
+    std::printf("  el recuento o las destrucciones no cuadran durante las mediciones\n");
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,278 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+/**
+ * Benchmark y prueba de TArray frente a std::vector.
+ *
+ * Primero repite la misma secuencia aleatoria de Add, Emplace, Insert, RemoveAt, RemoveAtSwap y
+ * Reserve sobre un TArray y un std::vector, con un tipo trivial (int) y con uno pesado (cadena y
+ * vector en el heap, con contador de objetos vivos), y comprueba tras cada bloque que los dos
+ * contienen lo mismo y que no se pierde ni se duplica ningun destructor. Despues mide cada
+ * operacion por separado: anadir al final (con y sin Reserve, es decir, incluyendo el crecimiento),
+ * construir en sitio, insertar y quitar en medio.
+ *
+ * No forma parte del proyecto de Visual Studio; se compila aparte, por ejemplo en Linux:
+ *
+ *   g++ -std=c++17 -O2 -I IzzyEngine/Include IzzyEngine/Benchmarks/TArrayBenchmark.cpp -o tarraybench
+ *
+ * Termina con codigo 1 si alguna comprobacion falla.
+ */
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Utilities/Structures/TArray.h"
+
+using EngineUtilities::TArray;
+
+namespace {
+
+  volatile size_t g_sink;   ///< Evita que el compilador descarte los bucles medidos.
+  int g_liveHeavy = 0;      ///< Objetos Heavy construidos y no destruidos.
+
+  /**
+   * @brief Elemento caro de copiar: dos reservas en el heap por copia.
+   */
+  struct Heavy {
+    std::string name;
+    std::vector<int> data;
+
+    Heavy() { ++g_liveHeavy; }
+    explicit Heavy(int value)
+      : name("elemento pesado numero " + std::to_string(value)), data(8, value) { ++g_liveHeavy; }
+    Heavy(const Heavy& other) : name(other.name), data(other.data) { ++g_liveHeavy; }
+    Heavy(Heavy&& other) noexcept : name(std::move(other.name)), data(std::move(other.data)) { ++g_liveHeavy; }
+    Heavy& operator=(const Heavy&) = default;
+    Heavy& operator=(Heavy&&) noexcept = default;
+    ~Heavy() { --g_liveHeavy; }
+
+    bool operator==(const Heavy& other) const { return name == other.name && data == other.data; }
+  };
+
+  template<typename T> T makeValue(int value);
+  template<> int makeValue<int>(int value) { return value; }
+  template<> Heavy makeValue<Heavy>(int value) { return Heavy(value); }
+
+  template<typename T>
+  bool sameContents(const TArray<T>& engine, const std::vector<T>& reference) {
+    if (engine.Num() != reference.size()) {
+      return false;
+    }
+    for (size_t i = 0; i < reference.size(); ++i) {
+      if (!(engine[i] == reference[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Operaciones aleatorias sobre TArray y std::vector, comparadas cada pocos pasos.
+   */
+  template<typename T>
+  bool differentialTest(const char* name) {
+    std::mt19937 rng(5);
+    bool ok = true;
+    {
+      TArray<T> engine;
+      std::vector<T> reference;
+      for (int step = 0; step < 20000 && ok; ++step) {
+        size_t size = reference.size();
+        size_t index = size ? rng() % size : 0;
+        switch (rng() % 8) {
+        case 0:
+        case 1:
+          engine.Add(makeValue<T>(step));
+          reference.push_back(makeValue<T>(step));
+          break;
+        case 2:
+          // Emplace a partir de un elemento del propio array: debe sobrevivir al crecimiento.
+          if (size) {
+            engine.Emplace(engine[index]);
+            reference.push_back(reference[index]);
+          }
+          break;
+        case 3: {
+          size_t position = rng() % (size + 1);
+          engine.Insert(position, makeValue<T>(step));
+          reference.insert(reference.begin() + position, makeValue<T>(step));
+          break;
+        }
+        case 4:
+        case 5:
+          if (size) {
+            engine.RemoveAt(index);
+            reference.erase(reference.begin() + index);
+          }
+          break;
+        case 6:
+          if (size) {
+            engine.RemoveAtSwap(index);
+            reference[index] = std::move(reference.back());
+            reference.pop_back();
+          }
+          break;
+        default:
+          engine.Reserve(size + rng() % 64);
+          break;
+        }
+        if (step % 101 == 0 && !sameContents(engine, reference)) {
+          std::printf("  %s: el contenido difiere de std::vector en el paso %d\n", name, step);
+          ok = false;
+        }
+      }
+      ok = ok && sameContents(engine, reference);
+
+      TArray<T> copy(engine);
+      TArray<T> moved(std::move(copy));
+      engine.ShrinkToFit();
+      if (ok && (!sameContents(moved, reference) || !sameContents(engine, reference) ||
+                 engine.GetCapacity() != engine.Num())) {
+        std::printf("  %s: copia, movimiento o ShrinkToFit no conservan el contenido\n", name);
+        ok = false;
+      }
+      engine.Empty();
+      ok = ok && engine.Num() == 0;
+    }
+    if (g_liveHeavy != 0 && ok) {
+      std::printf("  %s: quedan %d objetos sin destruir\n", name, g_liveHeavy);
+      ok = false;
+    }
+    return ok;
+  }
+
+  template<typename Func>
+  double nsPerOp(size_t opsPerCall, int repetitions, Func func) {
+    func();  // Calentamiento.
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+      func();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() /
+           (static_cast<double>(opsPerCall) * repetitions);
+  }
+
+  void printRow(const char* operation, double engineNs, double vectorNs) {
+    std::printf("  %-24s TArray %8.2f ns  std::vector %8.2f ns  (x%.2f)\n",
+                operation, engineNs, vectorNs, vectorNs / engineNs);
+  }
+
+  /**
+   * @brief Mide cada operacion con count elementos (insertar y quitar en medio con middleCount).
+   */
+  template<typename T>
+  void measure(const char* name, size_t count, size_t middleCount, int repetitions) {
+    std::vector<T> values;
+    for (size_t i = 0; i < count; ++i) {
+      values.push_back(makeValue<T>(static_cast<int>(i)));
+    }
+    std::printf("\n%s, %zu elementos:\n", name, count);
+
+    printRow("Add (con crecimiento)",
+      nsPerOp(count, repetitions, [&] {
+        TArray<T> array;
+        for (size_t i = 0; i < count; ++i) array.Add(values[i]);
+        g_sink = array.Num();
+      }),
+      nsPerOp(count, repetitions, [&] {
+        std::vector<T> vector;
+        for (size_t i = 0; i < count; ++i) vector.push_back(values[i]);
+        g_sink = vector.size();
+      }));
+
+    printRow("Add tras Reserve",
+      nsPerOp(count, repetitions, [&] {
+        TArray<T> array;
+        array.Reserve(count);
+        for (size_t i = 0; i < count; ++i) array.Add(values[i]);
+        g_sink = array.Num();
+      }),
+      nsPerOp(count, repetitions, [&] {
+        std::vector<T> vector;
+        vector.reserve(count);
+        for (size_t i = 0; i < count; ++i) vector.push_back(values[i]);
+        g_sink = vector.size();
+      }));
+
+    printRow("Emplace",
+      nsPerOp(count, repetitions, [&] {
+        TArray<T> array;
+        for (size_t i = 0; i < count; ++i) array.Emplace(makeValue<T>(static_cast<int>(i)));
+        g_sink = array.Num();
+      }),
+      nsPerOp(count, repetitions, [&] {
+        std::vector<T> vector;
+        for (size_t i = 0; i < count; ++i) vector.emplace_back(makeValue<T>(static_cast<int>(i)));
+        g_sink = vector.size();
+      }));
+
+    printRow("Insert en medio",
+      nsPerOp(middleCount, repetitions, [&] {
+        TArray<T> array;
+        for (size_t i = 0; i < middleCount; ++i) array.Insert(array.Num() / 2, values[i]);
+        g_sink = array.Num();
+      }),
+      nsPerOp(middleCount, repetitions, [&] {
+        std::vector<T> vector;
+        for (size_t i = 0; i < middleCount; ++i) vector.insert(vector.begin() + vector.size() / 2, values[i]);
+        g_sink = vector.size();
+      }));
+
+    // Incluye rellenar el array antes de vaciarlo, igual en los dos.
+    printRow("RemoveAt en medio",
+      nsPerOp(middleCount, repetitions, [&] {
+        TArray<T> array;
+        for (size_t i = 0; i < middleCount; ++i) array.Add(values[i]);
+        while (array.Num()) array.RemoveAt(array.Num() / 2);
+        g_sink = array.Num();
+      }),
+      nsPerOp(middleCount, repetitions, [&] {
+        std::vector<T> vector;
+        for (size_t i = 0; i < middleCount; ++i) vector.push_back(values[i]);
+        while (!vector.empty()) vector.erase(vector.begin() + vector.size() / 2);
+        g_sink = vector.size();
+      }));
+  }
+}
+
+int main() {
+  std::printf("TArray benchmark\n\n");
+  std::printf("Pruebas:\n");
+  if (!differentialTest<int>("int") || !differentialTest<Heavy>("Heavy")) {
+    return 1;
+  }
+  std::printf("  TArray coincide con std::vector (int y Heavy) y los destructores cuadran\n");
+
+  measure<int>("int", 1000000, 20000, 10);
+  measure<Heavy>("Heavy (string + vector)", 100000, 5000, 5);
+  return 0;
+}
@@ -0,0 +1,288 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+/**
+ * Benchmark y prueba de TMap frente a std::unordered_map.
+ *
+ * Comprueba que Add y Emplace aceptan una clave o un valor que apuntan al propio mapa aunque la
+ * insercion lo haga crecer (el par se construye antes de redistribuir las ranuras). Despues inserta,
+ * busca y elimina un millon de claves aleatorias en un TMap y en un std::unordered_map y comprueba
+ * que los dos dan las mismas respuestas y terminan con el mismo contenido. Por ultimo mide insertar
+ * (con y sin Reserve), buscar claves que estan y claves que no estan, y eliminar.
+ *
+ * No forma parte del proyecto de Visual Studio; se compila aparte, por ejemplo en Linux:
+ *
+ *   g++ -std=c++17 -O2 -I IzzyEngine/Include IzzyEngine/Benchmarks/TMapBenchmark.cpp -o tmapbench
+ *
+ * Termina con codigo 1 si alguna comprobacion falla.
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Utilities/Structures/TMap.h"
+
+using EngineUtilities::TMap;
+
+namespace {
+
+  volatile size_t g_sink;  ///< Evita que el compilador descarte los bucles medidos.
+
+  // Cadenas largas: viven en el heap, asi que leerlas tras liberarlas no da el valor esperado.
+  std::string longValue(size_t i) {
+    return "valor que no cabe en el buffer corto de std::string " + std::to_string(i);
+  }
+
+  /**
+   * @brief Inserta copiando una clave y un valor del propio mapa, en todos los tamanos que cruzan un crecimiento.
+   */
+  bool aliasingTest() {
+    for (size_t count = 1; count < 300; ++count) {
+      TMap<std::string, std::string> map;
+      for (size_t i = 0; i < count; ++i) {
+        map.Add("clave " + std::to_string(i), longValue(i));
+      }
+      std::string expected = *map.Find("clave 0");
+
+      // Add(const K&, const V&) con el valor dentro del mapa.
+      TMap<std::string, std::string> added(map);
+      added.Add("nueva", *added.Find("clave 0"));
+
+      // Emplace con la clave y el valor sacados del propio mapa (el valor de un par sirve de clave nueva).
+      TMap<std::string, std::string> emplaced(map);
+      const std::string& aliasKey = *emplaced.Find("clave 0");
+      emplaced.Emplace(aliasKey, *emplaced.Find("clave 0"));
+
+      // Add(K&&, V&&) moviendo desde una copia (no debe tocar el mapa).
+      TMap<std::string, std::string> moved(map);
+      std::string key = "nueva", value = *moved.Find("clave 0");
+      moved.Add(std::move(key), std::move(value));
+
+      const std::string* a = added.Find("nueva");
+      const std::string* e = emplaced.Find(expected);
+      const std::string* m = moved.Find("nueva");
+      if (!a || *a != expected || !e || *e != expected || !m || *m != expected ||
+          added.Num() != count + 1 || emplaced.Num() != count + 1 || moved.Num() != count + 1) {
+        std::printf("  insertar un elemento del propio mapa con %zu pares da un resultado incorrecto\n", count);
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Genera count claves aleatorias distintas y otras tantas que no estan entre ellas.
+   */
+  void makeKeys(size_t count, std::vector<uint64_t>& present, std::vector<uint64_t>& absent) {
+    std::mt19937_64 rng(12345);
+    std::unordered_map<uint64_t, bool> used;
+    used.reserve(count * 2);
+    present.clear();
+    absent.clear();
+    while (present.size() < count || absent.size() < count) {
+      uint64_t key = rng();
+      if (!used.emplace(key, true).second) {
+        continue;
+      }
+      (present.size() < count ? present : absent).push_back(key);
+    }
+  }
+
+  /**
+   * @brief Repite las mismas inserciones, busquedas y eliminaciones en TMap y std::unordered_map.
+   */
+  bool differentialTest(const std::vector<uint64_t>& present, const std::vector<uint64_t>& absent) {
+    TMap<uint64_t, uint64_t> map;
+    std::unordered_map<uint64_t, uint64_t> reference;
+    for (size_t i = 0; i < present.size(); ++i) {
+      map.Add(present[i], i);
+      reference.emplace(present[i], i);
+    }
+    // Reinsertar una de cada cuatro claves actualiza el valor.
+    for (size_t i = 0; i < present.size(); i += 4) {
+      map.Add(present[i], i + 1);
+      reference[present[i]] = i + 1;
+    }
+    if (map.Num() != reference.size()) {
+      std::printf("  TMap tiene %zu pares y std::unordered_map %zu\n", map.Num(), reference.size());
+      return false;
+    }
+    for (size_t i = 0; i < present.size(); ++i) {
+      const uint64_t* value = map.Find(present[i]);
+      if (!value || *value != reference[present[i]] || map.Find(absent[i])) {
+        std::printf("  Find no coincide con std::unordered_map en la clave %zu\n", i);
+        return false;
+      }
+    }
+    // Eliminar la mitad, junto con claves que no estan.
+    for (size_t i = 0; i < present.size(); i += 2) {
+      if (map.Remove(present[i]) != (reference.erase(present[i]) == 1) || map.Remove(absent[i])) {
+        std::printf("  Remove no coincide con std::unordered_map en la clave %zu\n", i);
+        return false;
+      }
+    }
+    size_t visited = 0;
+    for (auto it = map.begin(); it != map.end(); ++it, ++visited) {
+      auto found = reference.find(it->Key);
+      if (found == reference.end() || found->second != it->Value) {
+        std::printf("  tras eliminar, el recorrido del TMap no coincide con std::unordered_map\n");
+        return false;
+      }
+    }
+    for (size_t i = 0; i < present.size(); ++i) {
+      if (map.Contains(present[i]) != (reference.count(present[i]) == 1)) {
+        std::printf("  tras eliminar, Contains no coincide con std::unordered_map en la clave %zu\n", i);
+        return false;
+      }
+    }
+    if (visited != reference.size() || map.Num() != reference.size()) {
+      std::printf("  tras eliminar, TMap tiene %zu pares y std::unordered_map %zu\n", map.Num(), reference.size());
+      return false;
+    }
+    return true;
+  }
+
+  template<typename Func>
+  double nsPerOp(size_t opsPerCall, int repetitions, Func func) {
+    func();  // Calentamiento.
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+      func();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() /
+           (static_cast<double>(opsPerCall) * repetitions);
+  }
+
+  void printRow(const char* operation, double engineNs, double referenceNs) {
+    std::printf("  %-24s TMap %8.2f ns  std::unordered_map %8.2f ns  (x%.2f)\n",
+                operation, engineNs, referenceNs, referenceNs / engineNs);
+  }
+
+  /**
+   * @brief Mide cada operacion con present.size() claves.
+   */
+  void measure(const std::vector<uint64_t>& present, const std::vector<uint64_t>& absent, int repetitions) {
+    size_t count = present.size();
+    std::printf("\nuint64_t -> uint64_t, %zu claves aleatorias:\n", count);
+
+    printRow("Add (con crecimiento)",
+      nsPerOp(count, repetitions, [&] {
+        TMap<uint64_t, uint64_t> map;
+        for (size_t i = 0; i < count; ++i) map.Add(present[i], i);
+        g_sink = map.Num();
+      }),
+      nsPerOp(count, repetitions, [&] {
+        std::unordered_map<uint64_t, uint64_t> map;
+        for (size_t i = 0; i < count; ++i) map.emplace(present[i], i);
+        g_sink = map.size();
+      }));
+
+    printRow("Add tras Reserve",
+      nsPerOp(count, repetitions, [&] {
+        TMap<uint64_t, uint64_t> map;
+        map.Reserve(count);
+        for (size_t i = 0; i < count; ++i) map.Add(present[i], i);
+        g_sink = map.Num();
+      }),
+      nsPerOp(count, repetitions, [&] {
+        std::unordered_map<uint64_t, uint64_t> map;
+        map.reserve(count);
+        for (size_t i = 0; i < count; ++i) map.emplace(present[i], i);
+        g_sink = map.size();
+      }));
+
+    TMap<uint64_t, uint64_t> map;
+    std::unordered_map<uint64_t, uint64_t> reference;
+    for (size_t i = 0; i < count; ++i) {
+      map.Add(present[i], i);
+      reference.emplace(present[i], i);
+    }
+
+    printRow("Find (clave presente)",
+      nsPerOp(count, repetitions, [&] {
+        size_t sum = 0;
+        for (size_t i = 0; i < count; ++i) sum += *map.Find(present[i]);
+        g_sink = sum;
+      }),
+      nsPerOp(count, repetitions, [&] {
+        size_t sum = 0;
+        for (size_t i = 0; i < count; ++i) sum += reference.find(present[i])->second;
+        g_sink = sum;
+      }));
+
+    printRow("Find (clave ausente)",
+      nsPerOp(count, repetitions, [&] {
+        size_t found = 0;
+        for (size_t i = 0; i < count; ++i) found += map.Find(absent[i]) != nullptr;
+        g_sink = found;
+      }),
+      nsPerOp(count, repetitions, [&] {
+        size_t found = 0;
+        for (size_t i = 0; i < count; ++i) found += reference.find(absent[i]) != reference.end();
+        g_sink = found;
+      }));
+
+    // Cada repeticion trabaja sobre una copia; la copia se mide en los dos por igual.
+    printRow("Remove (con copia)",
+      nsPerOp(count, repetitions, [&] {
+        TMap<uint64_t, uint64_t> copy(map);
+        for (size_t i = 0; i < count; ++i) copy.Remove(present[i]);
+        g_sink = copy.Num();
+      }),
+      nsPerOp(count, repetitions, [&] {
+        std::unordered_map<uint64_t, uint64_t> copy(reference);
+        for (size_t i = 0; i < count; ++i) copy.erase(present[i]);
+        g_sink = copy.size();
+      }));
+  }
+}
+
+int main() {
+  std::printf("TMap benchmark\n\n");
+  std::printf("Pruebas:\n");
+  if (!aliasingTest()) {
+    return 1;
+  }
+  std::printf("  Add y Emplace con referencias al propio mapa correctos\n");
+
+  std::vector<uint64_t> present, absent;
+  makeKeys(1000000, present, absent);
+  if (!differentialTest(present, absent)) {
+    return 1;
+  }
+  std::printf("  TMap coincide con std::unordered_map en 1000000 claves aleatorias\n");
+
+  measure(present, absent, 5);
+  return 0;
+}
@@ -0,0 +1,181 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+/**
+ * Benchmark de la transformacion de vertices por lotes: vertices con la disposicion de
+ * SimpleVertex (posicion y coordenadas de textura intercaladas) transformados por una matriz,
+ * calculando la caja envolvente del resultado. Mide una malla de 16K vertices (en cache) y
+ * otra de 1M (limitada por el ancho de banda de memoria).
+ *
+ * Compara el bucle vertice a vertice (transformPoint + AABB::expand) con transformPositions
+ * en un hilo y con transformPositionsParallel en el pool de hilos del motor.
+ *
+ * No forma parte del proyecto de Visual Studio; se compila aparte, por ejemplo en Linux:
+ *
+ *   g++ -std=c++17 -O2 -pthread -I IzzyEngine/Include IzzyEngine/Benchmarks/VertexTransformBenchmark.cpp -o vertexbench
+ *   g++ -std=c++17 -O2 -pthread -mavx2 -mfma -I IzzyEngine/Include IzzyEngine/Benchmarks/VertexTransformBenchmark.cpp -o vertexbench
+ *
+ * Antes de medir comprueba que las tres versiones dan las mismas posiciones (salvo redondeo)
+ * y la misma caja; si no, termina con codigo 1.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Utilities/Bounds/VertexTransform.h"
+#include "Utilities/Vectors/Quaternion.h"
+
+using EngineUtilities::AABB;
+using EngineUtilities::Matrix4x4;
+using EngineUtilities::Quaternion;
+using EngineUtilities::Vector3;
+
+namespace {
+
+  volatile float g_sink;  ///< Evita que el compilador descarte los bucles medidos.
+
+  /**
+   * @brief Misma disposicion que SimpleVertex (XMFLOAT3 + XMFLOAT2), sin depender de DirectX.
+   */
+  struct Vertex {
+    float pos[3];
+    float tex[2];
+  };
+
+  template<typename Func>
+  double nsPerOp(size_t opsPerCall, int repetitions, Func func) {
+    func();  // Calentamiento.
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+      func();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() /
+           (static_cast<double>(opsPerCall) * repetitions);
+  }
+
+  /**
+   * @brief El bucle que escribiria el usuario: un vertice a la vez.
+   */
+  AABB scalarTransform(const Matrix4x4& matrix, const std::vector<Vertex>& vertices, std::vector<Vector3>& out) {
+    AABB bounds;
+    for (size_t i = 0; i < vertices.size(); ++i) {
+      const Vertex& v = vertices[i];
+      out[i] = matrix.transformPoint(Vector3(v.pos[0], v.pos[1], v.pos[2]));
+      bounds.expand(out[i]);
+    }
+    return bounds;
+  }
+
+  /**
+   * @brief Mayor diferencia entre dos conjuntos de posiciones, relativa a la escala de la escena.
+   */
+  float maxDifference(const std::vector<Vector3>& a, const std::vector<Vector3>& b, float scale) {
+    float result = 0.0f;
+    for (size_t i = 0; i < a.size(); ++i) {
+      result = std::max({ result, std::fabs(a[i].x - b[i].x), std::fabs(a[i].y - b[i].y), std::fabs(a[i].z - b[i].z) });
+    }
+    return result / scale;
+  }
+
+  float maxDifference(const AABB& a, const AABB& b, float scale) {
+    return std::max({ std::fabs(a.minCorner.x - b.minCorner.x), std::fabs(a.minCorner.y - b.minCorner.y),
+                      std::fabs(a.minCorner.z - b.minCorner.z), std::fabs(a.maxCorner.x - b.maxCorner.x),
+                      std::fabs(a.maxCorner.y - b.maxCorner.y), std::fabs(a.maxCorner.z - b.maxCorner.z) }) / scale;
+  }
+}
+
+int main() {
+  std::mt19937 rng(19);
+  unsigned threads = EngineUtilities::ThreadPool::get().threadCount();
+
+  std::printf("Vertex transform benchmark (SSE2 %d, AVX2 %d, FMA %d), %u hilos\n",
+              ENGINE_MATH_SSE2, ENGINE_MATH_AVX2, ENGINE_MATH_FMA, threads);
+
+  Matrix4x4 matrix = EngineUtilities::composeTRS(Vector3(10.0f, -3.0f, 7.0f),
+                                                 Quaternion::fromEuler(Vector3(0.3f, 1.1f, -0.4f)),
+                                                 Vector3(2.0f, 0.5f, 1.5f));
+
+  // Una malla que cabe en cache (mide el calculo) y otra de 1M de vertices (mide la memoria).
+  for (size_t vertexCount : { size_t(16384), size_t(1000000) }) {
+    int repetitions = static_cast<int>(20000000 / vertexCount);
+    std::uniform_real_distribution<float> coordinate(-50.0f, 50.0f);
+    std::vector<Vertex> vertices(vertexCount);
+    for (Vertex& v : vertices) {
+      v = { { coordinate(rng), coordinate(rng), coordinate(rng) }, { 0.5f, 0.5f } };
+    }
+    const float* positions = vertices[0].pos;
+
+    std::vector<Vector3> scalarOut(vertexCount), batchOut(vertexCount), parallelOut(vertexCount);
+    AABB scalarBounds = scalarTransform(matrix, vertices, scalarOut);
+    AABB batchBounds = EngineUtilities::transformPositions(matrix, positions, sizeof(Vertex), vertexCount, batchOut.data());
+    AABB parallelBounds = EngineUtilities::transformPositionsParallel(matrix, positions, sizeof(Vertex), vertexCount,
+                                                                      parallelOut.data());
+    AABB boundsOnly = EngineUtilities::transformPositionsParallel(matrix, positions, sizeof(Vertex), vertexCount);
+
+    // Las posiciones llegan a ~200; 1e-6 de esa escala son pocos ULP.
+    const float scale = 200.0f;
+    float worst = std::max({ maxDifference(scalarOut, batchOut, scale), maxDifference(scalarOut, parallelOut, scale),
+                             maxDifference(scalarBounds, batchBounds, scale),
+                             maxDifference(scalarBounds, parallelBounds, scale),
+                             maxDifference(parallelBounds, boundsOnly, scale) });
+    std::printf("\n%zu vertices. Caja: (%.3f, %.3f, %.3f) - (%.3f, %.3f, %.3f), diferencia maxima relativa %.2e\n",
+                vertexCount, scalarBounds.minCorner.x, scalarBounds.minCorner.y, scalarBounds.minCorner.z,
+                scalarBounds.maxCorner.x, scalarBounds.maxCorner.y, scalarBounds.maxCorner.z, worst);
+    if (!(worst < 1e-6f)) {
+      std::printf("Las versiones no coinciden\n");
+      return 1;
+    }
+
+    double scalarNs = nsPerOp(vertexCount, repetitions, [&] {
+      g_sink = scalarTransform(matrix, vertices, scalarOut).maxCorner.x;
+    });
+    double batchNs = nsPerOp(vertexCount, repetitions, [&] {
+      g_sink = EngineUtilities::transformPositions(matrix, positions, sizeof(Vertex), vertexCount,
+                                                   batchOut.data()).maxCorner.x;
+    });
+    double parallelNs = nsPerOp(vertexCount, repetitions, [&] {
+      g_sink = EngineUtilities::transformPositionsParallel(matrix, positions, sizeof(Vertex), vertexCount,
+                                                           parallelOut.data()).maxCorner.x;
+    });
+    double boundsNs = nsPerOp(vertexCount, repetitions, [&] {
+      g_sink = EngineUtilities::transformPositionsParallel(matrix, positions, sizeof(Vertex), vertexCount).maxCorner.x;
+    });
+
+    std::printf("Rendimiento por vertice:\n");
+    std::printf("  %-34s %7.3f ns\n", "vertice a vertice", scalarNs);
+    std::printf("  %-34s %7.3f ns  (x%.2f)\n", "transformPositions", batchNs, scalarNs / batchNs);
+    std::printf("  %-34s %7.3f ns  (x%.2f)\n", "transformPositionsParallel", parallelNs, scalarNs / parallelNs);
+    std::printf("  %-34s %7.3f ns  (x%.2f)\n", "transformPositionsParallel (caja)", boundsNs, scalarNs / boundsNs);
+  }
+  return 0;
+}
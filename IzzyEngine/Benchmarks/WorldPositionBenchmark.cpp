@@ -0,0 +1,152 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+/**
+ * Benchmark de las posiciones de mundo en double con render relativo a la camara.
+ *
+ * Primero mide la precision: un vertice de un objeto colocado a distintas distancias del
+ * origen, transformado con la matriz de mundo absoluta en float (y luego restando la camara,
+ * como hace la vista) frente a la ruta relativa (Vector3d::relativeTo en double y matriz con
+ * traslacion pequena). Despues mide rebasePositions frente al bucle escalar con 10K y 1M actores.
+ *
+ * No forma parte del proyecto de Visual Studio; se compila aparte, por ejemplo en Linux:
+ *
+ *   g++ -std=c++17 -O2 -I IzzyEngine/Include IzzyEngine/Benchmarks/WorldPositionBenchmark.cpp -o worldbench
+ *   g++ -std=c++17 -O2 -mavx2 -mfma -I IzzyEngine/Include IzzyEngine/Benchmarks/WorldPositionBenchmark.cpp -o worldbench
+ *
+ * Termina con codigo 1 si el kernel no da exactamente el mismo resultado que el bucle escalar.
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Utilities/Vectors/Vector3d.h"
+#include "Utilities/Vectors/Quaternion.h"
+
+using EngineUtilities::Matrix4x4;
+using EngineUtilities::Quaternion;
+using EngineUtilities::Vector3;
+using EngineUtilities::Vector3d;
+
+namespace {
+
+  volatile float g_sink;  ///< Evita que el compilador descarte los bucles medidos.
+
+  template<typename Func>
+  double nsPerOp(size_t opsPerCall, int repetitions, Func func) {
+    func();  // Calentamiento.
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+      func();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() /
+           (static_cast<double>(opsPerCall) * repetitions);
+  }
+
+  /**
+   * @brief Error (en metros) de un vertice relativo a la camara con las dos rutas.
+   */
+  void precisionAt(double distance) {
+    Quaternion rotation = Quaternion::fromEuler(Vector3(0.2f, 0.7f, 0.1f));
+    Vector3 scale(1.0f, 1.0f, 1.0f);
+    Vector3 vertex(0.123f, 0.456f, 0.789f);
+    Vector3d object(distance, 0.25 * distance, -0.5 * distance);
+    Vector3d camera = object + Vector3d(3.0, 1.5, -4.0);
+
+    // Referencia en double: vertice rotado mas la posicion del objeto, menos la camara.
+    Vector3 rotated = rotation.rotate(vertex);
+    Vector3d expected = Vector3d(rotated) + (object - camera);
+
+    // Ruta absoluta: matriz de mundo en float con la posicion completa, despues se resta la camara en float.
+    Matrix4x4 absolute = EngineUtilities::composeTRS(object.toVector3(), rotation, scale);
+    Vector3 absoluteResult = absolute.transformPoint(vertex) - camera.toVector3();
+
+    // Ruta relativa: la resta se hace en double y la matriz solo lleva la traslacion pequena.
+    Matrix4x4 relative = EngineUtilities::composeTRS(object.relativeTo(camera), rotation, scale);
+    Vector3 relativeResult = relative.transformPoint(vertex);
+
+    double absoluteError = (Vector3d(absoluteResult) - expected).magnitude();
+    double relativeError = (Vector3d(relativeResult) - expected).magnitude();
+    std::printf("  %12.0f m   absoluta %12.6f m   relativa %12.9f m\n", distance, absoluteError, relativeError);
+  }
+}
+
+int main() {
+  std::printf("World position benchmark (SSE2 %d, AVX2 %d, FMA %d)\n\n",
+              ENGINE_MATH_SSE2, ENGINE_MATH_AVX2, ENGINE_MATH_FMA);
+
+  std::printf("Error de un vertice a 5 m de la camara segun la distancia al origen:\n");
+  for (double distance : { 10.0, 1.0e3, 1.0e4, 1.0e5, 1.0e6 }) {
+    precisionAt(distance);
+  }
+
+  std::mt19937_64 rng(20);
+  std::uniform_real_distribution<double> coordinate(-5.0e4, 5.0e4);
+  Vector3d camera(12345.678, 210.5, -20000.25);
+  std::printf("\nRendimiento por actor:\n");
+  for (size_t count : { size_t(10000), size_t(1000000) }) {
+    int repetitions = static_cast<int>(50000000 / count);
+    std::vector<Vector3d> positions(count);
+    for (Vector3d& p : positions) {
+      p = Vector3d(coordinate(rng), coordinate(rng), coordinate(rng));
+    }
+    std::vector<Vector3> scalarOut(count), simdOut(count);
+
+    for (size_t i = 0; i < count; ++i) {
+      scalarOut[i] = positions[i].relativeTo(camera);
+    }
+    EngineUtilities::rebasePositions(positions.data(), camera, simdOut.data(), count);
+    size_t mismatches = 0;
+    for (size_t i = 0; i < count; ++i) {
+      mismatches += (scalarOut[i].x != simdOut[i].x || scalarOut[i].y != simdOut[i].y ||
+                     scalarOut[i].z != simdOut[i].z) ? 1 : 0;
+    }
+    if (mismatches != 0) {
+      std::printf("rebasePositions difiere del bucle escalar en %zu posiciones\n", mismatches);
+      return 1;
+    }
+
+    double scalarNs = nsPerOp(count, repetitions, [&] {
+      for (size_t i = 0; i < count; ++i) {
+        scalarOut[i] = positions[i].relativeTo(camera);
+      }
+      g_sink = scalarOut.back().x;
+    });
+    double simdNs = nsPerOp(count, repetitions, [&] {
+      EngineUtilities::rebasePositions(positions.data(), camera, simdOut.data(), count);
+      g_sink = simdOut.back().x;
+    });
+    std::printf("  %8zu actores   rebasePositions %6.3f ns   escalar %6.3f ns  (x%.2f)\n",
+                count, simdNs, scalarNs, scalarNs / simdNs);
+  }
+  return 0;
+}
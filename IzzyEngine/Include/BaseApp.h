@@ -15,6 +15,9 @@
 #include "userInterface.h"
 #include "ModelLoader.h"
 #include "ECS/Actor.h"
+#include "ECS/System.h"
+#include "ECS/TransformSystem.h"
+#include "ECS/BoundsSystem.h"
 
 /*
  * @brief BaseApp.
@@ -129,7 +132,11 @@ public:
 
   //Actores
   std::vector<EngineUtilities::TSharedPointer<Actor>> m_actors;  // contenedor de todos los actores
-  int selectedActorIndex = 0; // ndice del actor seleccionado
+  EntityId selectedActor = InvalidEntityId; // handle del actor seleccionado (invlido si se destruye)
+
+  //Sistemas del ECS
+  SystemScheduler                m_systems;                    // ejecuta los sistemas en paralelo cada frame
+  TransformSystem*               m_transformSystem = nullptr;  // pertenece a m_systems
 
 
   bool keys[256] = { false }; // Arreglo de teclas para manejar los inputs de teclado
@@ -5,6 +5,7 @@
 #include "Texture.h"
 #include "SamplerState.h"
 #include "Transform.h"
+#include "Utilities\Bounds\Frustum.h"
 
 class Device;
 class MeshComponent;
@@ -38,6 +39,7 @@ public:
 
   /**
    * @brief Actualiza el actor.
+   * Usa la matriz del Transform tal como la dej TransformSystem en este frame.
    * @param deltaTime El tiempo transcurrido desde la ltima actualizacin.
    * @param deviceContext Contexto del dispositivo para operaciones grficas.
    */
@@ -76,12 +78,25 @@ public:
     m_textures = textures;
   }
 
+  /**
+   * @brief Establece el frustum de la cmara para el frame actual.
+   * A partir de la primera llamada, render() omite las mallas cuya caja envolvente
+   * (MeshBounds::renderBounds) queda fuera del frustum.
+   * @param frustum Frustum relativo a la cmara (origen de render), el mismo espacio que las cajas
+   *                (ver Frustum::fromViewProjection).
+   */
+  void
+  setViewFrustum(const EngineUtilities::Frustum& frustum) {
+    m_viewFrustum = frustum;
+    m_hasViewFrustum = true;
+  }
+
   /**
    * @brief Obtiene el nombre del actor.
    * @return El nombre del actor.
    */
-  std::string
-  getName() {
+  const std::string&
+  getName() const {
     return m_name;
   }
 
@@ -94,15 +109,6 @@ public:
     m_name = name;
   }
 
-  /**
-   * @brief Obtiene un componente especfico del actor.
-   * @tparam T Tipo del componente que se va a obtener.
-   * @return Puntero compartido al componente, o nullptr si no se encuentra.
-   */
-  template <typename T>
-  EngineUtilities::TSharedPointer<T>
-    getComponent();
-
 private:
   std::vector<MeshComponent> m_meshes;  // Vector de componentes de malla.
   std::vector<Texture> m_textures;      // Vector de texturas.
@@ -115,25 +121,8 @@ private:
   
   SamplerState m_sampler;               // Estado del muestreador.
 
+  EngineUtilities::Frustum m_viewFrustum;           // Frustum de la cmara, relativo a la cmara (origen de render).
+  bool m_hasViewFrustum = false;                    // Si es falso no se descarta ninguna malla.
+
   std::string m_name = "Actor";         // Nombre del actor.
 };
-
-/*
-* @brief Obtiene un componente especfico del actor.
-* @param T Tipo del componente que se va a obtener.
-* @return Puntero compartido al componente, o nullptr si no se encuentra.
-*
-* Este mtodo busca en la lista de componentes del actor y devuelve el primer componente que coincide con el tipo T.
-*/
-template<typename T>
-inline EngineUtilities::TSharedPointer<T>
-Actor::getComponent() {
-  for (auto& component : m_components) {
-    EngineUtilities::TSharedPointer<T> specificComponent = component.template dynamic_pointer_cast<T>();
-    if (specificComponent) {
-      return specificComponent;
-    }
-  }
-  // Devuelve un TSharedPointer vaco si no se encuentra el componente
-  return EngineUtilities::TSharedPointer<T>();
-}
\ No newline at end of file
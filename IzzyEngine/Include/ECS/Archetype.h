@@ -0,0 +1,323 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <array>
+#include <iostream>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Utilities/Memory/TMemoryTracker.h"
+#include "ComponentTypeId.h"
+
+/*
+ * Almacenamiento por arquetipos del ECS.
+ *
+ * Un arquetipo agrupa todas las entidades que tienen exactamente el mismo conjunto de tipos de
+ * componente (su firma). Sus componentes viven en chunks de 16 KB: dentro de cada chunk hay una
+ * columna contigua por tipo, de modo que recorrer un tipo de componente es un barrido lineal sobre
+ * memoria empaquetada, sin punteros intermedios ni casts. La firma es una ComponentMask y la columna
+ * de cada tipo se busca en una tabla indexada por ComponentTypeId.
+ *
+ * Las filas se mantienen densas: todos los chunks estn llenos salvo el ltimo, y al quitar una
+ * entidad la ltima fila del arquetipo ocupa su hueco.
+ *
+ * No depende de Prerequisites.h para poder compilarse tambin desde los benchmarks.
+ */
+
+/*
+ * Identificador de una entidad dentro de un World: un handle de 32 bits con el ndice de su ranura
+ * en los bits bajos y la generacin de la ranura en los altos. Al destruir la entidad la ranura
+ * cambia de generacin, as que los handles antiguos dejan de ser vlidos aunque la ranura se reutilice.
+ */
+using EntityId = uint32_t;
+
+static constexpr uint32_t EntityIndexBits = 20;                                 // Bits del ndice (hasta ~1M entidades a la vez).
+static constexpr uint32_t EntityIndexMask = (1u << EntityIndexBits) - 1;        // Mscara del ndice.
+static constexpr uint32_t MaxEntityGeneration = (1u << (32 - EntityIndexBits)) - 1;  // ltima generacin de una ranura.
+
+// Valor de EntityId que no corresponde a ninguna entidad (su ndice no se reparte nunca).
+static constexpr EntityId InvalidEntityId = 0xFFFFFFFFu;
+
+// ndice de la ranura de un handle.
+constexpr uint32_t
+entityIndex(EntityId entity) { return entity & EntityIndexMask; }
+
+// Generacin de un handle.
+constexpr uint32_t
+entityGeneration(EntityId entity) { return entity >> EntityIndexBits; }
+
+// Compone un handle a partir de ndice y generacin.
+constexpr EntityId
+makeEntityId(uint32_t index, uint32_t generation) { return (generation << EntityIndexBits) | index; }
+
+/*
+ * @struct ComponentInfo
+ * @brief Descripcin de un tipo de componente con la que un arquetipo maneja sus columnas sin conocer el tipo.
+ */
+struct
+ComponentInfo {
+  ComponentTypeIndex id;                   // ComponentTypeId del componente.
+  size_t size;                             // sizeof del componente.
+  size_t alignment;                        // alignof del componente.
+  void (*moveConstruct)(void* dst, void* src);  // Construye en dst moviendo desde src.
+  void (*destroy)(void* object);                // Llama al destructor.
+};
+
+/*
+ * @brief Devuelve la descripcin (nica por tipo) de un tipo de componente.
+ * @tparam T Tipo del componente; debe poder construirse por movimiento.
+ */
+template<typename T>
+const ComponentInfo&
+componentInfoOf() {
+  static_assert(std::is_move_constructible<T>::value, "Components stored in chunks must be move constructible");
+  static const ComponentInfo info = {
+    ComponentTypeId<T>(),
+    sizeof(T),
+    alignof(T),
+    [](void* dst, void* src) { ::new (dst) T(std::move(*static_cast<T*>(src))); },
+    [](void* object) { static_cast<T*>(object)->~T(); }
+  };
+  return info;
+}
+
+/*
+ * @struct ArchetypeChunk
+ * @brief Bloque de 16 KB con las filas de un arquetipo.
+ *
+ * La cabecera va al principio del bloque; detrs estn la columna de EntityId y una columna por
+ * tipo de componente, en los desplazamientos que calcula el arquetipo.
+ */
+struct
+ArchetypeChunk {
+  static constexpr size_t Size = 16 * 1024;   // Bytes de cada chunk, cabecera incluida.
+  static constexpr size_t Alignment = 64;     // Alineacin del chunk (lnea de cach).
+
+  uint32_t count = 0;                         // Filas ocupadas.
+
+  // Comienzo de la memoria del chunk, para aplicar los desplazamientos de las columnas.
+  unsigned char*
+  bytes() { return reinterpret_cast<unsigned char*>(this); }
+};
+
+/*
+ * @class Archetype
+ * @brief Conjunto de entidades con la misma firma y sus chunks.
+ */
+class
+Archetype {
+public:
+  /*
+   * @brief Crea un arquetipo para una firma.
+   * @param types Tipos de componente de la firma, ordenados por ComponentInfo::id.
+   */
+  explicit
+  Archetype(std::vector<const ComponentInfo*> types) : m_types(std::move(types)) {
+    m_columns.fill(-1);
+    m_addEdges.fill(nullptr);
+    m_removeEdges.fill(nullptr);
+    for (size_t c = 0; c < m_types.size(); ++c) {
+      m_mask |= ComponentMask(1) << m_types[c]->id;
+      m_columns[m_types[c]->id] = static_cast<int8_t>(c);
+    }
+    computeLayout();
+  }
+
+  Archetype(const Archetype&) = delete;
+  Archetype& operator=(const Archetype&) = delete;
+
+  /*
+   * @brief Destruye los componentes que queden y libera los chunks.
+   */
+  ~Archetype() {
+    for (ArchetypeChunk* chunk : m_chunks) {
+      for (size_t c = 0; c < m_types.size(); ++c) {
+        for (uint32_t row = 0; row < chunk->count; ++row) {
+          m_types[c]->destroy(componentAt(chunk, c, row));
+        }
+      }
+      freeChunk(chunk);
+    }
+  }
+
+  // Tipos de la firma, ordenados por ndice.
+  const std::vector<const ComponentInfo*>&
+  types() const { return m_types; }
+
+  // Firma como mscara de tipos.
+  ComponentMask
+  mask() const { return m_mask; }
+
+  // ndice de columna de un tipo, o -1 si la firma no lo contiene.
+  int
+  columnIndex(ComponentTypeIndex type) const { return m_columns[type]; }
+
+  // Indica si la firma contiene el tipo.
+  bool
+  hasType(ComponentTypeIndex type) const { return (m_mask >> type) & 1; }
+
+  // Filas por chunk.
+  uint32_t
+  chunkCapacity() const { return m_capacity; }
+
+  // Nmero de entidades del arquetipo.
+  size_t
+  size() const { return m_size; }
+
+  // Chunks del arquetipo (todos llenos salvo el ltimo).
+  const std::vector<ArchetypeChunk*>&
+  chunks() const { return m_chunks; }
+
+  // Columna de EntityId de un chunk.
+  EntityId*
+  entities(ArchetypeChunk* chunk) const {
+    return reinterpret_cast<EntityId*>(chunk->bytes() + m_entityOffset);
+  }
+
+  // Comienzo de la columna c de un chunk.
+  void*
+  column(ArchetypeChunk* chunk, size_t c) const {
+    return chunk->bytes() + m_offsets[c];
+  }
+
+  // Componente de la columna c en una fila.
+  void*
+  componentAt(ArchetypeChunk* chunk, size_t c, uint32_t row) const {
+    return chunk->bytes() + m_offsets[c] + row * m_types[c]->size;
+  }
+
+  /*
+   * @brief Reserva una fila al final del arquetipo para una entidad.
+   *
+   * Las columnas de componentes de la fila quedan sin construir: quien la reserva debe
+   * construir todos sus componentes.
+   *
+   * @param entity Entidad a la que pertenece la fila.
+   * @param chunkIndex Devuelve el ndice del chunk.
+   * @param row Devuelve la fila dentro del chunk.
+   */
+  void
+  pushRow(EntityId entity, uint32_t& chunkIndex, uint32_t& row) {
+    if (m_chunks.empty() || m_chunks.back()->count == m_capacity) {
+      m_chunks.push_back(allocateChunk());
+    }
+    ArchetypeChunk* chunk = m_chunks.back();
+    chunkIndex = static_cast<uint32_t>(m_chunks.size() - 1);
+    row = chunk->count++;
+    entities(chunk)[row] = entity;
+    ++m_size;
+  }
+
+  /*
+   * @brief Quita una fila cuyos componentes ya se destruyeron o se movieron.
+   *
+   * La ltima fila del arquetipo se mueve al hueco para que las filas sigan densas.
+   *
+   * @return La entidad que se movi al hueco, o InvalidEntityId si la fila quitada era la ltima.
+   */
+  EntityId
+  removeRow(uint32_t chunkIndex, uint32_t row) {
+    ArchetypeChunk* chunk = m_chunks[chunkIndex];
+    ArchetypeChunk* last = m_chunks.back();
+    uint32_t lastRow = last->count - 1;
+    EntityId moved = InvalidEntityId;
+
+    if (chunk != last || row != lastRow) {
+      for (size_t c = 0; c < m_types.size(); ++c) {
+        void* src = componentAt(last, c, lastRow);
+        m_types[c]->moveConstruct(componentAt(chunk, c, row), src);
+        m_types[c]->destroy(src);
+      }
+      moved = entities(last)[lastRow];
+      entities(chunk)[row] = moved;
+    }
+
+    --m_size;
+    if (--last->count == 0) {
+      freeChunk(last);
+      m_chunks.pop_back();
+    }
+    return moved;
+  }
+
+  // Arquetipo al que se llega aadiendo un tipo (cach del grafo de arquetipos), o nullptr.
+  Archetype*
+  addEdge(ComponentTypeIndex type) const { return m_addEdges[type]; }
+
+  // Arquetipo al que se llega quitando un tipo, o nullptr.
+  Archetype*
+  removeEdge(ComponentTypeIndex type) const { return m_removeEdges[type]; }
+
+  void
+  setAddEdge(ComponentTypeIndex type, Archetype* target) { m_addEdges[type] = target; }
+
+  void
+  setRemoveEdge(ComponentTypeIndex type, Archetype* target) { m_removeEdges[type] = target; }
+
+private:
+
+  static size_t
+  alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+  }
+
+  // Calcula cuntas filas caben en un chunk y dnde empieza cada columna.
+  void
+  computeLayout() {
+    size_t rowBytes = sizeof(EntityId);
+    for (const ComponentInfo* info : m_types) {
+      rowBytes += info->size;
+    }
+    // Primera estimacin sin relleno; se reduce hasta que las columnas alineadas quepan.
+    uint32_t capacity = static_cast<uint32_t>((ArchetypeChunk::Size - sizeof(ArchetypeChunk)) / rowBytes);
+    m_offsets.resize(m_types.size());
+    for (; capacity > 0; --capacity) {
+      size_t offset = alignUp(sizeof(ArchetypeChunk), alignof(EntityId));
+      m_entityOffset = offset;
+      offset += capacity * sizeof(EntityId);
+      for (size_t c = 0; c < m_types.size(); ++c) {
+        offset = alignUp(offset, m_types[c]->alignment);
+        m_offsets[c] = offset;
+        offset += capacity * m_types[c]->size;
+      }
+      if (offset <= ArchetypeChunk::Size) {
+        break;
+      }
+    }
+    // Una fila que no cabe en un chunk no tiene sitio en este almacenamiento: seguir escribira
+    // fuera del bloque.
+    if (capacity == 0) {
+      std::cerr << "Archetype row of " << rowBytes << " bytes does not fit in a chunk (ArchetypeChunk::Size = "
+                << ArchetypeChunk::Size << ")" << std::endl;
+      std::abort();
+    }
+    m_capacity = capacity;
+  }
+
+  ArchetypeChunk*
+  allocateChunk() {
+    void* memory = ::operator new(ArchetypeChunk::Size, std::align_val_t(ArchetypeChunk::Alignment));
+    EngineUtilities::MemoryTracker::recordAllocation(EngineUtilities::MemoryTag::Components, ArchetypeChunk::Size);
+    return ::new (memory) ArchetypeChunk();
+  }
+
+  void
+  freeChunk(ArchetypeChunk* chunk) {
+    chunk->~ArchetypeChunk();
+    EngineUtilities::MemoryTracker::recordFree(EngineUtilities::MemoryTag::Components, ArchetypeChunk::Size);
+    ::operator delete(chunk, std::align_val_t(ArchetypeChunk::Alignment));
+  }
+
+  std::vector<const ComponentInfo*> m_types;  // Firma, ordenada por ndice de tipo.
+  ComponentMask m_mask = 0;                   // Firma como mscara.
+  std::array<int8_t, MaxComponentTypes> m_columns;  // Columna de cada ndice de tipo, o -1.
+  std::vector<size_t> m_offsets;              // Desplazamiento de cada columna dentro del chunk.
+  size_t m_entityOffset = 0;                  // Desplazamiento de la columna de EntityId.
+  uint32_t m_capacity = 0;                    // Filas por chunk.
+  size_t m_size = 0;                          // Entidades en el arquetipo.
+  std::vector<ArchetypeChunk*> m_chunks;      // Chunks; todos llenos salvo el ltimo.
+  std::array<Archetype*, MaxComponentTypes> m_addEdges;     // Destino ya conocido al aadir cada tipo.
+  std::array<Archetype*, MaxComponentTypes> m_removeEdges;  // Destino ya conocido al quitar cada tipo.
+};
@@ -0,0 +1,23 @@
+#pragma once
+#include "Prerequisites.h"
+#include "System.h"
+
+/*
+* @class BoundsSystem
+* @brief Transforma las cajas locales de MeshBounds con la matriz del Transform de su entidad.
+*
+* Lee Transform y escribe MeshBounds, as que el planificador lo ejecuta despus de TransformSystem;
+* dentro del sistema los chunks se reparten entre los hilos. Las cajas de un Transform que no cambi
+* desde el frame anterior no se tocan.
+*/
+class
+BoundsSystem : public System {
+public:
+  BoundsSystem();
+
+  const char*
+  getName() const override { return "BoundsSystem"; }
+
+  void
+  update(World& world, float deltaTime) override;
+};
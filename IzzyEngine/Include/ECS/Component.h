@@ -52,6 +52,9 @@ public:
   ComponentType
     getType() const { return m_type; }
 
+  // Etiqueta con la que el MemoryTracker cuenta los componentes creados con MakeShared.
+  static constexpr EngineUtilities::MemoryTag EngineMemoryTag = EngineUtilities::MemoryTag::Components;
+
 protected:
   ComponentType m_type; // Tipo del componente.
 };
\ No newline at end of file
@@ -0,0 +1,83 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <type_traits>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/*
+ * Identificadores de tipo de componente generados en compilacin.
+ *
+ * ComponentTypeId<T>() da a cada tipo un ndice denso (0, 1, 2...) la primera vez que se pide, sin
+ * RTTI. Con l los arquetipos y las entidades guardan qu tipos tienen en una mscara de bits y
+ * encuentran la columna o la ranura de un tipo con un acceso a tabla en lugar de una bsqueda.
+ */
+
+// ndice denso de un tipo de componente.
+using ComponentTypeIndex = uint32_t;
+
+// Mximo de tipos de componente distintos: cada uno ocupa un bit de ComponentMask.
+static constexpr ComponentTypeIndex MaxComponentTypes = 64;
+
+// Conjunto de tipos de componente (el bit i corresponde al tipo de ndice i).
+using ComponentMask = uint64_t;
+
+namespace ComponentTypeDetail {
+  // Reparte el siguiente ndice libre.
+  inline ComponentTypeIndex
+  nextIndex() {
+    static std::atomic<ComponentTypeIndex> counter(0);
+    ComponentTypeIndex index = counter.fetch_add(1, std::memory_order_relaxed);
+    if (index >= MaxComponentTypes) {
+      std::cerr << "Too many component types (MaxComponentTypes = " << MaxComponentTypes << ")" << std::endl;
+      std::abort();
+    }
+    return index;
+  }
+
+  template<typename T>
+  ComponentTypeIndex
+  indexOf() {
+    static const ComponentTypeIndex index = nextIndex();
+    return index;
+  }
+}
+
+/*
+ * @brief ndice denso del tipo de componente T.
+ *
+ * Es estable durante toda la ejecucin pero puede cambiar entre ejecuciones (depende del orden en
+ * que se piden los tipos), as que no debe guardarse en disco.
+ */
+template<typename T>
+inline ComponentTypeIndex
+ComponentTypeId() {
+  return ComponentTypeDetail::indexOf<typename std::remove_cv<T>::type>();
+}
+
+// Bit de ComponentMask del tipo T.
+template<typename T>
+inline ComponentMask
+componentBit() {
+  return ComponentMask(1) << ComponentTypeId<T>();
+}
+
+/*
+ * @brief Nmero de bits activos de una mscara.
+ *
+ * Con la mscara de una entidad, componentCount(mask & (componentBit<T>() - 1)) es la posicin del
+ * componente T entre los suyos si se guardan ordenados por ndice de tipo.
+ */
+inline uint32_t
+componentCount(ComponentMask mask) {
+#if defined(_MSC_VER) && defined(_M_X64)
+  return static_cast<uint32_t>(__popcnt64(mask));
+#elif defined(_MSC_VER)
+  return static_cast<uint32_t>(__popcnt(static_cast<uint32_t>(mask)) + __popcnt(static_cast<uint32_t>(mask >> 32)));
+#else
+  return static_cast<uint32_t>(__builtin_popcountll(mask));
+#endif
+}
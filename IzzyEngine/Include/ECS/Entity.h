@@ -1,7 +1,19 @@
 #pragma once
 #include "Prerequisites.h"
 #include "Component.h"
+#include "World.h"
+#include "Utilities\Structures\TInlineArray.h"
 class DeviceContext;
+class Entity;
+
+/*
+ * @struct EntityOwner
+ * @brief Componente del World que apunta al objeto Entity dueo de la fila, para Entity::find.
+ */
+struct
+EntityOwner {
+  Entity* entity;  // Entidad que cre la fila.
+};
 
 /*
  * @class Entity
@@ -9,15 +21,56 @@ class DeviceContext;
  *
  * Esta clase define la interfaz bsica para las entidades que pueden tener componentes asociados.
  * Las entidades pueden ser actualizadas y renderizadas, y pueden contener mltiples componentes.
+ *
+ * Cada entidad tiene una fila en World::get(). Los componentes creados con emplaceComponent viven
+ * en los chunks de su arquetipo (memoria contigua por tipo); los que se aaden con addComponent
+ * siguen guardndose aparte, como punteros compartidos.
+ *
+ * Para referirse a una entidad desde fuera sin alargar su vida conviene guardar su EntityId y
+ * resolverlo con find() cuando haga falta: si la entidad se destruy, find devuelve nullptr en lugar
+ * de un puntero colgante.
  */
 class
 Entity {
 public:
   /**
-   * @brief Destructor virtual.
+   * @brief Constructor. Registra la entidad en el World global.
+   */
+  Entity() : m_entity(World::get().createEntity()) {
+    World::get().addComponent<EntityOwner>(m_entity, EntityOwner{ this });
+  }
+
+  // La fila en el World pertenece a una sola entidad
+  Entity(const Entity&) = delete;
+  Entity& operator=(const Entity&) = delete;
+
+  /**
+   * @brief Destructor virtual. Destruye la fila de la entidad y sus componentes en el World.
    */
   virtual
-  ~Entity() = default;
+  ~Entity() {
+    World::get().destroyEntity(m_entity);
+  }
+
+  /**
+   * @brief Identificador de la entidad en World::get().
+   */
+  EntityId
+  getEntityId() const { return m_entity; }
+
+  /**
+   * @brief Busca la entidad de un handle en O(1).
+   * @param entity Handle de la entidad.
+   * @return La entidad, o nullptr si ya se destruy (aunque su ranura la ocupe otra entidad).
+   */
+  static Entity*
+  find(EntityId entity) {
+    EntityOwner* owner = World::get().getComponent<EntityOwner>(entity);
+    return owner ? owner->entity : nullptr;
+  }
+
+  // Etiqueta con la que el MemoryTracker cuenta las entidades creadas con MakeShared.
+  static constexpr EngineUtilities::MemoryTag EngineMemoryTag = EngineUtilities::MemoryTag::Actors;
 
   /**
    * @brief Mtodo virtual puro para actualizar la entidad.
@@ -39,7 +92,9 @@ public:
   /*
    * @brief Aade un componente a la entidad.
    *
-   * El componente debe ser derivado de la clase Component.
+   * El componente debe ser derivado de la clase Component. Se guarda ordenado por ComponentTypeId,
+   * de forma que su posicin sale de la mscara de la entidad; si ya haba uno del mismo tipo,
+   * se sustituye.
    *
    * @tparam T Tipo del componente a aadir.
    * @param component Puntero compartido al componente a aadir.
@@ -49,32 +104,68 @@ public:
   void
   addComponent(EngineUtilities::TSharedPointer<T> component) {
     static_assert(std::is_base_of<Component, T>::value, "T must be derived from Component");
-    m_components.push_back(component.template dynamic_pointer_cast<Component>());
+    ComponentMask bit = componentBit<T>();
+    size_t slot = componentCount(m_componentMask & (bit - 1));
+    if (m_componentMask & bit) {
+      m_components[slot] = EngineUtilities::TSharedPointer<Component>(component);
+      return;
+    }
+    m_components.Add(EngineUtilities::TSharedPointer<Component>(component));
+    for (size_t i = m_components.Num() - 1; i > slot; --i) {
+      m_components[i].swap(m_components[i - 1]);
+    }
+    m_componentMask |= bit;
   }
+  /*
+   * @brief Construye un componente dentro del almacenamiento por arquetipos del World.
+   *
+   * Es la forma preferida para los componentes que se actualizan en bloque (por ejemplo Transform):
+   * World::forEachChunk los recorre sin pasar por la entidad.
+   *
+   * @tparam T Tipo del componente a construir.
+   * @param args Argumentos del constructor del componente.
+   * @return Puntero al componente (vlido hasta que la entidad cambie de arquetipo).
+  */
+  template<typename T, typename... Args>
+  T*
+  emplaceComponent(Args&&... args) {
+    static_assert(std::is_base_of<Component, T>::value, "T must be derived from Component");
+    return World::get().addComponent<T>(m_entity, std::forward<Args>(args)...);
+  }
+
   /*
    * @brief Obtiene un componente de la entidad.
    *
-   * Busca un componente del tipo especificado que est asociado a la entidad.
+   * Busca por tipo exacto (un componente derivado de T no cuenta como T) en O(1) y sin RTTI:
+   * primero en la mscara de los componentes aadidos con addComponent, despus en el World.
    *
    * @tparam T Tipo del componente a buscar.
-   * @return EngineUtilities::TSharedPointer<T> Puntero compartido al componente si existe,
-   * o un puntero compartido vaco si no se encuentra.
+   * @return Puntero al componente si existe, o nullptr si no se encuentra. El puntero es vlido
+   * hasta que la entidad cambie de arquetipo; no debe guardarse entre frames.
   */
-
   template<typename T>
-  EngineUtilities::TSharedPointer<T>
-    getComponent() {
-    for (auto& component : m_components) {
-      EngineUtilities::TSharedPointer<T> specificComponent = component.template dynamic_pointer_cast<T>();
-      if (specificComponent) {
-        return specificComponent;
-      }
+  T*
+  getComponent() {
+    ComponentMask bit = componentBit<T>();
+    if (m_componentMask & bit) {
+      return static_cast<T*>(m_components[componentCount(m_componentMask & (bit - 1))].get());
     }
-    return EngineUtilities::TSharedPointer<T>();
+    return World::get().getComponent<T>(m_entity);
+  }
+
+  /*
+   * @brief Indica si la entidad tiene un componente del tipo T (tipo exacto), en O(1).
+  */
+  template<typename T>
+  bool
+  hasComponent() const {
+    return (m_componentMask & componentBit<T>()) != 0 || World::get().hasComponent<T>(m_entity);
   }
 protected:
 
-  bool isActive;
-  int id;
-  std::vector<EngineUtilities::TSharedPointer<Component>> m_components;
+  EntityId m_entity;  // Handle de la entidad en World::get().
+  ComponentMask m_componentMask = 0;  // Tipos de los componentes de m_components.
+  // Los actores suelen tener 2-4 componentes: caben dentro de la entidad sin reservar memoria.
+  // Se guardan ordenados por ComponentTypeId; la posicin de cada uno sale de m_componentMask.
+  EngineUtilities::TInlineArray<EngineUtilities::TSharedPointer<Component>, 4> m_components;
 };
\ No newline at end of file
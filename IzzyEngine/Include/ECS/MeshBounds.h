@@ -0,0 +1,28 @@
+#pragma once
+#include "Prerequisites.h"
+#include "Utilities\Bounds\AABB.h"
+#include "Component.h"
+
+/*
+* @class MeshBounds
+* @brief Cajas envolventes de las mallas de un actor, en espacio local y en espacio de render.
+*
+* BoundsSystem recalcula renderBounds a partir de la matriz del Transform cuando esta cambia; el actor
+* las usa para descartar por frustum las mallas que quedan fuera de la vista.
+*/
+class
+MeshBounds : public Component {
+public:
+  MeshBounds() : Component(ComponentType::BOUNDS) {}
+
+  // Las cajas se actualizan en BoundsSystem, no por componente
+  void
+  update(float deltaTime) override {}
+
+  void
+  render(DeviceContext& deviceContext) override {}
+
+  std::vector<EngineUtilities::AABB> localBounds;  // Caja de cada malla en su espacio local.
+  std::vector<EngineUtilities::AABB> renderBounds;  // Las mismas transformadas por la matriz del Transform (relativa a la cmara).
+  uint32_t transformVersion = 0;  // Transform::getWorldVersion con la que se calcularon renderBounds; 0 obliga a recalcular.
+};
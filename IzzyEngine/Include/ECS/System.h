@@ -0,0 +1,192 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "World.h"
+
+/*
+ * @class System
+ * @brief Lgica que se ejecuta cada frame sobre los componentes del World.
+ *
+ * Cada sistema declara en su constructor qu tipos de componente lee y cules escribe. Con esas
+ * declaraciones SystemScheduler decide qu sistemas pueden ejecutarse a la vez: dos sistemas
+ * entran en conflicto si uno escribe un tipo que el otro lee o escribe.
+ *
+ * update() puede repartir su propio trabajo con World::forEachChunkParallel, pero no debe crear ni
+ * destruir entidades ni aadir o quitar componentes, ni tocar tipos que no haya declarado.
+ */
+class
+System {
+public:
+  /**
+   * @brief Destructor virtual.
+   */
+  virtual
+  ~System() = default;
+
+  /**
+   * @brief Nombre del sistema, para depurar el orden de ejecucin.
+   */
+  virtual const char*
+  getName() const = 0;
+
+  /**
+   * @brief Ejecuta el sistema para un frame.
+   * @param world World sobre el que trabaja.
+   * @param deltaTime El tiempo transcurrido desde la ltima actualizacin.
+   */
+  virtual void
+  update(World& world, float deltaTime) = 0;
+
+  // Tipos de componente que lee.
+  ComponentMask
+  getReads() const { return m_reads; }
+
+  // Tipos de componente que escribe.
+  ComponentMask
+  getWrites() const { return m_writes; }
+
+  /**
+   * @brief Indica si este sistema y otro no pueden ejecutarse a la vez.
+   */
+  bool
+  conflictsWith(const System& other) const {
+    return (m_writes & (other.m_reads | other.m_writes)) != 0 || (other.m_writes & m_reads) != 0;
+  }
+
+protected:
+  // Declara que el sistema lee componentes de tipo T.
+  template<typename T>
+  void
+  reads() { m_reads |= componentBit<T>(); }
+
+  // Declara que el sistema escribe componentes de tipo T (escribir incluye leer).
+  template<typename T>
+  void
+  writes() { m_writes |= componentBit<T>(); }
+
+private:
+  ComponentMask m_reads = 0;   // Tipos que lee.
+  ComponentMask m_writes = 0;  // Tipos que escribe.
+};
+
+/*
+ * @class SystemScheduler
+ * @brief Ejecuta los sistemas de cada frame en paralelo respetando sus accesos declarados.
+ *
+ * En cada frame construye un grafo de dependencias: un sistema depende de cada sistema registrado
+ * antes que l con el que entra en conflicto. Los sistemas sin dependencias pendientes se encolan en
+ * el ThreadPool; al terminar, cada uno libera a los que dependan de l. El resultado es el mismo que
+ * ejecutarlos en el orden de registro, pero los que no comparten datos corren a la vez.
+ */
+class
+SystemScheduler {
+public:
+  /**
+   * @brief Constructor.
+   * @param pool Pool en el que se ejecutan los sistemas (por defecto el global).
+   */
+  explicit
+  SystemScheduler(EngineUtilities::ThreadPool& pool = EngineUtilities::ThreadPool::get()) : m_pool(&pool) {}
+
+  /**
+   * @brief Registra un sistema; el orden de registro decide quin va antes cuando hay conflicto.
+   * @tparam T Tipo del sistema.
+   * @param args Argumentos del constructor del sistema.
+   * @return Referencia al sistema, que pertenece al planificador.
+   */
+  template<typename T, typename... Args>
+  T&
+  addSystem(Args&&... args) {
+    static_assert(std::is_base_of<System, T>::value, "T must be derived from System");
+    T* system = new T(std::forward<Args>(args)...);
+    m_systems.push_back(std::unique_ptr<System>(system));
+    return *system;
+  }
+
+  /**
+   * @brief Ejecuta todos los sistemas una vez y espera a que terminen.
+   * @param world World sobre el que trabajan.
+   * @param deltaTime El tiempo transcurrido desde la ltima actualizacin.
+   */
+  void
+  update(World& world, float deltaTime) {
+    buildGraph();
+
+    m_world = &world;
+    m_deltaTime = deltaTime;
+    EngineUtilities::TaskCounter counter;
+    m_counter = &counter;
+    for (size_t i = 0; i < m_systems.size(); ++i) {
+      if (m_nodes[i].dependencies == 0) {
+        launch(i);
+      }
+    }
+    m_pool->wait(counter);
+    m_counter = nullptr;
+  }
+
+  /**
+   * @brief Sistemas de los que depende el sistema i en el ltimo frame (ndices de registro).
+   */
+  const std::vector<size_t>&
+  getDependencies(size_t i) const { return m_nodes[i].dependsOn; }
+
+  // Nmero de sistemas registrados.
+  size_t
+  getSystemCount() const { return m_systems.size(); }
+
+  // Sistema i en orden de registro.
+  System&
+  getSystem(size_t i) { return *m_systems[i]; }
+
+private:
+  struct Node {
+    std::vector<size_t> dependsOn;     // Sistemas anteriores en conflicto.
+    std::vector<size_t> dependents;    // Sistemas posteriores que esperan a este.
+    int dependencies = 0;              // Nmero de elementos de dependsOn.
+    std::atomic<int> pending{ 0 };     // Dependencias que an no han terminado en este frame.
+  };
+
+  // Rehace el grafo: las declaraciones de un sistema pueden cambiar entre frames.
+  void
+  buildGraph() {
+    if (m_nodes.size() != m_systems.size()) {
+      m_nodes = std::vector<Node>(m_systems.size());
+    }
+    for (Node& node : m_nodes) {
+      node.dependsOn.clear();
+      node.dependents.clear();
+    }
+    for (size_t j = 0; j < m_systems.size(); ++j) {
+      for (size_t i = 0; i < j; ++i) {
+        if (m_systems[j]->conflictsWith(*m_systems[i])) {
+          m_nodes[j].dependsOn.push_back(i);
+          m_nodes[i].dependents.push_back(j);
+        }
+      }
+      m_nodes[j].dependencies = static_cast<int>(m_nodes[j].dependsOn.size());
+      m_nodes[j].pending.store(m_nodes[j].dependencies, std::memory_order_relaxed);
+    }
+  }
+
+  // Encola el sistema i; al terminar libera a los que dependan de l.
+  void
+  launch(size_t i) {
+    m_pool->submit([this, i] {
+      m_systems[i]->update(*m_world, m_deltaTime);
+      for (size_t dependent : m_nodes[i].dependents) {
+        if (m_nodes[dependent].pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+          launch(dependent);
+        }
+      }
+    }, m_counter);
+  }
+
+  EngineUtilities::ThreadPool* m_pool;            // Pool en el que se ejecutan los sistemas.
+  std::vector<std::unique_ptr<System>> m_systems; // Sistemas en orden de registro.
+  std::vector<Node> m_nodes;                      // Grafo del frame, uno por sistema.
+  World* m_world = nullptr;                       // World del frame en curso.
+  float m_deltaTime = 0.0f;                       // deltaTime del frame en curso.
+  EngineUtilities::TaskCounter* m_counter = nullptr;  // Grupo de las tareas del frame en curso.
+};
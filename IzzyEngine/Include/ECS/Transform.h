@@ -1,28 +1,50 @@
 #pragma once
+#include <atomic>
 #include "Prerequisites.h"
 #include "Utilities\Vectors\Vector3.h"
+#include "Utilities\Vectors\Vector3d.h"
+#include "Utilities\Vectors\Quaternion.h"
+#include "Utilities\Matrix\Matrix4x4.h"
+#include "Archetype.h"
 #include "Component.h"
 
 /*
 * @class Transform
 * @brief Clase que representa la transformacin de un objeto en el espacio 3D.
+*
+* La posicin, la rotacin y la escala son locales: relativas al padre si lo tiene, al mundo si no.
+* TransformSystem compone las matrices locales con las de los padres en orden de profundidad y solo
+* recalcula los Transform marcados como sucios y sus descendientes; un objeto que no se mueve no
+* cuesta nada por frame. Por eso los cambios deben hacerse siempre con los mtodos set*.
 */
 class
 Transform : public Component {
 public:
   // Constructor que inicializa posicin, rotacin y escala por defecto
   Transform() : position(),
+    renderPosition(),
     rotation(),
     scale(),
+    orientation(),
+    orientationEuler(),
+    parent(InvalidEntityId),
+    localMatrix(),
+    worldMatrix(),
+    worldPosition(),
+    worldVersion(0),
+    dirty(true),
     matrix(),
-    Component(ComponentType::TRANSFORM) {}
+    Component(ComponentType::TRANSFORM) {
+    // Un Transform nuevo es un nodo ms de la jerarqua
+    s_hierarchyVersion.fetch_add(1, std::memory_order_relaxed);
+  }
 
   // Mtodos para inicializacin, actualizacin, renderizado y destruccin
   // Inicializa el objeto Transform
   void
   init();
 
-  // Actualiza el estado del objeto Transform basado en el tiempo transcurrido
+  // Recompone la matriz local si el Transform est sucio. La matriz de mundo la calcula TransformSystem.
   // @param deltaTime: Tiempo transcurrido desde la ltima actualizacin
   void
   update(float deltaTime) override;
@@ -37,13 +59,21 @@ public:
   destroy() {}
 
   // Mtodos de acceso a los datos de posicin
-  // Retorna la posicin actual
-  const EngineUtilities::Vector3&
+  // Retorna la posicin local (relativa al padre, o al mundo si no tiene padre)
+  const EngineUtilities::Vector3d&
   getPosition() const { return position; }
 
-  // Establece una nueva posicin
+  // Establece una nueva posicin local
   void
-  setPosition(const EngineUtilities::Vector3& newPos) { position = newPos; }
+  setPosition(const EngineUtilities::Vector3d& newPos) { position = newPos; markDirty(); }
+
+  // Posicin en el mundo (double), calculada por TransformSystem a partir de la jerarqua
+  const EngineUtilities::Vector3d&
+  getWorldPosition() const { return worldPosition; }
+
+  // Posicin en el mundo relativa al origen de render (la cmara), la traslacin de matrix
+  const EngineUtilities::Vector3&
+  getRenderPosition() const { return renderPosition; }
 
   // Mtodos de acceso a los datos de rotacin
   // Retorna la rotacin actual
@@ -52,7 +82,18 @@ public:
 
   // Establece una nueva rotacin
   void
-  setRotation(const EngineUtilities::Vector3& newRot) { rotation = newRot; }
+  setRotation(const EngineUtilities::Vector3& newRot) { rotation = newRot; markDirty(); }
+
+  // Retorna la rotacin como cuaternin (la que se usa para construir la matriz)
+  // Si los ngulos de Euler cambiaron desde el ltimo update, se reconstruye aqu.
+  const EngineUtilities::Quaternion&
+  getOrientation();
+
+  // Establece la rotacin como cuaternin (p. ej. el resultado de un slerp de animacin)
+  // y actualiza los ngulos de Euler que muestra el editor.
+  // @param newOrientation: Cuaternin de rotacin; se normaliza
+  void
+  setOrientation(const EngineUtilities::Quaternion& newOrientation);
 
   // Mtodos de acceso a los datos de escala
   // Retorna la escala actual
@@ -61,10 +102,10 @@ public:
 
   // Establece una nueva escala
   void
-  setScale(const EngineUtilities::Vector3& newScale) { scale = newScale; }
+  setScale(const EngineUtilities::Vector3& newScale) { scale = newScale; markDirty(); }
 
   void
-  setTransform(const EngineUtilities::Vector3& newPos,
+  setTransform(const EngineUtilities::Vector3d& newPos,
                const EngineUtilities::Vector3& newRot,
                const EngineUtilities::Vector3& newSca);
 
@@ -73,11 +114,64 @@ public:
   void
   translate(const EngineUtilities::Vector3& translation);
 
+  // Retorna la entidad padre, o InvalidEntityId si el Transform es una raz
+  EntityId
+  getParent() const { return parent; }
+
+  // Cuelga el Transform de otra entidad. La posicin, rotacin y escala pasan a ser relativas a ella;
+  // si el padre no tiene Transform, se destruye o forma un ciclo, se trata como raz.
+  // @param newParent: Entidad padre, o InvalidEntityId para volver a ser raz
+  void
+  setParent(EntityId newParent);
+
+  // Matriz de mundo sin traslacin (rotacin y escala acumuladas de toda la cadena de padres)
+  const EngineUtilities::Matrix4x4&
+  getWorldMatrix() const { return worldMatrix; }
+
+  // Aumenta cada vez que TransformSystem reescribe matrix; sirve para saber si hay que recalcular lo que depende de ella
+  uint32_t
+  getWorldVersion() const { return worldVersion; }
+
+  // Nmero de veces que algn Transform pas de limpio a sucio
+  static uint32_t
+  getChangeCount() { return s_changeCount.load(std::memory_order_relaxed); }
+
+  // Nmero de cambios de la jerarqua (padres nuevos y Transform creados)
+  static uint32_t
+  getHierarchyVersion() { return s_hierarchyVersion.load(std::memory_order_relaxed); }
+
 private:
-  EngineUtilities::Vector3 position;  // Posicin del objeto
-  EngineUtilities::Vector3 rotation;  // Rotacin del objeto
+  friend class TransformSystem;
+
+  EngineUtilities::Vector3d position; // Posicin local (double para mundos de ms de 10 km)
+  EngineUtilities::Vector3 renderPosition; // Posicin en el mundo relativa al origen de render (la cmara)
+  EngineUtilities::Vector3 rotation;  // Rotacin del objeto en ngulos de Euler (pitch, yaw, roll), editable desde la UI
   EngineUtilities::Vector3 scale;     // Escala del objeto
+  EngineUtilities::Quaternion orientation;      // Rotacin usada para la matriz
+  EngineUtilities::Vector3 orientationEuler;    // ngulos de Euler de los que sale orientation
+  EntityId parent;                              // Entidad padre, o InvalidEntityId
+  EngineUtilities::Matrix4x4 localMatrix;       // Escala y rotacin locales; la traslacin es position (double)
+  EngineUtilities::Matrix4x4 worldMatrix;       // Escala y rotacin en el mundo; la traslacin es worldPosition
+  EngineUtilities::Vector3d worldPosition;      // Posicin en el mundo
+  uint32_t worldVersion;                        // Ver getWorldVersion
+  bool dirty;                                   // La matriz local no est al da
+
+  // Marca el Transform para que TransformSystem lo recalcule junto con sus hijos
+  void
+  markDirty() {
+    if (!dirty) {
+      dirty = true;
+      s_changeCount.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  // Reconstruye orientation si rotation se modific con setRotation
+  void
+  syncOrientation();
+
+  static inline std::atomic<uint32_t> s_changeCount{ 0 };      // Ver getChangeCount
+  static inline std::atomic<uint32_t> s_hierarchyVersion{ 0 }; // Ver getHierarchyVersion
 
 public:
-  XMMATRIX matrix;    // Matriz de transformacin
-};
\ No newline at end of file
+  XMMATRIX matrix;    // Matriz de transformacin en el mundo, relativa al origen de render (la cmara)
+};
@@ -0,0 +1,171 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Archetype.h"
+#include "Utilities/Threading/ThreadPool.h"
+
+/*
+ * @class TransformHierarchy
+ * @brief Orden padre-antes-que-hijo de un conjunto de entidades con padre, por niveles de profundidad.
+ *
+ * rebuild() ordena los nodos por profundidad (las races primero, luego sus hijos, etc.) conservando
+ * dentro de cada nivel el orden de entrada. Con ese orden un nico recorrido lineal basta para
+ * propagar los cambios: cuando se visita un nodo, su padre ya est actualizado. propagate() recorre
+ * los niveles y marca qu nodos cambiaron; un nodo se recalcula solo si cambi l o su padre, as que
+ * los subrboles que no se tocaron no cuestan ms que leer una marca.
+ *
+ * No sabe nada de matrices: quien lo usa guarda los datos de cada nodo en arrays paralelos indexados
+ * por nodo. No depende de Prerequisites.h para poder compilarse tambin desde los benchmarks.
+ */
+class
+TransformHierarchy {
+public:
+  // Valor de parent() para los nodos raz.
+  static constexpr uint32_t NoParent = 0xFFFFFFFFu;
+
+  /*
+   * @brief Rehace el orden a partir de una lista de entidades y sus padres.
+   *
+   * Un padre que no est en la lista (InvalidEntityId, o el handle de una entidad ya destruida aunque
+   * su ranura la ocupe otra) convierte al nodo en raz. Si los padres
+   * forman un ciclo, se corta en un nodo del ciclo, que pasa a ser raz.
+   *
+   * @param entities Entidad de cada elemento.
+   * @param parents Padre de cada elemento, o InvalidEntityId.
+   * @param count Nmero de elementos.
+   */
+  void
+  rebuild(const EntityId* entities, const EntityId* parents, size_t count) {
+    // Posicin de cada entidad en la lista de entrada, por ndice de ranura.
+    uint32_t maxIndex = 0;
+    for (size_t i = 0; i < count; ++i) {
+      maxIndex = entityIndex(entities[i]) > maxIndex ? entityIndex(entities[i]) : maxIndex;
+    }
+    std::vector<uint32_t> indexOf(count ? size_t(maxIndex) + 1 : 0, NoParent);
+    for (size_t i = 0; i < count; ++i) {
+      indexOf[entityIndex(entities[i])] = static_cast<uint32_t>(i);
+    }
+    std::vector<uint32_t> parentOf(count, NoParent);
+    for (size_t i = 0; i < count; ++i) {
+      uint32_t slot = entityIndex(parents[i]);
+      uint32_t parent = slot < indexOf.size() ? indexOf[slot] : NoParent;
+      // El handle completo debe coincidir: una generacin distinta es un padre que ya no existe.
+      if (parent != NoParent && parent != i && entities[parent] == parents[i]) {
+        parentOf[i] = parent;
+      }
+    }
+
+    // Profundidad de cada elemento: se sube por los padres hasta uno ya conocido y se baja asignando.
+    const int32_t Unknown = -1;
+    const int32_t Visiting = -2;
+    std::vector<int32_t> depth(count, Unknown);
+    std::vector<uint32_t> path;
+    size_t levels = 0;
+    for (size_t i = 0; i < count; ++i) {
+      path.clear();
+      uint32_t node = static_cast<uint32_t>(i);
+      while (depth[node] == Unknown) {
+        depth[node] = Visiting;
+        path.push_back(node);
+        uint32_t parent = parentOf[node];
+        if (parent == NoParent) {
+          break;
+        }
+        if (depth[parent] == Visiting) {
+          parentOf[node] = NoParent;  // Ciclo: el nodo se queda sin padre.
+          break;
+        }
+        node = parent;
+      }
+      for (size_t p = path.size(); p-- > 0;) {
+        uint32_t n = path[p];
+        depth[n] = parentOf[n] == NoParent ? 0 : depth[parentOf[n]] + 1;
+        levels = size_t(depth[n]) + 1 > levels ? size_t(depth[n]) + 1 : levels;
+      }
+    }
+
+    // Ordenacin por conteo: estable, as que dentro de un nivel se conserva el orden de entrada.
+    m_levelStart.assign(levels + 1, 0);
+    for (size_t i = 0; i < count; ++i) {
+      ++m_levelStart[depth[i] + 1];
+    }
+    for (size_t l = 0; l < levels; ++l) {
+      m_levelStart[l + 1] += m_levelStart[l];
+    }
+    std::vector<uint32_t> next(m_levelStart.begin(), m_levelStart.end() - 1);
+    std::vector<uint32_t> nodeOf(count);
+    m_source.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+      uint32_t node = next[depth[i]]++;
+      nodeOf[i] = node;
+      m_source[node] = static_cast<uint32_t>(i);
+    }
+    m_parent.resize(count);
+    for (size_t node = 0; node < count; ++node) {
+      uint32_t parent = parentOf[m_source[node]];
+      m_parent[node] = parent == NoParent ? NoParent : nodeOf[parent];
+    }
+    m_changed.assign(count, 0);
+  }
+
+  // Nmero de nodos.
+  size_t
+  size() const { return m_source.size(); }
+
+  // Posicin del nodo en la lista que se pas a rebuild().
+  uint32_t
+  source(size_t node) const { return m_source[node]; }
+
+  // Nodo padre (siempre anterior en el orden), o NoParent.
+  uint32_t
+  parent(size_t node) const { return m_parent[node]; }
+
+  // Nmero de niveles de profundidad.
+  size_t
+  levelCount() const { return m_levelStart.empty() ? 0 : m_levelStart.size() - 1; }
+
+  // Primer nodo del nivel.
+  size_t
+  levelBegin(size_t level) const { return m_levelStart[level]; }
+
+  // Uno ms all del ltimo nodo del nivel.
+  size_t
+  levelEnd(size_t level) const { return m_levelStart[level + 1]; }
+
+  // Indica si el nodo cambi en el ltimo propagate().
+  bool
+  changed(size_t node) const { return m_changed[node] != 0; }
+
+  /*
+   * @brief Recorre todos los nodos, padres antes que hijos, y registra cules cambiaron.
+   *
+   * Los nodos de un mismo nivel no dependen entre s, as que cada nivel se reparte entre los hilos
+   * del pool; el siguiente nivel empieza cuando el anterior ha terminado.
+   *
+   * @param update Se llama como bool update(size_t node, bool parentChanged), a la vez desde varios
+   *               hilos para nodos distintos del mismo nivel. Devuelve si el nodo cambi, lo que obliga
+   *               a recalcular a sus hijos.
+   * @param pool Pool en el que se reparten los niveles.
+   */
+  template<typename Function>
+  void
+  propagate(Function&& update, EngineUtilities::ThreadPool& pool = EngineUtilities::ThreadPool::get()) {
+    for (size_t level = 0; level < levelCount(); ++level) {
+      size_t begin = m_levelStart[level];
+      pool.parallelFor(m_levelStart[level + 1] - begin, 1024, [&](size_t first, size_t last) {
+        for (size_t node = begin + first; node < begin + last; ++node) {
+          uint32_t parent = m_parent[node];
+          bool parentChanged = parent != NoParent && m_changed[parent] != 0;
+          m_changed[node] = update(node, parentChanged) ? 1 : 0;
+        }
+      });
+    }
+  }
+
+private:
+  std::vector<uint32_t> m_source;      // Posicin de entrada de cada nodo.
+  std::vector<uint32_t> m_parent;      // Nodo padre de cada nodo, o NoParent.
+  std::vector<uint32_t> m_levelStart;  // Primer nodo de cada nivel; el ltimo elemento es size().
+  std::vector<uint8_t> m_changed;      // 1 si el nodo cambi en el ltimo propagate().
+};
@@ -0,0 +1,58 @@
+#pragma once
+#include "Prerequisites.h"
+#include "System.h"
+#include "TransformHierarchy.h"
+
+class Transform;
+
+/*
+* @class TransformSystem
+* @brief Mantiene al da las matrices de mundo de todos los Transform del World, con su jerarqua.
+*
+* Guarda los Transform ordenados por profundidad (TransformHierarchy) y en cada frame compone la
+* matriz de mundo solo de los que se marcaron como sucios y de sus descendientes; cada nivel se
+* reparte entre los hilos. Las posiciones de mundo (double) se convierten en relativas al origen de
+* render con rebasePositions: si la cmara se mueve se rebasan todas, si no solo las que cambiaron.
+* Si no cambi ningn Transform ni la cmara, update() vuelve sin recorrer nada.
+*
+* El orden se rehace cuando cambia la estructura del World o la jerarqua (setParent).
+*/
+class
+TransformSystem : public System {
+public:
+  TransformSystem();
+
+  const char*
+  getName() const override { return "TransformSystem"; }
+
+  void
+  update(World& world, float deltaTime) override;
+
+  // Establece el origen de render (la posicin de la cmara) para el siguiente update
+  void
+  setRenderOrigin(const EngineUtilities::Vector3d& origin) { m_renderOrigin = origin; }
+
+private:
+  // Recoge los Transform del World y los ordena por profundidad.
+  void
+  rebuildHierarchy(World& world);
+
+  // Recompone la matriz de mundo de un nodo si cambi l o su padre; devuelve si cambi.
+  bool
+  updateWorld(size_t node, bool parentChanged, float deltaTime);
+
+  // Escribe la posicin relativa a la cmara de un nodo y su matriz final.
+  void
+  applyRenderPosition(size_t node);
+
+  TransformHierarchy m_hierarchy;             // Orden por profundidad de los Transform.
+  std::vector<Transform*> m_transforms;       // Transform de cada nodo.
+  std::vector<EngineUtilities::Vector3d> m_worldPositions;  // Posicin de mundo de cada nodo.
+  std::vector<EngineUtilities::Vector3> m_renderPositions;  // Posicin relativa a la cmara de cada nodo.
+  EngineUtilities::Vector3d m_renderOrigin;   // Posicin en el mundo que se convierte en el origen de render.
+  EngineUtilities::Vector3d m_appliedOrigin;  // Origen con el que se calcularon las matrices actuales.
+  uint64_t m_structureVersion = 0;            // World::getStructureVersion del ltimo rebuildHierarchy.
+  uint32_t m_hierarchyVersion = 0;            // Transform::getHierarchyVersion del ltimo rebuildHierarchy.
+  uint32_t m_changeCount = 0;                 // Transform::getChangeCount del ltimo update.
+  bool m_built = false;                       // Ya se construy el orden alguna vez.
+};
@@ -0,0 +1,402 @@
+#pragma once
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include "Archetype.h"
+#include "Utilities/Structures/TMap.h"
+#include "Utilities/Threading/ThreadPool.h"
+
+/*
+ * @class World
+ * @brief Registro de entidades y de sus componentes, almacenados por arquetipos.
+ *
+ * Cada entidad vive en una fila de un arquetipo (el de su firma actual). Aadir o quitar un
+ * componente mueve la fila al arquetipo vecino; los destinos se guardan en el propio arquetipo,
+ * as que tras la primera vez el cambio no busca firmas.
+ *
+ * Cada registro guarda la mscara de tipos de la entidad: hasComponent es una prueba de bit y
+ * getComponent un acceso a la tabla de columnas del arquetipo, ambos O(1) y sin RTTI.
+ *
+ * Los EntityId son handles con generacin (ver Archetype.h): cuando una entidad se destruye, todas
+ * las funciones tratan sus handles como de una entidad inexistente (isAlive falso, getComponent
+ * nullptr, destroyEntity no hace nada), aunque su ranura ya la ocupe otra entidad. Una ranura que
+ * agota sus generaciones se retira en lugar de reutilizarse, as que un handle nunca puede volver
+ * a ser vlido.
+ *
+ * Los punteros que devuelven getComponent y addComponent son vlidos hasta el siguiente
+ * addComponent, removeComponent o destroyEntity de cualquier entidad del mismo arquetipo.
+ */
+class
+World {
+public:
+  World() = default;
+  World(const World&) = delete;
+  World& operator=(const World&) = delete;
+
+  /*
+   * @brief Instancia global que usan los actores.
+   * No se destruye nunca, para que los actores que sobreviven al final del programa puedan soltarse.
+   */
+  static World&
+  get() {
+    static World* instance = new World();
+    return *instance;
+  }
+
+  /*
+   * @brief Crea una entidad sin componentes, reutilizando una ranura libre si la hay.
+   * @return Handle de la entidad.
+   */
+  EntityId
+  createEntity() {
+    uint32_t index;
+    if (!m_freeIndices.empty()) {
+      index = m_freeIndices.back();
+      m_freeIndices.pop_back();
+    }
+    else {
+      // El ndice EntityIndexMask queda reservado para InvalidEntityId.
+      if (m_records.size() >= EntityIndexMask) {
+        std::cerr << "Too many entities (limit = " << EntityIndexMask << ")" << std::endl;
+        std::abort();
+      }
+      index = static_cast<uint32_t>(m_records.size());
+      m_records.emplace_back();
+    }
+    m_records[index].alive = true;
+    return makeEntityId(index, m_records[index].generation);
+  }
+
+  /*
+   * @brief Destruye una entidad y todos sus componentes.
+   * @param entity Entidad a destruir; si no est viva no se hace nada.
+   */
+  void
+  destroyEntity(EntityId entity) {
+    if (!isAlive(entity)) {
+      return;
+    }
+    uint32_t index = entityIndex(entity);
+    EntityRecord& record = m_records[index];
+    if (record.archetype) {
+      Archetype& archetype = *record.archetype;
+      ArchetypeChunk* chunk = archetype.chunks()[record.chunk];
+      for (size_t c = 0; c < archetype.types().size(); ++c) {
+        archetype.types()[c]->destroy(archetype.componentAt(chunk, c, record.row));
+      }
+      releaseRow(archetype, record.chunk, record.row);
+      ++m_structureVersion;
+    }
+    uint32_t generation = record.generation;
+    record = EntityRecord();
+    // La nueva generacin invalida los handles que queden de esta entidad
+    if (generation < MaxEntityGeneration) {
+      record.generation = generation + 1;
+      m_freeIndices.push_back(index);
+    }
+    else {
+      record.generation = generation;
+      ++m_retiredCount;
+    }
+  }
+
+  // Indica si el handle corresponde a una entidad que sigue viva.
+  bool
+  isAlive(EntityId entity) const {
+    uint32_t index = entityIndex(entity);
+    return index < m_records.size() && m_records[index].alive &&
+           m_records[index].generation == entityGeneration(entity);
+  }
+
+  /*
+   * @brief Aade un componente a una entidad, construyndolo dentro de su chunk.
+   *
+   * Si la entidad ya tena un componente de ese tipo, se sustituye.
+   *
+   * @tparam T Tipo del componente.
+   * @param entity Entidad viva.
+   * @param args Argumentos del constructor del componente.
+   * @return Puntero al componente construido, o nullptr si la entidad no existe.
+   */
+  template<typename T, typename... Args>
+  T*
+  addComponent(EntityId entity, Args&&... args) {
+    static_assert(sizeof(T) + sizeof(EntityId) <= ArchetypeChunk::Size - sizeof(ArchetypeChunk),
+                  "Component does not fit in an archetype chunk");
+    if (!isAlive(entity)) {
+      return nullptr;
+    }
+    if (T* existing = getComponent<T>(entity)) {
+      *existing = T(std::forward<Args>(args)...);
+      return existing;
+    }
+
+    const ComponentInfo& info = componentInfoOf<T>();
+    EntityRecord& record = m_records[entityIndex(entity)];
+    Archetype* source = record.archetype;
+    Archetype* target = source ? source->addEdge(info.id) : nullptr;
+    if (!target) {
+      std::vector<const ComponentInfo*> types;
+      if (source) {
+        types = source->types();
+      }
+      types.insert(std::upper_bound(types.begin(), types.end(), &info, typeLess), &info);
+      target = findOrCreateArchetype(std::move(types));
+      if (source) {
+        source->setAddEdge(info.id, target);
+      }
+    }
+
+    uint32_t chunkIndex, row;
+    target->pushRow(entity, chunkIndex, row);
+    ArchetypeChunk* targetChunk = target->chunks()[chunkIndex];
+    if (source) {
+      moveRow(*source, record.chunk, record.row, *target, targetChunk, row);
+      releaseRow(*source, record.chunk, record.row);
+    }
+    T* component = ::new (target->componentAt(targetChunk, target->columnIndex(info.id), row))
+                     T(std::forward<Args>(args)...);
+
+    record.archetype = target;
+    record.chunk = chunkIndex;
+    record.row = row;
+    record.mask = target->mask();
+    ++m_structureVersion;
+    return component;
+  }
+
+  /*
+   * @brief Quita un componente de una entidad.
+   * @tparam T Tipo del componente; si la entidad no lo tiene no se hace nada.
+   */
+  template<typename T>
+  void
+  removeComponent(EntityId entity) {
+    if (!hasComponent<T>(entity)) {
+      return;
+    }
+    const ComponentInfo& info = componentInfoOf<T>();
+    EntityRecord& record = m_records[entityIndex(entity)];
+    Archetype* source = record.archetype;
+    ArchetypeChunk* sourceChunk = source->chunks()[record.chunk];
+    info.destroy(source->componentAt(sourceChunk, source->columnIndex(info.id), record.row));
+
+    Archetype* target = source->removeEdge(info.id);
+    if (!target && source->types().size() > 1) {
+      std::vector<const ComponentInfo*> types = source->types();
+      types.erase(std::find(types.begin(), types.end(), &info));
+      target = findOrCreateArchetype(std::move(types));
+      source->setRemoveEdge(info.id, target);
+    }
+
+    uint32_t chunkIndex = 0, row = 0;
+    if (target) {
+      target->pushRow(entity, chunkIndex, row);
+      moveRow(*source, record.chunk, record.row, *target, target->chunks()[chunkIndex], row);
+    }
+    releaseRow(*source, record.chunk, record.row);
+
+    record.archetype = target;
+    record.chunk = chunkIndex;
+    record.row = row;
+    record.mask = target ? target->mask() : 0;
+    ++m_structureVersion;
+  }
+
+  /*
+   * @brief Obtiene un componente de una entidad.
+   * @return Puntero al componente, o nullptr si la entidad no existe o no lo tiene.
+   */
+  template<typename T>
+  T*
+  getComponent(EntityId entity) {
+    if (!hasComponent<T>(entity)) {
+      return nullptr;
+    }
+    const EntityRecord& record = m_records[entityIndex(entity)];
+    ArchetypeChunk* chunk = record.archetype->chunks()[record.chunk];
+    return static_cast<T*>(record.archetype->componentAt(chunk, record.archetype->columnIndex(ComponentTypeId<T>()),
+                                                         record.row));
+  }
+
+  // Indica si la entidad tiene un componente del tipo T.
+  template<typename T>
+  bool
+  hasComponent(EntityId entity) const {
+    return isAlive(entity) && (m_records[entityIndex(entity)].mask & componentBit<T>()) != 0;
+  }
+
+  /*
+   * @brief Recorre, chunk a chunk, las entidades que tienen todos los tipos indicados.
+   *
+   * Es la forma rpida de actualizar muchos componentes: cada llamada recibe columnas contiguas.
+   *
+   * @param function Se llama como function(count, entities, Ts* columna...) por cada chunk.
+   */
+  template<typename... Ts, typename Function>
+  void
+  forEachChunk(Function&& function) {
+    forEachMatchingArchetype<Ts...>([&](Archetype& archetype, const int* columns) {
+      for (ArchetypeChunk* chunk : archetype.chunks()) {
+        callWithColumns<Ts...>(function, archetype, chunk, columns, std::index_sequence_for<Ts...>());
+      }
+    });
+  }
+
+  /*
+   * @brief Como forEachChunk, pero reparte los chunks entre los hilos de un ThreadPool.
+   *
+   * La funcin se llama a la vez desde varios hilos, cada vez con un chunk distinto: solo debe
+   * escribir en las filas que recibe. Mientras dura el recorrido no se pueden crear ni destruir
+   * entidades ni aadir o quitar componentes.
+   *
+   * @param function Se llama como function(count, entities, Ts* columna...) por cada chunk.
+   * @param pool Pool en el que se reparte el trabajo (por defecto el global).
+   */
+  template<typename... Ts, typename Function>
+  void
+  forEachChunkParallel(Function&& function, EngineUtilities::ThreadPool& pool = EngineUtilities::ThreadPool::get()) {
+    struct ChunkView {
+      Archetype* archetype;
+      ArchetypeChunk* chunk;
+      int columns[sizeof...(Ts)];
+    };
+    std::vector<ChunkView> views;
+    forEachMatchingArchetype<Ts...>([&](Archetype& archetype, const int* columns) {
+      for (ArchetypeChunk* chunk : archetype.chunks()) {
+        ChunkView view = { &archetype, chunk, {} };
+        std::copy(columns, columns + sizeof...(Ts), view.columns);
+        views.push_back(view);
+      }
+    });
+    pool.parallelFor(views.size(), 1, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        callWithColumns<Ts...>(function, *views[i].archetype, views[i].chunk, views[i].columns,
+                               std::index_sequence_for<Ts...>());
+      }
+    });
+  }
+
+  /*
+   * @brief Recorre las entidades que tienen todos los tipos indicados.
+   * @param function Se llama como function(Ts&...) por cada entidad.
+   */
+  template<typename... Ts, typename Function>
+  void
+  each(Function&& function) {
+    forEachChunk<Ts...>([&](size_t count, const EntityId*, Ts*... columns) {
+      for (size_t i = 0; i < count; ++i) {
+        function(columns[i]...);
+      }
+    });
+  }
+
+  // Nmero de entidades vivas.
+  size_t
+  entityCount() const { return m_records.size() - m_freeIndices.size() - m_retiredCount; }
+
+  // Nmero de arquetipos creados.
+  size_t
+  archetypeCount() const { return m_archetypes.size(); }
+
+  /*
+   * @brief Contador que aumenta con cada cambio que mueve filas entre chunks.
+   *
+   * Sube en addComponent (salvo al sustituir un componente), removeComponent y destroyEntity. Mientras
+   * no cambie, los punteros a componentes que se hayan guardado siguen siendo vlidos.
+   */
+  uint64_t
+  getStructureVersion() const { return m_structureVersion; }
+
+private:
+  // Dnde vive cada entidad.
+  struct EntityRecord {
+    Archetype* archetype = nullptr;  // Arquetipo de su firma, nullptr si no tiene componentes.
+    uint32_t chunk = 0;              // Chunk dentro del arquetipo.
+    uint32_t row = 0;                // Fila dentro del chunk.
+    ComponentMask mask = 0;          // Tipos de componente que tiene (la firma de su arquetipo).
+    bool alive = false;              // Falso para las ranuras libres.
+    uint32_t generation = 0;         // Generacin de la ranura; sube cada vez que se destruye su entidad.
+  };
+
+  static bool
+  typeLess(const ComponentInfo* a, const ComponentInfo* b) { return a->id < b->id; }
+
+  // Llama a visit(archetype, columnas) por cada arquetipo cuya firma contiene todos los tipos.
+  template<typename... Ts, typename Visitor>
+  void
+  forEachMatchingArchetype(Visitor&& visit) {
+    const ComponentTypeIndex required[] = { ComponentTypeId<Ts>()... };
+    ComponentMask requiredMask = 0;
+    for (ComponentTypeIndex type : required) {
+      requiredMask |= ComponentMask(1) << type;
+    }
+    for (const std::unique_ptr<Archetype>& archetype : m_archetypes) {
+      if ((archetype->mask() & requiredMask) != requiredMask || archetype->size() == 0) {
+        continue;
+      }
+      int columns[sizeof...(Ts)];
+      for (size_t i = 0; i < sizeof...(Ts); ++i) {
+        columns[i] = archetype->columnIndex(required[i]);
+      }
+      visit(*archetype, columns);
+    }
+  }
+
+  template<typename... Ts, typename Function, size_t... I>
+  static void
+  callWithColumns(Function& function, Archetype& archetype, ArchetypeChunk* chunk,
+                  const int* columns, std::index_sequence<I...>) {
+    function(static_cast<size_t>(chunk->count), archetype.entities(chunk),
+             static_cast<Ts*>(archetype.column(chunk, columns[I]))...);
+  }
+
+  Archetype*
+  findOrCreateArchetype(std::vector<const ComponentInfo*> types) {
+    ComponentMask mask = 0;
+    for (const ComponentInfo* info : types) {
+      mask |= ComponentMask(1) << info->id;
+    }
+    if (Archetype** existing = m_archetypeByMask.Find(mask)) {
+      return *existing;
+    }
+    m_archetypes.push_back(std::unique_ptr<Archetype>(new Archetype(std::move(types))));
+    m_archetypeByMask.Add(mask, m_archetypes.back().get());
+    return m_archetypes.back().get();
+  }
+
+  // Mueve los componentes de una fila a otra de un arquetipo que contiene todos sus tipos.
+  static void
+  moveRow(Archetype& source, uint32_t sourceChunkIndex, uint32_t sourceRow,
+          Archetype& target, ArchetypeChunk* targetChunk, uint32_t targetRow) {
+    ArchetypeChunk* sourceChunk = source.chunks()[sourceChunkIndex];
+    const std::vector<const ComponentInfo*>& types = source.types();
+    for (size_t c = 0; c < types.size(); ++c) {
+      int targetColumn = target.columnIndex(types[c]->id);
+      if (targetColumn < 0) {
+        continue;  // El tipo que se quita ya se destruy.
+      }
+      void* src = source.componentAt(sourceChunk, c, sourceRow);
+      types[c]->moveConstruct(target.componentAt(targetChunk, targetColumn, targetRow), src);
+      types[c]->destroy(src);
+    }
+  }
+
+  // Quita una fila ya vaciada y corrige el registro de la entidad que ocupa su hueco.
+  void
+  releaseRow(Archetype& archetype, uint32_t chunkIndex, uint32_t row) {
+    EntityId moved = archetype.removeRow(chunkIndex, row);
+    if (moved != InvalidEntityId) {
+      m_records[entityIndex(moved)].chunk = chunkIndex;
+      m_records[entityIndex(moved)].row = row;
+    }
+  }
+
+  std::vector<EntityRecord> m_records;                  // Registro por ndice de ranura.
+  std::vector<uint32_t> m_freeIndices;                  // Ranuras libres para reutilizar.
+  size_t m_retiredCount = 0;                            // Ranuras retiradas por agotar sus generaciones.
+  std::vector<std::unique_ptr<Archetype>> m_archetypes; // Arquetipos creados (nunca se borran).
+  EngineUtilities::TMap<ComponentMask, Archetype*> m_archetypeByMask;  // Arquetipo de cada firma.
+  uint64_t m_structureVersion = 0;                      // Cambios estructurales (ver getStructureVersion).
+};
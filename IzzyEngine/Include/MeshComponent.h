@@ -2,6 +2,8 @@
 #include "Prerequisites.h"
 #include "DeviceContext.h"
 #include "ECS/Component.h"
+#include "Utilities/Bounds/BoundingSphere.h"
+#include "Utilities/Bounds/VertexTransform.h"
 
 /*
 * @brief MeshComponent.
@@ -11,6 +13,10 @@
 class 
 MeshComponent : public Component {
 public:
+  // Los vrtices y los ndices en CPU cuentan en MemoryTag::Meshes
+  using VertexArray = std::vector<SimpleVertex, EngineUtilities::TTaggedStlAllocator<SimpleVertex, EngineUtilities::MemoryTag::Meshes>>;
+  using IndexArray = std::vector<unsigned int, EngineUtilities::TTaggedStlAllocator<unsigned int, EngineUtilities::MemoryTag::Meshes>>;
+
   MeshComponent() : m_numVertex(0), m_numIndex(0), Component(ComponentType::MESH) {}
   virtual
   ~MeshComponent() = default;
@@ -29,12 +35,55 @@ public:
   void 
   render(DeviceContext& deviceContext) override {};
 
+  /*
+  * @brief Calcula la caja y la esfera envolventes a partir de los vrtices.
+  * Se llama al cargar la malla; si se modifican los vrtices hay que volver a llamarla.
+  */
+  void
+  computeBounds() {
+    // Con la identidad el kernel solo calcula la caja (x * 1 + 0 es exacto)
+    m_bounds = EngineUtilities::transformPositionsParallel(EngineUtilities::Matrix4x4(), positionData(),
+                                                           sizeof(SimpleVertex), m_vertex.size());
+    // Esfera centrada en la caja, con el radio justo para contener todos los vrtices
+    m_boundingSphere = m_bounds.isEmpty() ? EngineUtilities::BoundingSphere()
+                                          : EngineUtilities::BoundingSphere(m_bounds.center(), 0.0f);
+    for (const SimpleVertex& vertex : m_vertex) {
+      m_boundingSphere.include(EngineUtilities::Vector3(vertex.Pos.x, vertex.Pos.y, vertex.Pos.z));
+    }
+  }
+
+  /*
+  * @brief Transforma las posiciones de todos los vrtices y calcula su caja envolvente en la misma pasada.
+  * Lee las posiciones directamente de m_vertex con el kernel por lotes (AVX2/SSE2, repartido en varios
+  * hilos en mallas grandes); pensado para picking, skinning en CPU o cajas en espacio de mundo.
+  * @param matrix Matriz afn a aplicar (p * M).
+  * @param out Recibe las posiciones transformadas; se redimensiona al nmero de vrtices.
+  * @return Caja envolvente de las posiciones transformadas.
+  */
+  EngineUtilities::AABB
+  transformVertices(const EngineUtilities::Matrix4x4& matrix, std::vector<EngineUtilities::Vector3>& out) const {
+    out.resize(m_vertex.size());
+    return EngineUtilities::transformPositionsParallel(matrix, positionData(), sizeof(SimpleVertex),
+                                                       m_vertex.size(), out.data());
+  }
+
+private:
+  /*
+  * @brief Posicin del primer vrtice; las dems estn a sizeof(SimpleVertex) bytes de distancia.
+  */
+  const float*
+  positionData() const {
+    return m_vertex.empty() ? nullptr : &m_vertex[0].Pos.x;
+  }
+
 public:
   std::string m_name; // Nombre de la malla
-  std::vector<SimpleVertex> m_vertex; // Vector que contiene los vrtices de la malla
-  std::vector<unsigned int> m_index; // Vector que contiene los ndices de la malla
+  VertexArray m_vertex; // Vector que contiene los vrtices de la malla
+  IndexArray m_index; // Vector que contiene los ndices de la malla
   int m_numVertex; // Nmero de vrtices en la malla
   int m_numIndex; // Nmero de ndices en la malla
+  EngineUtilities::AABB m_bounds; // Caja envolvente en espacio local
+  EngineUtilities::BoundingSphere m_boundingSphere; // Esfera envolvente en espacio local
 
 };
 
@@ -20,6 +20,9 @@
 #include "Utilities\Memory\TWeakPointer.h"
 #include "Utilities\Memory\TStaticPtr.h"
 #include "Utilities\Memory\TUniquePtr.h"
+#include "Utilities\Memory\TFrameAllocator.h"
+#include "Utilities\Memory\TMemoryTracker.h"
+#include "Utilities\Vectors\Vector3d.h"
 //Librerias DirectX
 #include <D3D11.h>        /* Interfaz principal para la gestin de Direct3D 11. */
 #include <D3DX11.h>       /* Extensiones de Direct3D 11 (deprecated en versiones recientes). */
@@ -137,7 +140,8 @@ enum
   NONE = 0,     ///< Tipo de componente no especificado.
   TRANSFORM = 1,///< Componente de transformacin.
   MESH = 2,     ///< Componente de malla.
-  MATERIAL = 3  ///< Componente de material.
+  MATERIAL = 3, ///< Componente de material.
+  BOUNDS = 4    ///< Cajas envolventes de las mallas.
 };
 
 enum 
@@ -151,7 +155,7 @@ ShaderType {
  */
 struct 
 Camera {
-  XMFLOAT3 pos;      /* Posicin de la cmara en el espacio 3D. */
+  EngineUtilities::Vector3d pos; /* Posicin de la cmara en el mundo (double: es el origen de render). */
   XMFLOAT3 target;   /* Punto al que la cmara apunta. */
 
   XMFLOAT3 up;       /* Vector de direccin hacia arriba. */
@@ -162,7 +166,7 @@ Camera {
   float pitch;       /* ngulo de rotacin vertical. */
 
   Camera() {
-    pos = XMFLOAT3(0.0f, 0.0f, -6.0f);    // Posicin inicial de la cmara
+    pos = EngineUtilities::Vector3d(0.0, 0.0, -6.0); // Posicin inicial de la cmara
     target = XMFLOAT3(0.0f, 2.0f, 0.0f);  // Punto al que la cmara apunta
     up = XMFLOAT3(0.0f, 1.0f, 0.0f);      // Vector de direccin hacia arriba
     forward = XMFLOAT3(0.0f, 0.0f, 1.0f); // Vector de direccin hacia adelante
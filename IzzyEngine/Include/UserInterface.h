@@ -54,21 +54,21 @@ public:
   /*
   * @brief Crea una ventana de actores.
   * param actors: Vector de punteros compartidos a actores.
-  * param selectedIndex: ndice del actor seleccionado.
+  * param selectedActor: Handle del actor seleccionado.
   * 
   * Esta funcin crea una ventana que muestra una lista de actores y permite seleccionar uno de ellos.
   * La ventana se actualiza automticamente para reflejar los cambios en la lista de actores.
   */
   void 
   actorsWindow(std::vector<EngineUtilities::TSharedPointer<Actor>>& actors, 
-               int& selectedIndex);
+               EntityId& selectedActor);
 
   /*
   * @brief Crea una ventana de transformaciones.
-  * param actor: Puntero compartido al actor seleccionado.
+  * param actor: Actor seleccionado, o nullptr si no hay ninguno.
   */
   void 
-  transformWindow(EngineUtilities::TSharedPointer<Actor>& actor);
+  transformWindow(Actor* actor);
 
   /*
   * @brief Crea una ventana de prueba.
@@ -76,6 +76,15 @@ public:
   void 
   drawTestDock();
 
+  /*
+  * @brief Crea una ventana con el uso de memoria por etiqueta (MemoryTracker).
+  *
+  * Muestra bytes vivos, pico, reservas y ritmo por frame de cada subsistema, y marca en rojo
+  * las etiquetas que superan su presupuesto.
+  */
+  void 
+  memoryWindow();
+
 
   /*
    * @brief Crea un botn en la interfaz de usuario.
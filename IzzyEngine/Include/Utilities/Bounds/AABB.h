@@ -0,0 +1,170 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+
+#include <cfloat>
+#include "Utilities/Vectors/Vector3.h"
+#include "Utilities/Matrix/Matrix4x4.h"
+namespace EngineUtilities {
+  /**
+   * @brief An axis-aligned bounding box.
+   *
+   * Stored as its two corners. A default-constructed box is empty (min > max), so it can be
+   * grown point by point with expand().
+   */
+  class AABB {
+  public:
+    Vector3 minCorner; /**< The corner with the smallest coordinates. */
+    Vector3 maxCorner; /**< The corner with the largest coordinates. */
+
+    /**
+     * @brief Default constructor.
+     *
+     * Initializes an empty box: expanding it by a point yields a box around that point.
+     */
+    constexpr AABB()
+      : minCorner(FLT_MAX, FLT_MAX, FLT_MAX), maxCorner(-FLT_MAX, -FLT_MAX, -FLT_MAX) {}
+
+    /**
+     * @brief Parameterized constructor.
+     *
+     * @param minCorner The corner with the smallest coordinates.
+     * @param maxCorner The corner with the largest coordinates.
+     */
+    constexpr AABB(const Vector3& minCorner, const Vector3& maxCorner)
+      : minCorner(minCorner), maxCorner(maxCorner) {}
+
+    /**
+     * @brief Builds a box from its center and half-size.
+     *
+     * @param center The center of the box.
+     * @param extents The half-size along each axis (non-negative).
+     * @return The box.
+     */
+    static constexpr AABB fromCenterExtents(const Vector3& center, const Vector3& extents) {
+      return AABB(center - extents, center + extents);
+    }
+
+    /**
+     * @brief Checks whether the box contains no point.
+     *
+     * @return True if the box is empty.
+     */
+    constexpr bool isEmpty() const {
+      return minCorner.x > maxCorner.x || minCorner.y > maxCorner.y || minCorner.z > maxCorner.z;
+    }
+
+    /**
+     * @brief Grows the box to contain a point.
+     *
+     * @param point The point to include.
+     */
+    constexpr void expand(const Vector3& point) {
+      minCorner = Vector3(EMin(minCorner.x, point.x), EMin(minCorner.y, point.y), EMin(minCorner.z, point.z));
+      maxCorner = Vector3(EMax(maxCorner.x, point.x), EMax(maxCorner.y, point.y), EMax(maxCorner.z, point.z));
+    }
+
+    /**
+     * @brief Grows the box to contain another box.
+     *
+     * @param other The box to include; an empty box leaves this one unchanged.
+     */
+    constexpr void expand(const AABB& other) {
+      if (!other.isEmpty()) {
+        expand(other.minCorner);
+        expand(other.maxCorner);
+      }
+    }
+
+    /**
+     * @brief Calculates the center of the box.
+     *
+     * @return The center point.
+     */
+    constexpr Vector3 center() const {
+      return (minCorner + maxCorner) * 0.5f;
+    }
+
+    /**
+     * @brief Calculates the half-size of the box along each axis.
+     *
+     * @return The extents.
+     */
+    constexpr Vector3 extents() const {
+      return (maxCorner - minCorner) * 0.5f;
+    }
+
+    /**
+     * @brief Checks whether a point lies inside the box (borders included).
+     *
+     * @param point The point to test.
+     * @return True if the point is inside.
+     */
+    constexpr bool contains(const Vector3& point) const {
+      return point.x >= minCorner.x && point.x <= maxCorner.x &&
+             point.y >= minCorner.y && point.y <= maxCorner.y &&
+             point.z >= minCorner.z && point.z <= maxCorner.z;
+    }
+
+    /**
+     * @brief Checks whether two boxes overlap (touching counts as overlapping).
+     *
+     * @param other The other box.
+     * @return True if the boxes overlap.
+     */
+    constexpr bool intersects(const AABB& other) const {
+      return minCorner.x <= other.maxCorner.x && maxCorner.x >= other.minCorner.x &&
+             minCorner.y <= other.maxCorner.y && maxCorner.y >= other.minCorner.y &&
+             minCorner.z <= other.maxCorner.z && maxCorner.z >= other.minCorner.z;
+    }
+
+    /**
+     * @brief Calculates the box that encloses this box after an affine transform.
+     *
+     * Uses Arvo's method: the new center is the transformed center and each new extent is
+     * the sum of the old extents weighted by the absolute values of the matrix. The result
+     * is exact for translations and scales and conservative under rotation.
+     *
+     * @param matrix An affine transform in row-vector convention (translation in row 3).
+     * @return The enclosing box; an empty box stays empty.
+     */
+    constexpr AABB transformed(const Matrix4x4& matrix) const {
+      if (isEmpty()) {
+        return *this;
+      }
+      Vector3 c = matrix.transformPoint(center());
+      Vector3 e = extents();
+      Vector3 newExtents(
+        fabs(matrix.m[0][0]) * e.x + fabs(matrix.m[1][0]) * e.y + fabs(matrix.m[2][0]) * e.z,
+        fabs(matrix.m[0][1]) * e.x + fabs(matrix.m[1][1]) * e.y + fabs(matrix.m[2][1]) * e.z,
+        fabs(matrix.m[0][2]) * e.x + fabs(matrix.m[1][2]) * e.y + fabs(matrix.m[2][2]) * e.z);
+      return fromCenterExtents(c, newExtents);
+    }
+  };
+}
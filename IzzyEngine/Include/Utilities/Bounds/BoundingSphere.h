@@ -0,0 +1,138 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+
+#include "AABB.h"
+namespace EngineUtilities {
+  /**
+   * @brief A bounding sphere.
+   *
+   * Cheaper to test than an AABB and rotation-invariant, but usually looser.
+   */
+  class BoundingSphere {
+  public:
+    Vector3 center; /**< The center of the sphere. */
+    float radius;   /**< The radius of the sphere; negative means empty. */
+
+    /**
+     * @brief Default constructor.
+     *
+     * Initializes an empty sphere at the origin.
+     */
+    constexpr BoundingSphere() : center(), radius(-1.0f) {}
+
+    /**
+     * @brief Parameterized constructor.
+     *
+     * @param center The center of the sphere.
+     * @param radius The radius of the sphere.
+     */
+    constexpr BoundingSphere(const Vector3& center, float radius) : center(center), radius(radius) {}
+
+    /**
+     * @brief Builds the sphere that circumscribes a box.
+     *
+     * @param box The box to enclose.
+     * @return The sphere; empty if the box is empty.
+     */
+    static BoundingSphere fromAABB(const AABB& box) {
+      if (box.isEmpty()) {
+        return BoundingSphere();
+      }
+      return BoundingSphere(box.center(), box.extents().magnitude());
+    }
+
+    /**
+     * @brief Checks whether the sphere contains no point.
+     *
+     * @return True if the sphere is empty.
+     */
+    constexpr bool isEmpty() const {
+      return radius < 0.0f;
+    }
+
+    /**
+     * @brief Grows the radius, keeping the center, so that the sphere contains a point.
+     *
+     * Starting from fromAABB() and then including every point gives a sphere centered on the
+     * box that is tighter than the circumscribed one.
+     *
+     * @param point The point to include.
+     */
+    void include(const Vector3& point) {
+      float distanceSq = (point - center).dot(point - center);
+      if (distanceSq > radius * radius || radius < 0.0f) {
+        radius = EngineUtilities::sqrt(distanceSq);
+      }
+    }
+
+    /**
+     * @brief Checks whether a point lies inside the sphere (surface included).
+     *
+     * @param point The point to test.
+     * @return True if the point is inside.
+     */
+    constexpr bool contains(const Vector3& point) const {
+      return (point - center).dot(point - center) <= radius * radius && radius >= 0.0f;
+    }
+
+    /**
+     * @brief Checks whether two spheres overlap.
+     *
+     * @param other The other sphere.
+     * @return True if the spheres overlap.
+     */
+    constexpr bool intersects(const BoundingSphere& other) const {
+      float radii = radius + other.radius;
+      Vector3 d = other.center - center;
+      return !isEmpty() && !other.isEmpty() && d.dot(d) <= radii * radii;
+    }
+
+    /**
+     * @brief Calculates the sphere that encloses this sphere after an affine transform.
+     *
+     * The radius is scaled by the largest axis scale of the matrix, so the result is exact for
+     * uniform scales and conservative otherwise.
+     *
+     * @param matrix An affine transform in row-vector convention (translation in row 3).
+     * @return The enclosing sphere; an empty sphere stays empty.
+     */
+    BoundingSphere transformed(const Matrix4x4& matrix) const {
+      if (isEmpty()) {
+        return *this;
+      }
+      float scaleSq = 0.0f;
+      for (int i = 0; i < 3; ++i) {
+        Vector3 axis(matrix.m[i][0], matrix.m[i][1], matrix.m[i][2]);
+        scaleSq = EMax(scaleSq, axis.dot(axis));
+      }
+      return BoundingSphere(matrix.transformPoint(center), radius * EngineUtilities::sqrt(scaleSq));
+    }
+  };
+}
@@ -0,0 +1,225 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+
+#include <cstdint>
+#include "BoundingSphere.h"
+#include "Utilities/Vectors/Vector4.h"
+#include "Utilities/Vectors/Vector3x8.h"
+namespace EngineUtilities {
+  /**
+   * @brief A view frustum as six inward-facing planes.
+   *
+   * Each plane is stored as (a, b, c, d) with a unit normal (a, b, c): a point p is on the inner
+   * side when a*p.x + b*p.y + c*p.z + d >= 0.
+   */
+  class Frustum {
+  public:
+    /**
+     * @brief Indices of the planes.
+     */
+    enum PlaneIndex {
+      LeftPlane = 0,
+      RightPlane,
+      BottomPlane,
+      TopPlane,
+      NearPlane,
+      FarPlane,
+      PlaneCount
+    };
+
+    Vector4 planes[PlaneCount]; /**< The six planes, in PlaneIndex order. */
+
+    /**
+     * @brief Extracts the frustum planes from a view-projection matrix (Gribb-Hartmann).
+     *
+     * Expects the engine convention: row vectors (clip = p * viewProjection) and a Direct3D clip
+     * volume with 0 <= z <= w. Passing view * projection gives world-space planes; passing
+     * world * view * projection gives planes in that object's local space.
+     *
+     * @param viewProjection The combined view-projection matrix.
+     * @return The frustum.
+     */
+    static Frustum fromViewProjection(const Matrix4x4& viewProjection) {
+      const float (&m)[4][4] = viewProjection.m;
+      Frustum frustum;
+      for (int axis = 0; axis < 2; ++axis) {
+        for (int side = 0; side < 2; ++side) {
+          float sign = side == 0 ? 1.0f : -1.0f;
+          frustum.planes[axis * 2 + side] = Vector4(m[0][3] + sign * m[0][axis],
+                                                    m[1][3] + sign * m[1][axis],
+                                                    m[2][3] + sign * m[2][axis],
+                                                    m[3][3] + sign * m[3][axis]);
+        }
+      }
+      frustum.planes[NearPlane] = Vector4(m[0][2], m[1][2], m[2][2], m[3][2]);
+      frustum.planes[FarPlane] = Vector4(m[0][3] - m[0][2], m[1][3] - m[1][2],
+                                         m[2][3] - m[2][2], m[3][3] - m[3][2]);
+
+      for (Vector4& plane : frustum.planes) {
+        float length = EngineUtilities::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+        if (length > 0.0f) {
+          plane = plane * (1.0f / length);
+        }
+      }
+      return frustum;
+    }
+
+    /**
+     * @brief Checks whether a box is at least partly inside the frustum.
+     *
+     * A box is rejected only when it lies entirely behind one plane, so boxes near a frustum
+     * corner can be reported visible although they are outside (the usual conservative test).
+     * This is the scalar reference for cullAABBs; both give the same answers, except that with
+     * FMA enabled a box that touches a plane within rounding error may be classified differently.
+     *
+     * @param box The box to test.
+     * @return True if the box may be visible.
+     */
+    bool intersects(const AABB& box) const {
+      if (box.isEmpty()) {
+        return false;
+      }
+      Vector3 c = box.center();
+      Vector3 e = box.extents();
+      for (const Vector4& p : planes) {
+        float distance = p.x * c.x + (p.y * c.y + (p.z * c.z + p.w));
+        float radius = fabs(p.x) * e.x + (fabs(p.y) * e.y + (fabs(p.z) * e.z));
+        if (distance + radius < 0.0f) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    /**
+     * @brief Checks whether a sphere is at least partly inside the frustum.
+     *
+     * @param sphere The sphere to test.
+     * @return True if the sphere may be visible.
+     */
+    bool intersects(const BoundingSphere& sphere) const {
+      if (sphere.isEmpty()) {
+        return false;
+      }
+      const Vector3& c = sphere.center;
+      for (const Vector4& p : planes) {
+        if (p.x * c.x + p.y * c.y + p.z * c.z + p.w < -sphere.radius) {
+          return false;
+        }
+      }
+      return true;
+    }
+  };
+
+  /**
+   * @brief Converts an array of boxes into the SoA center/extents blocks used by cullAABBs.
+   *
+   * Empty boxes get negative extents so that they are always culled. The unused lanes of the
+   * last block are zero; cullAABBs ignores them.
+   *
+   * @param boxes The source boxes.
+   * @param count The number of boxes.
+   * @param centers The destination centers (Vector3x8::blocksFor(count) elements).
+   * @param extents The destination extents (Vector3x8::blocksFor(count) elements).
+   */
+  inline void packAABBs(const AABB* boxes, size_t count, Vector3x8* centers, Vector3x8* extents) {
+    for (size_t i = 0; i < Vector3x8::blocksFor(count) * Vector3x8::Width; ++i) {
+      Vector3 c;
+      Vector3 e;
+      if (i < count) {
+        c = boxes[i].center();
+        e = boxes[i].isEmpty() ? Vector3(-FLT_MAX, -FLT_MAX, -FLT_MAX) : boxes[i].extents();
+      }
+      centers[i / Vector3x8::Width].set(i % Vector3x8::Width, c);
+      extents[i / Vector3x8::Width].set(i % Vector3x8::Width, e);
+    }
+  }
+
+  /**
+   * @brief Tests many boxes against a frustum: 8 boxes per iteration from SoA bounds.
+   *
+   * Each box is given by its center and extents. For every plane the kernel computes the signed
+   * distance of the center plus the projected radius of the box and rejects the lanes where it
+   * is negative, exactly like Frustum::intersects(const AABB&). One AVX2 register (or two SSE2
+   * registers) holds a whole block; without SIMD the same body runs as a scalar loop.
+   *
+   * @param frustum The frustum to test against.
+   * @param centers The box centers (Vector3x8::blocksFor(count) blocks).
+   * @param extents The box extents (Vector3x8::blocksFor(count) blocks).
+   * @param count The number of boxes.
+   * @param visibleMasks Receives one byte per block; bit i is set when box i of the block may be
+   *        visible. Bits past count are cleared.
+   * @return The number of boxes that may be visible.
+   */
+  inline size_t cullAABBs(const Frustum& frustum,
+                          const Vector3x8* centers,
+                          const Vector3x8* extents,
+                          size_t count,
+                          uint8_t* visibleMasks) {
+    using namespace MathDetail;
+    Float8 nx[Frustum::PlaneCount], ny[Frustum::PlaneCount], nz[Frustum::PlaneCount];
+    Float8 ax[Frustum::PlaneCount], ay[Frustum::PlaneCount], az[Frustum::PlaneCount];
+    Float8 nw[Frustum::PlaneCount];
+    for (int p = 0; p < Frustum::PlaneCount; ++p) {
+      const Vector4& plane = frustum.planes[p];
+      nx[p] = splat8(plane.x);
+      ny[p] = splat8(plane.y);
+      nz[p] = splat8(plane.z);
+      nw[p] = splat8(plane.w);
+      ax[p] = splat8(fabs(plane.x));
+      ay[p] = splat8(fabs(plane.y));
+      az[p] = splat8(fabs(plane.z));
+    }
+
+    size_t blocks = Vector3x8::blocksFor(count);
+    size_t visible = 0;
+    for (size_t b = 0; b < blocks; ++b) {
+      Float8 cx = load8(centers[b].x), cy = load8(centers[b].y), cz = load8(centers[b].z);
+      Float8 ex = load8(extents[b].x), ey = load8(extents[b].y), ez = load8(extents[b].z);
+      unsigned outside = 0;
+      for (int p = 0; p < Frustum::PlaneCount; ++p) {
+        Float8 distance = mulAdd(nx[p], cx, mulAdd(ny[p], cy, mulAdd(nz[p], cz, nw[p])));
+        Float8 radius = mulAdd(ax[p], ex, mulAdd(ay[p], ey, az[p] * ez));
+        outside |= negativeMask(distance + radius);
+      }
+
+      unsigned mask = ~outside & 0xFFu;
+      size_t remaining = count - b * Vector3x8::Width;
+      if (remaining < Vector3x8::Width) {
+        mask &= (1u << remaining) - 1u;
+      }
+      visibleMasks[b] = static_cast<uint8_t>(mask);
+      for (; mask != 0; mask &= mask - 1u) {
+        ++visible;
+      }
+    }
+    return visible;
+  }
+}
@@ -0,0 +1,244 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+
+#include <algorithm>
+#include <cfloat>
+#include <cstddef>
+#include <mutex>
+#include "AABB.h"
+#include "Utilities/Threading/ThreadPool.h"
+
+namespace EngineUtilities {
+  /**
+   * @brief The fewest positions transformPositionsParallel hands to one pool task.
+   */
+  constexpr size_t MIN_POSITIONS_PER_THREAD = 16384;
+
+  namespace MathDetail {
+    static_assert(sizeof(Vector3) == 3 * sizeof(float), "Vector3 must be three packed floats");
+
+    /**
+     * @brief The position of vertex i in an interleaved array with the given byte stride.
+     */
+    inline const float* positionAt(const float* positions, size_t stride, size_t i) {
+      return reinterpret_cast<const float*>(reinterpret_cast<const char*>(positions) + i * stride);
+    }
+
+#if ENGINE_MATH_SSE2
+    /**
+     * @brief Smallest and largest lane of a register.
+     */
+    inline float horizontalMin(__m128 v) {
+      v = _mm_min_ps(v, _mm_movehl_ps(v, v));
+      return _mm_cvtss_f32(_mm_min_ss(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1))));
+    }
+
+    inline float horizontalMax(__m128 v) {
+      v = _mm_max_ps(v, _mm_movehl_ps(v, v));
+      return _mm_cvtss_f32(_mm_max_ss(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1))));
+    }
+
+    /**
+     * @brief Writes the xyz lanes of a register to a Vector3 with a 16-byte store.
+     *
+     * The fourth float lands on the next element, so positions must be stored in increasing
+     * order and the last one of a run with storeVector3Exact.
+     */
+    inline void storeVector3Overlapping(Vector3* out, __m128 v) {
+      _mm_storeu_ps(&out->x, v);
+    }
+
+    inline void storeVector3Exact(Vector3* out, __m128 v) {
+      _mm_storel_pi(reinterpret_cast<__m64*>(&out->x), v);
+      _mm_store_ss(&out->z, _mm_movehl_ps(v, v));
+    }
+#endif
+  }
+
+  /**
+   * @brief Transforms the positions of an interleaved vertex array and returns their bounds.
+   *
+   * Reads positions straight from the vertex layout (for example &vertices[0].Pos.x with
+   * stride sizeof(SimpleVertex)), so callers never copy them out first. Every position is
+   * transformed as a point (p * M, like Matrix4x4::transformPoint), written to out if given,
+   * and folded into the returned box in the same pass.
+   *
+   * With AVX2 eight positions are transposed to SoA registers per step (four with SSE2), so
+   * the transform is nine multiply-adds per eight points and the bounds two min/max per axis.
+   * The vector loads read one float past each position, so the last position always goes
+   * through the scalar path.
+   *
+   * @param matrix The affine matrix to apply.
+   * @param positions The x coordinate of the first position; y and z must follow it.
+   * @param stride The distance in bytes between consecutive positions (a multiple of 4, >= 12).
+   * @param count The number of positions.
+   * @param out Receives the transformed positions (count elements), or nullptr for bounds only.
+   * @return The bounds of the transformed positions (empty when count is 0).
+   */
+  inline AABB transformPositions(const Matrix4x4& matrix,
+                                 const float* positions,
+                                 size_t stride,
+                                 size_t count,
+                                 Vector3* out = nullptr) {
+    using namespace MathDetail;
+    size_t i = 0;
+    AABB bounds;
+#if ENGINE_MATH_SSE2
+    const float (&m)[4][4] = matrix.m;
+    __m128 minX = _mm_set1_ps(FLT_MAX), minY = minX, minZ = minX;
+    __m128 maxX = _mm_set1_ps(-FLT_MAX), maxY = maxX, maxZ = maxX;
+#if ENGINE_MATH_AVX2
+    if (count > 8) {
+      __m256 m00 = _mm256_set1_ps(m[0][0]), m01 = _mm256_set1_ps(m[0][1]), m02 = _mm256_set1_ps(m[0][2]);
+      __m256 m10 = _mm256_set1_ps(m[1][0]), m11 = _mm256_set1_ps(m[1][1]), m12 = _mm256_set1_ps(m[1][2]);
+      __m256 m20 = _mm256_set1_ps(m[2][0]), m21 = _mm256_set1_ps(m[2][1]), m22 = _mm256_set1_ps(m[2][2]);
+      __m256 t0 = _mm256_set1_ps(m[3][0]), t1 = _mm256_set1_ps(m[3][1]), t2 = _mm256_set1_ps(m[3][2]);
+      __m256 minX8 = _mm256_set1_ps(FLT_MAX), minY8 = minX8, minZ8 = minX8;
+      __m256 maxX8 = _mm256_set1_ps(-FLT_MAX), maxY8 = maxX8, maxZ8 = maxX8;
+      for (; i + 8 < count; i += 8) {
+        // Positions i..i+3 in the low lanes and i+4..i+7 in the high lanes; a 4x4 transpose
+        // per half then gives xxxxxxxx, yyyyyyyy, zzzzzzzz.
+        __m256 p[4];
+        for (int k = 0; k < 4; ++k) {
+          p[k] = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(positionAt(positions, stride, i + k))),
+                                      _mm_loadu_ps(positionAt(positions, stride, i + k + 4)), 1);
+        }
+        __m256 xy01 = _mm256_unpacklo_ps(p[0], p[1]), zw01 = _mm256_unpackhi_ps(p[0], p[1]);
+        __m256 xy23 = _mm256_unpacklo_ps(p[2], p[3]), zw23 = _mm256_unpackhi_ps(p[2], p[3]);
+        __m256 x = _mm256_shuffle_ps(xy01, xy23, _MM_SHUFFLE(1, 0, 1, 0));
+        __m256 y = _mm256_shuffle_ps(xy01, xy23, _MM_SHUFFLE(3, 2, 3, 2));
+        __m256 z = _mm256_shuffle_ps(zw01, zw23, _MM_SHUFFLE(1, 0, 1, 0));
+
+        __m256 rx = mulAdd8(z, m20, mulAdd8(y, m10, mulAdd8(x, m00, t0)));
+        __m256 ry = mulAdd8(z, m21, mulAdd8(y, m11, mulAdd8(x, m01, t1)));
+        __m256 rz = mulAdd8(z, m22, mulAdd8(y, m12, mulAdd8(x, m02, t2)));
+        minX8 = _mm256_min_ps(minX8, rx); maxX8 = _mm256_max_ps(maxX8, rx);
+        minY8 = _mm256_min_ps(minY8, ry); maxY8 = _mm256_max_ps(maxY8, ry);
+        minZ8 = _mm256_min_ps(minZ8, rz); maxZ8 = _mm256_max_ps(maxZ8, rz);
+
+        if (out) {
+          __m256 zero = _mm256_setzero_ps();
+          __m256 xy0145 = _mm256_unpacklo_ps(rx, ry), xy2367 = _mm256_unpackhi_ps(rx, ry);
+          __m256 z0145 = _mm256_unpacklo_ps(rz, zero), z2367 = _mm256_unpackhi_ps(rz, zero);
+          __m256 v04 = _mm256_shuffle_ps(xy0145, z0145, _MM_SHUFFLE(1, 0, 1, 0));
+          __m256 v15 = _mm256_shuffle_ps(xy0145, z0145, _MM_SHUFFLE(3, 2, 3, 2));
+          __m256 v26 = _mm256_shuffle_ps(xy2367, z2367, _MM_SHUFFLE(1, 0, 1, 0));
+          __m256 v37 = _mm256_shuffle_ps(xy2367, z2367, _MM_SHUFFLE(3, 2, 3, 2));
+          storeVector3Overlapping(out + i, _mm256_castps256_ps128(v04));
+          storeVector3Overlapping(out + i + 1, _mm256_castps256_ps128(v15));
+          storeVector3Overlapping(out + i + 2, _mm256_castps256_ps128(v26));
+          storeVector3Overlapping(out + i + 3, _mm256_castps256_ps128(v37));
+          storeVector3Overlapping(out + i + 4, _mm256_extractf128_ps(v04, 1));
+          storeVector3Overlapping(out + i + 5, _mm256_extractf128_ps(v15, 1));
+          storeVector3Overlapping(out + i + 6, _mm256_extractf128_ps(v26, 1));
+          storeVector3Exact(out + i + 7, _mm256_extractf128_ps(v37, 1));
+        }
+      }
+      minX = _mm_min_ps(_mm256_castps256_ps128(minX8), _mm256_extractf128_ps(minX8, 1));
+      minY = _mm_min_ps(_mm256_castps256_ps128(minY8), _mm256_extractf128_ps(minY8, 1));
+      minZ = _mm_min_ps(_mm256_castps256_ps128(minZ8), _mm256_extractf128_ps(minZ8, 1));
+      maxX = _mm_max_ps(_mm256_castps256_ps128(maxX8), _mm256_extractf128_ps(maxX8, 1));
+      maxY = _mm_max_ps(_mm256_castps256_ps128(maxY8), _mm256_extractf128_ps(maxY8, 1));
+      maxZ = _mm_max_ps(_mm256_castps256_ps128(maxZ8), _mm256_extractf128_ps(maxZ8, 1));
+    }
+#endif
+    if (i + 4 < count) {
+      __m128 m00 = _mm_set1_ps(m[0][0]), m01 = _mm_set1_ps(m[0][1]), m02 = _mm_set1_ps(m[0][2]);
+      __m128 m10 = _mm_set1_ps(m[1][0]), m11 = _mm_set1_ps(m[1][1]), m12 = _mm_set1_ps(m[1][2]);
+      __m128 m20 = _mm_set1_ps(m[2][0]), m21 = _mm_set1_ps(m[2][1]), m22 = _mm_set1_ps(m[2][2]);
+      __m128 t0 = _mm_set1_ps(m[3][0]), t1 = _mm_set1_ps(m[3][1]), t2 = _mm_set1_ps(m[3][2]);
+      for (; i + 4 < count; i += 4) {
+        __m128 x = _mm_loadu_ps(positionAt(positions, stride, i));
+        __m128 y = _mm_loadu_ps(positionAt(positions, stride, i + 1));
+        __m128 z = _mm_loadu_ps(positionAt(positions, stride, i + 2));
+        __m128 w = _mm_loadu_ps(positionAt(positions, stride, i + 3));
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+
+        __m128 rx = mulAdd4(z, m20, mulAdd4(y, m10, mulAdd4(x, m00, t0)));
+        __m128 ry = mulAdd4(z, m21, mulAdd4(y, m11, mulAdd4(x, m01, t1)));
+        __m128 rz = mulAdd4(z, m22, mulAdd4(y, m12, mulAdd4(x, m02, t2)));
+        minX = _mm_min_ps(minX, rx); maxX = _mm_max_ps(maxX, rx);
+        minY = _mm_min_ps(minY, ry); maxY = _mm_max_ps(maxY, ry);
+        minZ = _mm_min_ps(minZ, rz); maxZ = _mm_max_ps(maxZ, rz);
+
+        if (out) {
+          __m128 rw = _mm_setzero_ps();
+          _MM_TRANSPOSE4_PS(rx, ry, rz, rw);
+          storeVector3Overlapping(out + i, rx);
+          storeVector3Overlapping(out + i + 1, ry);
+          storeVector3Overlapping(out + i + 2, rz);
+          storeVector3Exact(out + i + 3, rw);
+        }
+      }
+    }
+    bounds = AABB(Vector3(horizontalMin(minX), horizontalMin(minY), horizontalMin(minZ)),
+                  Vector3(horizontalMax(maxX), horizontalMax(maxY), horizontalMax(maxZ)));
+#endif
+    for (; i < count; ++i) {
+      const float* p = positionAt(positions, stride, i);
+      Vector3 transformed = matrix.transformPoint(Vector3(p[0], p[1], p[2]));
+      bounds.expand(transformed);
+      if (out) {
+        out[i] = transformed;
+      }
+    }
+    return bounds;
+  }
+
+  /**
+   * @brief transformPositions split across the engine thread pool for large vertex arrays.
+   *
+   * The array is cut into contiguous ranges of at least MIN_POSITIONS_PER_THREAD positions
+   * (smaller arrays run on the calling thread). Each range writes only its own part of out and
+   * computes its own box; the boxes are merged into the result as the ranges finish.
+   *
+   * @param matrix The affine matrix to apply.
+   * @param positions The x coordinate of the first position; y and z must follow it.
+   * @param stride The distance in bytes between consecutive positions (a multiple of 4, >= 12).
+   * @param count The number of positions.
+   * @param out Receives the transformed positions (count elements), or nullptr for bounds only.
+   * @return The bounds of the transformed positions (empty when count is 0).
+   */
+  inline AABB transformPositionsParallel(const Matrix4x4& matrix,
+                                         const float* positions,
+                                         size_t stride,
+                                         size_t count,
+                                         Vector3* out = nullptr) {
+    AABB bounds;
+    std::mutex boundsMutex;
+    ThreadPool::get().parallelFor(count, MIN_POSITIONS_PER_THREAD, [&](size_t first, size_t last) {
+      AABB rangeBounds = transformPositions(matrix, MathDetail::positionAt(positions, stride, first), stride,
+                                            last - first, out ? out + first : nullptr);
+      std::lock_guard<std::mutex> lock(boundsMutex);
+      bounds.expand(rangeBounds);
+    });
+    return bounds;
+  }
+}
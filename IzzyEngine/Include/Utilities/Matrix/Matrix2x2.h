@@ -43,10 +43,7 @@ namespace EngineUtilities {
      *
      * Initializes the matrix to the identity matrix.
      */
-    Matrix2x2() {
-      m[0][0] = 1; m[0][1] = 0;
-      m[1][0] = 0; m[1][1] = 1;
-    }
+    constexpr Matrix2x2() : m{ { 1, 0 }, { 0, 1 } } {}
 
     /**
      * @brief Parameterized constructor.
@@ -58,10 +55,8 @@ namespace EngineUtilities {
      * @param a21 Element at row 2, column 1.
      * @param a22 Element at row 2, column 2.
      */
-    Matrix2x2(float a11, float a12, float a21, float a22) {
-      m[0][0] = a11; m[0][1] = a12;
-      m[1][0] = a21; m[1][1] = a22;
-    }
+    constexpr Matrix2x2(float a11, float a12, float a21, float a22)
+      : m{ { a11, a12 }, { a21, a22 } } {}
 
     /**
      * @brief Adds another matrix to this matrix.
@@ -69,7 +64,7 @@ namespace EngineUtilities {
      * @param other The matrix to add.
      * @return The result of the addition.
      */
-    Matrix2x2 operator+(const Matrix2x2& other) const {
+    constexpr Matrix2x2 operator+(const Matrix2x2& other) const {
       return Matrix2x2(
         m[0][0] + other.m[0][0], m[0][1] + other.m[0][1],
         m[1][0] + other.m[1][0], m[1][1] + other.m[1][1]
@@ -82,7 +77,7 @@ namespace EngineUtilities {
      * @param other The matrix to subtract.
      * @return The result of the subtraction.
      */
-    Matrix2x2 operator-(const Matrix2x2& other) const {
+    constexpr Matrix2x2 operator-(const Matrix2x2& other) const {
       return Matrix2x2(
         m[0][0] - other.m[0][0], m[0][1] - other.m[0][1],
         m[1][0] - other.m[1][0], m[1][1] - other.m[1][1]
@@ -95,7 +90,7 @@ namespace EngineUtilities {
      * @param other The matrix to multiply by.
      * @return The result of the multiplication.
      */
-    Matrix2x2 operator*(const Matrix2x2& other) const {
+    constexpr Matrix2x2 operator*(const Matrix2x2& other) const {
       return Matrix2x2(
         m[0][0] * other.m[0][0] + m[0][1] * other.m[1][0], m[0][0] * other.m[0][1] + m[0][1] * other.m[1][1],
         m[1][0] * other.m[0][0] + m[1][1] * other.m[1][0], m[1][0] * other.m[0][1] + m[1][1] * other.m[1][1]
@@ -108,7 +103,7 @@ namespace EngineUtilities {
      * @param scalar The scalar to multiply by.
      * @return The result of the multiplication.
      */
-    Matrix2x2 operator*(float scalar) const {
+    constexpr Matrix2x2 operator*(float scalar) const {
       return Matrix2x2(
         m[0][0] * scalar, m[0][1] * scalar,
         m[1][0] * scalar, m[1][1] * scalar
@@ -120,7 +115,7 @@ namespace EngineUtilities {
      *
      * @return The determinant of the matrix.
      */
-    float determinant() const {
+    constexpr float determinant() const {
       return m[0][0] * m[1][1] - m[0][1] * m[1][0];
     }
 
@@ -129,7 +124,7 @@ namespace EngineUtilities {
      *
      * @return The inverse of the matrix.
      */
-    Matrix2x2 inverse() const {
+    constexpr Matrix2x2 inverse() const {
       float det = determinant();
       if (det == 0) {
         // Handle non-invertible matrix gracefully.
@@ -27,38 +27,33 @@
  * SOFTWARE.
 */
 #pragma once
+
+#include <cstddef>
+#include "Utilities/Utilities/EngineMathSIMD.h"
+#include "Utilities/Vectors/Vector3.h"
+#include "Utilities/Vectors/Vector3x8.h"
+#include "Utilities/Vectors/Vector4.h"
 namespace EngineUtilities {
   /**
  * @brief A 4x4 matrix class.
  *
  * This class represents a 4x4 matrix and provides basic matrix operations such as
  * addition, subtraction, multiplication, determinant calculation, and inversion.
+ *
+ * The matrix is row-major and 16-byte aligned, so each row loads into one SSE register.
+ * Vectors are row vectors, as in DirectXMath: a point is transformed as p * M and the
+ * translation lives in the fourth row (m[3][0..2]).
  */
-  class Matrix4x4 {
+  class alignas(16) Matrix4x4 {
   public:
     float m[4][4]; /**< The elements of the matrix. */
 
-    // Default constructor initializes to identity matrix
-    Matrix4x4() {
-      for (int i = 0; i < 4; ++i) {
-        for (int j = 0; j < 4; ++j) {
-          m[i][j] = (i == j) ? 1.0f : 0.0f;
-        }
-      }
-    }
-
     /**
      * @brief Default constructor.
      *
      * Initializes the matrix to the identity matrix.
      */
-    Matrix4x4() {
-      m[0][0] = 1; m[0][1] = 0; m[0][2] = 0; m[0][3] = 0;
-      m[1][0] = 0; m[1][1] = 1; m[1][2] = 0; m[1][3] = 0;
-      m[2][0] = 0; m[2][1] = 0; m[2][2] = 1; m[2][3] = 0;
-      m[3][0] = 0; m[3][1] = 0; m[3][2] = 0; m[3][3] = 1;
-    }
-
+    constexpr Matrix4x4() : m{ { 1, 0, 0, 0 }, { 0, 1, 0, 0 }, { 0, 0, 1, 0 }, { 0, 0, 0, 1 } } {}
 
     /**
      * @brief Parameterized constructor.
@@ -82,25 +77,101 @@ namespace EngineUtilities {
      * @param a43 Element at row 4, column 3.
      * @param a44 Element at row 4, column 4.
      */
-    Matrix4x4(float a11, float a12, float a13, float a14,
+    constexpr Matrix4x4(float a11, float a12, float a13, float a14,
       float a21, float a22, float a23, float a24,
       float a31, float a32, float a33, float a34,
-      float a41, float a42, float a43, float a44) {
-      m[0][0] = a11; m[0][1] = a12; m[0][2] = a13; m[0][3] = a14;
-      m[1][0] = a21; m[1][1] = a22; m[1][2] = a23; m[1][3] = a24;
-      m[2][0] = a31; m[2][1] = a32; m[2][2] = a33; m[2][3] = a34;
-      m[3][0] = a41; m[3][1] = a42; m[3][2] = a43; m[3][3] = a44;
+      float a41, float a42, float a43, float a44)
+      : m{ { a11, a12, a13, a14 }, { a21, a22, a23, a24 }, { a31, a32, a33, a34 }, { a41, a42, a43, a44 } } {}
+
+    /**
+     * @brief Builds a translation matrix.
+     *
+     * @param x The translation along X.
+     * @param y The translation along Y.
+     * @param z The translation along Z.
+     * @return The translation matrix.
+     */
+    static constexpr Matrix4x4 translation(float x, float y, float z) {
+      return Matrix4x4(1, 0, 0, 0,
+                       0, 1, 0, 0,
+                       0, 0, 1, 0,
+                       x, y, z, 1);
     }
 
-    // Copy constructor
-    Matrix4x4(const Matrix4x4& other) {
-      for (int i = 0; i < 4; ++i) {
-        for (int j = 0; j < 4; ++j) {
-          m[i][j] = other.m[i][j];
-        }
-      }
+    /**
+     * @brief Builds a scaling matrix.
+     *
+     * @param x The scale along X.
+     * @param y The scale along Y.
+     * @param z The scale along Z.
+     * @return The scaling matrix.
+     */
+    static constexpr Matrix4x4 scaling(float x, float y, float z) {
+      return Matrix4x4(x, 0, 0, 0,
+                       0, y, 0, 0,
+                       0, 0, z, 0,
+                       0, 0, 0, 1);
+    }
+
+    /**
+     * @brief Builds a left-handed perspective projection, like XMMatrixPerspectiveLH.
+     *
+     * Takes the size of the view volume at the near plane instead of a field of view, so it
+     * needs no trigonometry and can be evaluated at compile time.
+     *
+     * @param width The width of the view volume at the near plane.
+     * @param height The height of the view volume at the near plane.
+     * @param nearZ The distance to the near clipping plane (greater than 0).
+     * @param farZ The distance to the far clipping plane.
+     * @return The projection matrix.
+     */
+    static constexpr Matrix4x4 perspectiveLH(float width, float height, float nearZ, float farZ) {
+      float range = farZ / (farZ - nearZ);
+      return Matrix4x4(2 * nearZ / width, 0, 0, 0,
+                       0, 2 * nearZ / height, 0, 0,
+                       0, 0, range, 1,
+                       0, 0, -range * nearZ, 0);
+    }
+
+    /**
+     * @brief Builds a left-handed orthographic projection, like XMMatrixOrthographicLH.
+     *
+     * @param width The width of the view volume.
+     * @param height The height of the view volume.
+     * @param nearZ The distance to the near clipping plane.
+     * @param farZ The distance to the far clipping plane.
+     * @return The projection matrix.
+     */
+    static constexpr Matrix4x4 orthographicLH(float width, float height, float nearZ, float farZ) {
+      float range = 1.0f / (farZ - nearZ);
+      return Matrix4x4(2 / width, 0, 0, 0,
+                       0, 2 / height, 0, 0,
+                       0, 0, range, 0,
+                       0, 0, -range * nearZ, 1);
+    }
+
+#if ENGINE_MATH_SSE2
+    /**
+     * @brief Loads one row into an SSE register.
+     *
+     * @param row The row index, in [0, 4).
+     * @return The register holding the row.
+     */
+    __m128 row(int row) const {
+      return _mm_load_ps(m[row]);
     }
 
+    /**
+     * @brief Stores an SSE register into one row.
+     *
+     * @param row The row index, in [0, 4).
+     * @param value The register to store.
+     */
+    void setRow(int row, __m128 value) {
+      _mm_store_ps(m[row], value);
+    }
+#endif
+
     /**
      * @brief Adds another matrix to this matrix.
      *
@@ -108,12 +179,19 @@ namespace EngineUtilities {
      * @return The result of the addition.
      */
     Matrix4x4 operator+(const Matrix4x4& other) const {
-      return Matrix4x4(
-        m[0][0] + other.m[0][0], m[0][1] + other.m[0][1], m[0][2] + other.m[0][2], m[0][3] + other.m[0][3],
-        m[1][0] + other.m[1][0], m[1][1] + other.m[1][1], m[1][2] + other.m[1][2], m[1][3] + other.m[1][3],
-        m[2][0] + other.m[2][0], m[2][1] + other.m[2][1], m[2][2] + other.m[2][2], m[2][3] + other.m[2][3],
-        m[3][0] + other.m[3][0], m[3][1] + other.m[3][1], m[3][2] + other.m[3][2], m[3][3] + other.m[3][3]
-      );
+      Matrix4x4 result;
+#if ENGINE_MATH_SSE2
+      for (int i = 0; i < 4; ++i) {
+        result.setRow(i, _mm_add_ps(row(i), other.row(i)));
+      }
+#else
+      for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+          result.m[i][j] = m[i][j] + other.m[i][j];
+        }
+      }
+#endif
+      return result;
     }
 
     /**
@@ -123,42 +201,71 @@ namespace EngineUtilities {
      * @return The result of the subtraction.
      */
     Matrix4x4 operator-(const Matrix4x4& other) const {
-      return Matrix4x4(
-        m[0][0] - other.m[0][0], m[0][1] - other.m[0][1], m[0][2] - other.m[0][2], m[0][3] - other.m[0][3],
-        m[1][0] - other.m[1][0], m[1][1] - other.m[1][1], m[1][2] - other.m[1][2], m[1][3] - other.m[1][3],
-        m[2][0] - other.m[2][0], m[2][1] - other.m[2][1], m[2][2] - other.m[2][2], m[2][3] - other.m[2][3],
-        m[3][0] - other.m[3][0], m[3][1] - other.m[3][1], m[3][2] - other.m[3][2], m[3][3] - other.m[3][3]
-      );
+      Matrix4x4 result;
+#if ENGINE_MATH_SSE2
+      for (int i = 0; i < 4; ++i) {
+        result.setRow(i, _mm_sub_ps(row(i), other.row(i)));
+      }
+#else
+      for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+          result.m[i][j] = m[i][j] - other.m[i][j];
+        }
+      }
+#endif
+      return result;
     }
 
     /**
      * @brief Multiplies this matrix by another matrix.
      *
+     * With SSE each result row is a linear combination of the rows of other:
+     * four broadcasts and four multiply-adds per row, 16 in total instead of 64 scalar ones.
+     *
      * @param other The matrix to multiply by.
      * @return The result of the multiplication.
      */
     Matrix4x4 operator*(const Matrix4x4& other) const {
-      return Matrix4x4(
-        m[0][0] * other.m[0][0] + m[0][1] * other.m[1][0] + m[0][2] * other.m[2][0] + m[0][3] * other.m[3][0],
-        m[0][0] * other.m[0][1] + m[0][1] * other.m[1][1] + m[0][2] * other.m[2][1] + m[0][3] * other.m[3][1],
-        m[0][0] * other.m[0][2] + m[0][1] * other.m[1][2] + m[0][2] * other.m[2][2] + m[0][3] * other.m[3][2],
-        m[0][0] * other.m[0][3] + m[0][1] * other.m[1][3] + m[0][2] * other.m[2][3] + m[0][3] * other.m[3][3],
-
-        m[1][0] * other.m[0][0] + m[1][1] * other.m[1][0] + m[1][2] * other.m[2][0] + m[1][3] * other.m[3][0],
-        m[1][0] * other.m[0][1] + m[1][1] * other.m[1][1] + m[1][2] * other.m[2][1] + m[1][3] * other.m[3][1],
-        m[1][0] * other.m[0][2] + m[1][1] * other.m[1][2] + m[1][2] * other.m[2][2] + m[1][3] * other.m[3][2],
-        m[1][0] * other.m[0][3] + m[1][1] * other.m[1][3] + m[1][2] * other.m[2][3] + m[1][3] * other.m[3][3],
-
-        m[2][0] * other.m[0][0] + m[2][1] * other.m[1][0] + m[2][2] * other.m[2][0] + m[2][3] * other.m[3][0],
-        m[2][0] * other.m[0][1] + m[2][1] * other.m[1][1] + m[2][2] * other.m[2][1] + m[2][3] * other.m[3][1],
-        m[2][0] * other.m[0][2] + m[2][1] * other.m[1][2] + m[2][2] * other.m[2][2] + m[2][3] * other.m[3][2],
-        m[2][0] * other.m[0][3] + m[2][1] * other.m[1][3] + m[2][2] * other.m[2][3] + m[2][3] * other.m[3][3],
+      Matrix4x4 result;
+#if ENGINE_MATH_SSE2
+      __m128 b0 = other.row(0), b1 = other.row(1), b2 = other.row(2), b3 = other.row(3);
+      result.setRow(0, combineRows(row(0), b0, b1, b2, b3));
+      result.setRow(1, combineRows(row(1), b0, b1, b2, b3));
+      result.setRow(2, combineRows(row(2), b0, b1, b2, b3));
+      result.setRow(3, combineRows(row(3), b0, b1, b2, b3));
+#else
+      for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+          result.m[i][j] = m[i][0] * other.m[0][j] + m[i][1] * other.m[1][j] +
+                           m[i][2] * other.m[2][j] + m[i][3] * other.m[3][j];
+        }
+      }
+#endif
+      return result;
+    }
 
-        m[3][0] * other.m[0][0] + m[3][1] * other.m[1][0] + m[3][2] * other.m[2][0] + m[3][3] * other.m[3][0],
-        m[3][0] * other.m[0][1] + m[3][1] * other.m[1][1] + m[3][2] * other.m[2][1] + m[3][3] * other.m[3][1],
-        m[3][0] * other.m[0][2] + m[3][1] * other.m[1][2] + m[3][2] * other.m[2][2] + m[3][3] * other.m[3][2],
-        m[3][0] * other.m[0][3] + m[3][1] * other.m[1][3] + m[3][2] * other.m[2][3] + m[3][3] * other.m[3][3]
-      );
+    /**
+     * @brief Returns the transpose of the matrix.
+     *
+     * @return The transposed matrix.
+     */
+    Matrix4x4 transpose() const {
+      Matrix4x4 result;
+#if ENGINE_MATH_SSE2
+      __m128 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+      _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+      result.setRow(0, r0);
+      result.setRow(1, r1);
+      result.setRow(2, r2);
+      result.setRow(3, r3);
+#else
+      for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+          result.m[i][j] = m[j][i];
+        }
+      }
+#endif
+      return result;
     }
 
     /**
@@ -166,7 +273,7 @@ namespace EngineUtilities {
      *
      * @return The determinant of the matrix.
      */
-    float determinant() const {
+    constexpr float determinant() const {
       return
         m[0][0] * (
           m[1][1] * (m[2][2] * m[3][3] - m[2][3] * m[3][2]) -
@@ -190,63 +297,354 @@ namespace EngineUtilities {
           );
     }
 
+    /**
+     * @brief Computes the inverse of a general matrix.
+     *
+     * Uses the adjugate (transposed cofactor matrix) divided by the determinant. The cofactors
+     * are built from the twelve 2x2 minors of the top and bottom row pairs, so each minor is
+     * computed once (about 100 flops in total).
+     *
+     * @param result Receives the inverse; left untouched if the matrix is singular.
+     * @return False if the matrix is singular (determinant equal to 0).
+     */
+    constexpr bool inverse(Matrix4x4& result) const {
+      // 2x2 minors of rows 0-1 (s) and rows 2-3 (c).
+      float s0 = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+      float s1 = m[0][0] * m[1][2] - m[1][0] * m[0][2];
+      float s2 = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+      float s3 = m[0][1] * m[1][2] - m[1][1] * m[0][2];
+      float s4 = m[0][1] * m[1][3] - m[1][1] * m[0][3];
+      float s5 = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+
+      float c5 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+      float c4 = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+      float c3 = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+      float c2 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+      float c1 = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+      float c0 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+
+      float det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+      if (det == 0.0f) {
+        return false;
+      }
+      float invDet = 1.0f / det;
+
+      result.m[0][0] = ( m[1][1] * c5 - m[1][2] * c4 + m[1][3] * c3) * invDet;
+      result.m[0][1] = (-m[0][1] * c5 + m[0][2] * c4 - m[0][3] * c3) * invDet;
+      result.m[0][2] = ( m[3][1] * s5 - m[3][2] * s4 + m[3][3] * s3) * invDet;
+      result.m[0][3] = (-m[2][1] * s5 + m[2][2] * s4 - m[2][3] * s3) * invDet;
+
+      result.m[1][0] = (-m[1][0] * c5 + m[1][2] * c2 - m[1][3] * c1) * invDet;
+      result.m[1][1] = ( m[0][0] * c5 - m[0][2] * c2 + m[0][3] * c1) * invDet;
+      result.m[1][2] = (-m[3][0] * s5 + m[3][2] * s2 - m[3][3] * s1) * invDet;
+      result.m[1][3] = ( m[2][0] * s5 - m[2][2] * s2 + m[2][3] * s1) * invDet;
+
+      result.m[2][0] = ( m[1][0] * c4 - m[1][1] * c2 + m[1][3] * c0) * invDet;
+      result.m[2][1] = (-m[0][0] * c4 + m[0][1] * c2 - m[0][3] * c0) * invDet;
+      result.m[2][2] = ( m[3][0] * s4 - m[3][1] * s2 + m[3][3] * s0) * invDet;
+      result.m[2][3] = (-m[2][0] * s4 + m[2][1] * s2 - m[2][3] * s0) * invDet;
+
+      result.m[3][0] = (-m[1][0] * c3 + m[1][1] * c1 - m[1][2] * c0) * invDet;
+      result.m[3][1] = ( m[0][0] * c3 - m[0][1] * c1 + m[0][2] * c0) * invDet;
+      result.m[3][2] = (-m[3][0] * s3 + m[3][1] * s1 - m[3][2] * s0) * invDet;
+      result.m[3][3] = ( m[2][0] * s3 - m[2][1] * s1 + m[2][2] * s0) * invDet;
+      return true;
+    }
+
     /**
      * @brief Computes the inverse of the matrix.
      *
+     * @return The inverse of the matrix, or the identity matrix if it is singular.
+     */
+    constexpr Matrix4x4 inverse() const {
+      Matrix4x4 result;
+      inverse(result);
+      return result;
+    }
+
+    /**
+     * @brief Computes the inverse of an affine matrix (last column equal to (0, 0, 0, 1)).
+     *
+     * Only the upper 3x3 block A is inverted: with rows a, b and c, the columns of A^-1 are
+     * b x c, c x a and a x b divided by det(A). The translation of the inverse is -t * A^-1.
+     * Valid for any mix of rotation, scale, shear and translation, but not for projections.
+     *
+     * @return The inverse, or the identity matrix if the 3x3 block is singular.
+     */
+    Matrix4x4 inverseAffine() const {
+#if ENGINE_MATH_SSE2
+      __m128 xyzMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+      __m128 a = _mm_and_ps(row(0), xyzMask);
+      __m128 b = _mm_and_ps(row(1), xyzMask);
+      __m128 c = _mm_and_ps(row(2), xyzMask);
+      __m128 bc = cross3(b, c);
+      __m128 ca = cross3(c, a);
+      __m128 ab = cross3(a, b);
+      __m128 det = dot3Splat(a, bc);
+      if (_mm_cvtss_f32(det) == 0.0f) {
+        return Matrix4x4();
+      }
+      __m128 invDet = _mm_div_ps(_mm_set1_ps(1.0f), det);
+      __m128 zero = _mm_setzero_ps();
+      _MM_TRANSPOSE4_PS(bc, ca, ab, zero);
+      return fromInverseRows(_mm_mul_ps(bc, invDet), _mm_mul_ps(ca, invDet), _mm_mul_ps(ab, invDet));
+#else
+      float c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+      float c01 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+      float c02 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+      float det = m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02;
+      if (det == 0.0f) {
+        return Matrix4x4();
+      }
+      float invDet = 1.0f / det;
+
+      Matrix4x4 result;
+      result.m[0][0] = c00 * invDet;
+      result.m[1][0] = c01 * invDet;
+      result.m[2][0] = c02 * invDet;
+      result.m[0][1] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * invDet;
+      result.m[1][1] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * invDet;
+      result.m[2][1] = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * invDet;
+      result.m[0][2] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * invDet;
+      result.m[1][2] = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * invDet;
+      result.m[2][2] = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * invDet;
+      result.setTranslationFromInverse(m[3][0], m[3][1], m[3][2]);
+      return result;
+#endif
+    }
+
+    /**
+     * @brief Computes the inverse of a rigid matrix (rotation and translation only).
+     *
+     * The inverse of an orthonormal rotation is its transpose, so this needs no division.
+     * The result is wrong if the matrix contains scale or shear; use inverseAffine() then.
+     *
      * @return The inverse of the matrix.
      */
-    
-    //Matrix4x4 inverse() const {
-    //  float det = determinant();
-    //  if (det == 0) {
-    //    // Return identity matrix for simplicity when the matrix is singular.
-    //    return Matrix4x4();
-    //  }
-
-    //  float invDet = 1.0f / det;
-
-    //  return Matrix4x4(
-    //    (m[1][1] * (m[2][2] * m[3][3] - m[2][3] * m[3][2]) -
-    //      m[1][2] * (m[2][1] * m[3][3] - m[2][3] * m[3][1]) +
-    //      m[1][3] * (m[2][1] * m[3][2] - m[2][2] * m[3][1])) * invDet,
-    //    -(m[0][1] * (m[2][2] * m[3][3] - m[2][3] * m[3][2]) -
-    //      m[0][2] * (m[2][1] * m[3][3] - m[2][3] * m[3][1]) +
-    //      m[0][3] * (m[2][1] * m[3][2] - m[2][2] * m[3][1])) * invDet,
-    //    (m[0][1] * (m[1][2] * m[3][3] - m[1][3] * m[3][2]) -
-    //      m[0][2] * (m[1][1] * m[3][3] - m[1][3] * m[3][1]) +
-    //      m[0][3] * (m[1][1] * m[3][2] - m[1][2] * m[3][1])) * invDet,
-    //    -(m[0][1] * (m[1][2] * m[2][3] - m[1][3] * m[2][2]) -
-    //      m[0][2] * (m[1][1] * m[2][3] - m[1][3] * m[2][1]) +
-    //      m[0][3] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])) * invDet,
-
-    //    -(m[1][0] * (m[2][2] * m[3][3] - m[2][3] * m[3][2]) -
-    //      m[1][2] * (m[2][0] * m[3][3] - m[2][3] * m[3][0]) +
-    //      m[1][3] * (m[2][0] * m[3][2] - m[2][2] * m[3][0])) * invDet,
-    //    (m[0][0] * (m[2][2] * m[3][3] - m[2][3] * m[3][2]) -
-    //      m[0][2] * (m[2][0] * m[3][3] - m[2][3] * m[3][0]) +
-    //      m[0][3] * (m[2][0] * m[3][2] - m[2][2] * m[3][0])) * invDet,
-    //    -(m[0][0] * (m[1][2] * m[3][3] - m[1][3] * m[3][2]) -
-    //      m[0][2] * (m[1][0] * m[3][3] - m[1][3] * m[3][0]) +
-    //      m[0][3] * (m[1][0] * m[3][2] - m[1][2] * m[3][0])) * invDet,
-    //    (m[0][0] * (m[1][2] * m[2][3] - m[1][3] * m[2][2]) -
-    //      m[0][2] * (m[1][0] * m[2][3] - m[1][3] * m[2][0]) +
-    //      m[0][3] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])) * invDet,
-
-    //    (m[1][0] * (m[2][1] * m[3][3] - m[2][3] * m[3][1]) -
-    //      m[1][1] * (m[2][0] * m[3][3] - m[2][3] * m[3][0]) +
-    //      m[1][3] * (m[2][0] * m[3][1] - m[2][1] * m[3][0])) * invDet,
-    //    -(m[0][0] * (m[2][1] * m[3][3] - m[2][3] * m[3][1]) -
-    //      m[0][1] * (m[2][0] * m[3][3] - m[2][3] * m[3][0]) +
-    //      m[0][3] * (m[2][0] * m[3][1] - m[2][1] * m[3][0])) * invDet,
-    //    (m[0][0] * (m[1][1] * m[3][3] - m[1][3] * m[3][1]) -
-    //      m[0][1] * (m[1][0] * m[3][3] - m[1][3] * m[3][0]) +
-    //      m[0][3] * (m[1][0] * m[3][1] - m[1][1] * m[3][0])) * invDet,
-    //    -(m[0][0] * (m[1][1] * m[2][3] - m[1][3] * m[2][1]) -
-    //      m[0][1] * (m[1][0] * m[2][3] - m[1][3] * m[2][0]) +
-    //      m[0][3] * (m[1][0] * m[2][1] - m[1][1] * m[2][0])) * invDet
-    //  );
-    //}
+    Matrix4x4 inverseRigid() const {
+#if ENGINE_MATH_SSE2
+      __m128 xyzMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+      __m128 r0 = _mm_and_ps(row(0), xyzMask);
+      __m128 r1 = _mm_and_ps(row(1), xyzMask);
+      __m128 r2 = _mm_and_ps(row(2), xyzMask);
+      __m128 r3 = _mm_setzero_ps();
+      _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+      return fromInverseRows(r0, r1, r2);
+#else
+      Matrix4x4 result;
+      for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+          result.m[i][j] = m[j][i];
+        }
+      }
+      result.setTranslationFromInverse(m[3][0], m[3][1], m[3][2]);
+      return result;
+#endif
+    }
+
+    /**
+     * @brief Transforms a point (w = 1) by an affine matrix.
+     *
+     * @param point The point to transform.
+     * @return point * M.
+     */
+    constexpr Vector3 transformPoint(const Vector3& point) const {
+      return Vector3(point.x * m[0][0] + point.y * m[1][0] + point.z * m[2][0] + m[3][0],
+                     point.x * m[0][1] + point.y * m[1][1] + point.z * m[2][1] + m[3][1],
+                     point.x * m[0][2] + point.y * m[1][2] + point.z * m[2][2] + m[3][2]);
+    }
+
+    /**
+     * @brief Transforms a direction (w = 0): translation is ignored.
+     *
+     * @param vector The direction to transform.
+     * @return vector * M.
+     */
+    constexpr Vector3 transformVector(const Vector3& vector) const {
+      return Vector3(vector.x * m[0][0] + vector.y * m[1][0] + vector.z * m[2][0],
+                     vector.x * m[0][1] + vector.y * m[1][1] + vector.z * m[2][1],
+                     vector.x * m[0][2] + vector.y * m[1][2] + vector.z * m[2][2]);
+    }
+
+    /**
+     * @brief Transforms an array of points (w = 1) by an affine matrix.
+     *
+     * The rows stay in registers for the whole array. The fourth column is ignored, so
+     * projective matrices need the Vector4 overload of TransformVectors.
+     *
+     * @param points The source points.
+     * @param out The destination (count elements); may be the same array as points.
+     * @param count The number of points.
+     */
+    void TransformPoints(const Vector3* points, Vector3* out, size_t count) const {
+#if ENGINE_MATH_SSE2
+      __m128 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+      for (size_t i = 0; i < count; ++i) {
+        storeVector3(out[i], combineRows(points[i], r0, r1, r2, r3));
+      }
+#else
+      for (size_t i = 0; i < count; ++i) {
+        out[i] = transformPoint(points[i]);
+      }
+#endif
+    }
+
+    /**
+     * @brief Transforms an array of directions (w = 0): translation is ignored.
+     *
+     * @param vectors The source directions.
+     * @param out The destination (count elements); may be the same array as vectors.
+     * @param count The number of directions.
+     */
+    void TransformVectors(const Vector3* vectors, Vector3* out, size_t count) const {
+#if ENGINE_MATH_SSE2
+      __m128 r0 = row(0), r1 = row(1), r2 = row(2);
+      for (size_t i = 0; i < count; ++i) {
+        storeVector3(out[i], combineRows(vectors[i], r0, r1, r2, _mm_setzero_ps()));
+      }
+#else
+      for (size_t i = 0; i < count; ++i) {
+        out[i] = transformVector(vectors[i]);
+      }
+#endif
+    }
+
+    /**
+     * @brief Transforms an array of 4D vectors (full v * M, valid for projections).
+     *
+     * @param vectors The source vectors.
+     * @param out The destination (count elements); may be the same array as vectors.
+     * @param count The number of vectors.
+     */
+    void TransformVectors(const Vector4* vectors, Vector4* out, size_t count) const {
+#if ENGINE_MATH_SSE2
+      __m128 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+      for (size_t i = 0; i < count; ++i) {
+        out[i] = Vector4(combineRows(vectors[i].toSIMD(), r0, r1, r2, r3));
+      }
+#else
+      for (size_t i = 0; i < count; ++i) {
+        const Vector4& v = vectors[i];
+        out[i] = Vector4(v.x * m[0][0] + v.y * m[1][0] + v.z * m[2][0] + v.w * m[3][0],
+                         v.x * m[0][1] + v.y * m[1][1] + v.z * m[2][1] + v.w * m[3][1],
+                         v.x * m[0][2] + v.y * m[1][2] + v.z * m[2][2] + v.w * m[3][2],
+                         v.x * m[0][3] + v.y * m[1][3] + v.z * m[2][3] + v.w * m[3][3]);
+      }
+#endif
+    }
+
+    /**
+     * @brief Transforms SoA blocks of points (w = 1) by an affine matrix.
+     *
+     * Eight points per step with AVX2; this is the fastest path for large arrays.
+     *
+     * @param points The source blocks.
+     * @param out The destination blocks; may be the same array as points.
+     * @param blockCount The number of blocks.
+     */
+    void TransformPoints(const Vector3x8* points, Vector3x8* out, size_t blockCount) const {
+      transformBlocks(points, out, blockCount, 1.0f);
+    }
+
+    /**
+     * @brief Transforms SoA blocks of directions (w = 0): translation is ignored.
+     *
+     * @param vectors The source blocks.
+     * @param out The destination blocks; may be the same array as vectors.
+     * @param blockCount The number of blocks.
+     */
+    void TransformVectors(const Vector3x8* vectors, Vector3x8* out, size_t blockCount) const {
+      transformBlocks(vectors, out, blockCount, 0.0f);
+    }
 
+  private:
+    /**
+     * @brief Writes -t * A^-1 into the translation row, where A^-1 is already in rows 0-2.
+     */
+    constexpr void setTranslationFromInverse(float tx, float ty, float tz) {
+      for (int j = 0; j < 3; ++j) {
+        m[3][j] = -(tx * m[0][j] + ty * m[1][j] + tz * m[2][j]);
+      }
+      m[0][3] = 0; m[1][3] = 0; m[2][3] = 0; m[3][3] = 1;
+    }
 
+#if ENGINE_MATH_SSE2
+    /**
+     * @brief Builds an affine inverse from the rows of A^-1 (w lanes equal to 0) and this translation.
+     */
+    Matrix4x4 fromInverseRows(__m128 i0, __m128 i1, __m128 i2) const {
+      __m128 translation = combineRows(Vector3(m[3][0], m[3][1], m[3][2]), i0, i1, i2, _mm_setzero_ps());
+      Matrix4x4 result;
+      result.setRow(0, i0);
+      result.setRow(1, i1);
+      result.setRow(2, i2);
+      result.setRow(3, _mm_sub_ps(_mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f), translation));
+      return result;
+    }
+
+    /**
+     * @brief Cross product of the xyz lanes; the w lane of the result is 0 when both w lanes are 0.
+     */
+    static __m128 cross3(__m128 u, __m128 v) {
+      __m128 uYzx = _mm_shuffle_ps(u, u, _MM_SHUFFLE(3, 0, 2, 1));
+      __m128 vYzx = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 0, 2, 1));
+      __m128 zxy = _mm_sub_ps(_mm_mul_ps(u, vYzx), _mm_mul_ps(uYzx, v));
+      return _mm_shuffle_ps(zxy, zxy, _MM_SHUFFLE(3, 0, 2, 1));
+    }
+
+    /**
+     * @brief Dot product of the xyz lanes broadcast to every lane (w lanes must be 0).
+     */
+    static __m128 dot3Splat(__m128 u, __m128 v) {
+      __m128 product = _mm_mul_ps(u, v);
+      __m128 pairs = _mm_add_ps(product, _mm_shuffle_ps(product, product, _MM_SHUFFLE(1, 0, 3, 2)));
+      return _mm_add_ps(pairs, _mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+
+    /**
+     * @brief v.x * r0 + v.y * r1 + v.z * r2 + v.w * r3, summed as two pairs to halve the dependency chain.
+     */
+    static __m128 combineRows(__m128 v, __m128 r0, __m128 r1, __m128 r2, __m128 r3) {
+      __m128 low = _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)), r0);
+      __m128 high = _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)), r2);
+      low = MathDetail::mulAdd4(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)), r1, low);
+      high = MathDetail::mulAdd4(_mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)), r3, high);
+      return _mm_add_ps(low, high);
+    }
+
+    /**
+     * @brief p.x * r0 + p.y * r1 + p.z * r2 + r3 for a packed Vector3.
+     */
+    static __m128 combineRows(const Vector3& p, __m128 r0, __m128 r1, __m128 r2, __m128 r3) {
+      __m128 result = MathDetail::mulAdd4(_mm_set1_ps(p.x), r0, r3);
+      result = MathDetail::mulAdd4(_mm_set1_ps(p.y), r1, result);
+      return MathDetail::mulAdd4(_mm_set1_ps(p.z), r2, result);
+    }
+
+    /**
+     * @brief Stores the three low lanes into a packed Vector3.
+     */
+    static void storeVector3(Vector3& out, __m128 value) {
+      _mm_storel_pi(reinterpret_cast<__m64*>(&out.x), value);
+      _mm_store_ss(&out.z, _mm_movehl_ps(value, value));
+    }
+#endif
+
+    void transformBlocks(const Vector3x8* in, Vector3x8* out, size_t blockCount, float w) const {
+      using namespace MathDetail;
+      Float8 m00 = splat8(m[0][0]), m01 = splat8(m[0][1]), m02 = splat8(m[0][2]);
+      Float8 m10 = splat8(m[1][0]), m11 = splat8(m[1][1]), m12 = splat8(m[1][2]);
+      Float8 m20 = splat8(m[2][0]), m21 = splat8(m[2][1]), m22 = splat8(m[2][2]);
+      Float8 t0 = splat8(m[3][0] * w), t1 = splat8(m[3][1] * w), t2 = splat8(m[3][2] * w);
+      for (size_t i = 0; i < blockCount; ++i) {
+        Float8 x = load8(in[i].x), y = load8(in[i].y), z = load8(in[i].z);
+        Float8 rx = mulAdd(z, m20, mulAdd(y, m10, mulAdd(x, m00, t0)));
+        Float8 ry = mulAdd(z, m21, mulAdd(y, m11, mulAdd(x, m01, t1)));
+        Float8 rz = mulAdd(z, m22, mulAdd(y, m12, mulAdd(x, m02, t2)));
+        store8(out[i].x, rx);
+        store8(out[i].y, ry);
+        store8(out[i].z, rz);
+      }
+    }
   };
-}
\ No newline at end of file
+}
@@ -0,0 +1,339 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string>
+#include "Utilities/Memory/TMemoryTracker.h"
+#include "Utilities/Structures/TArray.h"
+
+namespace EngineUtilities {
+	/**
+	 * @brief Arena lineal (bump allocator) para datos que solo viven durante un frame.
+	 *
+	 * Reservar es avanzar un cursor; liberar no hace nada salvo que sea la ltima reserva,
+	 * que se deshace. Todo se libera de golpe con reset(). Si un frame no cabe en el bloque
+	 * principal se encadenan bloques extra, y en el siguiente reset() el bloque principal
+	 * crece hasta el total usado, de modo que en rgimen estable no se llama a malloc.
+	 *
+	 * No es thread-safe: pensada para el hilo principal.
+	 */
+	class FrameArena
+	{
+	public:
+		/**
+		 * @brief Constructor.
+		 *
+		 * @param InitialCapacity Bytes del bloque principal.
+		 */
+		explicit FrameArena(size_t InitialCapacity) : Head(nullptr), Current(nullptr),
+			Cursor(nullptr), End(nullptr), LastAllocation(nullptr), Used(0), Peak(0)
+		{
+			Head = newChunk(InitialCapacity);
+			setCurrent(Head);
+		}
+
+		FrameArena(const FrameArena&) = delete;
+		FrameArena& operator=(const FrameArena&) = delete;
+
+		/**
+		 * @brief Destructor. Libera todos los bloques.
+		 */
+		~FrameArena()
+		{
+			freeChunks(Head);
+		}
+
+		/**
+		 * @brief Reserva Bytes con la alineacin indicada (potencia de dos).
+		 *
+		 * @return Puntero a memoria sin inicializar, vlido hasta el prximo reset().
+		 */
+		void* allocate(size_t Bytes, size_t Alignment = alignof(std::max_align_t))
+		{
+			unsigned char* Aligned = alignUp(Cursor, Alignment);
+			if (Aligned + Bytes > End)
+			{
+				size_t ChunkSize = Head->Size > Bytes + Alignment ? Head->Size : Bytes + Alignment;
+				Chunk* Extra = newChunk(ChunkSize);
+				Current->Next = Extra;
+				setCurrent(Extra);
+				Aligned = alignUp(Cursor, Alignment);
+			}
+			Used += static_cast<size_t>(Aligned + Bytes - Cursor);
+			Cursor = Aligned + Bytes;
+			LastAllocation = Aligned;
+			return Aligned;
+		}
+
+		/**
+		 * @brief Devuelve memoria a la arena. Solo tiene efecto si es la ltima reserva.
+		 */
+		void deallocate(void* Block, size_t Bytes)
+		{
+			if (Block && Block == LastAllocation)
+			{
+				Used -= static_cast<size_t>(Cursor - LastAllocation);
+				Cursor = LastAllocation;
+				LastAllocation = nullptr;
+			}
+			(void)Bytes;
+		}
+
+		/**
+		 * @brief Invalida todas las reservas. Si hubo bloques extra, los funde en uno ms grande.
+		 */
+		void reset()
+		{
+			if (Used > Peak)
+			{
+				Peak = Used;
+			}
+			if (Head->Next)
+			{
+				size_t Total = 0;
+				for (Chunk* It = Head; It; It = It->Next)
+				{
+					Total += It->Size;
+				}
+				freeChunks(Head);
+				Head = newChunk(Total);
+			}
+			setCurrent(Head);
+			LastAllocation = nullptr;
+			Used = 0;
+		}
+
+		/**
+		 * @brief Bytes usados desde el ltimo reset().
+		 */
+		size_t bytesUsed() const { return Used; }
+
+		/**
+		 * @brief Mximo de bytes usados en un frame hasta ahora.
+		 */
+		size_t peakBytes() const { return Used > Peak ? Used : Peak; }
+
+		/**
+		 * @brief Bytes del bloque principal.
+		 */
+		size_t capacity() const { return Head->Size; }
+
+	private:
+		/**
+		 * @brief Cabecera de cada bloque; los datos van justo detrs.
+		 */
+		struct alignas(std::max_align_t) Chunk
+		{
+			Chunk* Next;
+			size_t Size;
+		};
+
+		static Chunk* newChunk(size_t Size)
+		{
+			Chunk* NewChunk = static_cast<Chunk*>(::operator new(sizeof(Chunk) + Size));
+			MemoryTracker::recordAllocation(MemoryTag::Frame, sizeof(Chunk) + Size);
+			NewChunk->Next = nullptr;
+			NewChunk->Size = Size;
+			return NewChunk;
+		}
+
+		static void freeChunks(Chunk* First)
+		{
+			while (First)
+			{
+				Chunk* Next = First->Next;
+				MemoryTracker::recordFree(MemoryTag::Frame, sizeof(Chunk) + First->Size);
+				::operator delete(First);
+				First = Next;
+			}
+		}
+
+		static unsigned char* alignUp(unsigned char* Pointer, size_t Alignment)
+		{
+			uintptr_t Address = reinterpret_cast<uintptr_t>(Pointer);
+			return Pointer + (((Address + Alignment - 1) & ~(uintptr_t)(Alignment - 1)) - Address);
+		}
+
+		void setCurrent(Chunk* Target)
+		{
+			Current = Target;
+			Cursor = reinterpret_cast<unsigned char*>(Target + 1);
+			End = Cursor + Target->Size;
+		}
+
+		Chunk* Head;                    ///< Bloque principal (primero de la lista).
+		Chunk* Current;                 ///< Bloque del que se est reservando.
+		unsigned char* Cursor;          ///< Siguiente byte libre en Current.
+		unsigned char* End;             ///< Fin de Current.
+		unsigned char* LastAllocation;  ///< ltima reserva, para poder deshacerla.
+		size_t Used;                    ///< Bytes usados en este frame (incluye relleno de alineacin).
+		size_t Peak;                    ///< Mximo de Used en frames anteriores.
+	};
+
+	/**
+	 * @brief Asignador por frame con doble buffer.
+	 *
+	 * Mantiene dos arenas: la del frame actual y la del anterior. beginFrame() cambia de arena
+	 * y limpia la nueva, as que los datos de un frame siguen siendo vlidos durante el frame
+	 * siguiente (por ejemplo, para que el render los consuma) y nunca ms.
+	 *
+	 * Se usa desde el hilo principal a travs de FrameAllocator::get().
+	 */
+	class FrameAllocator
+	{
+	public:
+		static const size_t DefaultFrameSize = 256 * 1024; ///< Bytes iniciales por arena.
+
+		explicit FrameAllocator(size_t FrameSize = DefaultFrameSize)
+			: Arenas{ FrameArena(FrameSize), FrameArena(FrameSize) }, CurrentIndex(0), FrameIndex(0) {}
+
+		/**
+		 * @brief Instancia global usada por TFrameStlAllocator y TFrameArrayAllocator.
+		 */
+		static FrameAllocator& get()
+		{
+			static FrameAllocator Instance;
+			return Instance;
+		}
+
+		/**
+		 * @brief Empieza un frame nuevo: cambia de arena y libera lo que se reserv hace dos frames.
+		 */
+		void beginFrame()
+		{
+			CurrentIndex ^= 1;
+			Arenas[CurrentIndex].reset();
+			++FrameIndex;
+		}
+
+		void* allocate(size_t Bytes, size_t Alignment = alignof(std::max_align_t))
+		{
+			return Arenas[CurrentIndex].allocate(Bytes, Alignment);
+		}
+
+		void deallocate(void* Block, size_t Bytes)
+		{
+			Arenas[CurrentIndex].deallocate(Block, Bytes);
+		}
+
+		/**
+		 * @brief Arena del frame actual.
+		 */
+		FrameArena& currentArena() { return Arenas[CurrentIndex]; }
+		const FrameArena& currentArena() const { return Arenas[CurrentIndex]; }
+
+		/**
+		 * @brief Nmero de frames empezados desde el arranque.
+		 */
+		uint64_t frameIndex() const { return FrameIndex; }
+
+	private:
+		FrameArena Arenas[2];   ///< Arenas del frame actual y del anterior.
+		uint32_t CurrentIndex;  ///< ndice de la arena del frame actual.
+		uint64_t FrameIndex;    ///< Contador de frames.
+	};
+
+	/**
+	 * @brief Adaptador con la interfaz de asignador de la STL que reserva en el frame actual.
+	 *
+	 * Los contenedores que lo usan no deben vivir ms de un frame despus del que los cre.
+	 *
+	 * @tparam T Tipo de los elementos.
+	 */
+	template<typename T>
+	class TFrameStlAllocator
+	{
+	public:
+		using value_type = T;
+
+		TFrameStlAllocator() noexcept = default;
+
+		template<typename U>
+		TFrameStlAllocator(const TFrameStlAllocator<U>&) noexcept {}
+
+		T* allocate(size_t Count)
+		{
+			return static_cast<T*>(FrameAllocator::get().allocate(Count * sizeof(T), alignof(T)));
+		}
+
+		void deallocate(T* Block, size_t Count) noexcept
+		{
+			FrameAllocator::get().deallocate(Block, Count * sizeof(T));
+		}
+
+		template<typename U>
+		bool operator==(const TFrameStlAllocator<U>&) const noexcept { return true; }
+
+		template<typename U>
+		bool operator!=(const TFrameStlAllocator<U>&) const noexcept { return false; }
+	};
+
+	/**
+	 * @brief Poltica de TArray que reserva en el frame actual.
+	 */
+	struct TFrameArrayAllocator
+	{
+		static void* Allocate(size_t Bytes, size_t Alignment)
+		{
+			return FrameAllocator::get().allocate(Bytes, Alignment);
+		}
+
+		static void Deallocate(void* Block, size_t Bytes, size_t /*Alignment*/)
+		{
+			FrameAllocator::get().deallocate(Block, Bytes);
+		}
+	};
+
+	/**
+	 * @brief Contenedores temporales que viven en el asignador por frame.
+	 */
+	template<typename T>
+	using TFrameArray = TArray<T, TFrameArrayAllocator>;
+
+	using TFrameString = std::basic_string<char, std::char_traits<char>, TFrameStlAllocator<char>>;
+
+	// EXAMPLE
+
+	/*
+	void Update()
+	{
+		FrameAllocator::get().beginFrame();
+
+		TFrameArray<int> VisibleIds;
+		VisibleIds.Reserve(128);
+		VisibleIds.Add(42);
+
+		TFrameString Label("Actor");
+		Label += "##0";
+	}
+	*/
+}
@@ -0,0 +1,445 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <new>
+#include <ostream>
+#include <type_traits>
+
+/**
+ * @brief Activa el seguimiento de memoria por etiqueta (1 por defecto, tambin en builds de produccin).
+ */
+#ifndef ENGINE_MEMORY_TRACKING
+#define ENGINE_MEMORY_TRACKING 1
+#endif
+
+namespace EngineUtilities {
+	/**
+	 * @brief Subsistema al que se atribuye una reserva de memoria.
+	 */
+	enum class MemoryTag : uint8_t
+	{
+		General,     ///< Sin etiqueta concreta.
+		Containers,  ///< TArray, TInlineArray y dems contenedores del heap.
+		Components,  ///< Componentes del ECS.
+		Actors,      ///< Entidades y actores.
+		Meshes,      ///< Vrtices e ndices de las mallas en CPU (MeshComponent).
+		Textures,    ///< Texturas creadas con Texture::init (tamao del recurso de D3D11).
+		UI,          ///< ImGui.
+		Frame,       ///< Bloques del asignador por frame.
+		Count
+	};
+
+	/**
+	 * @brief Etiqueta de memoria de un tipo.
+	 *
+	 * Un tipo (o su clase base) puede declarar
+	 * `static constexpr EngineUtilities::MemoryTag EngineMemoryTag = ...;`
+	 * para que MakeShared y MakeUnique le atribuyan sus reservas. Si no, se usa General.
+	 */
+	template<typename T, typename = void>
+	struct TMemoryTagOf
+	{
+		static constexpr MemoryTag value = MemoryTag::General;
+	};
+
+	template<typename T>
+	struct TMemoryTagOf<T, std::void_t<decltype(T::EngineMemoryTag)>>
+	{
+		static constexpr MemoryTag value = T::EngineMemoryTag;
+	};
+
+	/**
+	 * @brief Estadsticas de una etiqueta.
+	 */
+	struct MemoryTagStats
+	{
+		MemoryTag Tag;              ///< Etiqueta.
+		int64_t LiveBytes;          ///< Bytes vivos ahora.
+		int64_t PeakBytes;          ///< Mximo de bytes vivos observado al final de cada frame.
+		uint64_t Allocations;       ///< Reservas totales.
+		uint64_t Frees;             ///< Liberaciones totales.
+		uint64_t FrameAllocations;  ///< Reservas durante el ltimo frame completo.
+		uint64_t FrameBytes;        ///< Bytes reservados durante el ltimo frame completo.
+		uint64_t BudgetBytes;       ///< Presupuesto (0 = sin lmite).
+		bool OverBudget;            ///< LiveBytes supera el presupuesto.
+	};
+
+	/**
+	 * @brief Seguimiento de memoria por etiqueta.
+	 *
+	 * Cada hilo escribe en sus propios contadores (atmicos con un nico escritor: una carga y
+	 * un store relaxed, sin bloqueos ni contencin). Leer las estadsticas suma los contadores
+	 * de todos los hilos. endFrame() se llama una vez por frame desde el hilo principal para
+	 * calcular el ritmo por frame y el pico.
+	 */
+	class MemoryTracker
+	{
+	public:
+		static const uint32_t TagCount = static_cast<uint32_t>(MemoryTag::Count);
+
+		/**
+		 * @brief Instancia global. No se destruye nunca, para poder registrar liberaciones al salir.
+		 */
+		static MemoryTracker& get()
+		{
+			static MemoryTracker* Instance = new MemoryTracker();
+			return *Instance;
+		}
+
+		/**
+		 * @brief Registra una reserva de Bytes con la etiqueta indicada.
+		 */
+		static void recordAllocation(MemoryTag Tag, size_t Bytes)
+		{
+#if ENGINE_MEMORY_TRACKING
+			ThreadCounters& Counters = threadCounters();
+			uint32_t Index = static_cast<uint32_t>(Tag);
+			bump(Counters.AllocatedBytes[Index], Bytes);
+			bump(Counters.Allocations[Index], 1);
+#else
+			(void)Tag;
+			(void)Bytes;
+#endif
+		}
+
+		/**
+		 * @brief Registra una liberacin de Bytes con la etiqueta indicada.
+		 */
+		static void recordFree(MemoryTag Tag, size_t Bytes)
+		{
+#if ENGINE_MEMORY_TRACKING
+			ThreadCounters& Counters = threadCounters();
+			uint32_t Index = static_cast<uint32_t>(Tag);
+			bump(Counters.FreedBytes[Index], Bytes);
+			bump(Counters.Frees[Index], 1);
+#else
+			(void)Tag;
+			(void)Bytes;
+#endif
+		}
+
+		/**
+		 * @brief Cierra el frame: calcula reservas y bytes del frame y actualiza los picos.
+		 *
+		 * Solo desde el hilo principal.
+		 */
+		void endFrame()
+		{
+			Totals Current[TagCount];
+			sum(Current);
+			for (uint32_t i = 0; i < TagCount; ++i)
+			{
+				TagSample& Sample = Samples[i];
+				Sample.FrameAllocations = Current[i].Allocations - Sample.LastAllocations;
+				Sample.FrameBytes = Current[i].AllocatedBytes - Sample.LastAllocatedBytes;
+				Sample.LastAllocations = Current[i].Allocations;
+				Sample.LastAllocatedBytes = Current[i].AllocatedBytes;
+
+				int64_t Live = Current[i].live();
+				if (Live > Sample.PeakBytes.load(std::memory_order_relaxed))
+				{
+					Sample.PeakBytes.store(Live, std::memory_order_relaxed);
+				}
+			}
+		}
+
+		/**
+		 * @brief Estadsticas actuales de una etiqueta.
+		 */
+		MemoryTagStats stats(MemoryTag Tag) const
+		{
+			Totals Current[TagCount];
+			sum(Current);
+			return makeStats(Tag, Current[static_cast<uint32_t>(Tag)]);
+		}
+
+		/**
+		 * @brief Estadsticas de todas las etiquetas, indexadas por MemoryTag.
+		 */
+		void snapshot(MemoryTagStats (&Out)[TagCount]) const
+		{
+			Totals Current[TagCount];
+			sum(Current);
+			for (uint32_t i = 0; i < TagCount; ++i)
+			{
+				Out[i] = makeStats(static_cast<MemoryTag>(i), Current[i]);
+			}
+		}
+
+		/**
+		 * @brief Fija el presupuesto de una etiqueta en bytes (0 = sin lmite).
+		 */
+		void setBudget(MemoryTag Tag, uint64_t Bytes)
+		{
+			Budgets[static_cast<uint32_t>(Tag)].store(Bytes, std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Indica si alguna etiqueta supera su presupuesto.
+		 */
+		bool anyOverBudget() const
+		{
+			MemoryTagStats All[TagCount];
+			snapshot(All);
+			for (const MemoryTagStats& Stats : All)
+			{
+				if (Stats.OverBudget)
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		/**
+		 * @brief Escribe un informe en texto con una lnea por etiqueta (til sin interfaz).
+		 */
+		void writeReport(std::ostream& Out) const
+		{
+			MemoryTagStats All[TagCount];
+			snapshot(All);
+			Out << std::left << std::setw(12) << "Tag" << std::right
+			    << std::setw(14) << "Live(B)" << std::setw(14) << "Peak(B)" << std::setw(12) << "Allocs"
+			    << std::setw(14) << "Allocs/frame" << std::setw(14) << "Bytes/frame" << std::setw(14) << "Budget(B)" << '\n';
+			for (const MemoryTagStats& Stats : All)
+			{
+				Out << std::left << std::setw(12) << tagName(Stats.Tag) << std::right
+				    << std::setw(14) << Stats.LiveBytes << std::setw(14) << Stats.PeakBytes << std::setw(12) << Stats.Allocations
+				    << std::setw(14) << Stats.FrameAllocations << std::setw(14) << Stats.FrameBytes << std::setw(14) << Stats.BudgetBytes
+				    << (Stats.OverBudget ? "  OVER BUDGET" : "") << '\n';
+			}
+		}
+
+		/**
+		 * @brief Nombre legible de una etiqueta.
+		 */
+		static const char* tagName(MemoryTag Tag)
+		{
+			static const char* const Names[TagCount] = {
+				"General", "Containers", "Components", "Actors", "Meshes", "Textures", "UI", "Frame"
+			};
+			uint32_t Index = static_cast<uint32_t>(Tag);
+			return Index < TagCount ? Names[Index] : "Unknown";
+		}
+
+	private:
+		/**
+		 * @brief Contadores de un hilo. Solo ese hilo escribe; cualquiera puede leer.
+		 */
+		struct ThreadCounters
+		{
+			std::atomic<uint64_t> AllocatedBytes[TagCount] = {};
+			std::atomic<uint64_t> FreedBytes[TagCount] = {};
+			std::atomic<uint64_t> Allocations[TagCount] = {};
+			std::atomic<uint64_t> Frees[TagCount] = {};
+			ThreadCounters* Next = nullptr;
+		};
+
+		/**
+		 * @brief Suma de los contadores de todos los hilos para una etiqueta.
+		 */
+		struct Totals
+		{
+			uint64_t AllocatedBytes = 0;
+			uint64_t FreedBytes = 0;
+			uint64_t Allocations = 0;
+			uint64_t Frees = 0;
+
+			int64_t live() const { return static_cast<int64_t>(AllocatedBytes - FreedBytes); }
+		};
+
+		/**
+		 * @brief Datos calculados en endFrame().
+		 */
+		struct TagSample
+		{
+			std::atomic<int64_t> PeakBytes{ 0 };
+			uint64_t LastAllocations = 0;
+			uint64_t LastAllocatedBytes = 0;
+			uint64_t FrameAllocations = 0;
+			uint64_t FrameBytes = 0;
+		};
+
+		MemoryTracker() : Threads(nullptr) {}
+
+		/**
+		 * @brief Suma sin RMW: el hilo actual es el nico que escribe este contador.
+		 */
+		static void bump(std::atomic<uint64_t>& Counter, uint64_t Amount)
+		{
+			Counter.store(Counter.load(std::memory_order_relaxed) + Amount, std::memory_order_relaxed);
+		}
+
+		static ThreadCounters& threadCounters()
+		{
+			thread_local ThreadCounters* Counters = get().registerThread();
+			return *Counters;
+		}
+
+		/**
+		 * @brief Crea los contadores del hilo actual y los aade a la lista (solo push, sin bloqueos).
+		 *
+		 * Los contadores no se liberan al terminar el hilo: sus totales siguen contando.
+		 */
+		ThreadCounters* registerThread()
+		{
+			ThreadCounters* Counters = new ThreadCounters();
+			Counters->Next = Threads.load(std::memory_order_relaxed);
+			while (!Threads.compare_exchange_weak(Counters->Next, Counters,
+			                                      std::memory_order_release,
+			                                      std::memory_order_relaxed))
+			{
+			}
+			return Counters;
+		}
+
+		void sum(Totals (&Out)[TagCount]) const
+		{
+			for (ThreadCounters* It = Threads.load(std::memory_order_acquire); It; It = It->Next)
+			{
+				for (uint32_t i = 0; i < TagCount; ++i)
+				{
+					Out[i].AllocatedBytes += It->AllocatedBytes[i].load(std::memory_order_relaxed);
+					Out[i].FreedBytes += It->FreedBytes[i].load(std::memory_order_relaxed);
+					Out[i].Allocations += It->Allocations[i].load(std::memory_order_relaxed);
+					Out[i].Frees += It->Frees[i].load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		MemoryTagStats makeStats(MemoryTag Tag, const Totals& Current) const
+		{
+			uint32_t Index = static_cast<uint32_t>(Tag);
+			const TagSample& Sample = Samples[Index];
+			MemoryTagStats Stats;
+			Stats.Tag = Tag;
+			Stats.LiveBytes = Current.live();
+			int64_t Peak = Sample.PeakBytes.load(std::memory_order_relaxed);
+			Stats.PeakBytes = Stats.LiveBytes > Peak ? Stats.LiveBytes : Peak;
+			Stats.Allocations = Current.Allocations;
+			Stats.Frees = Current.Frees;
+			Stats.FrameAllocations = Sample.FrameAllocations;
+			Stats.FrameBytes = Sample.FrameBytes;
+			Stats.BudgetBytes = Budgets[Index].load(std::memory_order_relaxed);
+			Stats.OverBudget = Stats.BudgetBytes && Stats.LiveBytes > static_cast<int64_t>(Stats.BudgetBytes);
+			return Stats;
+		}
+
+		std::atomic<ThreadCounters*> Threads;        ///< Contadores de cada hilo que ha reservado algo.
+		TagSample Samples[TagCount];                 ///< Datos por frame (hilo principal).
+		std::atomic<uint64_t> Budgets[TagCount] = {};  ///< Presupuesto por etiqueta.
+	};
+
+	/**
+	 * @brief Poltica de memoria del heap, alineada y atribuida a una etiqueta.
+	 *
+	 * Sirve como poltica de TArray: TArray<Vertex, TTaggedHeapAllocator<MemoryTag::Meshes>>.
+	 */
+	template<MemoryTag Tag>
+	struct TTaggedHeapAllocator
+	{
+		static void* Allocate(size_t Bytes, size_t Alignment)
+		{
+			void* Block = ::operator new(Bytes, std::align_val_t(Alignment));
+			MemoryTracker::recordAllocation(Tag, Bytes);
+			return Block;
+		}
+
+		static void Deallocate(void* Block, size_t Bytes, size_t Alignment)
+		{
+			MemoryTracker::recordFree(Tag, Bytes);
+			::operator delete(Block, std::align_val_t(Alignment));
+		}
+	};
+
+	/**
+	 * @brief Adaptador con la interfaz de asignador de la STL que atribuye sus reservas a una etiqueta.
+	 *
+	 * Para contenedores de la STL que deben contar en el seguimiento, por ejemplo
+	 * std::vector<SimpleVertex, TTaggedStlAllocator<SimpleVertex, MemoryTag::Meshes>>.
+	 *
+	 * @tparam T Tipo de los elementos.
+	 * @tparam Tag Etiqueta a la que se atribuyen las reservas.
+	 */
+	template<typename T, MemoryTag Tag>
+	class TTaggedStlAllocator
+	{
+	public:
+		using value_type = T;
+
+		template<typename U>
+		struct rebind
+		{
+			using other = TTaggedStlAllocator<U, Tag>;
+		};
+
+		TTaggedStlAllocator() noexcept = default;
+
+		template<typename U>
+		TTaggedStlAllocator(const TTaggedStlAllocator<U, Tag>&) noexcept {}
+
+		T* allocate(size_t Count)
+		{
+			T* Block = static_cast<T*>(::operator new(Count * sizeof(T)));
+			MemoryTracker::recordAllocation(Tag, Count * sizeof(T));
+			return Block;
+		}
+
+		void deallocate(T* Block, size_t Count) noexcept
+		{
+			MemoryTracker::recordFree(Tag, Count * sizeof(T));
+			::operator delete(Block);
+		}
+
+		template<typename U>
+		bool operator==(const TTaggedStlAllocator<U, Tag>&) const noexcept { return true; }
+
+		template<typename U>
+		bool operator!=(const TTaggedStlAllocator<U, Tag>&) const noexcept { return false; }
+	};
+
+	// EXAMPLE
+
+	/*
+	MemoryTracker::get().setBudget(MemoryTag::Components, 64 * 1024 * 1024);
+
+	// Una vez por frame:
+	MemoryTracker::get().endFrame();
+
+	if (MemoryTracker::get().anyOverBudget())
+	{
+		MemoryTracker::get().writeReport(std::cerr);
+	}
+	*/
+}
@@ -0,0 +1,449 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace EngineUtilities {
+	/**
+	 * @brief Pool de bloques de tamao fijo con lista libre, cachs por hilo y recarga global sin bloqueos.
+	 *
+	 * La memoria se reserva en chunks contiguos de SlotsPerChunk bloques que no se devuelven al
+	 * sistema hasta destruir el pool, as que los objetos del mismo tipo quedan juntos en memoria.
+	 *
+	 * - Cada hilo tiene una cach (lista libre propia): reservar y liberar son O(1) y sin atmicos.
+	 * - Cuando la cach se vaca se recarga desde una pila global de lotes (batches) sin bloqueos.
+	 *   La cabeza de la pila lleva una etiqueta que cambia en cada operacin para evitar el problema ABA.
+	 * - Cuando la cach acumula demasiados bloques, devuelve un lote a la pila global.
+	 * - Solo el crecimiento (un chunk nuevo) toma un mutex.
+	 *
+	 * Todos los objetos deben haberse liberado antes de destruir el pool.
+	 */
+	class FixedBlockPool
+	{
+	public:
+		static const uint32_t MaxCachedPools = 64;  ///< Pools vivos con cach por hilo; el resto usa solo la pila global.
+
+		// La cabeza de la pila global guarda el puntero en los bits bajos y una etiqueta en los altos:
+		// en 64 bits las direcciones de usuario caben en 48 bits, en 32 bits se usa un entero de 64.
+		static constexpr unsigned TagShift = sizeof(void*) == 8 ? 48 : 32;
+		static constexpr uint64_t PointerMask = (uint64_t(1) << TagShift) - 1;
+
+		/**
+		 * @brief Constructor.
+		 *
+		 * @param InSlotSize Bytes de cada bloque.
+		 * @param InSlotAlignment Alineacin de cada bloque (potencia de dos).
+		 * @param InSlotsPerChunk Bloques por chunk.
+		 */
+		FixedBlockPool(size_t InSlotSize, size_t InSlotAlignment, size_t InSlotsPerChunk = 256)
+			: SlotAlignment(InSlotAlignment > alignof(FreeNode) ? InSlotAlignment : alignof(FreeNode)),
+			  SlotSize(0), SlotsPerChunk(InSlotsPerChunk ? InSlotsPerChunk : 1),
+			  BatchSize(InSlotsPerChunk < 64 ? (InSlotsPerChunk ? InSlotsPerChunk : 1) : 64),
+			  GlobalBatches(0), Serial(nextSerial()), CacheIndex(MaxCachedPools)
+		{
+			size_t Size = InSlotSize > sizeof(FreeNode) ? InSlotSize : sizeof(FreeNode);
+			SlotSize = (Size + SlotAlignment - 1) & ~(SlotAlignment - 1);
+
+			for (uint32_t i = 0; i < MaxCachedPools; ++i)
+			{
+				uint64_t Expected = 0;
+				if (registry()[i].compare_exchange_strong(Expected, Serial, std::memory_order_acq_rel))
+				{
+					CacheIndex = i;
+					break;
+				}
+			}
+		}
+
+		FixedBlockPool(const FixedBlockPool&) = delete;
+		FixedBlockPool& operator=(const FixedBlockPool&) = delete;
+
+		/**
+		 * @brief Destructor. Libera todos los chunks.
+		 */
+		~FixedBlockPool()
+		{
+			// Las entradas de cach que quedan en otros hilos se descartan solas: su Serial ya no coincide.
+			if (CacheIndex < MaxCachedPools)
+			{
+				registry()[CacheIndex].store(0, std::memory_order_release);
+			}
+			for (void* Chunk : Chunks)
+			{
+				::operator delete(Chunk, std::align_val_t(SlotAlignment));
+			}
+		}
+
+		/**
+		 * @brief Reserva un bloque de SlotSize bytes sin inicializar.
+		 */
+		void* allocate()
+		{
+			ThreadCache* Cache = cache();
+			if (!Cache)
+			{
+				ThreadCache Local;
+				refill(Local);
+				FreeNode* Node = Local.Head;
+				if (Local.Count > 1)
+				{
+					pushBatch(Node->Next, Local.Count - 1);
+				}
+				return Node;
+			}
+
+			if (!Cache->Head)
+			{
+				refill(*Cache);
+			}
+			FreeNode* Node = Cache->Head;
+			Cache->Head = Node->Next;
+			--Cache->Count;
+			return Node;
+		}
+
+		/**
+		 * @brief Devuelve un bloque reservado con allocate(), desde cualquier hilo.
+		 */
+		void deallocate(void* Block)
+		{
+			if (!Block)
+			{
+				return;
+			}
+			FreeNode* Node = static_cast<FreeNode*>(Block);
+			ThreadCache* Cache = cache();
+			if (!Cache)
+			{
+				Node->Next = nullptr;
+				pushBatch(Node, 1);
+				return;
+			}
+
+			Node->Next = Cache->Head;
+			Cache->Head = Node;
+			if (++Cache->Count >= 2 * BatchSize)
+			{
+				FreeNode* Last = Cache->Head;
+				for (size_t i = 1; i < BatchSize; ++i)
+				{
+					Last = Last->Next;
+				}
+				FreeNode* First = Cache->Head;
+				Cache->Head = Last->Next;
+				Cache->Count -= static_cast<uint32_t>(BatchSize);
+				Last->Next = nullptr;
+				pushBatch(First, BatchSize);
+			}
+		}
+
+		/**
+		 * @brief Bytes de cada bloque (incluye el relleno de alineacin).
+		 */
+		size_t slotSize() const { return SlotSize; }
+
+		/**
+		 * @brief Nmero total de bloques reservados en chunks.
+		 */
+		size_t capacity() const
+		{
+			std::lock_guard<std::mutex> Lock(ChunkMutex);
+			return Chunks.size() * SlotsPerChunk;
+		}
+
+	private:
+		/**
+		 * @brief Bloque libre. La cabeza de cada lote guarda adems el siguiente lote y su tamao.
+		 */
+		struct FreeNode
+		{
+			FreeNode* Next;
+			FreeNode* NextBatch;
+			size_t BatchCount;
+		};
+
+		/**
+		 * @brief Lista libre de un hilo para un pool.
+		 */
+		struct ThreadCache
+		{
+			FixedBlockPool* Owner = nullptr;
+			uint64_t Serial = 0;  ///< Pool al que pertenece; si no coincide, la entrada est obsoleta.
+			FreeNode* Head = nullptr;
+			uint32_t Count = 0;
+		};
+
+		/**
+		 * @brief Cachs del hilo actual. Al terminar el hilo se devuelven a sus pools si siguen vivos.
+		 */
+		struct ThreadCaches
+		{
+			ThreadCache Entries[MaxCachedPools];
+
+			~ThreadCaches()
+			{
+				for (uint32_t i = 0; i < MaxCachedPools; ++i)
+				{
+					ThreadCache& Entry = Entries[i];
+					if (Entry.Head && registry()[i].load(std::memory_order_acquire) == Entry.Serial)
+					{
+						Entry.Owner->pushBatch(Entry.Head, Entry.Count);
+					}
+				}
+			}
+		};
+
+		static std::atomic<uint64_t>* registry()
+		{
+			static std::atomic<uint64_t> Slots[MaxCachedPools] = {};
+			return Slots;
+		}
+
+		static uint64_t nextSerial()
+		{
+			static std::atomic<uint64_t> Counter{ 0 };
+			return Counter.fetch_add(1, std::memory_order_relaxed) + 1;
+		}
+
+		static ThreadCaches& threadCaches()
+		{
+			thread_local ThreadCaches Caches;
+			return Caches;
+		}
+
+		ThreadCache* cache()
+		{
+			if (CacheIndex >= MaxCachedPools)
+			{
+				return nullptr;
+			}
+			ThreadCache& Entry = threadCaches().Entries[CacheIndex];
+			if (Entry.Serial != Serial)
+			{
+				Entry.Owner = this;
+				Entry.Serial = Serial;
+				Entry.Head = nullptr;
+				Entry.Count = 0;
+			}
+			return &Entry;
+		}
+
+		/**
+		 * @brief Extrae el puntero de una cabeza etiquetada.
+		 */
+		static FreeNode* topOf(uint64_t Head)
+		{
+			return reinterpret_cast<FreeNode*>(static_cast<uintptr_t>(Head & PointerMask));
+		}
+
+		/**
+		 * @brief Nueva cabeza que apunta a Node con la etiqueta de Head incrementada.
+		 */
+		static uint64_t makeHead(FreeNode* Node, uint64_t Head)
+		{
+			return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(Node)) | (((Head >> TagShift) + 1) << TagShift);
+		}
+
+		/**
+		 * @brief Publica una lista de Count bloques como un lote en la pila global.
+		 */
+		void pushBatch(FreeNode* First, size_t Count)
+		{
+			First->BatchCount = Count;
+			uint64_t Head = GlobalBatches.load(std::memory_order_relaxed);
+			do
+			{
+				First->NextBatch = topOf(Head);
+			} while (!GlobalBatches.compare_exchange_weak(Head, makeHead(First, Head),
+			                                             std::memory_order_release,
+			                                             std::memory_order_relaxed));
+		}
+
+		/**
+		 * @brief Intenta tomar un lote de la pila global.
+		 *
+		 * Leer Top->NextBatch es seguro aunque otro hilo ya haya sacado Top: los chunks no se
+		 * liberan mientras el pool vive, y si Top cambi la etiqueta hace fallar el CAS.
+		 */
+		bool takeBatch(ThreadCache& Cache)
+		{
+			uint64_t Head = GlobalBatches.load(std::memory_order_acquire);
+			while (FreeNode* Top = topOf(Head))
+			{
+				if (GlobalBatches.compare_exchange_weak(Head, makeHead(Top->NextBatch, Head),
+				                                        std::memory_order_acquire,
+				                                        std::memory_order_acquire))
+				{
+					Cache.Head = Top;
+					Cache.Count = static_cast<uint32_t>(Top->BatchCount);
+					return true;
+				}
+			}
+			return false;
+		}
+
+		/**
+		 * @brief Llena una cach vaca desde la pila global o, si est vaca, con un chunk nuevo.
+		 */
+		void refill(ThreadCache& Cache)
+		{
+			if (takeBatch(Cache))
+			{
+				return;
+			}
+
+			std::lock_guard<std::mutex> Lock(ChunkMutex);
+			if (takeBatch(Cache))
+			{
+				return;
+			}
+
+			unsigned char* Chunk = static_cast<unsigned char*>(
+				::operator new(SlotSize * SlotsPerChunk, std::align_val_t(SlotAlignment)));
+			Chunks.push_back(Chunk);
+
+			FreeNode* Head = nullptr;
+			for (size_t i = SlotsPerChunk; i-- > 0;)
+			{
+				FreeNode* Node = reinterpret_cast<FreeNode*>(Chunk + i * SlotSize);
+				Node->Next = Head;
+				Head = Node;
+			}
+			Cache.Head = Head;
+			Cache.Count = static_cast<uint32_t>(SlotsPerChunk);
+		}
+
+		size_t SlotAlignment;                  ///< Alineacin de los bloques.
+		size_t SlotSize;                       ///< Bytes por bloque.
+		size_t SlotsPerChunk;                  ///< Bloques por chunk.
+		size_t BatchSize;                      ///< Bloques que se mueven entre cach y pila global.
+		std::atomic<uint64_t> GlobalBatches;   ///< Pila global de lotes libres (puntero y etiqueta ABA).
+		uint64_t Serial;                       ///< Identificador nico del pool (nunca se reutiliza).
+		uint32_t CacheIndex;                   ///< Entrada de la cach por hilo, o MaxCachedPools si no tiene.
+		mutable std::mutex ChunkMutex;         ///< Protege Chunks y el crecimiento.
+		std::vector<void*> Chunks;             ///< Chunks reservados.
+	};
+
+	/**
+	 * @brief Pool tipado de objetos T sobre FixedBlockPool.
+	 *
+	 * @tparam T Tipo de los objetos del pool.
+	 */
+	template<typename T>
+	class TPool
+	{
+	public:
+		/**
+		 * @brief Constructor.
+		 *
+		 * @param SlotsPerChunk Objetos por chunk contiguo.
+		 */
+		explicit TPool(size_t SlotsPerChunk = 256) : Blocks(sizeof(T), alignof(T), SlotsPerChunk) {}
+
+		/**
+		 * @brief Pool global para T, compartido por todo el motor.
+		 *
+		 * No se destruye nunca: as los objetos globales (como la aplicacin) pueden soltar sus
+		 * punteros al salir sin depender del orden de destruccin de estticos.
+		 */
+		static TPool& get()
+		{
+			static TPool* Instance = new TPool();
+			return *Instance;
+		}
+
+		/**
+		 * @brief Reserva memoria sin construir para un T.
+		 */
+		void* allocate() { return Blocks.allocate(); }
+
+		/**
+		 * @brief Devuelve la memoria de un T ya destruido.
+		 */
+		void deallocate(void* Block) { Blocks.deallocate(Block); }
+
+		/**
+		 * @brief Construye un T en el pool.
+		 */
+		template<typename... Args>
+		T* create(Args&&... args)
+		{
+			void* Block = allocate();
+			try
+			{
+				return ::new (Block) T(std::forward<Args>(args)...);
+			}
+			catch (...)
+			{
+				deallocate(Block);
+				throw;
+			}
+		}
+
+		/**
+		 * @brief Destruye un T creado con create() y devuelve su memoria.
+		 */
+		void destroy(T* Object)
+		{
+			if (Object)
+			{
+				Object->~T();
+				deallocate(Object);
+			}
+		}
+
+		/**
+		 * @brief Nmero de objetos que caben en los chunks reservados.
+		 */
+		size_t capacity() const { return Blocks.capacity(); }
+
+	private:
+		FixedBlockPool Blocks;  ///< Bloques de tamao sizeof(T).
+	};
+
+	// EXAMPLE
+
+	/*
+	struct Particle { float Position[3]; float Life; };
+
+	TPool<Particle> Particles(1024);
+	Particle* P = Particles.create();
+	Particles.destroy(P);
+
+	// Con TSharedPointer (ver TSharedPointer.h):
+	TSharedPointer<Transform> T = MakeShared(TSharedPool<Transform>::get());
+	*/
+}
@@ -27,147 +27,388 @@
  * SOFTWARE.
 */
 #pragma once
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "Utilities/Memory/TMemoryTracker.h"
+#include "Utilities/Memory/TPool.h"
 
 namespace EngineUtilities {
+	/**
+	 * @brief Poltica de recuento de referencias atmica (por defecto).
+	 *
+	 * Los incrementos son relaxed: quien incrementa ya posee una referencia, as que no
+	 * necesita sincronizarse con nadie. Los decrementos son acq_rel para que todas las
+	 * escrituras sobre el objeto sean visibles para el hilo que lo destruye.
+	 */
+	struct TAtomicRefPolicy
+	{
+		using CounterType = std::atomic<int32_t>;
+
+		static void Increment(CounterType& Counter)
+		{
+			Counter.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		static int32_t Decrement(CounterType& Counter)
+		{
+			return Counter.fetch_sub(1, std::memory_order_acq_rel) - 1;
+		}
+
+		static int32_t Load(const CounterType& Counter)
+		{
+			return Counter.load(std::memory_order_acquire);
+		}
+
+		/**
+		 * @brief Incrementa el contador solo si no es cero, sin bloqueos (bucle CAS).
+		 *
+		 * Un contador fuerte a cero significa que el objeto ya se destruy o se est
+		 * destruyendo, y nunca debe "resucitarse".
+		 *
+		 * @return true si se increment.
+		 */
+		static bool IncrementIfNotZero(CounterType& Counter)
+		{
+			int32_t Count = Counter.load(std::memory_order_relaxed);
+			while (Count != 0)
+			{
+				if (Counter.compare_exchange_weak(Count, Count + 1,
+				                                  std::memory_order_acq_rel,
+				                                  std::memory_order_relaxed))
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+	};
+
+	/**
+	 * @brief Poltica de recuento de referencias no atmica, para rutas de un solo hilo.
+	 */
+	struct TLocalRefPolicy
+	{
+		using CounterType = int32_t;
+
+		static void Increment(CounterType& Counter)
+		{
+			++Counter;
+		}
+
+		static int32_t Decrement(CounterType& Counter)
+		{
+			return --Counter;
+		}
+
+		static int32_t Load(const CounterType& Counter)
+		{
+			return Counter;
+		}
+
+		static bool IncrementIfNotZero(CounterType& Counter)
+		{
+			if (Counter == 0)
+			{
+				return false;
+			}
+			++Counter;
+			return true;
+		}
+	};
+
+	/**
+	 * @brief Bloque de control compartido por todos los punteros a un mismo objeto.
+	 *
+	 * Guarda el recuento fuerte (TSharedPointer) y el dbil (TWeakPointer). Mientras exista
+	 * alguna referencia fuerte, el conjunto de todas ellas aporta una unidad al recuento dbil,
+	 * de modo que el bloque se libera cuando el recuento dbil llega a cero.
+	 *
+	 * @tparam Policy Poltica de recuento (TAtomicRefPolicy o TLocalRefPolicy).
+	 */
+	template<typename Policy>
+	class TRefControlBlock
+	{
+	public:
+		TRefControlBlock() : StrongCount(1), WeakCount(1) {}
+		virtual ~TRefControlBlock() = default;
+
+		TRefControlBlock(const TRefControlBlock&) = delete;
+		TRefControlBlock& operator=(const TRefControlBlock&) = delete;
+
+		void addStrong() { Policy::Increment(StrongCount); }
+		void addWeak() { Policy::Increment(WeakCount); }
+		int32_t strongCount() const { return Policy::Load(StrongCount); }
+
+		/**
+		 * @brief Intenta aadir una referencia fuerte si el objeto sigue vivo (usado por TWeakPointer::lock).
+		 */
+		bool tryAddStrong() { return Policy::IncrementIfNotZero(StrongCount); }
+
+		/**
+		 * @brief Libera una referencia fuerte; destruye el objeto si era la ltima.
+		 */
+		void releaseStrong()
+		{
+			if (Policy::Decrement(StrongCount) == 0)
+			{
+				destroyObject();
+				releaseWeak();  ///< Soltar la unidad dbil que aportaban las referencias fuertes.
+			}
+		}
+
+		/**
+		 * @brief Libera una referencia dbil; libera el bloque si era la ltima.
+		 */
+		void releaseWeak()
+		{
+			if (Policy::Decrement(WeakCount) == 0)
+			{
+				destroyBlock();
+			}
+		}
+
+	protected:
+		virtual void destroyObject() = 0;  ///< Destruye el objeto gestionado.
+		virtual void destroyBlock() = 0;   ///< Libera la memoria del bloque de control.
+
+		typename Policy::CounterType StrongCount;  ///< Nmero de TSharedPointer vivos.
+		typename Policy::CounterType WeakCount;    ///< Nmero de TWeakPointer vivos (+1 si hay fuertes).
+	};
+
+	/**
+	 * @brief Bloque de control para un objeto reservado por separado (constructor desde puntero crudo).
+	 */
+	template<typename T, typename Policy>
+	class TRefControlBlockPointer : public TRefControlBlock<Policy>
+	{
+	public:
+		explicit TRefControlBlockPointer(T* InObject) : Object(InObject)
+		{
+			MemoryTracker::recordAllocation(TMemoryTagOf<T>::value, sizeof(T) + sizeof(*this));
+		}
+
+	protected:
+		void destroyObject() override { delete Object; }
+		void destroyBlock() override
+		{
+			MemoryTracker::recordFree(TMemoryTagOf<T>::value, sizeof(T) + sizeof(*this));
+			delete this;
+		}
+
+	private:
+		T* Object;  ///< Objeto gestionado.
+	};
+
+	/**
+	 * @brief Bloque de control que contiene el objeto en su propia memoria (MakeShared).
+	 *
+	 * Objeto y recuentos comparten una nica reserva y suelen caer en la misma lnea de cach.
+	 */
+	template<typename T, typename Policy>
+	class TRefControlBlockInline : public TRefControlBlock<Policy>
+	{
+	public:
+		template<typename... Args>
+		explicit TRefControlBlockInline(Args&&... args)
+		{
+			::new (static_cast<void*>(&Storage)) T(std::forward<Args>(args)...);
+			MemoryTracker::recordAllocation(TMemoryTagOf<T>::value, sizeof(*this));
+		}
+
+		T* object() { return reinterpret_cast<T*>(&Storage); }
+
+	protected:
+		void destroyObject() override { object()->~T(); }
+		void destroyBlock() override
+		{
+			MemoryTracker::recordFree(TMemoryTagOf<T>::value, sizeof(*this));
+			delete this;
+		}
+
+	private:
+		alignas(T) unsigned char Storage[sizeof(T)];  ///< Memoria del objeto gestionado.
+	};
+
+	/**
+	 * @brief Bloque de control con el objeto dentro, reservado en un TPool (MakeShared con pool).
+	 *
+	 * Al soltar la ltima referencia el bloque vuelve a su pool en lugar de al heap.
+	 */
+	template<typename T, typename Policy>
+	class TRefControlBlockPooled : public TRefControlBlock<Policy>
+	{
+	public:
+		template<typename... Args>
+		explicit TRefControlBlockPooled(TPool<TRefControlBlockPooled>& InPool, Args&&... args) : Pool(&InPool)
+		{
+			::new (static_cast<void*>(&Storage)) T(std::forward<Args>(args)...);
+			MemoryTracker::recordAllocation(TMemoryTagOf<T>::value, sizeof(*this));
+		}
+
+		T* object() { return reinterpret_cast<T*>(&Storage); }
+
+	protected:
+		void destroyObject() override { object()->~T(); }
+		void destroyBlock() override
+		{
+			TPool<TRefControlBlockPooled>* Owner = Pool;
+			MemoryTracker::recordFree(TMemoryTagOf<T>::value, sizeof(*this));
+			this->~TRefControlBlockPooled();
+			Owner->deallocate(this);
+		}
+
+	private:
+		TPool<TRefControlBlockPooled>* Pool;          ///< Pool al que vuelve el bloque.
+		alignas(T) unsigned char Storage[sizeof(T)];  ///< Memoria del objeto gestionado.
+	};
+
+	/**
+	 * @brief Pool de objetos T listos para usarse con TSharedPointer (objeto y recuentos en el mismo bloque).
+	 */
+	template<typename T, typename Policy = TAtomicRefPolicy>
+	using TSharedPool = TPool<TRefControlBlockPooled<T, Policy>>;
+
+	template<typename T, typename Policy>
+	class TWeakPointer;
+
 	/**
 	 * @brief Clase TSharedPointer para manejar la gestin de memoria compartida.
 	 *
 	 * La clase TSharedPointer gestiona la memoria de un objeto de tipo T y lleva un
 	 * recuento de referencias para permitir la comparticin segura de un mismo objeto
-	 * en mltiples instancias de TSharedPointer.
+	 * en mltiples instancias de TSharedPointer. Con la poltica por defecto el recuento
+	 * es atmico y los punteros pueden copiarse y destruirse desde varios hilos.
+	 *
+	 * @tparam T Tipo del objeto gestionado.
+	 * @tparam Policy Poltica de recuento (TAtomicRefPolicy por defecto).
 	 */
-	template<typename T>
+	template<typename T, typename Policy = TAtomicRefPolicy>
 	class TSharedPointer
 	{
 	public:
+		using ControlBlock = TRefControlBlock<Policy>;
+
 		/**
 		 * @brief Constructor por defecto.
 		 *
-		 * Inicializa el puntero y el recuento de referencias a nullptr.
+		 * Inicializa el puntero y el bloque de control a nullptr.
 		 */
-		TSharedPointer() : ptr(nullptr), refCount(nullptr) {}
+		TSharedPointer() : ptr(nullptr), control(nullptr) {}
 
 		/**
 		 * @brief Constructor que toma un puntero crudo.
 		 *
+		 * Reserva un bloque de control aparte; MakeShared evita esa segunda reserva.
+		 *
 		 * @param rawPtr Puntero crudo al objeto que se va a gestionar.
 		 */
-		explicit TSharedPointer(T* rawPtr) : ptr(rawPtr), refCount(new int(1)) {}
+		explicit TSharedPointer(T* rawPtr)
+			: ptr(rawPtr), control(rawPtr ? new TRefControlBlockPointer<T, Policy>(rawPtr) : nullptr) {}
 
 		/**
-		 * @brief Constructor desde un puntero crudo y un recuento de referencias.
+		 * @brief Constructor desde un puntero crudo y un bloque de control existente.
+		 *
+		 * Aade una referencia fuerte al bloque.
 		 *
 		 * @param rawPtr Puntero crudo al objeto gestionado.
-		 * @param existingRefCount Puntero al recuento de referencias existente.
+		 * @param existingControl Bloque de control existente.
 		 */
-		TSharedPointer(T* rawPtr, int* existingRefCount) : ptr(rawPtr), refCount(existingRefCount)
+		TSharedPointer(T* rawPtr, ControlBlock* existingControl) : ptr(rawPtr), control(existingControl)
 		{
-			if (refCount)
+			if (control)
 			{
-				++(*refCount);
+				control->addStrong();
 			}
 		}
 
 		/**
 		 * @brief Constructor de copia.
 		 *
-		 * Copia el puntero y el recuento de referencias del otro TSharedPointer y
+		 * Copia el puntero y el bloque de control del otro TSharedPointer y
 		 * aumenta el recuento de referencias.
 		 *
 		 * @param other Otro objeto TSharedPointer del mismo tipo T.
 		 */
-		TSharedPointer(const TSharedPointer<T>& other) : ptr(other.ptr), refCount(other.refCount)
+		TSharedPointer(const TSharedPointer& other) : ptr(other.ptr), control(other.control)
+		{
+			if (control)
+			{
+				control->addStrong();
+			}
+		}
+
+		/**
+		 * @brief Constructor de conversin desde un TSharedPointer de un tipo derivado.
+		 *
+		 * @param other TSharedPointer cuyo tipo se convierte implcitamente a T*.
+		 */
+		template<typename U, typename = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+		TSharedPointer(const TSharedPointer<U, Policy>& other) : ptr(other.ptr), control(other.control)
 		{
-			if (refCount)
+			if (control)
 			{
-				++(*refCount);
+				control->addStrong();
 			}
 		}
 
 		/**
 		 * @brief Constructor de movimiento.
 		 *
-		 * Transfiere la propiedad del puntero y el recuento de referencias del otro
+		 * Transfiere la propiedad del puntero y el bloque de control del otro
 		 * TSharedPointer al nuevo objeto TSharedPointer.
 		 *
 		 * @param other Otro objeto TSharedPointer del mismo tipo T.
 		 */
-		TSharedPointer(TSharedPointer<T>&& other) noexcept : ptr(other.ptr), refCount(other.refCount)
+		TSharedPointer(TSharedPointer&& other) noexcept : ptr(other.ptr), control(other.control)
 		{
 			other.ptr = nullptr;
-			other.refCount = nullptr;
+			other.control = nullptr;
 		}
 
 		/**
 		 * @brief Operador de asignacin de copia.
 		 *
-		 * Libera el objeto actual, copia el puntero y el recuento de referencias del otro
-		 * TSharedPointer, y aumenta el recuento de referencias.
+		 * Copia el puntero y el bloque de control del otro TSharedPointer, aumenta su
+		 * recuento y libera la referencia que tena este puntero.
 		 *
 		 * @param other Otro objeto TSharedPointer del mismo tipo T.
 		 * @return Referencia al objeto TSharedPointer actual.
 		 */
-		TSharedPointer<T>& operator=(const TSharedPointer<T>& other)
+		TSharedPointer& operator=(const TSharedPointer& other)
 		{
-			if (this != &other)
-			{
-				// Disminuir el recuento de referencias del objeto actual
-				if (refCount && --(*refCount) == 0)
-				{
-					delete ptr;
-					delete refCount;
-				}
-				// Copiar datos del otro puntero compartido
-				ptr = other.ptr;
-				refCount = other.refCount;
-				if (refCount)
-				{
-					++(*refCount);
-				}
-			}
+			TSharedPointer(other).swap(*this);
 			return *this;
 		}
 
 		/**
 		 * @brief Operador de asignacin de movimiento.
 		 *
-		 * Libera el objeto actual, transfiere la propiedad del puntero y el recuento de
-		 * referencias del otro TSharedPointer al actual.
+		 * Libera el objeto actual, transfiere la propiedad del puntero y el bloque de
+		 * control del otro TSharedPointer al actual.
 		 *
 		 * @param other Otro objeto TSharedPointer del mismo tipo T.
 		 * @return Referencia al objeto TSharedPointer actual.
 		 */
-		TSharedPointer<T>& operator=(TSharedPointer<T>&& other) noexcept
+		TSharedPointer& operator=(TSharedPointer&& other) noexcept
 		{
-			if (this != &other)
-			{
-				// Liberar el objeto actual
-				if (refCount && --(*refCount) == 0)
-				{
-					delete ptr;
-					delete refCount;
-				}
-				// Transferir los datos del otro puntero compartido
-				ptr = other.ptr;
-				refCount = other.refCount;
-				other.ptr = nullptr;
-				other.refCount = nullptr;
-			}
+			TSharedPointer(std::move(other)).swap(*this);
 			return *this;
 		}
 
 		/**
 		 * @brief Destructor.
 		 *
-		 * Disminuye el recuento de referencias y libera la memoria del objeto
-		 * gestionado si el recuento de referencias llega a cero.
+		 * Disminuye el recuento de referencias y destruye el objeto gestionado
+		 * si el recuento de referencias llega a cero.
 		 */
 		~TSharedPointer()
 		{
-			if (refCount && --(*refCount) == 0)
+			if (control)
 			{
-				delete ptr;
-				delete refCount;
+				control->releaseStrong();
 			}
 		}
 
@@ -203,9 +444,10 @@ namespace EngineUtilities {
 		 */
 		bool isNull() const { return ptr == nullptr; }
 
-	public:
-		T* ptr;       ///< Puntero al objeto gestionado.
-		int* refCount; ///< Puntero al recuento de referencias.
+		/**
+		 * @brief Nmero de TSharedPointer que comparten el objeto (0 si es nulo).
+		 */
+		int32_t useCount() const { return control ? control->strongCount() : 0; }
 
 		/**
 		 * @brief Mtodo swap.
@@ -214,72 +456,129 @@ namespace EngineUtilities {
 		 *
 		 * @param other Otro objeto TSharedPointer del mismo tipo T.
 		 */
-		void swap(TSharedPointer<T>& other) noexcept
+		void swap(TSharedPointer& other) noexcept
 		{
-			T* tempPtr = other.ptr;
-			int* tempRefCount = other.refCount;
-
-			other.ptr = this->ptr;
-			other.refCount = this->refCount;
-
-			this->ptr = tempPtr;
-			this->refCount = tempRefCount;
+			std::swap(ptr, other.ptr);
+			std::swap(control, other.control);
 		}
 
 		/**
-				 * @brief Libera el objeto actual y opcionalmente asigna un nuevo objeto.
-				 *
-				 * @param newPtr Nuevo puntero crudo al objeto que se va a gestionar (por defecto es nullptr).
-				 */
+		 * @brief Libera el objeto actual y opcionalmente asigna un nuevo objeto.
+		 *
+		 * @param newPtr Nuevo puntero crudo al objeto que se va a gestionar (por defecto es nullptr).
+		 */
 		void reset(T* newPtr = nullptr)
 		{
-			// Disminuir el recuento de referencias del objeto actual
-			if (refCount && --(*refCount) == 0)
-			{
-				delete ptr;
-				delete refCount;
-			}
-
-			// Si newPtr es nullptr, asignar nullptr al puntero y recuento de referencias
-			if (newPtr == nullptr)
-			{
-				ptr = nullptr;
-				refCount = nullptr;
-			}
-			else
-			{
-				// Asignar nuevo objeto y manejar el recuento de referencias
-				ptr = newPtr;
-				refCount = new int(1);
-			}
+			TSharedPointer(newPtr).swap(*this);
 		}
+
 		// Mtodo de conversin para hacer cast dinmico
 		template<typename U>
-		TSharedPointer<U> dynamic_pointer_cast() const {
+		TSharedPointer<U, Policy> dynamic_pointer_cast() const {
 			// Intenta convertir el puntero de tipo T a U
 			U* castedPtr = dynamic_cast<U*>(ptr);
 			if (castedPtr) {
-				// Si la conversin es exitosa, devuelve un nuevo TSharedPointer<U>
-				return TSharedPointer<U>(castedPtr, refCount);
+				// Si la conversin es exitosa, devuelve un nuevo TSharedPointer<U> que comparte el bloque
+				return TSharedPointer<U, Policy>(castedPtr, control);
 			}
 			else {
 				// Si falla la conversin, devuelve un TSharedPointer<U> nulo
-				return TSharedPointer<U>();
+				return TSharedPointer<U, Policy>();
 			}
 		}
+
+	private:
+		template<typename U, typename OtherPolicy>
+		friend class TSharedPointer;
+
+		template<typename U, typename OtherPolicy>
+		friend class TWeakPointer;
+
+		template<typename U, typename OtherPolicy, typename... Args>
+		friend TSharedPointer<U, OtherPolicy> MakeSharedWithPolicy(Args&&... args);
+
+		template<typename U, typename OtherPolicy, typename... Args>
+		friend TSharedPointer<U, OtherPolicy> MakeShared(TPool<TRefControlBlockPooled<U, OtherPolicy>>& pool, Args&&... args);
+
+		/**
+		 * @brief Adopta un bloque de control sin aumentar el recuento.
+		 */
+		struct AdoptTag {};
+		TSharedPointer(T* rawPtr, ControlBlock* adoptedControl, AdoptTag) : ptr(rawPtr), control(adoptedControl) {}
+
+		T* ptr;                 ///< Puntero al objeto gestionado.
+		ControlBlock* control;  ///< Puntero al bloque de control (recuentos fuerte y dbil).
 	};
 
+	/**
+	 * @brief TSharedPointer con recuento no atmico, para datos que no salen de un hilo.
+	 */
+	template<typename T>
+	using TLocalSharedPointer = TSharedPointer<T, TLocalRefPolicy>;
+
+	/**
+	 * @brief Crea un TSharedPointer con la poltica indicada en una nica reserva.
+	 *
+	 * @tparam T Tipo del objeto gestionado.
+	 * @tparam Policy Poltica de recuento.
+	 * @param args Argumentos del constructor del objeto gestionado.
+	 */
+	template<typename T, typename Policy, typename... Args>
+	TSharedPointer<T, Policy> MakeSharedWithPolicy(Args&&... args)
+	{
+		auto* block = new TRefControlBlockInline<T, Policy>(std::forward<Args>(args)...);
+		return TSharedPointer<T, Policy>(block->object(), block, typename TSharedPointer<T, Policy>::AdoptTag{});
+	}
+
 	/**
 	 * @brief Funcin de utilidad para crear un TSharedPointer.
 	 *
+	 * El objeto y su bloque de control se construyen en una sola reserva de memoria.
+	 *
 	 * @tparam T Tipo del objeto gestionado.
 	 * @tparam Args Tipos de los argumentos del constructor del objeto gestionado.
 	 * @param args Argumentos del constructor del objeto gestionado.
 	 * @return Un objeto TSharedPointer gestionando un nuevo objeto de tipo T.
 	 */
 	template<typename T, typename... Args>
-	TSharedPointer<T> MakeShared(Args... args)
+	TSharedPointer<T> MakeShared(Args&&... args)
+	{
+		return MakeSharedWithPolicy<T, TAtomicRefPolicy>(std::forward<Args>(args)...);
+	}
+
+	/**
+	 * @brief Crea un TSharedPointer cuyo objeto y bloque de control salen de un pool.
+	 *
+	 * Reservar es O(1) y los objetos creados desde el mismo pool quedan contiguos en memoria.
+	 * El pool debe sobrevivir a todos los punteros (fuertes y dbiles) creados desde l.
+	 *
+	 * @param pool Pool del que se toma la memoria (por ejemplo, TSharedPool<T>::get()).
+	 * @param args Argumentos del constructor del objeto gestionado.
+	 */
+	template<typename T, typename Policy, typename... Args>
+	TSharedPointer<T, Policy> MakeShared(TPool<TRefControlBlockPooled<T, Policy>>& pool, Args&&... args)
+	{
+		using Block = TRefControlBlockPooled<T, Policy>;
+		void* memory = pool.allocate();
+		Block* block;
+		try
+		{
+			block = ::new (memory) Block(pool, std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			pool.deallocate(memory);
+			throw;
+		}
+		return TSharedPointer<T, Policy>(block->object(), block, typename TSharedPointer<T, Policy>::AdoptTag{});
+	}
+
+	/**
+	 * @brief Crea un TLocalSharedPointer (recuento no atmico) en una nica reserva.
+	 */
+	template<typename T, typename... Args>
+	TLocalSharedPointer<T> MakeLocalShared(Args&&... args)
 	{
-		return TSharedPointer<T>(new T(args...));
+		return MakeSharedWithPolicy<T, TLocalRefPolicy>(std::forward<Args>(args)...);
 	}
 }
@@ -27,6 +27,7 @@
  * SOFTWARE.
 */
 #pragma once
+#include "Utilities/Memory/TMemoryTracker.h"
 
 namespace EngineUtilities {
   /**
@@ -35,6 +36,9 @@ namespace EngineUtilities {
  * La clase TUniquePtr gestiona la memoria de un objeto de tipo T y garantiza
  * que solo una instancia de TUniquePtr puede poseer y gestionar el objeto en
  * cualquier momento.
+ *
+ * Mientras un objeto pertenece a un TUniquePtr su memoria cuenta en el MemoryTracker
+ * con la etiqueta TMemoryTagOf<T>.
  */
   template<typename T>
   class TUniquePtr
@@ -52,7 +56,10 @@ namespace EngineUtilities {
      *
      * @param rawPtr Puntero crudo al objeto que se va a gestionar.
      */
-    explicit TUniquePtr(T* rawPtr) : ptr(rawPtr) {}
+    explicit TUniquePtr(T* rawPtr) : ptr(rawPtr)
+    {
+      track(ptr);
+    }
 
     /**
      * @brief Constructor de movimiento.
@@ -80,7 +87,7 @@ namespace EngineUtilities {
       if (this != &other)
       {
         // Liberar el objeto actual
-        delete ptr;
+        destroy(ptr);
 
         // Transferir los datos del otro puntero exclusivo
         ptr = other.ptr;
@@ -96,7 +103,7 @@ namespace EngineUtilities {
      */
     ~TUniquePtr()
     {
-      delete ptr;
+      destroy(ptr);
     }
 
     // Prohibir la copia de TUniquePtr
@@ -135,6 +142,7 @@ namespace EngineUtilities {
     {
       T* oldPtr = ptr;
       ptr = nullptr;
+      untrack(oldPtr);
       return oldPtr;
     }
 
@@ -147,8 +155,9 @@ namespace EngineUtilities {
      */
     void reset(T* rawPtr = nullptr)
     {
-      delete ptr;
+      destroy(ptr);
       ptr = rawPtr;
+      track(ptr);
     }
 
     /**
@@ -161,6 +170,37 @@ namespace EngineUtilities {
       return ptr == nullptr;
     }
   private:
+    /**
+     * @brief Registra en el MemoryTracker un objeto que pasa a ser propiedad del puntero.
+     */
+    static void track(T* object)
+    {
+      if (object)
+      {
+        MemoryTracker::recordAllocation(TMemoryTagOf<T>::value, sizeof(T));
+      }
+    }
+
+    /**
+     * @brief Registra que un objeto deja de ser propiedad del puntero.
+     */
+    static void untrack(T* object)
+    {
+      if (object)
+      {
+        MemoryTracker::recordFree(TMemoryTagOf<T>::value, sizeof(T));
+      }
+    }
+
+    /**
+     * @brief Destruye el objeto gestionado.
+     */
+    static void destroy(T* object)
+    {
+      untrack(object);
+      delete object;
+    }
+
     T* ptr; ///< Puntero al objeto gestionado.
   };
 
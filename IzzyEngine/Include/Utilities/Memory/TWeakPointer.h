@@ -37,44 +37,142 @@ namespace EngineUtilities {
 		 * sin tener influencia sobre el recuento de referencias del objeto. Permite acceder al objeto solo si
 		 * an existe.
 		 */
-	template<typename T>
+	template<typename T, typename Policy = TAtomicRefPolicy>
 	class TWeakPointer
 	{
 	public:
 		/**
 		 * @brief Constructor por defecto.
 		 */
-		TWeakPointer() : ptr(nullptr), refCount(nullptr) {}
+		TWeakPointer() : ptr(nullptr), control(nullptr) {}
 
 		/**
 		 * @brief Constructor que toma un TSharedPointer.
 		 *
+		 * Aade una referencia dbil al bloque de control, que seguir existiendo
+		 * aunque el objeto se destruya mientras este TWeakPointer viva.
+		 *
 		 * @param sharedPtr TSharedPointer desde el cual se observar el objeto.
 		 */
-		TWeakPointer(const TSharedPointer<T>& sharedPtr) 
-		: ptr(sharedPtr.ptr), refCount(sharedPtr.refCount) {}
+		TWeakPointer(const TSharedPointer<T, Policy>& sharedPtr) 
+		: ptr(sharedPtr.ptr), control(sharedPtr.control)
+		{
+			if (control)
+			{
+				control->addWeak();
+			}
+		}
+
+		/**
+		 * @brief Constructor de copia.
+		 */
+		TWeakPointer(const TWeakPointer& other) : ptr(other.ptr), control(other.control)
+		{
+			if (control)
+			{
+				control->addWeak();
+			}
+		}
+
+		/**
+		 * @brief Constructor de movimiento.
+		 */
+		TWeakPointer(TWeakPointer&& other) noexcept : ptr(other.ptr), control(other.control)
+		{
+			other.ptr = nullptr;
+			other.control = nullptr;
+		}
+
+		/**
+		 * @brief Operador de asignacin de copia.
+		 */
+		TWeakPointer& operator=(const TWeakPointer& other)
+		{
+			TWeakPointer(other).swap(*this);
+			return *this;
+		}
+
+		/**
+		 * @brief Operador de asignacin de movimiento.
+		 */
+		TWeakPointer& operator=(TWeakPointer&& other) noexcept
+		{
+			TWeakPointer(std::move(other)).swap(*this);
+			return *this;
+		}
+
+		/**
+		 * @brief Asigna un nuevo objeto a observar.
+		 */
+		TWeakPointer& operator=(const TSharedPointer<T, Policy>& sharedPtr)
+		{
+			TWeakPointer(sharedPtr).swap(*this);
+			return *this;
+		}
+
+		/**
+		 * @brief Destructor. Libera la referencia dbil (y el bloque si era la ltima).
+		 */
+		~TWeakPointer()
+		{
+			if (control)
+			{
+				control->releaseWeak();
+			}
+		}
 
 		/**
 		 * @brief Convertir TWeakPointer a TSharedPointer.
 		 *
+		 * El recuento fuerte solo se incrementa si no es cero, con una operacin atmica
+		 * (bucle CAS), as que es seguro llamar a lock() mientras otro hilo suelta la ltima
+		 * referencia fuerte: o se obtiene el objeto vivo o un puntero nulo.
+		 *
 		 * @return Un TSharedPointer al objeto gestionado, o nullptr si el objeto ha sido destruido.
 		 */
-		TSharedPointer<T> lock() const
+		TSharedPointer<T, Policy> lock() const
 		{
-			if (refCount && *refCount > 0)
+			if (control && control->tryAddStrong())
 			{
-				return TSharedPointer<T>(ptr, refCount);
+				return TSharedPointer<T, Policy>(ptr, control, typename TSharedPointer<T, Policy>::AdoptTag{});
 			}
-			return TSharedPointer<T>();
+			return TSharedPointer<T, Policy>();
+		}
+
+		/**
+		 * @brief Comprobar si el objeto observado ya fue destruido.
+		 *
+		 * @return true si no queda ningn TSharedPointer al objeto.
+		 */
+		bool expired() const
+		{
+			return !control || control->strongCount() == 0;
+		}
+
+		/**
+		 * @brief Deja de observar el objeto.
+		 */
+		void reset()
+		{
+			TWeakPointer().swap(*this);
+		}
+
+		/**
+		 * @brief Intercambia los datos de dos objetos TWeakPointer.
+		 */
+		void swap(TWeakPointer& other) noexcept
+		{
+			std::swap(ptr, other.ptr);
+			std::swap(control, other.control);
 		}
 
 		// Hacer que TSharedPointer sea un amigo para acceder a los miembros privados.
-		template<typename U>
+		template<typename U, typename OtherPolicy>
 		friend class TSharedPointer;
 
 	private:
 		T* ptr;       ///< Puntero al objeto observado.
-		int* refCount; ///< Puntero al recuento de referencias del TSharedPointer original.
+		TRefControlBlock<Policy>* control; ///< Bloque de control del TSharedPointer original.
 	};
 
 	/*
@@ -28,17 +28,47 @@
 */
 
 #pragma once
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "Utilities/Memory/TMemoryTracker.h"
+
 namespace EngineUtilities {
+	/**
+	 * @brief Indica si un tipo puede reubicarse en memoria con un simple memcpy.
+	 *
+	 * Por defecto solo los tipos trivialmente copiables se consideran reubicables.
+	 * Los tipos que no guardan punteros a s mismos (por ejemplo, punteros inteligentes)
+	 * pueden especializar esta plantilla para aprovechar la ruta rpida de TArray.
+	 *
+	 * @tparam T El tipo a evaluar.
+	 */
+	template<typename T>
+	struct TIsTriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+	/**
+	 * @brief Poltica de memoria por defecto de TArray: memoria del heap alineada, atribuida a MemoryTag::Containers.
+	 *
+	 * Cualquier otra poltica debe ofrecer las mismas dos funciones estticas Allocate/Deallocate
+	 * (ver TTaggedHeapAllocator en TMemoryTracker.h y TFrameArrayAllocator en TFrameAllocator.h).
+	 */
+	using THeapAllocator = TTaggedHeapAllocator<MemoryTag::Containers>;
+
 	/**
 	 * @brief TArray es una clase de array dinmica para almacenar elementos de tipo T.
 	 *
-	 * Esta implementacin de TArray proporciona una forma sencilla de almacenar y gestionar
-	 * colecciones de elementos, con operaciones bsicas como agregar, eliminar y acceder a elementos.
-	 * La memoria se gestiona dinmicamente, aumentando la capacidad del array segn sea necesario.
+	 * Los elementos viven en un bloque de memoria sin inicializar alineado a alignof(T);
+	 * solo las posiciones [0, Num()) contienen objetos construidos. Al crecer, los elementos
+	 * se reubican con memcpy si el tipo es trivialmente reubicable, o con movimiento
+	 * (copia si el constructor de movimiento puede lanzar) en caso contrario.
 	 *
 	 * @tparam T El tipo de elementos almacenados en el array.
+	 * @tparam Allocator Poltica de donde sale la memoria (heap por defecto).
 	 */
-	template<typename T>
+	template<typename T, typename Allocator = THeapAllocator>
 	class TArray
 	{
 	private:
@@ -47,22 +77,102 @@ namespace EngineUtilities {
 		size_t Size;       ///< Nmero de elementos actualmente en el array.
 
 		/**
-		 * @brief Redimensiona el array para tener una nueva capacidad.
+		 * @brief Reserva memoria sin inicializar para Count elementos.
 		 *
-		 * @param NewCapacity La nueva capacidad del array.
+		 * @param Count Nmero de elementos.
+		 * @return Puntero al bloque reservado.
 		 */
-		void Resize(size_t NewCapacity)
+		static T* Allocate(size_t Count)
+		{
+			return static_cast<T*>(Allocator::Allocate(Count * sizeof(T), alignof(T)));
+		}
+
+		/**
+		 * @brief Libera un bloque reservado con Allocate.
+		 *
+		 * @param Block Bloque a liberar (puede ser nullptr).
+		 * @param Count Nmero de elementos con el que se reserv.
+		 */
+		static void Deallocate(T* Block, size_t Count)
 		{
-			T* NewData = new T[NewCapacity];  ///< Crear un nuevo bloque de memoria con la nueva capacidad.
-			for (size_t i = 0; i < Size; ++i)
+			if (Block)
 			{
-				NewData[i] = Data[i];  ///< Copiar los elementos existentes al nuevo bloque de memoria.
+				Allocator::Deallocate(Block, Count * sizeof(T), alignof(T));
 			}
-			delete[] Data;  ///< Liberar la memoria del array antiguo.
+		}
+
+		/**
+		 * @brief Mueve Count elementos de Source a la memoria sin inicializar Dest y destruye los originales.
+		 *
+		 * @param Dest Memoria destino sin inicializar.
+		 * @param Source Elementos a reubicar.
+		 * @param Count Nmero de elementos.
+		 */
+		static void Relocate(T* Dest, T* Source, size_t Count)
+		{
+			if constexpr (TIsTriviallyRelocatable<T>::value)
+			{
+				if (Count)
+				{
+					std::memcpy(static_cast<void*>(Dest), static_cast<const void*>(Source), Count * sizeof(T));
+				}
+			}
+			else
+			{
+				for (size_t i = 0; i < Count; ++i)
+				{
+					::new (static_cast<void*>(Dest + i)) T(std::move_if_noexcept(Source[i]));
+					Source[i].~T();
+				}
+			}
+		}
+
+		/**
+		 * @brief Destruye los elementos en el rango [First, Last).
+		 */
+		static void DestroyRange(T* First, T* Last)
+		{
+			if constexpr (!std::is_trivially_destructible<T>::value)
+			{
+				for (; First != Last; ++First)
+				{
+					First->~T();
+				}
+			}
+		}
+
+		/**
+		 * @brief Calcula la capacidad a usar cuando se necesitan al menos MinCapacity elementos.
+		 */
+		size_t CalculateGrowth(size_t MinCapacity) const
+		{
+			size_t NewCapacity = Capacity ? Capacity * 2 : 4;  ///< Crecimiento geomtrico para Add amortizado O(1).
+			return NewCapacity < MinCapacity ? MinCapacity : NewCapacity;
+		}
+
+		/**
+		 * @brief Redimensiona el array para tener una nueva capacidad.
+		 *
+		 * @param NewCapacity La nueva capacidad del array (debe ser >= Size).
+		 */
+		void Resize(size_t NewCapacity)
+		{
+			T* NewData = NewCapacity ? Allocate(NewCapacity) : nullptr;  ///< Memoria sin construir: no se paga ningn constructor por defecto.
+			Relocate(NewData, Data, Size);  ///< Reubicar los elementos existentes al nuevo bloque.
+			Deallocate(Data, Capacity);  ///< Liberar la memoria del array antiguo.
 			Data = NewData; ///< Actualizar el puntero Data para que apunte al nuevo bloque de memoria.
 			Capacity = NewCapacity;  ///< Actualizar la capacidad del array.
 		}
 
+		/**
+		 * @brief Maneja un acceso fuera de rango igual que el resto de contenedores del motor.
+		 */
+		[[noreturn]] static void OutOfRange()
+		{
+			std::cerr << "Index out of range" << std::endl;
+			exit(1);
+		}
+
 	public:
 		/**
 		 * @brief Constructor por defecto que inicializa el array con capacidad y tamao cero.
@@ -70,10 +180,112 @@ namespace EngineUtilities {
 		TArray() : Data(nullptr), Capacity(0), Size(0)	{}
 
 		/**
-		 * @brief Destructor que libera la memoria asignada al array.
+		 * @brief Constructor de copia. Copia los elementos en un bloque del tamao exacto.
+		 *
+		 * @param Other Array a copiar.
+		 */
+		TArray(const TArray& Other) : Data(nullptr), Capacity(0), Size(0)
+		{
+			Reserve(Other.Size);
+			for (size_t i = 0; i < Other.Size; ++i)
+			{
+				::new (static_cast<void*>(Data + i)) T(Other.Data[i]);
+				++Size;
+			}
+		}
+
+		/**
+		 * @brief Constructor de movimiento. Roba el bloque de memoria del otro array.
+		 *
+		 * @param Other Array del que se transfiere la memoria.
+		 */
+		TArray(TArray&& Other) noexcept : Data(Other.Data), Capacity(Other.Capacity), Size(Other.Size)
+		{
+			Other.Data = nullptr;
+			Other.Capacity = 0;
+			Other.Size = 0;
+		}
+
+		/**
+		 * @brief Operador de asignacin de copia.
+		 */
+		TArray& operator=(const TArray& Other)
+		{
+			if (this != &Other)
+			{
+				TArray Copy(Other);
+				*this = std::move(Copy);
+			}
+			return *this;
+		}
+
+		/**
+		 * @brief Operador de asignacin de movimiento.
+		 */
+		TArray& operator=(TArray&& Other) noexcept
+		{
+			if (this != &Other)
+			{
+				DestroyRange(Data, Data + Size);
+				Deallocate(Data, Capacity);
+				Data = Other.Data;
+				Capacity = Other.Capacity;
+				Size = Other.Size;
+				Other.Data = nullptr;
+				Other.Capacity = 0;
+				Other.Size = 0;
+			}
+			return *this;
+		}
+
+		/**
+		 * @brief Destructor que destruye los elementos y libera la memoria asignada al array.
 		 */
 		~TArray()	{
-			delete[] Data;  ///< Liberar la memoria del array.
+			DestroyRange(Data, Data + Size);  ///< Destruir solo los elementos construidos.
+			Deallocate(Data, Capacity);  ///< Liberar la memoria del array.
+		}
+
+		/**
+		 * @brief Garantiza capacidad para al menos NewCapacity elementos sin ms reservas.
+		 *
+		 * @param NewCapacity Capacidad mnima deseada.
+		 */
+		void Reserve(size_t NewCapacity)
+		{
+			if (NewCapacity > Capacity)
+			{
+				Resize(NewCapacity);
+			}
+		}
+
+		/**
+		 * @brief Construye un nuevo elemento al final del array directamente en su memoria.
+		 *
+		 * Si hace falta crecer, el elemento se construye en el bloque nuevo antes de reubicar
+		 * los antiguos, de modo que los argumentos pueden referirse a elementos del propio array.
+		 *
+		 * @param Args Argumentos para el constructor de T.
+		 * @return Referencia al elemento construido.
+		 */
+		template<typename... ArgsType>
+		T& Emplace(ArgsType&&... Args)
+		{
+			if (Size == Capacity)
+			{
+				size_t NewCapacity = CalculateGrowth(Size + 1);
+				T* NewData = Allocate(NewCapacity);
+				::new (static_cast<void*>(NewData + Size)) T(std::forward<ArgsType>(Args)...);
+				Relocate(NewData, Data, Size);
+				Deallocate(Data, Capacity);
+				Data = NewData;
+				Capacity = NewCapacity;
+			}
+			else
+			{
+				::new (static_cast<void*>(Data + Size)) T(std::forward<ArgsType>(Args)...);
+			}
+			return Data[Size++];
 		}
 
 		/**
@@ -83,15 +295,58 @@ namespace EngineUtilities {
 		 */
 		void Add(const T& Element)
 		{
-			if (Size == Capacity)
+			Emplace(Element);
+		}
+
+		/**
+		 * @brief Aade un nuevo elemento al final del array movindolo.
+		 *
+		 * @param Element El elemento a mover al array.
+		 */
+		void Add(T&& Element)
+		{
+			Emplace(std::move(Element));
+		}
+
+		/**
+		 * @brief Inserta un elemento en la posicin especificada desplazando los siguientes.
+		 *
+		 * El elemento se recibe por valor, as que puede ser una copia de un elemento del propio array.
+		 *
+		 * @param Index Posicin en [0, Num()].
+		 * @param Element El elemento a insertar.
+		 */
+		void Insert(size_t Index, T Element)
+		{
+			if (Index > Size)
+			{
+				OutOfRange();
+			}
+			if (Index == Size)
+			{
+				Emplace(std::move(Element));
+				return;
+			}
+			if constexpr (TIsTriviallyRelocatable<T>::value)
+			{
+				Reserve(Size == Capacity ? CalculateGrowth(Size + 1) : Capacity);
+				std::memmove(static_cast<void*>(Data + Index + 1), static_cast<const void*>(Data + Index), (Size - Index) * sizeof(T));
+				::new (static_cast<void*>(Data + Index)) T(std::move(Element));
+				++Size;
+			}
+			else
 			{
-				Resize(Capacity == 0 ? 1 : Capacity * 2);  ///< Redimensionar si es necesario.
+				Emplace(std::move(Data[Size - 1]));
+				for (size_t i = Size - 2; i > Index; --i)
+				{
+					Data[i] = std::move(Data[i - 1]);  ///< Desplazar los elementos hacia la derecha movindolos.
+				}
+				Data[Index] = std::move(Element);
 			}
-			Data[Size++] = Element;  ///< Aadir el nuevo elemento y aumentar el tamao.
 		}
 
 		/**
-		 * @brief Elimina el elemento en la posicin especificada.
+		 * @brief Elimina el elemento en la posicin especificada conservando el orden.
 		 *
 		 * @param Index La posicin del elemento a eliminar.
 		 */
@@ -102,13 +357,64 @@ namespace EngineUtilities {
 				std::cerr << "Index out of range" << std::endl;  ///< Manejar el caso de ndice fuera de rango.
 				return;
 			}
-			for (size_t i = Index; i < Size - 1; ++i)
+			if constexpr (TIsTriviallyRelocatable<T>::value)
+			{
+				Data[Index].~T();
+				std::memmove(static_cast<void*>(Data + Index), static_cast<const void*>(Data + Index + 1), (Size - Index - 1) * sizeof(T));
+			}
+			else
 			{
-				Data[i] = Data[i + 1];  ///< Desplazar los elementos hacia la izquierda para llenar el hueco.
+				for (size_t i = Index; i < Size - 1; ++i)
+				{
+					Data[i] = std::move(Data[i + 1]);  ///< Desplazar los elementos hacia la izquierda movindolos.
+				}
+				Data[Size - 1].~T();
 			}
 			--Size;  ///< Disminuir el tamao del array.
 		}
 
+		/**
+		 * @brief Elimina el elemento en la posicin especificada en O(1) sin conservar el orden.
+		 *
+		 * El ltimo elemento se mueve al hueco que deja el eliminado.
+		 *
+		 * @param Index La posicin del elemento a eliminar.
+		 */
+		void RemoveAtSwap(size_t Index)
+		{
+			if (Index >= Size)
+			{
+				std::cerr << "Index out of range" << std::endl;  ///< Manejar el caso de ndice fuera de rango.
+				return;
+			}
+			if (Index != Size - 1)
+			{
+				Data[Index] = std::move(Data[Size - 1]);
+			}
+			Data[Size - 1].~T();
+			--Size;
+		}
+
+		/**
+		 * @brief Destruye todos los elementos conservando la capacidad reservada.
+		 */
+		void Empty()
+		{
+			DestroyRange(Data, Data + Size);
+			Size = 0;
+		}
+
+		/**
+		 * @brief Reduce la capacidad al nmero de elementos actual.
+		 */
+		void ShrinkToFit()
+		{
+			if (Capacity != Size)
+			{
+				Resize(Size);
+			}
+		}
+
 		/**
 		 * @brief Sobrecarga del operador [] para acceder a elementos por ndice.
 		 *
@@ -119,8 +425,7 @@ namespace EngineUtilities {
 		{
 			if (Index >= Size)
 			{
-				std::cerr << "Index out of range" << std::endl;  ///< Manejar el caso de ndice fuera de rango.
-				exit(1);  ///< Salir del programa en caso de error.
+				OutOfRange();  ///< Salir del programa en caso de error.
 			}
 			return Data[Index];  ///< Devolver el elemento en la posicin especificada.
 		}
@@ -135,8 +440,7 @@ namespace EngineUtilities {
 		{
 			if (Index >= Size)
 			{
-				std::cerr << "Index out of range" << std::endl;  ///< Manejar el caso de ndice fuera de rango.
-				exit(1);  ///< Salir del programa en caso de error.
+				OutOfRange();  ///< Salir del programa en caso de error.
 			}
 			return Data[Index];  ///< Devolver el elemento en la posicin especificada.
 		}
@@ -160,6 +464,20 @@ namespace EngineUtilities {
 		{
 			return Capacity;  ///< Devolver la capacidad actual del array.
 		}
+
+		/**
+		 * @brief Devuelve un puntero a los elementos contiguos del array.
+		 */
+		T* GetData() { return Data; }
+		const T* GetData() const { return Data; }
+
+		/**
+		 * @brief Iteradores para recorrer el array con un bucle for de rango.
+		 */
+		T* begin() { return Data; }
+		T* end() { return Data + Size; }
+		const T* begin() const { return Data; }
+		const T* end() const { return Data + Size; }
 	};
 
 	// EXAMPLE
@@ -169,24 +487,27 @@ namespace EngineUtilities {
 
 		// TArray Example
 		TArray<int> MyArray;
+		MyArray.Reserve(8);
 		MyArray.Add(1);
 		MyArray.Add(2);
 		MyArray.Add(3);
 		MyArray.Add(4);
 		MyArray.Add(5);
 
-		MyArray.Add(6);
+		MyArray.Emplace(6);
 		MyArray.RemoveAt(2);
+		MyArray.RemoveAtSwap(0);
 
-		for (size_t i = 0; i < MyArray.Num(); ++i)
+		for (int Value : MyArray)
 		{
-			std::cout << MyArray[i] << " ";
+			std::cout << Value << " ";
 		}
 		std::cout << std::endl;
 
+		MyArray.ShrinkToFit();
 		std::cout << "Size: " << MyArray.Num() << ", Capacity: " << MyArray.GetCapacity() << std::endl;
 
 		return 0;
 	}
 	*/
-}
\ No newline at end of file
+}
@@ -0,0 +1,285 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include "TArray.h"
+#include "TFlatSet.h"
+#include "TPair.h"
+
+namespace EngineUtilities {
+	/**
+	 * @brief TFlatMap es un mapa ordenado con las claves y los valores en dos arrays contiguos paralelos.
+	 *
+	 * Pensado para tablas pequeas y calientes (ranuras de materiales, descriptores de samplers...):
+	 * la bsqueda solo recorre el array de claves, sin saltos (ver FlatLowerBound), y el valor se lee
+	 * con el mismo ndice. Add y Remove son O(n) por el desplazamiento; para cargar la tabla de
+	 * golpe usar Build, que ordena una sola vez.
+	 *
+	 * @tparam K El tipo de las claves.
+	 * @tparam V El tipo de los valores.
+	 * @tparam Compare Functor de orden (por defecto TLess, transparente).
+	 */
+	template<typename K, typename V, typename Compare = TLess>
+	class TFlatMap
+	{
+	public:
+		using Pair = TPair<K, V>;  ///< Tipo usado para construir el mapa.
+
+		/**
+		 * @brief Iterador en orden de clave. Devuelve un TPair de referencias (clave constante).
+		 */
+		template<typename ValueType, typename MapType>
+		class TIterator
+		{
+		public:
+			TIterator(MapType* InMap, size_t InIndex) : Map(InMap), Index(InIndex) {}
+			TPair<const K&, ValueType&> operator*() const
+			{
+				return TPair<const K&, ValueType&>(Map->Keys.GetData()[Index], Map->Values.GetData()[Index]);
+			}
+			TIterator& operator++() { ++Index; return *this; }
+			bool operator==(const TIterator& Other) const { return Index == Other.Index; }
+			bool operator!=(const TIterator& Other) const { return Index != Other.Index; }
+
+		private:
+			MapType* Map;
+			size_t Index;
+		};
+
+		using Iterator = TIterator<V, TFlatMap>;
+		using ConstIterator = TIterator<const V, const TFlatMap>;
+
+		/**
+		 * @brief Constructor por defecto.
+		 */
+		TFlatMap() = default;
+
+		/**
+		 * @brief Construye el mapa a partir de pares sin ordenar con una sola ordenacin.
+		 *
+		 * Si una clave se repite, gana el ltimo par con esa clave.
+		 *
+		 * @param Pairs Pares en cualquier orden.
+		 */
+		void Build(TArray<Pair>&& Pairs)
+		{
+			Compare Less;
+			std::stable_sort(Pairs.begin(), Pairs.end(),
+				[&Less](const Pair& Left, const Pair& Right) { return Less(Left.Key, Right.Key); });
+
+			Keys.Empty();
+			Values.Empty();
+			Keys.Reserve(Pairs.Num());
+			Values.Reserve(Pairs.Num());
+			for (size_t i = 0; i < Pairs.Num(); ++i)
+			{
+				bool LastOfKey = i + 1 == Pairs.Num() || Less(Pairs[i].Key, Pairs[i + 1].Key);
+				if (LastOfKey)
+				{
+					Keys.Add(std::move(Pairs[i].Key));
+					Values.Add(std::move(Pairs[i].Value));
+				}
+			}
+		}
+
+		/**
+		 * @brief Inserta un par construido a partir de Key y Value si la clave no existe.
+		 *
+		 * @return Referencia al valor asociado a la clave (nuevo o existente).
+		 */
+		template<typename InKeyType, typename... ArgsType>
+		V& Emplace(InKeyType&& Key, ArgsType&&... Args)
+		{
+			size_t Index = LowerBound(Key);
+			if (Index < Keys.Num() && IsEqual(Keys[Index], Key))
+			{
+				return Values[Index];
+			}
+			Keys.Insert(Index, K(std::forward<InKeyType>(Key)));
+			Values.Insert(Index, V(std::forward<ArgsType>(Args)...));
+			return Values[Index];
+		}
+
+		/**
+		 * @brief Aade un nuevo par clave-valor; si la clave existe, sustituye su valor.
+		 */
+		void Add(const K& Key, const V& Value)
+		{
+			Emplace(Key) = Value;
+		}
+
+		/**
+		 * @brief Aade un nuevo par clave-valor moviendo la clave y el valor.
+		 */
+		void Add(K&& Key, V&& Value)
+		{
+			Emplace(std::move(Key)) = std::move(Value);
+		}
+
+		/**
+		 * @brief Elimina el par con la clave especificada.
+		 *
+		 * @return true si la clave exista.
+		 */
+		template<typename Q>
+		bool Remove(const Q& Key)
+		{
+			size_t Index = LowerBound(Key);
+			if (Index < Keys.Num() && IsEqual(Keys[Index], Key))
+			{
+				Keys.RemoveAt(Index);
+				Values.RemoveAt(Index);
+				return true;
+			}
+			return false;
+		}
+
+		/**
+		 * @brief Busca el valor asociado a una clave.
+		 *
+		 * @return Puntero al valor, o nullptr si la clave no existe.
+		 */
+		template<typename Q>
+		V* Find(const Q& Key)
+		{
+			size_t Index = LowerBound(Key);
+			return Index < Keys.Num() && IsEqual(Keys.GetData()[Index], Key) ? Values.GetData() + Index : nullptr;
+		}
+
+		/**
+		 * @brief Versin constante de Find.
+		 */
+		template<typename Q>
+		const V* Find(const Q& Key) const
+		{
+			size_t Index = LowerBound(Key);
+			return Index < Keys.Num() && IsEqual(Keys.GetData()[Index], Key) ? Values.GetData() + Index : nullptr;
+		}
+
+		/**
+		 * @brief Verifica si el mapa contiene la clave especificada.
+		 */
+		template<typename Q>
+		bool Contains(const Q& Key) const
+		{
+			return Find(Key) != nullptr;
+		}
+
+		/**
+		 * @brief Sobrecarga del operador [] para acceder a valores por clave.
+		 *
+		 * Si la clave no existe, inserta un valor construido por defecto.
+		 */
+		V& operator[](const K& Key)
+		{
+			return Emplace(Key);
+		}
+
+		/**
+		 * @brief Garantiza capacidad para al menos NewCapacity pares.
+		 */
+		void Reserve(size_t NewCapacity)
+		{
+			Keys.Reserve(NewCapacity);
+			Values.Reserve(NewCapacity);
+		}
+
+		/**
+		 * @brief Elimina todos los pares conservando la capacidad.
+		 */
+		void Empty()
+		{
+			Keys.Empty();
+			Values.Empty();
+		}
+
+		/**
+		 * @brief Devuelve el nmero de pares actualmente en el mapa.
+		 */
+		size_t Num() const { return Keys.Num(); }
+
+		/**
+		 * @brief Claves ordenadas y valores en el mismo orden.
+		 */
+		const TArray<K>& GetKeys() const { return Keys; }
+		const TArray<V>& GetValues() const { return Values; }
+		TArray<V>& GetValues() { return Values; }
+
+		/**
+		 * @brief Iteradores sobre los pares en orden de clave.
+		 */
+		Iterator begin() { return Iterator(this, 0); }
+		Iterator end() { return Iterator(this, Keys.Num()); }
+		ConstIterator begin() const { return ConstIterator(this, 0); }
+		ConstIterator end() const { return ConstIterator(this, Keys.Num()); }
+
+	private:
+		template<typename Q>
+		size_t LowerBound(const Q& Key) const
+		{
+			return FlatLowerBound(Keys.GetData(), Keys.Num(), Key, Compare());
+		}
+
+		template<typename Q>
+		static bool IsEqual(const K& Stored, const Q& Key)
+		{
+			return !Compare()(Key, Stored);  ///< Stored ya no es menor que Key: basta con la otra comparacin.
+		}
+
+		TArray<K> Keys;    ///< Claves ordenadas.
+		TArray<V> Values;  ///< Values[i] corresponde a Keys[i].
+	};
+
+	// EXAMPLE
+
+	/*
+	int main() {
+		TArray<TFlatMap<std::string, int>::Pair> Pairs;
+		Pairs.Add(TFlatMap<std::string, int>::Pair("Diffuse", 0));
+		Pairs.Add(TFlatMap<std::string, int>::Pair("Normal", 1));
+
+		TFlatMap<std::string, int> MaterialSlots;
+		MaterialSlots.Build(std::move(Pairs));
+		MaterialSlots.Add("Specular", 2);
+
+		if (const int* Slot = MaterialSlots.Find("Normal"))
+		{
+			std::cout << "Normal -> " << *Slot << std::endl;
+		}
+		for (auto Entry : MaterialSlots)
+		{
+			std::cout << Entry.Key << " = " << Entry.Value << std::endl;
+		}
+		return 0;
+	}
+	*/
+}
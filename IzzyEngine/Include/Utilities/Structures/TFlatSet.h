@@ -0,0 +1,233 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include "TArray.h"
+
+namespace EngineUtilities {
+	/**
+	 * @brief Functor de orden transparente: compara claves de tipos distintos (por ejemplo std::string y const char*).
+	 */
+	struct TLess
+	{
+		using is_transparent = void;
+
+		template<typename A, typename B>
+		bool operator()(const A& Left, const B& Right) const
+		{
+			return Left < Right;
+		}
+	};
+
+	/**
+	 * @brief Bsqueda binaria sin saltos: devuelve la primera posicin cuya clave no es menor que Key.
+	 *
+	 * El bucle siempre da log2(Count) pasos y la eleccin de mitad se compila como un cmov,
+	 * as que no hay predicciones de salto fallidas en tablas pequeas que se consultan cada frame.
+	 *
+	 * @param Keys Claves ordenadas.
+	 * @param Count Nmero de claves.
+	 * @param Key Clave buscada.
+	 * @param Compare Functor de orden.
+	 */
+	template<typename K, typename Q, typename Compare>
+	size_t FlatLowerBound(const K* Keys, size_t Count, const Q& Key, const Compare& Less)
+	{
+		if (Count == 0)
+		{
+			return 0;
+		}
+		const K* Base = Keys;
+		while (Count > 1)
+		{
+			size_t Half = Count / 2;
+			Base = Less(Base[Half], Key) ? Base + Half : Base;
+			Count -= Half;
+		}
+		return static_cast<size_t>(Base - Keys) + (Less(*Base, Key) ? 1 : 0);
+	}
+
+	/**
+	 * @brief TFlatSet es un conjunto ordenado guardado en un nico array contiguo.
+	 *
+	 * Pensado para tablas pequeas (decenas de elementos) que se leen mucho ms de lo que se
+	 * modifican: Contains es una bsqueda binaria sin saltos sobre memoria contigua, Add y Remove
+	 * son O(n) por el desplazamiento. Para cargar muchos elementos de golpe usar Build (una sola ordenacin).
+	 *
+	 * @tparam K El tipo de los elementos.
+	 * @tparam Compare Functor de orden (por defecto TLess, transparente).
+	 */
+	template<typename K, typename Compare = TLess>
+	class TFlatSet
+	{
+	public:
+		/**
+		 * @brief Constructor por defecto.
+		 */
+		TFlatSet() = default;
+
+		/**
+		 * @brief Construye el conjunto a partir de elementos sin ordenar con una sola ordenacin.
+		 *
+		 * Los duplicados se eliminan.
+		 *
+		 * @param InKeys Elementos en cualquier orden.
+		 */
+		void Build(TArray<K>&& InKeys)
+		{
+			Keys = std::move(InKeys);
+			Compare Less;
+			std::sort(Keys.begin(), Keys.end(), Less);
+			K* Last = std::unique(Keys.begin(), Keys.end(),
+				[&Less](const K& Left, const K& Right) { return !Less(Left, Right) && !Less(Right, Left); });
+			while (Keys.end() != Last)
+			{
+				Keys.RemoveAt(Keys.Num() - 1);
+			}
+		}
+
+		/**
+		 * @brief Aade un elemento si no existe.
+		 *
+		 * @return true si se aadi, false si ya estaba.
+		 */
+		bool Add(const K& Key)
+		{
+			size_t Index = LowerBound(Key);
+			if (Index < Keys.Num() && IsEqual(Keys[Index], Key))
+			{
+				return false;
+			}
+			Keys.Insert(Index, Key);
+			return true;
+		}
+
+		/**
+		 * @brief Elimina un elemento.
+		 *
+		 * @return true si el elemento exista.
+		 */
+		template<typename Q>
+		bool Remove(const Q& Key)
+		{
+			size_t Index = LowerBound(Key);
+			if (Index < Keys.Num() && IsEqual(Keys[Index], Key))
+			{
+				Keys.RemoveAt(Index);
+				return true;
+			}
+			return false;
+		}
+
+		/**
+		 * @brief Verifica si el conjunto contiene el elemento.
+		 */
+		template<typename Q>
+		bool Contains(const Q& Key) const
+		{
+			size_t Index = LowerBound(Key);
+			return Index < Keys.Num() && IsEqual(Keys.GetData()[Index], Key);
+		}
+
+		/**
+		 * @brief Posicin de un elemento en el array ordenado, o Num() si no existe.
+		 */
+		template<typename Q>
+		size_t IndexOf(const Q& Key) const
+		{
+			size_t Index = LowerBound(Key);
+			return Index < Keys.Num() && IsEqual(Keys.GetData()[Index], Key) ? Index : Keys.Num();
+		}
+
+		/**
+		 * @brief Garantiza capacidad para al menos NewCapacity elementos.
+		 */
+		void Reserve(size_t NewCapacity) { Keys.Reserve(NewCapacity); }
+
+		/**
+		 * @brief Elimina todos los elementos conservando la capacidad.
+		 */
+		void Empty() { Keys.Empty(); }
+
+		/**
+		 * @brief Devuelve el nmero de elementos.
+		 */
+		size_t Num() const { return Keys.Num(); }
+
+		/**
+		 * @brief Elementos ordenados.
+		 */
+		const TArray<K>& GetKeys() const { return Keys; }
+
+		/**
+		 * @brief Iteradores sobre los elementos en orden.
+		 */
+		const K* begin() const { return Keys.begin(); }
+		const K* end() const { return Keys.end(); }
+
+	private:
+		template<typename Q>
+		size_t LowerBound(const Q& Key) const
+		{
+			return FlatLowerBound(Keys.GetData(), Keys.Num(), Key, Compare());
+		}
+
+		template<typename Q>
+		static bool IsEqual(const K& Stored, const Q& Key)
+		{
+			return !Compare()(Key, Stored);  ///< Stored ya no es menor que Key: basta con la otra comparacin.
+		}
+
+		TArray<K> Keys;  ///< Elementos ordenados.
+	};
+
+	// EXAMPLE
+
+	/*
+	int main() {
+		TArray<int> Unsorted;
+		Unsorted.Add(5);
+		Unsorted.Add(1);
+		Unsorted.Add(5);
+
+		TFlatSet<int> Slots;
+		Slots.Build(std::move(Unsorted));  // 1 5
+		Slots.Add(3);
+		std::cout << Slots.Contains(3) << std::endl;  // 1
+		for (int Slot : Slots)
+		{
+			std::cout << Slot << " ";  // 1 3 5
+		}
+		return 0;
+	}
+	*/
+}
@@ -0,0 +1,105 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace EngineUtilities {
+	/**
+	 * @brief Mezcla los bits de un hash para que los bits bajos dependan de todos los de entrada.
+	 *
+	 * Los contenedores hash del motor indexan con los bits bajos (capacidad potencia de dos),
+	 * y std::hash de enteros y punteros suele ser la identidad, as que todo hash pasa por aqu.
+	 *
+	 * @param Value Hash original.
+	 * @return Hash mezclado.
+	 */
+	inline size_t HashMix(uint64_t Value)
+	{
+		Value ^= Value >> 33;
+		Value *= 0xff51afd7ed558ccdULL;
+		Value ^= Value >> 33;
+		Value *= 0xc4ceb9fe1a85ec53ULL;
+		Value ^= Value >> 33;
+		return static_cast<size_t>(Value);
+	}
+
+	/**
+	 * @brief Funcin hash por defecto de TMap y TSet.
+	 *
+	 * Usa std::hash y mezcla el resultado. Se puede especializar para tipos propios
+	 * o sustituir por cualquier functor pasado como parmetro de plantilla del contenedor.
+	 *
+	 * @tparam T Tipo de la clave.
+	 */
+	template<typename T>
+	struct THash
+	{
+		size_t operator()(const T& Value) const
+		{
+			return HashMix(static_cast<uint64_t>(std::hash<T>{}(Value)));
+		}
+	};
+
+	/**
+	 * @brief Hash de cadenas con bsqueda heterognea.
+	 *
+	 * Acepta std::string, std::string_view y const char* con el mismo resultado, de modo que
+	 * un TMap<std::string, V> puede consultarse con un literal sin construir un std::string.
+	 */
+	template<>
+	struct THash<std::string>
+	{
+		using is_transparent = void;
+
+		size_t operator()(std::string_view Value) const
+		{
+			return HashMix(static_cast<uint64_t>(std::hash<std::string_view>{}(Value)));
+		}
+	};
+
+	/**
+	 * @brief Comparador de igualdad por defecto, transparente para bsquedas heterogneas.
+	 */
+	struct TEqualTo
+	{
+		using is_transparent = void;
+
+		template<typename A, typename B>
+		bool operator()(const A& Left, const B& Right) const
+		{
+			return Left == Right;
+		}
+	};
+}
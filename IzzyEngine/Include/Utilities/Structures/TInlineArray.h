@@ -0,0 +1,394 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#pragma once
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "Utilities/Structures/TArray.h"
+
+namespace EngineUtilities {
+	/**
+	 * @brief TInlineArray es un array dinmico que guarda hasta N elementos dentro del propio objeto.
+	 *
+	 * Mientras Num() <= N no hay ninguna reserva en el heap y los elementos estn junto a la
+	 * cabecera del array (un nico acceso a memoria para recorrerlos). Al superar N los elementos
+	 * pasan a un bloque del heap con el mismo crecimiento que TArray.
+	 *
+	 * @tparam T El tipo de elementos almacenados en el array.
+	 * @tparam N Nmero de elementos que caben sin reservar memoria.
+	 */
+	template<typename T, uint32_t N>
+	class TInlineArray
+	{
+		static_assert(N > 0, "TInlineArray needs at least one inline element");
+
+	private:
+		T* Data;            ///< Apunta a InlineStorage o al bloque del heap.
+		uint32_t Size;      ///< Nmero de elementos actualmente en el array.
+		uint32_t Capacity;  ///< Capacidad actual (N mientras los datos son internos).
+		alignas(T) unsigned char InlineStorage[N * sizeof(T)];  ///< Memoria interna para los primeros N elementos.
+
+		T* InlineData() { return reinterpret_cast<T*>(InlineStorage); }
+
+		/**
+		 * @brief Mueve Count elementos de Source a la memoria sin inicializar Dest y destruye los originales.
+		 */
+		static void Relocate(T* Dest, T* Source, size_t Count)
+		{
+			if constexpr (TIsTriviallyRelocatable<T>::value)
+			{
+				if (Count)
+				{
+					std::memcpy(static_cast<void*>(Dest), static_cast<const void*>(Source), Count * sizeof(T));
+				}
+			}
+			else
+			{
+				for (size_t i = 0; i < Count; ++i)
+				{
+					::new (static_cast<void*>(Dest + i)) T(std::move_if_noexcept(Source[i]));
+					Source[i].~T();
+				}
+			}
+		}
+
+		/**
+		 * @brief Destruye los elementos construidos.
+		 */
+		void DestroyElements()
+		{
+			if constexpr (!std::is_trivially_destructible<T>::value)
+			{
+				for (uint32_t i = 0; i < Size; ++i)
+				{
+					Data[i].~T();
+				}
+			}
+		}
+
+		/**
+		 * @brief Libera el bloque del heap, si lo hay.
+		 */
+		void FreeHeap()
+		{
+			if (!IsInline())
+			{
+				THeapAllocator::Deallocate(Data, Capacity * sizeof(T), alignof(T));
+			}
+		}
+
+		/**
+		 * @brief Lleva los elementos a un bloque del heap con NewCapacity posiciones.
+		 */
+		void Grow(uint32_t NewCapacity)
+		{
+			T* NewData = static_cast<T*>(THeapAllocator::Allocate(NewCapacity * sizeof(T), alignof(T)));
+			Relocate(NewData, Data, Size);
+			FreeHeap();
+			Data = NewData;
+			Capacity = NewCapacity;
+		}
+
+		/**
+		 * @brief Maneja un acceso fuera de rango igual que TArray.
+		 */
+		[[noreturn]] static void OutOfRange()
+		{
+			std::cerr << "Index out of range" << std::endl;
+			exit(1);
+		}
+
+		/**
+		 * @brief Roba el contenido de Other (que queda vaco). El array actual debe estar vaco e interno.
+		 */
+		void TakeFrom(TInlineArray& Other)
+		{
+			if (Other.IsInline())
+			{
+				Relocate(InlineData(), Other.Data, Other.Size);
+			}
+			else
+			{
+				Data = Other.Data;
+				Capacity = Other.Capacity;
+				Other.Data = Other.InlineData();
+				Other.Capacity = N;
+			}
+			Size = Other.Size;
+			Other.Size = 0;
+		}
+
+	public:
+		/**
+		 * @brief Constructor por defecto: array vaco usando la memoria interna.
+		 */
+		TInlineArray() : Data(InlineData()), Size(0), Capacity(N) {}
+
+		/**
+		 * @brief Constructor de copia.
+		 */
+		TInlineArray(const TInlineArray& Other) : TInlineArray()
+		{
+			Reserve(Other.Size);
+			for (uint32_t i = 0; i < Other.Size; ++i)
+			{
+				::new (static_cast<void*>(Data + i)) T(Other.Data[i]);
+				++Size;
+			}
+		}
+
+		/**
+		 * @brief Constructor de movimiento. Roba el bloque del heap o mueve los elementos internos.
+		 */
+		TInlineArray(TInlineArray&& Other) noexcept : TInlineArray()
+		{
+			TakeFrom(Other);
+		}
+
+		/**
+		 * @brief Operador de asignacin de copia.
+		 */
+		TInlineArray& operator=(const TInlineArray& Other)
+		{
+			if (this != &Other)
+			{
+				TInlineArray Copy(Other);
+				*this = std::move(Copy);
+			}
+			return *this;
+		}
+
+		/**
+		 * @brief Operador de asignacin de movimiento.
+		 */
+		TInlineArray& operator=(TInlineArray&& Other) noexcept
+		{
+			if (this != &Other)
+			{
+				DestroyElements();
+				FreeHeap();
+				Data = InlineData();
+				Size = 0;
+				Capacity = N;
+				TakeFrom(Other);
+			}
+			return *this;
+		}
+
+		/**
+		 * @brief Destructor que destruye los elementos y libera el bloque del heap si existe.
+		 */
+		~TInlineArray()
+		{
+			DestroyElements();
+			FreeHeap();
+		}
+
+		/**
+		 * @brief Garantiza capacidad para al menos NewCapacity elementos.
+		 */
+		void Reserve(size_t NewCapacity)
+		{
+			if (NewCapacity > Capacity)
+			{
+				Grow(static_cast<uint32_t>(NewCapacity));
+			}
+		}
+
+		/**
+		 * @brief Construye un nuevo elemento al final del array directamente en su memoria.
+		 *
+		 * @param Args Argumentos para el constructor de T.
+		 * @return Referencia al elemento construido.
+		 */
+		template<typename... ArgsType>
+		T& Emplace(ArgsType&&... Args)
+		{
+			if (Size == Capacity)
+			{
+				// Igual que TArray: se construye en el bloque nuevo antes de reubicar, porque los
+				// argumentos pueden referirse a elementos del propio array.
+				uint32_t NewCapacity = Capacity * 2;
+				T* NewData = static_cast<T*>(THeapAllocator::Allocate(NewCapacity * sizeof(T), alignof(T)));
+				::new (static_cast<void*>(NewData + Size)) T(std::forward<ArgsType>(Args)...);
+				Relocate(NewData, Data, Size);
+				FreeHeap();
+				Data = NewData;
+				Capacity = NewCapacity;
+			}
+			else
+			{
+				::new (static_cast<void*>(Data + Size)) T(std::forward<ArgsType>(Args)...);
+			}
+			return Data[Size++];
+		}
+
+		/**
+		 * @brief Aade un nuevo elemento al final del array.
+		 */
+		void Add(const T& Element)
+		{
+			Emplace(Element);
+		}
+
+		/**
+		 * @brief Aade un nuevo elemento al final del array movindolo.
+		 */
+		void Add(T&& Element)
+		{
+			Emplace(std::move(Element));
+		}
+
+		/**
+		 * @brief Elimina el elemento en la posicin especificada conservando el orden.
+		 */
+		void RemoveAt(size_t Index)
+		{
+			if (Index >= Size)
+			{
+				std::cerr << "Index out of range" << std::endl;
+				return;
+			}
+			for (size_t i = Index; i + 1 < Size; ++i)
+			{
+				Data[i] = std::move(Data[i + 1]);
+			}
+			Data[Size - 1].~T();
+			--Size;
+		}
+
+		/**
+		 * @brief Elimina el elemento en la posicin especificada en O(1) sin conservar el orden.
+		 */
+		void RemoveAtSwap(size_t Index)
+		{
+			if (Index >= Size)
+			{
+				std::cerr << "Index out of range" << std::endl;
+				return;
+			}
+			if (Index != Size - 1u)
+			{
+				Data[Index] = std::move(Data[Size - 1]);
+			}
+			Data[Size - 1].~T();
+			--Size;
+		}
+
+		/**
+		 * @brief Destruye todos los elementos conservando la capacidad.
+		 */
+		void Empty()
+		{
+			DestroyElements();
+			Size = 0;
+		}
+
+		/**
+		 * @brief Sobrecarga del operador [] para acceder a elementos por ndice.
+		 */
+		T& operator[](size_t Index)
+		{
+			if (Index >= Size)
+			{
+				OutOfRange();
+			}
+			return Data[Index];
+		}
+
+		/**
+		 * @brief Versin constante de la sobrecarga del operador [].
+		 */
+		const T& operator[](size_t Index) const
+		{
+			if (Index >= Size)
+			{
+				OutOfRange();
+			}
+			return Data[Index];
+		}
+
+		/**
+		 * @brief Devuelve el nmero de elementos actualmente en el array.
+		 */
+		size_t Num() const { return Size; }
+
+		/**
+		 * @brief Devuelve la capacidad actual del array.
+		 */
+		size_t GetCapacity() const { return Capacity; }
+
+		/**
+		 * @brief Indica si los elementos siguen en la memoria interna.
+		 */
+		bool IsInline() const { return Data == reinterpret_cast<const T*>(InlineStorage); }
+
+		/**
+		 * @brief Devuelve un puntero a los elementos contiguos del array.
+		 */
+		T* GetData() { return Data; }
+		const T* GetData() const { return Data; }
+
+		/**
+		 * @brief Iteradores para recorrer el array con un bucle for de rango.
+		 */
+		T* begin() { return Data; }
+		T* end() { return Data + Size; }
+		const T* begin() const { return Data; }
+		const T* end() const { return Data + Size; }
+	};
+
+	// EXAMPLE
+
+	/*
+	int main() {
+		TInlineArray<int, 4> Values;
+		Values.Add(1);
+		Values.Add(2);
+		Values.Add(3);
+		Values.Add(4);
+		std::cout << "Inline: " << Values.IsInline() << std::endl;  // 1
+
+		Values.Add(5);  // Pasa al heap.
+		std::cout << "Inline: " << Values.IsInline() << ", Capacity: " << Values.GetCapacity() << std::endl;
+
+		for (int Value : Values)
+		{
+			std::cout << Value << " ";
+		}
+		std::cout << std::endl;
+		return 0;
+	}
+	*/
+}
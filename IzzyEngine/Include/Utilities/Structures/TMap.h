@@ -27,149 +27,469 @@
  * SOFTWARE.
 */
 #pragma once
+#include <cstdint>
+#include <new>
+#include <utility>
+#include "TPair.h"
+#include "THash.h"
+
 namespace EngineUtilities {
 	/**
-	 * @brief TMap es una clase de mapa (diccionario) dinmica para almacenar pares clave-valor.
+	 * @brief TMap es una clase de mapa (diccionario) hash para almacenar pares clave-valor.
+	 *
+	 * Implementa direccionamiento abierto con Robin Hood hashing: cada ranura guarda la distancia
+	 * a su posicin ideal y, al insertar, un elemento "pobre" (lejos de su posicin) desplaza a uno
+	 * "rico". Esto mantiene las secuencias de sondeo cortas y permite terminar una bsqueda fallida
+	 * en cuanto se encuentra una ranura ms cercana a su origen que la clave buscada.
+	 * El borrado desplaza hacia atrs los elementos siguientes, as que no existen lpidas.
 	 *
-	 * Esta implementacin de TMap proporciona una forma sencilla de almacenar y gestionar
-	 * colecciones de pares clave-valor, con operaciones bsicas como agregar, eliminar y acceder a valores.
-	 * La memoria se gestiona dinmicamente, aumentando la capacidad del mapa segn sea necesario.
+	 * Add, Remove, Find y operator[] son O(1) en promedio.
 	 *
 	 * @tparam K El tipo de las claves.
 	 * @tparam V El tipo de los valores.
+	 * @tparam Hasher Functor hash (por defecto THash<K>). Si define is_transparent, Find acepta otros tipos de clave.
+	 * @tparam KeyEqual Functor de igualdad (por defecto TEqualTo, transparente).
 	 */
-	template<typename K, typename V>
+	template<typename K, typename V, typename Hasher = THash<K>, typename KeyEqual = TEqualTo>
 	class TMap
 	{
+	public:
+		using Pair = TPair<K, V>;  ///< Tipo de los elementos almacenados.
+
 	private:
-		struct Pair
+		/**
+		 * @brief Metadatos de una ranura: distancia de sondeo + 1 (0 = vaca) y parte del hash.
+		 */
+		struct SlotInfo
 		{
-			K Key;
-			V Value;
-
-			Pair() : Key(), Value() {}
-			Pair(const K& Key, const V& Value) : Key(Key), Value(Value) {}
+			uint32_t Distance;
+			uint32_t Hash;
 		};
 
-		Pair* Data;        ///< Puntero a la memoria donde se almacenan los pares clave-valor.
-		size_t Capacity;   ///< Capacidad actual del mapa (nmero de pares que puede almacenar).
+		static constexpr size_t npos = static_cast<size_t>(-1);
+
+		Pair* Data;        ///< Ranuras de pares (memoria sin inicializar salvo las ocupadas).
+		SlotInfo* Info;    ///< Metadatos paralelos a Data.
+		size_t Capacity;   ///< Nmero de ranuras (potencia de dos o cero).
 		size_t Size;       ///< Nmero de pares actualmente en el mapa.
+		Hasher Hash;       ///< Functor hash.
+		KeyEqual Equal;    ///< Functor de igualdad.
+
+		/**
+		 * @brief Nmero mximo de elementos antes de crecer (factor de carga 7/8).
+		 */
+		static size_t MaxLoad(size_t InCapacity)
+		{
+			return InCapacity - InCapacity / 8;
+		}
+
+		/**
+		 * @brief Busca la ranura de una clave.
+		 *
+		 * @return ndice de la ranura o npos si la clave no existe.
+		 */
+		template<typename Q>
+		size_t FindSlot(const Q& Key) const
+		{
+			if (Size == 0)
+			{
+				return npos;
+			}
+			const size_t Mask = Capacity - 1;
+			const size_t KeyHash = Hash(Key);
+			const uint32_t Fragment = static_cast<uint32_t>(KeyHash);
+			size_t Index = KeyHash & Mask;
+			for (uint32_t Distance = 1; ; ++Distance)
+			{
+				const SlotInfo& Slot = Info[Index];
+				if (Slot.Distance < Distance)
+				{
+					return npos;  ///< Vaca o ms rica que nosotros: la clave no puede estar ms adelante.
+				}
+				if (Slot.Hash == Fragment && Equal(Data[Index].Key, Key))
+				{
+					return Index;
+				}
+				Index = (Index + 1) & Mask;
+			}
+		}
+
+		/**
+		 * @brief Inserta un par que se sabe ausente, aplicando el desplazamiento Robin Hood.
+		 *
+		 * Requiere capacidad suficiente.
+		 *
+		 * @return ndice donde qued el par insertado.
+		 */
+		size_t InsertUnique(size_t KeyHash, Pair&& Carry)
+		{
+			const size_t Mask = Capacity - 1;
+			SlotInfo CarryInfo{ 1, static_cast<uint32_t>(KeyHash) };
+			size_t Index = KeyHash & Mask;
+			size_t Result = npos;
+			for (;;)
+			{
+				SlotInfo& Slot = Info[Index];
+				if (Slot.Distance == 0)
+				{
+					::new (static_cast<void*>(Data + Index)) Pair(std::move(Carry));
+					Slot = CarryInfo;
+					++Size;
+					return Result == npos ? Index : Result;
+				}
+				if (Slot.Distance < CarryInfo.Distance)
+				{
+					std::swap(Carry, Data[Index]);  ///< Robar la ranura al elemento ms rico y seguir colocndolo a l.
+					std::swap(CarryInfo, Slot);
+					if (Result == npos)
+					{
+						Result = Index;
+					}
+				}
+				Index = (Index + 1) & Mask;
+				++CarryInfo.Distance;
+			}
+		}
 
 		/**
-		 * @brief Redimensiona el mapa para tener una nueva capacidad.
+		 * @brief Redimensiona el mapa para tener una nueva capacidad y redistribuye los pares.
 		 *
-		 * @param NewCapacity La nueva capacidad del mapa.
+		 * @param NewCapacity La nueva capacidad del mapa (potencia de dos).
 		 */
 		void Resize(size_t NewCapacity)
 		{
-			Pair* NewData = new Pair[NewCapacity];  ///< Crear un nuevo bloque de memoria con la nueva capacidad.
-			for (size_t i = 0; i < Size; ++i)
+			Pair* OldData = Data;
+			SlotInfo* OldInfo = Info;
+			size_t OldCapacity = Capacity;
+
+			Data = static_cast<Pair*>(::operator new(NewCapacity * sizeof(Pair), std::align_val_t(alignof(Pair))));
+			Info = new SlotInfo[NewCapacity]();
+			Capacity = NewCapacity;
+			Size = 0;
+
+			for (size_t i = 0; i < OldCapacity; ++i)
+			{
+				if (OldInfo[i].Distance)
+				{
+					InsertUnique(Hash(OldData[i].Key), std::move(OldData[i]));
+					OldData[i].~Pair();
+				}
+			}
+			Release(OldData, OldInfo);
+		}
+
+		/**
+		 * @brief Garantiza espacio para un elemento ms.
+		 */
+		void GrowIfNeeded()
+		{
+			if (Size + 1 > MaxLoad(Capacity))
+			{
+				Resize(Capacity ? Capacity * 2 : 8);
+			}
+		}
+
+		/**
+		 * @brief Libera la memoria de las ranuras (sin destruir los pares).
+		 */
+		static void Release(Pair* InData, SlotInfo* InInfo)
+		{
+			if (InData)
+			{
+				::operator delete(InData, std::align_val_t(alignof(Pair)));
+			}
+			delete[] InInfo;
+		}
+
+		/**
+		 * @brief Destruye todos los pares ocupados.
+		 */
+		void DestroyAll()
+		{
+			for (size_t i = 0; i < Capacity; ++i)
 			{
-				NewData[i] = Data[i];  ///< Copiar los pares existentes al nuevo bloque de memoria.
+				if (Info[i].Distance)
+				{
+					Data[i].~Pair();
+					Info[i].Distance = 0;
+				}
 			}
-			delete[] Data;  ///< Liberar la memoria del mapa antiguo.
-			Data = NewData; ///< Actualizar el puntero Data para que apunte al nuevo bloque de memoria.
-			Capacity = NewCapacity;  ///< Actualizar la capacidad del mapa.
+			Size = 0;
 		}
 
 	public:
+		/**
+		 * @brief Iterador sobre los pares ocupados del mapa.
+		 */
+		template<typename PairType, typename MapType>
+		class TIterator
+		{
+		public:
+			TIterator(MapType* InMap, size_t InIndex) : Map(InMap), Index(InIndex) { SkipEmpty(); }
+			PairType& operator*() const { return Map->Data[Index]; }
+			PairType* operator->() const { return Map->Data + Index; }
+			TIterator& operator++() { ++Index; SkipEmpty(); return *this; }
+			bool operator==(const TIterator& Other) const { return Index == Other.Index; }
+			bool operator!=(const TIterator& Other) const { return Index != Other.Index; }
+
+		private:
+			void SkipEmpty()
+			{
+				while (Index < Map->Capacity && Map->Info[Index].Distance == 0)
+				{
+					++Index;
+				}
+			}
+
+			MapType* Map;
+			size_t Index;
+		};
+
+		using Iterator = TIterator<Pair, TMap>;
+		using ConstIterator = TIterator<const Pair, const TMap>;
+
 		/**
 		 * @brief Constructor por defecto que inicializa el mapa con capacidad y tamao cero.
 		 */
 		TMap()
-			: Data(nullptr), Capacity(0), Size(0)
+			: Data(nullptr), Info(nullptr), Capacity(0), Size(0)
 		{
 		}
 
+		/**
+		 * @brief Constructor de copia.
+		 */
+		TMap(const TMap& Other)
+			: Data(nullptr), Info(nullptr), Capacity(0), Size(0), Hash(Other.Hash), Equal(Other.Equal)
+		{
+			Reserve(Other.Size);
+			for (const Pair& Element : Other)
+			{
+				InsertUnique(Hash(Element.Key), Pair(Element));
+			}
+		}
+
+		/**
+		 * @brief Constructor de movimiento.
+		 */
+		TMap(TMap&& Other) noexcept
+			: Data(Other.Data), Info(Other.Info), Capacity(Other.Capacity), Size(Other.Size),
+			  Hash(std::move(Other.Hash)), Equal(std::move(Other.Equal))
+		{
+			Other.Data = nullptr;
+			Other.Info = nullptr;
+			Other.Capacity = 0;
+			Other.Size = 0;
+		}
+
+		/**
+		 * @brief Operador de asignacin de copia.
+		 */
+		TMap& operator=(const TMap& Other)
+		{
+			if (this != &Other)
+			{
+				TMap Copy(Other);
+				*this = std::move(Copy);
+			}
+			return *this;
+		}
+
+		/**
+		 * @brief Operador de asignacin de movimiento.
+		 */
+		TMap& operator=(TMap&& Other) noexcept
+		{
+			if (this != &Other)
+			{
+				DestroyAll();
+				Release(Data, Info);
+				Data = Other.Data;
+				Info = Other.Info;
+				Capacity = Other.Capacity;
+				Size = Other.Size;
+				Hash = std::move(Other.Hash);
+				Equal = std::move(Other.Equal);
+				Other.Data = nullptr;
+				Other.Info = nullptr;
+				Other.Capacity = 0;
+				Other.Size = 0;
+			}
+			return *this;
+		}
+
 		/**
 		 * @brief Destructor que libera la memoria asignada al mapa.
 		 */
 		~TMap()
 		{
-			delete[] Data;  ///< Liberar la memoria del mapa.
+			DestroyAll();
+			Release(Data, Info);  ///< Liberar la memoria del mapa.
+		}
+
+		/**
+		 * @brief Reserva espacio para Count pares sin volver a redistribuir.
+		 *
+		 * @param Count Nmero de pares esperado.
+		 */
+		void Reserve(size_t Count)
+		{
+			size_t NewCapacity = Capacity ? Capacity : 8;
+			while (MaxLoad(NewCapacity) < Count)
+			{
+				NewCapacity *= 2;
+			}
+			if (NewCapacity != Capacity)
+			{
+				Resize(NewCapacity);
+			}
+		}
+
+		/**
+		 * @brief Inserta un par construido a partir de Key y Value si la clave no existe.
+		 *
+		 * @return Referencia al valor asociado a la clave (el existente o el nuevo).
+		 */
+		template<typename InKeyType, typename... ArgsType>
+		V& Emplace(InKeyType&& Key, ArgsType&&... Args)
+		{
+			size_t Index = FindSlot(Key);
+			if (Index != npos)
+			{
+				return Data[Index].Value;
+			}
+			// El par se construye antes de crecer: Key y Args pueden referirse a elementos del propio mapa.
+			Pair Carry(K(std::forward<InKeyType>(Key)), V(std::forward<ArgsType>(Args)...));
+			GrowIfNeeded();
+			size_t KeyHash = Hash(Carry.Key);
+			return Data[InsertUnique(KeyHash, std::move(Carry))].Value;
 		}
 
 		/**
 		 * @brief Aade un nuevo par clave-valor al mapa.
 		 *
+		 * Si la clave ya existe se actualiza su valor.
+		 *
 		 * @param Key La clave del nuevo par.
 		 * @param Value El valor del nuevo par.
 		 */
 		void Add(const K& Key, const V& Value)
 		{
-			for (size_t i = 0; i < Size; ++i)
+			size_t Index = FindSlot(Key);
+			if (Index != npos)
 			{
-				if (Data[i].Key == Key)
-				{
-					Data[i].Value = Value;  ///< Actualizar el valor si la clave ya existe.
-					return;
-				}
+				Data[Index].Value = Value;  ///< Actualizar el valor si la clave ya existe.
+				return;
 			}
-			if (Size == Capacity)
+			// Copiar antes de crecer: Key y Value pueden referirse a elementos del propio mapa.
+			Pair Carry(Key, Value);
+			GrowIfNeeded();
+			size_t KeyHash = Hash(Carry.Key);
+			InsertUnique(KeyHash, std::move(Carry));
+		}
+
+		/**
+		 * @brief Aade un nuevo par clave-valor al mapa moviendo la clave y el valor.
+		 */
+		void Add(K&& Key, V&& Value)
+		{
+			size_t Index = FindSlot(Key);
+			if (Index != npos)
 			{
-				Resize(Capacity == 0 ? 1 : Capacity * 2);  ///< Redimensionar si es necesario.
+				Data[Index].Value = std::move(Value);
+				return;
 			}
-			Data[Size++] = Pair(Key, Value);  ///< Aadir el nuevo par y aumentar el tamao.
+			Pair Carry(std::move(Key), std::move(Value));
+			GrowIfNeeded();
+			size_t KeyHash = Hash(Carry.Key);
+			InsertUnique(KeyHash, std::move(Carry));
 		}
 
 		/**
-		 * @brief Elimina el par clave-valor en la posicin especificada.
+		 * @brief Elimina el par con la clave especificada.
+		 *
+		 * Los elementos siguientes de la cadena de sondeo retroceden una ranura, as que
+		 * no quedan lpidas que degraden las bsquedas posteriores.
 		 *
 		 * @param Key La clave del par a eliminar.
+		 * @return true si la clave exista.
 		 */
-		void Remove(const K& Key)
+		template<typename Q>
+		bool Remove(const Q& Key)
 		{
-			for (size_t i = 0; i < Size; ++i)
+			size_t Index = FindSlot(Key);
+			if (Index == npos)
 			{
-				if (Data[i].Key == Key)
-				{
-					for (size_t j = i; j < Size - 1; ++j)
-					{
-						Data[j] = Data[j + 1];  ///< Desplazar los pares hacia la izquierda para llenar el hueco.
-					}
-					--Size;  ///< Disminuir el tamao del mapa.
-					return;
-				}
+				return false;
 			}
-			std::cerr << "Key not found" << std::endl;  ///< Manejar el caso de clave no encontrada.
+			Data[Index].~Pair();
+			const size_t Mask = Capacity - 1;
+			size_t Next = (Index + 1) & Mask;
+			while (Info[Next].Distance > 1)
+			{
+				::new (static_cast<void*>(Data + Index)) Pair(std::move(Data[Next]));  ///< Desplazar el par hacia atrs.
+				Data[Next].~Pair();
+				Info[Index] = Info[Next];
+				--Info[Index].Distance;
+				Index = Next;
+				Next = (Next + 1) & Mask;
+			}
+			Info[Index].Distance = 0;
+			--Size;
+			return true;
+		}
+
+		/**
+		 * @brief Busca el valor asociado a una clave.
+		 *
+		 * @param Key La clave a buscar (puede ser de otro tipo si Hasher es transparente).
+		 * @return Puntero al valor, o nullptr si la clave no existe.
+		 */
+		template<typename Q>
+		V* Find(const Q& Key)
+		{
+			size_t Index = FindSlot(Key);
+			return Index == npos ? nullptr : &Data[Index].Value;
+		}
+
+		/**
+		 * @brief Versin constante de Find.
+		 */
+		template<typename Q>
+		const V* Find(const Q& Key) const
+		{
+			size_t Index = FindSlot(Key);
+			return Index == npos ? nullptr : &Data[Index].Value;
+		}
+
+		/**
+		 * @brief Verifica si el mapa contiene la clave especificada.
+		 */
+		template<typename Q>
+		bool Contains(const Q& Key) const
+		{
+			return FindSlot(Key) != npos;
 		}
 
 		/**
 		 * @brief Sobrecarga del operador [] para acceder a valores por clave.
 		 *
+		 * Si la clave no existe se inserta con un valor construido por defecto.
+		 *
 		 * @param Key La clave del valor a acceder.
 		 * @return Referencia al valor asociado con la clave especificada.
 		 */
 		V& operator[](const K& Key)
 		{
-			for (size_t i = 0; i < Size; ++i)
-			{
-				if (Data[i].Key == Key)
-				{
-					return Data[i].Value;  ///< Devolver el valor si la clave se encuentra.
-				}
-			}
-			std::cerr << "Key not found" << std::endl;  ///< Manejar el caso de clave no encontrada.
-			exit(1);  ///< Salir del programa en caso de error.
+			return Emplace(Key);
 		}
 
 		/**
-		 * @brief Versin constante de la sobrecarga del operador [] para acceder a valores por clave.
-		 *
-		 * @param Key La clave del valor a acceder.
-		 * @return Referencia constante al valor asociado con la clave especificada.
+		 * @brief Elimina todos los pares conservando la capacidad.
 		 */
-		const V& operator[](const K& Key) const
+		void Empty()
 		{
-			for (size_t i = 0; i < Size; ++i)
-			{
-				if (Data[i].Key == Key)
-				{
-					return Data[i].Value;  ///< Devolver el valor si la clave se encuentra.
-				}
-			}
-			std::cerr << "Key not found" << std::endl;  ///< Manejar el caso de clave no encontrada.
-			exit(1);  ///< Salir del programa en caso de error.
+			DestroyAll();
 		}
 
 		/**
@@ -191,6 +511,14 @@ namespace EngineUtilities {
 		{
 			return Capacity;  ///< Devolver la capacidad actual del mapa.
 		}
+
+		/**
+		 * @brief Iteradores sobre los pares (en orden arbitrario). No se debe modificar Key.
+		 */
+		Iterator begin() { return Iterator(this, 0); }
+		Iterator end() { return Iterator(this, Capacity); }
+		ConstIterator begin() const { return ConstIterator(this, 0); }
+		ConstIterator end() const { return ConstIterator(this, Capacity); }
 	};
 
 	// EXAMPLE
@@ -198,19 +526,27 @@ namespace EngineUtilities {
 	/*
 	int main()
 	{
-		TMap<int, std::string> MyMap;  ///< Crear una instancia de TMap para claves enteras y valores string.
-		MyMap.Add(1, "One");  ///< Aadir pares clave-valor al mapa.
-		MyMap.Add(2, "Two");
-		MyMap.Add(3, "Three");
+		TMap<std::string, int> MyMap;  ///< Crear una instancia de TMap para claves string y valores enteros.
+		MyMap.Add("One", 1);  ///< Aadir pares clave-valor al mapa.
+		MyMap.Add("Two", 2);
+		MyMap["Three"] = 3;   ///< operator[] inserta la clave si no existe.
 
-		MyMap.Remove(2);  ///< Eliminar el par con clave 2.
+		MyMap.Remove("Two");  ///< Eliminar el par con clave "Two".
 
-		std::cout << "Key 1: " << MyMap[1] << std::endl;  ///< Acceder e imprimir el valor asociado con la clave 1.
-		std::cout << "Key 3: " << MyMap[3] << std::endl;  ///< Acceder e imprimir el valor asociado con la clave 3.
+		if (int* Value = MyMap.Find("One"))  ///< Bsqueda heterognea: no se construye un std::string.
+		{
+			std::cout << "One: " << *Value << std::endl;
+		}
+		std::cout << "Contains Two: " << MyMap.Contains("Two") << std::endl;
+
+		for (auto& Element : MyMap)
+		{
+			std::cout << Element.Key << " -> " << Element.Value << std::endl;
+		}
 
 		std::cout << "Size: " << MyMap.Num() << ", Capacity: " << MyMap.GetCapacity() << std::endl;  ///< Imprimir el tamao y la capacidad del mapa.
 
 		return 0;
 	}
 	*/
-}
\ No newline at end of file
+}
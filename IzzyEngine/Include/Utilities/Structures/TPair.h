@@ -27,11 +27,10 @@
  * SOFTWARE.
 */
 #pragma once
-
-namespace EngineUtilities {
-#pragma once
 #include <iostream>
+#include <utility>
 
+namespace EngineUtilities {
 	/**
 	 * @brief Clase TPair para representar un par de valores.
 	 *
@@ -58,6 +57,18 @@ namespace EngineUtilities {
 		 */
 		TPair(const KeyType& InKey, const ValueType& InValue) : Key(InKey), Value(InValue) {}
 
+		/**
+		 * @brief Constructor que construye la clave y el valor a partir de los argumentos reenviados.
+		 *
+		 * Permite mover claves y valores al par sin copias intermedias.
+		 *
+		 * @param InKey Argumento para construir la clave.
+		 * @param InValue Argumento para construir el valor.
+		 */
+		template <typename InKeyType, typename InValueType>
+		TPair(InKeyType&& InKey, InValueType&& InValue)
+			: Key(std::forward<InKeyType>(InKey)), Value(std::forward<InValueType>(InValue)) {}
+
 		/**
 		 * @brief Clave del par.
 		 */
@@ -27,49 +27,375 @@
  * SOFTWARE.
 */
 #pragma once
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <utility>
+#include "THash.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ENGINE_TSET_SSE2 1
+#include <emmintrin.h>
+#else
+#define ENGINE_TSET_SSE2 0
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 namespace EngineUtilities {
 	/**
-	 * @brief TSet es una clase de conjunto dinmica para almacenar elementos nicos.
+	 * @brief TSet es una clase de conjunto hash para almacenar elementos nicos.
 	 *
-	 * Esta implementacin de TSet proporciona una forma sencilla de almacenar y gestionar
-	 * colecciones de elementos nicos, con operaciones bsicas como agregar, eliminar y verificar la existencia de elementos.
-	 * La memoria se gestiona dinmicamente, aumentando la capacidad del conjunto segn sea necesario.
+	 * La tabla se divide en grupos de 16 ranuras. Cada ranura tiene un byte de control que
+	 * indica si est vaca, borrada o llena; en el ltimo caso guarda 7 bits del hash.
+	 * Una bsqueda compara los 16 bytes de control de un grupo contra esos 7 bits en una
+	 * sola instruccin SSE2 y solo compara elementos cuyos bits coinciden. Los grupos se
+	 * recorren con sondeo cuadrtico y la bsqueda termina en el primer grupo con una ranura vaca.
 	 *
 	 * @tparam T El tipo de los elementos almacenados en el conjunto.
+	 * @tparam Hasher Functor hash (por defecto THash<T>).
+	 * @tparam KeyEqual Functor de igualdad (por defecto TEqualTo, transparente).
 	 */
-	template<typename T>
+	template<typename T, typename Hasher = THash<T>, typename KeyEqual = TEqualTo>
 	class TSet
 	{
 	private:
-		T* Data;        ///< Puntero a la memoria donde se almacenan los elementos.
-		size_t Capacity;   ///< Capacidad actual del conjunto (nmero de elementos que puede almacenar).
+		static constexpr size_t GroupWidth = 16;   ///< Ranuras por grupo (un registro SSE2).
+		static constexpr int8_t CtrlEmpty = -128;  ///< 0b10000000: ranura nunca usada.
+		static constexpr int8_t CtrlDeleted = -2;  ///< 0b11111110: ranura borrada (lpida).
+		static constexpr size_t npos = static_cast<size_t>(-1);
+
+		T* Data;           ///< Ranuras de elementos (memoria sin inicializar salvo las llenas).
+		int8_t* Ctrl;      ///< Bytes de control, uno por ranura.
+		size_t Capacity;   ///< Nmero de ranuras (mltiplo de GroupWidth, potencia de dos, o cero).
 		size_t Size;       ///< Nmero de elementos actualmente en el conjunto.
+		size_t GrowthLeft; ///< Inserciones en ranuras vacas posibles antes de redistribuir.
+		Hasher Hash;       ///< Functor hash.
+		KeyEqual Equal;    ///< Functor de igualdad.
+
+		/**
+		 * @brief ndice del bit menos significativo activo de una mscara no nula.
+		 */
+		static uint32_t CountTrailingZeros(uint32_t Mask)
+		{
+#if defined(_MSC_VER)
+			unsigned long Index;
+			_BitScanForward(&Index, Mask);
+			return static_cast<uint32_t>(Index);
+#else
+			return static_cast<uint32_t>(__builtin_ctz(Mask));
+#endif
+		}
+
+		/**
+		 * @brief Mscara de ranuras de un grupo cuyo byte de control es igual a Value.
+		 */
+		static uint32_t MatchByte(const int8_t* Group, int8_t Value)
+		{
+#if ENGINE_TSET_SSE2
+			__m128i Bytes = _mm_load_si128(reinterpret_cast<const __m128i*>(Group));
+			return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(Bytes, _mm_set1_epi8(Value))));
+#else
+			uint32_t Mask = 0;
+			for (size_t i = 0; i < GroupWidth; ++i)
+			{
+				Mask |= static_cast<uint32_t>(Group[i] == Value) << i;
+			}
+			return Mask;
+#endif
+		}
+
+		/**
+		 * @brief Mscara de ranuras vacas o borradas de un grupo (bit alto activo).
+		 */
+		static uint32_t MatchEmptyOrDeleted(const int8_t* Group)
+		{
+#if ENGINE_TSET_SSE2
+			return static_cast<uint32_t>(_mm_movemask_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(Group))));
+#else
+			uint32_t Mask = 0;
+			for (size_t i = 0; i < GroupWidth; ++i)
+			{
+				Mask |= static_cast<uint32_t>(Group[i] < 0) << i;
+			}
+			return Mask;
+#endif
+		}
+
+		/**
+		 * @brief Nmero mximo de elementos para una capacidad (factor de carga 7/8).
+		 */
+		static size_t MaxLoad(size_t InCapacity)
+		{
+			return InCapacity - InCapacity / 8;
+		}
+
+		/**
+		 * @brief Busca la ranura de un elemento.
+		 *
+		 * @return ndice de la ranura o npos si el elemento no existe.
+		 */
+		template<typename Q>
+		size_t FindSlot(const Q& Element, size_t ElementHash) const
+		{
+			if (Capacity == 0)
+			{
+				return npos;
+			}
+			const size_t GroupMask = Capacity / GroupWidth - 1;
+			const int8_t Fragment = static_cast<int8_t>(ElementHash & 0x7F);
+			size_t Group = (ElementHash >> 7) & GroupMask;
+			for (size_t Step = 1; ; ++Step)
+			{
+				const int8_t* GroupCtrl = Ctrl + Group * GroupWidth;
+				for (uint32_t Mask = MatchByte(GroupCtrl, Fragment); Mask; Mask &= Mask - 1)
+				{
+					size_t Index = Group * GroupWidth + CountTrailingZeros(Mask);
+					if (Equal(Data[Index], Element))
+					{
+						return Index;
+					}
+				}
+				if (MatchByte(GroupCtrl, CtrlEmpty))
+				{
+					return npos;  ///< Un grupo con ranuras vacas nunca estuvo lleno: la bsqueda termina aqu.
+				}
+				Group = (Group + Step) & GroupMask;
+			}
+		}
+
+		/**
+		 * @brief Encuentra la primera ranura vaca o borrada para un hash. Requiere capacidad.
+		 */
+		size_t FindInsertSlot(size_t ElementHash) const
+		{
+			const size_t GroupMask = Capacity / GroupWidth - 1;
+			size_t Group = (ElementHash >> 7) & GroupMask;
+			for (size_t Step = 1; ; ++Step)
+			{
+				uint32_t Mask = MatchEmptyOrDeleted(Ctrl + Group * GroupWidth);
+				if (Mask)
+				{
+					return Group * GroupWidth + CountTrailingZeros(Mask);
+				}
+				Group = (Group + Step) & GroupMask;
+			}
+		}
+
+		/**
+		 * @brief Construye un elemento que se sabe ausente en su ranura. Requiere GrowthLeft > 0.
+		 */
+		template<typename ArgType>
+		void InsertUnique(size_t ElementHash, ArgType&& Element)
+		{
+			size_t Index = FindInsertSlot(ElementHash);
+			if (Ctrl[Index] == CtrlEmpty)
+			{
+				--GrowthLeft;  ///< Reutilizar una lpida no consume crecimiento.
+			}
+			::new (static_cast<void*>(Data + Index)) T(std::forward<ArgType>(Element));
+			Ctrl[Index] = static_cast<int8_t>(ElementHash & 0x7F);
+			++Size;
+		}
 
 		/**
-		 * @brief Redimensiona el conjunto para tener una nueva capacidad.
+		 * @brief Redimensiona el conjunto para tener una nueva capacidad y redistribuye los elementos.
+		 *
+		 * Tambin sirve para limpiar lpidas cuando se llama con la capacidad actual.
 		 *
 		 * @param NewCapacity La nueva capacidad del conjunto.
 		 */
 		void Resize(size_t NewCapacity)
 		{
-			T* NewData = new T[NewCapacity];  ///< Crear un nuevo bloque de memoria con la nueva capacidad.
-			for (size_t i = 0; i < Size; ++i)
+			T* OldData = Data;
+			int8_t* OldCtrl = Ctrl;
+			size_t OldCapacity = Capacity;
+
+			Data = static_cast<T*>(::operator new(NewCapacity * sizeof(T), std::align_val_t(alignof(T))));
+			Ctrl = static_cast<int8_t*>(::operator new(NewCapacity, std::align_val_t(GroupWidth)));
+			std::memset(Ctrl, static_cast<unsigned char>(CtrlEmpty), NewCapacity);
+			Capacity = NewCapacity;
+			Size = 0;
+			GrowthLeft = MaxLoad(NewCapacity);
+
+			for (size_t i = 0; i < OldCapacity; ++i)
+			{
+				if (OldCtrl[i] >= 0)
+				{
+					InsertUnique(Hash(OldData[i]), std::move(OldData[i]));
+					OldData[i].~T();
+				}
+			}
+			Release(OldData, OldCtrl);
+		}
+
+		/**
+		 * @brief Garantiza espacio para un elemento ms.
+		 */
+		void GrowIfNeeded()
+		{
+			if (GrowthLeft == 0)
+			{
+				// Si la mitad de la carga son lpidas basta con redistribuir sin crecer.
+				bool MostlyTombstones = Capacity && Size <= MaxLoad(Capacity) / 2;
+				Resize(Capacity == 0 ? GroupWidth : (MostlyTombstones ? Capacity : Capacity * 2));
+			}
+		}
+
+		/**
+		 * @brief Borra el elemento de una ranura llena.
+		 */
+		void EraseSlot(size_t Index)
+		{
+			Data[Index].~T();
+			// Si el grupo an tiene ranuras vacas nunca estuvo lleno, as que ninguna
+			// bsqueda lo atraviesa y la ranura puede volver a quedar vaca sin lpida.
+			const int8_t* GroupCtrl = Ctrl + (Index & ~(GroupWidth - 1));
+			if (MatchByte(GroupCtrl, CtrlEmpty))
+			{
+				Ctrl[Index] = CtrlEmpty;
+				++GrowthLeft;
+			}
+			else
+			{
+				Ctrl[Index] = CtrlDeleted;
+			}
+			--Size;
+		}
+
+		/**
+		 * @brief Libera la memoria de las ranuras (sin destruir los elementos).
+		 */
+		static void Release(T* InData, int8_t* InCtrl)
+		{
+			if (InData)
+			{
+				::operator delete(InData, std::align_val_t(alignof(T)));
+			}
+			if (InCtrl)
 			{
-				NewData[i] = Data[i];  ///< Copiar los elementos existentes al nuevo bloque de memoria.
+				::operator delete(InCtrl, std::align_val_t(GroupWidth));
 			}
-			delete[] Data;  ///< Liberar la memoria del conjunto antiguo.
-			Data = NewData; ///< Actualizar el puntero Data para que apunte al nuevo bloque de memoria.
-			Capacity = NewCapacity;  ///< Actualizar la capacidad del conjunto.
+		}
+
+		/**
+		 * @brief Destruye todos los elementos y marca todas las ranuras como vacas.
+		 */
+		void DestroyAll()
+		{
+			for (size_t i = 0; i < Capacity; ++i)
+			{
+				if (Ctrl[i] >= 0)
+				{
+					Data[i].~T();
+				}
+			}
+			if (Capacity)
+			{
+				std::memset(Ctrl, static_cast<unsigned char>(CtrlEmpty), Capacity);
+			}
+			Size = 0;
+			GrowthLeft = MaxLoad(Capacity);
 		}
 
 	public:
+		/**
+		 * @brief Iterador sobre los elementos del conjunto (en orden arbitrario).
+		 */
+		class ConstIterator
+		{
+		public:
+			ConstIterator(const TSet* InSet, size_t InIndex) : Set(InSet), Index(InIndex) { SkipEmpty(); }
+			const T& operator*() const { return Set->Data[Index]; }
+			const T* operator->() const { return Set->Data + Index; }
+			ConstIterator& operator++() { ++Index; SkipEmpty(); return *this; }
+			bool operator==(const ConstIterator& Other) const { return Index == Other.Index; }
+			bool operator!=(const ConstIterator& Other) const { return Index != Other.Index; }
+
+		private:
+			void SkipEmpty()
+			{
+				while (Index < Set->Capacity && Set->Ctrl[Index] < 0)
+				{
+					++Index;
+				}
+			}
+
+			const TSet* Set;
+			size_t Index;
+		};
+
 		/**
 		 * @brief Constructor por defecto que inicializa el conjunto con capacidad y tamao cero.
 		 */
 		TSet()
-			: Data(nullptr), Capacity(0), Size(0)
+			: Data(nullptr), Ctrl(nullptr), Capacity(0), Size(0), GrowthLeft(0)
+		{
+		}
+
+		/**
+		 * @brief Constructor de copia.
+		 */
+		TSet(const TSet& Other)
+			: Data(nullptr), Ctrl(nullptr), Capacity(0), Size(0), GrowthLeft(0), Hash(Other.Hash), Equal(Other.Equal)
 		{
+			Append(Other);
+		}
+
+		/**
+		 * @brief Constructor de movimiento.
+		 */
+		TSet(TSet&& Other) noexcept
+			: Data(Other.Data), Ctrl(Other.Ctrl), Capacity(Other.Capacity), Size(Other.Size), GrowthLeft(Other.GrowthLeft),
+			  Hash(std::move(Other.Hash)), Equal(std::move(Other.Equal))
+		{
+			Other.Data = nullptr;
+			Other.Ctrl = nullptr;
+			Other.Capacity = 0;
+			Other.Size = 0;
+			Other.GrowthLeft = 0;
+		}
+
+		/**
+		 * @brief Operador de asignacin de copia.
+		 */
+		TSet& operator=(const TSet& Other)
+		{
+			if (this != &Other)
+			{
+				Empty();
+				Hash = Other.Hash;  ///< Antes de Append: los elementos se recolocan con el hash del origen.
+				Equal = Other.Equal;
+				Append(Other);  ///< Reutiliza la capacidad actual si alcanza.
+			}
+			return *this;
+		}
+
+		/**
+		 * @brief Operador de asignacin de movimiento.
+		 */
+		TSet& operator=(TSet&& Other) noexcept
+		{
+			if (this != &Other)
+			{
+				DestroyAll();
+				Release(Data, Ctrl);
+				Data = Other.Data;
+				Ctrl = Other.Ctrl;
+				Capacity = Other.Capacity;
+				Size = Other.Size;
+				GrowthLeft = Other.GrowthLeft;
+				Hash = std::move(Other.Hash);
+				Equal = std::move(Other.Equal);
+				Other.Data = nullptr;
+				Other.Ctrl = nullptr;
+				Other.Capacity = 0;
+				Other.Size = 0;
+				Other.GrowthLeft = 0;
+			}
+			return *this;
 		}
 
 		/**
@@ -77,47 +403,78 @@ namespace EngineUtilities {
 		 */
 		~TSet()
 		{
-			delete[] Data;  ///< Liberar la memoria del conjunto.
+			DestroyAll();
+			Release(Data, Ctrl);  ///< Liberar la memoria del conjunto.
+		}
+
+		/**
+		 * @brief Reserva espacio para Count elementos sin volver a redistribuir.
+		 *
+		 * @param Count Nmero de elementos esperado.
+		 */
+		void Reserve(size_t Count)
+		{
+			if (Count <= Size + GrowthLeft)
+			{
+				return;
+			}
+			size_t NewCapacity = Capacity ? Capacity : GroupWidth;
+			while (MaxLoad(NewCapacity) < Count)
+			{
+				NewCapacity *= 2;
+			}
+			Resize(NewCapacity);
 		}
 
 		/**
 		 * @brief Aade un nuevo elemento al conjunto.
 		 *
 		 * @param Element El elemento a aadir.
+		 * @return true si el elemento no estaba en el conjunto.
 		 */
-		void Add(const T& Element)
+		bool Add(const T& Element)
 		{
-			if (Contains(Element))
+			size_t ElementHash = Hash(Element);
+			if (FindSlot(Element, ElementHash) != npos)
 			{
-				return;  ///< No aadir duplicados.
+				return false;  ///< No aadir duplicados.
 			}
-			if (Size == Capacity)
+			GrowIfNeeded();
+			InsertUnique(ElementHash, Element);
+			return true;
+		}
+
+		/**
+		 * @brief Aade un nuevo elemento al conjunto movindolo.
+		 */
+		bool Add(T&& Element)
+		{
+			size_t ElementHash = Hash(Element);
+			if (FindSlot(Element, ElementHash) != npos)
 			{
-				Resize(Capacity == 0 ? 1 : Capacity * 2);  ///< Redimensionar si es necesario.
+				return false;
 			}
-			Data[Size++] = Element;  ///< Aadir el nuevo elemento y aumentar el tamao.
+			GrowIfNeeded();
+			InsertUnique(ElementHash, std::move(Element));
+			return true;
 		}
 
 		/**
 		 * @brief Elimina el elemento especificado del conjunto.
 		 *
 		 * @param Element El elemento a eliminar.
+		 * @return true si el elemento estaba en el conjunto.
 		 */
-		void Remove(const T& Element)
+		template<typename Q>
+		bool Remove(const Q& Element)
 		{
-			for (size_t i = 0; i < Size; ++i)
+			size_t Index = FindSlot(Element, Hash(Element));
+			if (Index == npos)
 			{
-				if (Data[i] == Element)
-				{
-					for (size_t j = i; j < Size - 1; ++j)
-					{
-						Data[j] = Data[j + 1];  ///< Desplazar los elementos hacia la izquierda para llenar el hueco.
-					}
-					--Size;  ///< Disminuir el tamao del conjunto.
-					return;
-				}
+				return false;
 			}
-			std::cerr << "Element not found" << std::endl;  ///< Manejar el caso de elemento no encontrado.
+			EraseSlot(Index);
+			return true;
 		}
 
 		/**
@@ -127,16 +484,115 @@ namespace EngineUtilities {
 		 * @return true Si el conjunto contiene el elemento.
 		 * @return false Si el conjunto no contiene el elemento.
 		 */
-		bool Contains(const T& Element) const
+		template<typename Q>
+		bool Contains(const Q& Element) const
 		{
-			for (size_t i = 0; i < Size; ++i)
+			return FindSlot(Element, Hash(Element)) != npos;
+		}
+
+		/**
+		 * @brief Aade un bloque de elementos reservando una sola vez.
+		 *
+		 * @param Elements Puntero al primer elemento.
+		 * @param Count Nmero de elementos.
+		 */
+		void Append(const T* Elements, size_t Count)
+		{
+			Reserve(Size + Count);
+			for (size_t i = 0; i < Count; ++i)
 			{
-				if (Data[i] == Element)
+				Add(Elements[i]);
+			}
+		}
+
+		/**
+		 * @brief Aade todos los elementos de otro conjunto reservando una sola vez.
+		 *
+		 * @param Other Conjunto de origen.
+		 */
+		void Append(const TSet& Other)
+		{
+			Reserve(Size + Other.Size);
+			for (size_t i = 0; i < Other.Capacity; ++i)
+			{
+				if (Other.Ctrl[i] >= 0)
 				{
-					return true;  ///< Devolver true si el elemento se encuentra.
+					Add(Other.Data[i]);
 				}
 			}
-			return false;  ///< Devolver false si el elemento no se encuentra.
+		}
+
+		/**
+		 * @brief Convierte este conjunto en su unin con Other.
+		 */
+		void Union(const TSet& Other)
+		{
+			if (this != &Other)
+			{
+				Append(Other);
+			}
+		}
+
+		/**
+		 * @brief Convierte este conjunto en su interseccin con Other.
+		 *
+		 * Recorre las ranuras en una sola pasada y borra en el sitio; no reserva memoria.
+		 */
+		void Intersect(const TSet& Other)
+		{
+			if (this == &Other)
+			{
+				return;
+			}
+			for (size_t i = 0; i < Capacity && Size; ++i)
+			{
+				if (Ctrl[i] >= 0 && !Other.Contains(Data[i]))
+				{
+					EraseSlot(i);
+				}
+			}
+		}
+
+		/**
+		 * @brief Elimina de este conjunto todos los elementos presentes en Other.
+		 *
+		 * Recorre el conjunto ms pequeo de los dos; no reserva memoria.
+		 */
+		void Difference(const TSet& Other)
+		{
+			if (this == &Other)
+			{
+				Empty();
+				return;
+			}
+			if (Other.Size < Size)
+			{
+				for (size_t i = 0; i < Other.Capacity && Size; ++i)
+				{
+					if (Other.Ctrl[i] >= 0)
+					{
+						Remove(Other.Data[i]);
+					}
+				}
+			}
+			else
+			{
+				for (size_t i = 0; i < Capacity && Size; ++i)
+				{
+					if (Ctrl[i] >= 0 && Other.Contains(Data[i]))
+					{
+						EraseSlot(i);
+					}
+				}
+			}
+		}
+
+		/**
+		 * @brief Elimina todos los elementos conservando la capacidad.
+		 */
+		void Empty()
+		{
+			DestroyAll();
 		}
 
 		/**
@@ -158,6 +614,12 @@ namespace EngineUtilities {
 		{
 			return Capacity;  ///< Devolver la capacidad actual del conjunto.
 		}
+
+		/**
+		 * @brief Iteradores sobre los elementos (en orden arbitrario).
+		 */
+		ConstIterator begin() const { return ConstIterator(this, 0); }
+		ConstIterator end() const { return ConstIterator(this, Capacity); }
 	};
 
 	// Example
@@ -165,19 +627,19 @@ namespace EngineUtilities {
 	/*
 	int main()
 	{
-		TSet<int> MySet;  ///< Crear una instancia de TSet para elementos enteros.
-		MySet.Add(1);  ///< Aadir elementos al conjunto.
-		MySet.Add(2);
-		MySet.Add(3);
-
-		MySet.Remove(2);  ///< Eliminar el elemento 2 del conjunto.
+		TSet<int> Visible;  ///< Crear una instancia de TSet para elementos enteros.
+		TSet<int> Loaded;
+		for (int i = 0; i < 1000; ++i) Visible.Add(i);
+		for (int i = 500; i < 1500; ++i) Loaded.Add(i);
 
-		std::cout << "Contains 1: " << MySet.Contains(1) << std::endl;  ///< Verificar e imprimir si el conjunto contiene el elemento 1.
-		std::cout << "Contains 2: " << MySet.Contains(2) << std::endl;  ///< Verificar e imprimir si el conjunto contiene el elemento 2.
+		Visible.Intersect(Loaded);   ///< Visible = {500..999}, sin reservar memoria.
+		Loaded.Difference(Visible);  ///< Loaded = {1000..1499}.
+		Visible.Union(Loaded);       ///< Visible = {500..1499}.
 
-		std::cout << "Size: " << MySet.Num() << ", Capacity: " << MySet.GetCapacity() << std::endl;  ///< Imprimir el tamao y la capacidad del conjunto.
+		std::cout << "Contains 700: " << Visible.Contains(700) << std::endl;
+		std::cout << "Size: " << Visible.Num() << ", Capacity: " << Visible.GetCapacity() << std::endl;  ///< Imprimir el tamao y la capacidad del conjunto.
 
 		return 0;
 	}
 	*/
-}
\ No newline at end of file
+}
@@ -0,0 +1,355 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace EngineUtilities {
+	/**
+	 * @brief Contador de tareas pendientes de un grupo, para esperar a que terminen todas.
+	 *
+	 * ThreadPool::submit lo incrementa al encolar y lo decrementa cuando la tarea termina.
+	 */
+	class TaskCounter
+	{
+	public:
+		TaskCounter() : Pending(0) {}
+
+		TaskCounter(const TaskCounter&) = delete;
+		TaskCounter& operator=(const TaskCounter&) = delete;
+
+		/**
+		 * @brief Indica si todas las tareas del grupo han terminado.
+		 */
+		bool isDone() const { return Pending.load(std::memory_order_acquire) == 0; }
+
+	private:
+		friend class ThreadPool;
+
+		std::atomic<int32_t> Pending;  ///< Tareas encoladas o en ejecucin.
+	};
+
+	/**
+	 * @brief Pool de hilos con robo de trabajo (work stealing).
+	 *
+	 * Cada hilo trabajador tiene su propia cola: encola y desencola por el final (LIFO, lo ltimo que
+	 * encol sigue en cach) y, cuando se queda sin trabajo, roba del principio de la cola de otro.
+	 * Las tareas que se encolan desde hilos ajenos al pool van a una cola compartida de la que todos roban.
+	 *
+	 * wait() no bloquea el hilo que espera: ejecuta tareas pendientes hasta que su grupo termina. As
+	 * una tarea puede lanzar subtareas y esperarlas (parallelFor dentro de parallelFor) sin bloquear el
+	 * pool, y con cero trabajadores todo se ejecuta en el hilo que espera.
+	 */
+	class ThreadPool
+	{
+	public:
+		using TaskFunction = std::function<void()>;
+
+		/**
+		 * @brief Constructor. Arranca los hilos trabajadores.
+		 *
+		 * @param WorkerCount Hilos trabajadores, sin contar el que llama a wait (puede ser cero).
+		 */
+		explicit ThreadPool(unsigned WorkerCount = defaultWorkerCount()) : Queued(0), Stop(false)
+		{
+			Queues.reserve(WorkerCount + 1);
+			for (unsigned i = 0; i <= WorkerCount; ++i)
+			{
+				Queues.push_back(std::unique_ptr<WorkQueue>(new WorkQueue()));
+			}
+			Workers.reserve(WorkerCount);
+			for (unsigned i = 0; i < WorkerCount; ++i)
+			{
+				Workers.emplace_back([this, i] { workerLoop(i + 1); });
+			}
+		}
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		/**
+		 * @brief Destructor. Los trabajadores terminan las tareas encoladas y se unen.
+		 */
+		~ThreadPool()
+		{
+			{
+				std::lock_guard<std::mutex> Lock(SleepMutex);
+				Stop = true;
+			}
+			WakeUp.notify_all();
+			for (std::thread& Worker : Workers)
+			{
+				Worker.join();
+			}
+		}
+
+		/**
+		 * @brief Pool global del motor, con un trabajador por hilo hardware menos el principal.
+		 *
+		 * No se destruye nunca, como los pools de memoria globales.
+		 */
+		static ThreadPool& get()
+		{
+			static ThreadPool* Instance = new ThreadPool();
+			return *Instance;
+		}
+
+		/**
+		 * @brief Trabajadores por defecto: uno por hilo hardware, menos el hilo principal.
+		 */
+		static unsigned defaultWorkerCount()
+		{
+			unsigned Hardware = std::thread::hardware_concurrency();
+			return Hardware > 1 ? Hardware - 1 : 0;
+		}
+
+		/**
+		 * @brief Hilos que ejecutan tareas: los trabajadores ms el que espera.
+		 */
+		unsigned threadCount() const { return static_cast<unsigned>(Workers.size()) + 1; }
+
+		/**
+		 * @brief Encola una tarea.
+		 *
+		 * @param Function Trabajo a ejecutar; puede encolar ms tareas.
+		 * @param Counter Grupo al que pertenece la tarea (opcional), para esperarla con wait.
+		 */
+		void submit(TaskFunction Function, TaskCounter* Counter = nullptr)
+		{
+			if (Counter)
+			{
+				Counter->Pending.fetch_add(1, std::memory_order_relaxed);
+			}
+			WorkQueue& Queue = *Queues[currentQueueIndex()];
+			{
+				std::lock_guard<std::mutex> Lock(Queue.Mutex);
+				Queue.Tasks.push_back(Task{ std::move(Function), Counter });
+			}
+			Queued.fetch_add(1, std::memory_order_release);
+			if (!Workers.empty())
+			{
+				// Tomar el mutex asegura que un trabajador que estaba a punto de dormirse vea la tarea.
+				{
+					std::lock_guard<std::mutex> Lock(SleepMutex);
+				}
+				WakeUp.notify_one();
+			}
+		}
+
+		/**
+		 * @brief Espera a que termine un grupo de tareas, ejecutando tareas pendientes mientras tanto.
+		 */
+		void wait(TaskCounter& Counter)
+		{
+			unsigned Self = currentQueueIndex();
+			while (!Counter.isDone())
+			{
+				if (!runOne(Self))
+				{
+					std::this_thread::yield();
+				}
+			}
+		}
+
+		/**
+		 * @brief Ejecuta Body(Begin, End) sobre [0, Count) repartido en rangos de al menos Grain elementos.
+		 *
+		 * El hilo que llama ejecuta el primer rango y espera al resto. Con un solo hilo, o con pocos
+		 * elementos, no se encola nada.
+		 *
+		 * @param Count Nmero de elementos.
+		 * @param Grain Elementos mnimos por tarea (como mnimo 1).
+		 * @param Body Se llama como Body(size_t Begin, size_t End), a la vez desde varios hilos.
+		 */
+		template<typename Function>
+		void parallelFor(size_t Count, size_t Grain, Function&& Body)
+		{
+			if (Count == 0)
+			{
+				return;
+			}
+			Grain = std::max<size_t>(Grain, 1);
+			// Unos cuantos rangos por hilo para que el robo reparta bien las cargas desiguales.
+			size_t Tasks = std::min((Count + Grain - 1) / Grain, static_cast<size_t>(threadCount()) * 4);
+			if (Tasks <= 1)
+			{
+				Body(size_t(0), Count);
+				return;
+			}
+			size_t Step = (Count + Tasks - 1) / Tasks;
+			TaskCounter Counter;
+			for (size_t Begin = Step; Begin < Count; Begin += Step)
+			{
+				size_t End = std::min(Begin + Step, Count);
+				submit([&Body, Begin, End] { Body(Begin, End); }, &Counter);
+			}
+			Body(size_t(0), Step);
+			wait(Counter);
+		}
+
+	private:
+		struct Task
+		{
+			TaskFunction Function;  ///< Trabajo.
+			TaskCounter* Counter;   ///< Grupo al que avisar al terminar, o nullptr.
+		};
+
+		struct WorkQueue
+		{
+			std::mutex Mutex;        ///< Protege Tasks (el dueo y los ladrones la comparten).
+			std::deque<Task> Tasks;  ///< El dueo usa el final; los ladrones, el principio.
+		};
+
+		/**
+		 * @brief Cola del hilo actual: la suya si es un trabajador de este pool, la compartida (0) si no.
+		 */
+		unsigned currentQueueIndex() const
+		{
+			return CurrentPool == this ? CurrentQueue : 0;
+		}
+
+		/**
+		 * @brief Saca una tarea (de la cola propia o robada) y la ejecuta.
+		 *
+		 * @return false si no haba ninguna tarea.
+		 */
+		bool runOne(unsigned Self)
+		{
+			Task Next;
+			if (!popOwn(Self, Next) && !steal(Self, Next))
+			{
+				return false;
+			}
+			Queued.fetch_sub(1, std::memory_order_relaxed);
+			Next.Function();
+			if (Next.Counter)
+			{
+				Next.Counter->Pending.fetch_sub(1, std::memory_order_acq_rel);
+			}
+			return true;
+		}
+
+		bool popOwn(unsigned Self, Task& Out)
+		{
+			WorkQueue& Queue = *Queues[Self];
+			std::lock_guard<std::mutex> Lock(Queue.Mutex);
+			if (Queue.Tasks.empty())
+			{
+				return false;
+			}
+			// La cola compartida se consume en orden de llegada; la de un trabajador, lo ms reciente.
+			if (Self == 0)
+			{
+				Out = std::move(Queue.Tasks.front());
+				Queue.Tasks.pop_front();
+			}
+			else
+			{
+				Out = std::move(Queue.Tasks.back());
+				Queue.Tasks.pop_back();
+			}
+			return true;
+		}
+
+		bool steal(unsigned Self, Task& Out)
+		{
+			size_t Count = Queues.size();
+			for (size_t Offset = 1; Offset < Count; ++Offset)
+			{
+				WorkQueue& Victim = *Queues[(Self + Offset) % Count];
+				std::lock_guard<std::mutex> Lock(Victim.Mutex);
+				if (!Victim.Tasks.empty())
+				{
+					Out = std::move(Victim.Tasks.front());
+					Victim.Tasks.pop_front();
+					return true;
+				}
+			}
+			return false;
+		}
+
+		void workerLoop(unsigned Self)
+		{
+			CurrentPool = this;
+			CurrentQueue = Self;
+			for (;;)
+			{
+				if (runOne(Self))
+				{
+					continue;
+				}
+				std::unique_lock<std::mutex> Lock(SleepMutex);
+				WakeUp.wait(Lock, [this] { return Stop || Queued.load(std::memory_order_acquire) > 0; });
+				if (Stop && Queued.load(std::memory_order_acquire) == 0)
+				{
+					return;
+				}
+			}
+		}
+
+		static thread_local const ThreadPool* CurrentPool;  ///< Pool del que es trabajador el hilo actual.
+		static thread_local unsigned CurrentQueue;          ///< Cola propia del hilo actual en ese pool.
+
+		std::vector<std::unique_ptr<WorkQueue>> Queues;  ///< 0: compartida; 1..N: una por trabajador.
+		std::vector<std::thread> Workers;                ///< Hilos trabajadores.
+		std::atomic<int64_t> Queued;                     ///< Tareas encoladas sin empezar (para dormir).
+		std::mutex SleepMutex;                           ///< Protege la espera de los trabajadores.
+		std::condition_variable WakeUp;                  ///< Despierta a los trabajadores al encolar.
+		bool Stop;                                       ///< Los trabajadores deben salir.
+	};
+
+	inline thread_local const ThreadPool* ThreadPool::CurrentPool = nullptr;
+	inline thread_local unsigned ThreadPool::CurrentQueue = 0;
+
+	// EXAMPLE
+
+	/*
+	ThreadPool& Pool = ThreadPool::get();
+
+	// Actualizar un array grande en rangos de al menos 1024 elementos repartidos entre todos los hilos.
+	Pool.parallelFor(Transforms.size(), 1024, [&](size_t Begin, size_t End) {
+		for (size_t i = Begin; i < End; ++i) Transforms[i].update(DeltaTime);
+	});
+
+	// Tareas sueltas agrupadas en un contador.
+	TaskCounter Counter;
+	Pool.submit([] { loadTextures(); }, &Counter);
+	Pool.submit([] { loadMeshes(); }, &Counter);
+	Pool.wait(Counter);
+	*/
+}
@@ -27,31 +27,219 @@
  * SOFTWARE.
 */
 #pragma once
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+// Definir ENGINE_MATH_DISABLE_SIMD fuerza las versiones escalares (para medirlas y compararlas).
+#if !defined(ENGINE_MATH_DISABLE_SIMD) && \
+    (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define ENGINE_MATH_SSE2 1
+#include <emmintrin.h>
+#else
+#define ENGINE_MATH_SSE2 0
+#endif
+
+// El proyecto compila con /fp:fast, que permite reasociar sumas y restas. La reduccin de rango de
+// sin/cos/exp/log depende del orden exacto de las restas, as que estas funciones se compilan en modo precise.
+#if defined(_MSC_VER)
+#pragma float_control(precise, on, push)
+#endif
+
 namespace EngineUtilities {
 
   // Constantes matemticas
   constexpr float PI = 3.14159265358979323846f;
   constexpr float E = 2.71828182845904523536f;
 
-	/**
-		 * @brief Computes the square root using the Newton-Raphson method.
-		 *
-		 * @param value The value to compute the square root of.
-		 * @return The computed square root.
-		 */
-	inline float sqrt(float value) {
-		if (value < 0) {
-			return 0; // Handle negative input gracefully.
-		}
-		float x = value;
-		float y = 1.0f;
-		float epsilon = 0.00001f; // Desired precision.
-		while (x - y > epsilon) {
-			x = (x + y) / 2.0f;
-			y = value / x;
-		}
-		return x;
-	}
+  /**
+   * @brief Constantes y ncleos polinmicos compartidos por las versiones escalares y SIMD
+   * (EngineMathSIMD.h) de las funciones trascendentes.
+   *
+   * Todos los ncleos trabajan sobre un argumento ya reducido a un intervalo pequeo y usan
+   * polinomios minimax (coeficientes de Cephes) evaluados con Horner.
+   */
+  namespace MathDetail {
+    constexpr float TWO_OVER_PI = 0.636619772367581343f;
+
+    // pi/2 en tres partes (Cody-Waite) para la reduccin en float de las versiones SIMD. PIO2_1 tiene
+    // 8 bits significativos y PIO2_2 once, as que q * PIO2_1 y q * PIO2_2 son exactos con |q| < 2^13.
+    // Solo suman 43 bits de pi/2: el error absoluto es ~1e-7, pero cerca de los ceros de sin/cos el
+    // error relativo crece.
+    constexpr float PIO2_1 = 1.5703125f;
+    constexpr float PIO2_2 = 4.837512969970703125e-4f;
+    constexpr float PIO2_3 = 7.54978995489188216e-8f;
+    constexpr float FLOAT_REDUCTION_LIMIT = 8192.0f;
+
+    // pi/2 en tres partes de 24 bits para la reduccin escalar en double: q * parte es exacto con
+    // |q| < 2^29 y la suma cubre 72 bits de pi/2.
+    constexpr double PIO2_D1 = 1.570796251296997;
+    constexpr double PIO2_D2 = 7.549789415861596e-08;
+    constexpr double PIO2_D3 = 5.390302529957765e-15;
+    constexpr float DOUBLE_REDUCTION_LIMIT = 1.0e18f;  ///< Lmite para que el cuadrante quepa en int64.
+
+    // sin(r) = r + r^3 * (S1 + S2 r^2 + S3 r^4) en [-pi/4, pi/4].
+    constexpr float SIN_S1 = -1.6666654611e-1f;
+    constexpr float SIN_S2 = 8.3321608736e-3f;
+    constexpr float SIN_S3 = -1.9515295891e-4f;
+
+    // cos(r) = 1 - r^2/2 + r^4 * (C1 + C2 r^2 + C3 r^4) en [-pi/4, pi/4].
+    constexpr float COS_C1 = 4.166664568298827e-2f;
+    constexpr float COS_C2 = -1.388731625493765e-3f;
+    constexpr float COS_C3 = 2.443315711809948e-5f;
+
+    // exp: x = k ln2 + r con |r| <= ln2/2; ln2 en dos partes.
+    constexpr float LOG2E = 1.44269504088896341f;
+    constexpr float LN2_HI = 0.693359375f;
+    constexpr float LN2_LO = -2.12194440e-4f;
+    constexpr float EXP_MAX = 88.7228393f;   ///< Por encima, exp desborda a infinito.
+    constexpr float EXP_MIN = -103.972076f;  ///< Por debajo, exp es 0 incluso como subnormal.
+    constexpr float EXP_P0 = 1.9875691500e-4f;
+    constexpr float EXP_P1 = 1.3981999507e-3f;
+    constexpr float EXP_P2 = 8.3334519073e-3f;
+    constexpr float EXP_P3 = 4.1665795894e-2f;
+    constexpr float EXP_P4 = 1.6666665459e-1f;
+    constexpr float EXP_P5 = 5.0000001201e-1f;
+
+    // log: x = m 2^e con m en [sqrt(1/2), sqrt(2)); log(1 + f) = f - f^2/2 + f^3 P(f).
+    constexpr float SQRT_HALF = 0.707106781186547524f;
+    constexpr float LOG_P0 = 7.0376836292e-2f;
+    constexpr float LOG_P1 = -1.1514610310e-1f;
+    constexpr float LOG_P2 = 1.1676998740e-1f;
+    constexpr float LOG_P3 = -1.2420140846e-1f;
+    constexpr float LOG_P4 = 1.4249322787e-1f;
+    constexpr float LOG_P5 = -1.6668057665e-1f;
+    constexpr float LOG_P6 = 2.0000714765e-1f;
+    constexpr float LOG_P7 = -2.4999993993e-1f;
+    constexpr float LOG_P8 = 3.3333331174e-1f;
+
+    // asin(x) = x + x^3 P(x^2) en [0, 0.5].
+    constexpr float ASIN_P0 = 4.2163199048e-2f;
+    constexpr float ASIN_P1 = 2.4181311049e-2f;
+    constexpr float ASIN_P2 = 4.5470025998e-2f;
+    constexpr float ASIN_P3 = 7.4953002686e-2f;
+    constexpr float ASIN_P4 = 1.6666752422e-1f;
+
+    // atan(x) = x + x^3 P(x^2) en [-tan(pi/8), tan(pi/8)].
+    constexpr float ATAN_P0 = 8.05374449538e-2f;
+    constexpr float ATAN_P1 = -1.38776856032e-1f;
+    constexpr float ATAN_P2 = 1.99777106478e-1f;
+    constexpr float ATAN_P3 = -3.33329491539e-1f;
+
+    inline float asinPolynomial(float z) {
+      return (((ASIN_P0 * z + ASIN_P1) * z + ASIN_P2) * z + ASIN_P3) * z + ASIN_P4;
+    }
+
+    inline uint32_t floatBits(float value) {
+      uint32_t bits;
+      std::memcpy(&bits, &value, sizeof(bits));
+      return bits;
+    }
+
+    inline float bitsToFloat(uint32_t bits) {
+      float value;
+      std::memcpy(&value, &bits, sizeof(value));
+      return value;
+    }
+
+    /**
+     * @brief 2^k como float para k en [-126, 127].
+     */
+    inline float pow2(int k) {
+      return bitsToFloat(static_cast<uint32_t>(k + 127) << 23);
+    }
+
+    /**
+     * @brief Redondea al entero ms cercano (empates a par con SSE2, lejos de cero sin SSE2).
+     */
+    inline int nearestInt(float value) {
+#if ENGINE_MATH_SSE2
+      return _mm_cvtss_si32(_mm_set_ss(value));
+#else
+      return static_cast<int>(value + bitsToFloat(0x3f000000u | (floatBits(value) & 0x80000000u)));
+#endif
+    }
+
+    inline int64_t nearestInt(double value) {
+#if ENGINE_MATH_SSE2 && (defined(_M_X64) || defined(__x86_64__))
+      return _mm_cvtsd_si64(_mm_set_sd(value));
+#else
+      return static_cast<int64_t>(value + (value >= 0.0 ? 0.5 : -0.5));
+#endif
+    }
+
+    inline float sinKernel(float r) {
+      float z = r * r;
+      return r + r * z * (SIN_S1 + z * (SIN_S2 + z * SIN_S3));
+    }
+
+    inline float cosKernel(float r) {
+      float z = r * r;
+      return 1.0f - 0.5f * z + z * z * (COS_C1 + z * (COS_C2 + z * COS_C3));
+    }
+
+    /**
+     * @brief Reduce angle a r en [-pi/4, pi/4] y devuelve el cuadrante q (angle = q pi/2 + r).
+     *
+     * La resta se hace en double con pi/2 en tres partes: es exacta hasta |angle| ~ 8.4e8 y pierde
+     * precisin poco a poco ms all. Requiere |angle| <= DOUBLE_REDUCTION_LIMIT.
+     */
+    inline int reduceQuadrant(float angle, float& r) {
+      if (angle <= 0.785398163f && angle >= -0.785398163f) {
+        r = angle;
+        return 0;
+      }
+      double x = static_cast<double>(angle);
+      int64_t q = nearestInt(x * 0.63661977236758134308);
+      double qd = static_cast<double>(q);
+      r = static_cast<float>(((x - qd * PIO2_D1) - qd * PIO2_D2) - qd * PIO2_D3);
+      return static_cast<int>(q & 3);
+    }
+
+    /**
+     * @brief Niega value cuando (q & 2) != 0, invirtiendo el bit de signo.
+     */
+    inline float withQuadrantSign(float value, int q) {
+      return bitsToFloat(floatBits(value) ^ (static_cast<uint32_t>(q & 2) << 30));
+    }
+
+    /**
+     * @brief Verdadero si angle es finito y cabe en el rango de reduceQuadrant.
+     */
+    inline bool isReducible(float angle) {
+      return angle == angle && angle <= DOUBLE_REDUCTION_LIMIT && angle >= -DOUBLE_REDUCTION_LIMIT;
+    }
+
+    inline bool isFiniteFloat(float value) {
+      return (floatBits(value) & 0x7f800000u) != 0x7f800000u;
+    }
+  }
+
+  /**
+   * @brief Calcula la raz cuadrada.
+   *
+   * Usa la instruccin sqrtss cuando hay SSE2 (resultado correctamente redondeado, 0.5 ULP).
+   * Sin SSE2 parte de una estimacin por bits de 1/sqrt(x) y aplica tres pasos de Newton-Raphson
+   * (error mximo medido 1.1 ULP con valores normales).
+   *
+   * @param value El valor del cual se desea calcular la raz cuadrada.
+   * @return La raz cuadrada, o 0 si value es negativo.
+   */
+  inline float sqrt(float value) {
+    if (!(value > 0.0f)) {
+      return 0.0f; // Negativos (y NaN) devuelven 0, igual que antes.
+    }
+#if ENGINE_MATH_SSE2
+    return _mm_cvtss_f32(_mm_sqrt_ss(_mm_set_ss(value)));
+#else
+    float y = MathDetail::bitsToFloat(0x5f3759dfu - (MathDetail::floatBits(value) >> 1));
+    for (int i = 0; i < 3; ++i) {
+      y = y * (1.5f - 0.5f * value * y * y);
+    }
+    float root = value * y;
+    return root + 0.5f * (value - root * root) * y;  // Correccin final en la propia raz.
+#endif
+  }
 
   /**
    * @brief Calcula el cuadrado de un nmero.
@@ -59,7 +247,7 @@ namespace EngineUtilities {
    * @param value El valor del cual se desea calcular el cuadrado.
    * @return El cuadrado del valor dado.
    */
-  inline float square(float value) {
+  constexpr float square(float value) {
     return value * value;
   }
 
@@ -69,7 +257,7 @@ namespace EngineUtilities {
    * @param value El valor del cual se desea calcular el cubo.
    * @return El cubo del valor dado.
    */
-  inline float cube(float value) {
+  constexpr float cube(float value) {
     return value * value * value;
   }
 
@@ -80,7 +268,7 @@ namespace EngineUtilities {
    * @param exponent El exponente al que se eleva la base.
    * @return La base elevada al exponente.
    */
-  inline float power(float base, int exponent) {
+  constexpr float power(float base, int exponent) {
     if (exponent == 0) return 1;
     if (exponent < 0) return 1.0f / power(base, -exponent);
     float result = 1;
@@ -98,7 +286,7 @@ namespace EngineUtilities {
    * @param value El valor del cual se desea calcular el valor absoluto.
    * @return El valor absoluto del valor dado.
    */
-  inline float abs(float value) {
+  constexpr float abs(float value) {
     return (value < 0) ? -value : value;
   }
 
@@ -109,7 +297,7 @@ namespace EngineUtilities {
    * @param b El segundo valor.
    * @return El mayor de los dos valores dados.
    */
-  inline float EMax(float a, float b) {
+  constexpr float EMax(float a, float b) {
     return (a > b) ? a : b;
   }
 
@@ -120,7 +308,7 @@ namespace EngineUtilities {
    * @param b El segundo valor.
    * @return El menor de los dos valores dados.
    */
-  inline float EMin(float a, float b) {
+  constexpr float EMin(float a, float b) {
     return (a < b) ? a : b;
   }
 
@@ -130,7 +318,7 @@ namespace EngineUtilities {
    * @param value El valor que se desea redondear.
    * @return El valor redondeado al entero ms cercano.
    */
-  inline float round(float value) {
+  constexpr float round(float value) {
     return (value > 0) ? static_cast<int>(value + 0.5f) : static_cast<int>(value - 0.5f);
   }
 
@@ -140,7 +328,7 @@ namespace EngineUtilities {
    * @param value El valor que se desea truncar.
    * @return La parte entera del valor dado, redondeada hacia abajo.
    */
-  inline float floor(float value) {
+  constexpr float floor(float value) {
     int intValue = static_cast<int>(value);
     return (value < intValue) ? intValue - 1 : intValue;
   }
@@ -151,7 +339,7 @@ namespace EngineUtilities {
    * @param value El valor que se desea redondear hacia arriba.
    * @return El valor redondeado hacia arriba al entero ms cercano.
    */
-  inline float ceil(float value) {
+  constexpr float ceil(float value) {
     int intValue = static_cast<int>(value);
     return (value > intValue) ? intValue + 1 : intValue;
   }
@@ -161,36 +349,71 @@ namespace EngineUtilities {
    * @param value Valor flotante.
    * @return Valor absoluto del nmero flotante.
    */
-  inline float fabs(float value) {
+  constexpr float fabs(float value) {
     return value < 0.0f ? -value : value;
   }
 
   // Funciones Trigonomtricas
+  /**
+   * Calcula el seno y el coseno de un ngulo a la vez (una sola reduccin de rango).
+   *
+   * El ngulo se reduce a r en [-pi/4, pi/4] restando q * pi/2 (Cody-Waite, pi/2 en tres partes)
+   * y se evalan los polinomios minimax de seno y coseno; el cuadrante q elige cul se usa y su signo.
+   * Error mximo medido frente a sin/cos en double: 2 ULP para |angle| <= 8192 y 4 ULP hasta 8.4e8;
+   * ms all la reduccin deja de ser exacta (error absoluto ~1e-4 en 1e12). Devuelve NaN para NaN,
+   * infinito o |angle| > 1e18.
+   *
+   * @param angle ngulo en radianes.
+   * @param outSin Seno del ngulo.
+   * @param outCos Coseno del ngulo.
+   */
+  inline void sincos(float angle, float& outSin, float& outCos) {
+    if (!MathDetail::isReducible(angle)) {
+      outSin = outCos = std::numeric_limits<float>::quiet_NaN();
+      return;
+    }
+    float r;
+    int q = MathDetail::reduceQuadrant(angle, r);
+    // Seleccin sin saltos: con ngulos aleatorios el cuadrante no se puede predecir.
+    float kernels[2] = { MathDetail::sinKernel(r), MathDetail::cosKernel(r) };
+    outSin = MathDetail::withQuadrantSign(kernels[q & 1], q);
+    outCos = MathDetail::withQuadrantSign(kernels[(q + 1) & 1], q + 1);
+  }
+
   /**
    * Calcula el seno de un ngulo en radianes.
+   *
+   * Reduccin de rango y polinomio minimax (ver sincos). Error mximo 2 ULP para |angle| <= 8192.
+   *
    * @param angle ngulo en radianes.
    * @return Valor del seno del ngulo.
    */
   inline float sin(float angle) {
-    float result = 0.0f;
-    float term = angle;
-    float angle_squared = angle * angle;
-    int n = 1;
-    while (term > 1e-6f || term < -1e-6f) {
-      result += term;
-      term *= -angle_squared / ((2 * n) * (2 * n + 1));
-      ++n;
+    if (!MathDetail::isReducible(angle)) {
+      return std::numeric_limits<float>::quiet_NaN();
     }
-    return result;
+    float r;
+    int q = MathDetail::reduceQuadrant(angle, r);
+    float kernels[2] = { MathDetail::sinKernel(r), MathDetail::cosKernel(r) };
+    return MathDetail::withQuadrantSign(kernels[q & 1], q);
   }
 
   /**
    * Calcula el coseno de un ngulo en radianes.
+   *
+   * Reduccin de rango y polinomio minimax (ver sincos). Error mximo 2 ULP para |angle| <= 8192.
+   *
    * @param angle ngulo en radianes.
    * @return Valor del coseno del ngulo.
    */
   inline float cos(float angle) {
-    return sin(angle + PI / 2);
+    if (!MathDetail::isReducible(angle)) {
+      return std::numeric_limits<float>::quiet_NaN();
+    }
+    float r;
+    int q = MathDetail::reduceQuadrant(angle, r);
+    float kernels[2] = { MathDetail::cosKernel(r), MathDetail::sinKernel(r) };
+    return MathDetail::withQuadrantSign(kernels[q & 1], q + 1);
   }
 
   /**
@@ -199,53 +422,182 @@ namespace EngineUtilities {
    * @return Valor de la tangente del ngulo.
    */
   inline float tan(float angle) {
-    float s = sin(angle);
-    float c = cos(angle);
+    float s, c;
+    sincos(angle, s, c);
     return c != 0.0f ? s / c : 0.0f; // Evita la divisin por cero
   }
 
   /**
    * Calcula el arco seno de un valor.
-   * @param value Valor en el rango [-1, 1].
+   *
+   * Para |value| <= 0.5 evala un polinomio minimax; por encima usa asin(x) = pi/2 - 2 asin(sqrt((1 - x) / 2)),
+   * que mantiene el argumento del polinomio pequeo. Error mximo medido: 2.4 ULP.
+   *
+   * @param value Valor en el rango [-1, 1]; fuera de l se satura a +-pi/2.
    * @return ngulo en radianes.
    */
   inline float asin(float value) {
-    // Aproximacin con la serie de Taylor
-    float x = value;
-    float result = x;
-    float term = x;
-    for (int n = 1; n < 10; ++n) {
-      term *= x * x * (2 * n - 1) / ((2 * n + 1) * (2 * n));
-      result += term;
+    using namespace MathDetail;
+    float x = value < 0.0f ? -value : value;
+    float result;
+    if (x > 0.5f) {
+      float z = x < 1.0f ? 0.5f * (1.0f - x) : 0.0f;
+      float root = sqrt(z);
+      result = PI / 2 - 2.0f * (root + root * z * asinPolynomial(z));
     }
-    return result;
+    else {
+      float z = x * x;
+      result = x + x * z * asinPolynomial(z);
+    }
+    return value < 0.0f ? -result : result;
   }
 
   /**
    * Calcula el arco coseno de un valor.
-   * @param value Valor en el rango [-1, 1].
+   *
+   * Cerca de +-1 se calcula como 2 asin(sqrt((1 -+ x) / 2)) en lugar de pi/2 - asin(x), que perdera los
+   * bits bajos justo donde slerp y los ngulos pequeos los necesitan. Error mximo medido: 1.3 ULP.
+   *
+   * @param value Valor en el rango [-1, 1]; fuera de l se satura a 0 o pi.
    * @return ngulo en radianes.
    */
   inline float acos(float value) {
+    using namespace MathDetail;
+    if (value > 0.5f) {
+      float z = value < 1.0f ? 0.5f * (1.0f - value) : 0.0f;
+      float root = sqrt(z);
+      return 2.0f * (root + root * z * asinPolynomial(z));
+    }
+    if (value < -0.5f) {
+      float z = value > -1.0f ? 0.5f * (1.0f + value) : 0.0f;
+      float root = sqrt(z);
+      return PI - 2.0f * (root + root * z * asinPolynomial(z));
+    }
     return PI / 2 - asin(value);
   }
 
   /**
    * Calcula el arco tangente de un valor.
+   *
+   * Reduce |value| a [0, tan(pi/8)] con atan(x) = pi/2 - atan(1/x) y atan(x) = pi/4 + atan((x - 1)/(x + 1)),
+   * y evala un polinomio minimax. Error mximo medido: 2.9 ULP.
+   *
    * @param value Valor.
-   * @return ngulo en radianes.
+   * @return ngulo en radianes, en [-pi/2, pi/2].
    */
   inline float atan(float value) {
-    // Aproximacin de la funcin arcotangente
-    float result = 0.0f;
-    float term = value;
-    for (int n = 0; n < 10; ++n) {
-      result += term / (2 * n + 1);
-      term *= -value * value;
+    using namespace MathDetail;
+    float x = value < 0.0f ? -value : value;
+    float offset = 0.0f;
+    if (x > 2.414213562373095f) {
+      offset = PI / 2;
+      x = -1.0f / x;
+    }
+    else if (x > 0.414213562373095f) {
+      offset = PI / 4;
+      x = (x - 1.0f) / (x + 1.0f);
+    }
+    float z = x * x;
+    float result = offset + (x + x * z * (((ATAN_P0 * z + ATAN_P1) * z + ATAN_P2) * z + ATAN_P3));
+    return value < 0.0f ? -result : result;
+  }
+
+  /**
+   * Calcula el arco tangente de y / x usando los signos de ambos para elegir el cuadrante.
+   * Error mximo medido: 3.1 ULP.
+   * @param y Componente vertical.
+   * @param x Componente horizontal.
+   * @return ngulo en radianes, en [-pi, pi]; 0 si ambos son 0.
+   */
+  inline float atan2(float y, float x) {
+    if (x == 0.0f) {
+      return y > 0.0f ? PI / 2 : (y < 0.0f ? -PI / 2 : 0.0f);
+    }
+    float result = atan(y / x);
+    if (x < 0.0f) {
+      result += y < 0.0f ? -PI : PI;
     }
     return result;
   }
 
+  // Funciones Exponenciales y Logartmicas
+  /**
+   * Calcula la funcin exponencial e^x.
+   *
+   * Se escribe x = k ln2 + r con |r| <= ln2/2, se evala e^r con un polinomio minimax de grado 6
+   * y se multiplica por 2^k construido en los bits del exponente. Error mximo medido: 1 ULP.
+   * Devuelve infinito por encima de ~88.72 y 0 por debajo de ~-103.97 (con subnormales en medio).
+   *
+   * @param value Exponente.
+   * @return Valor de e^x.
+   */
+  inline float exp(float value) {
+    using namespace MathDetail;
+    if (value != value) {
+      return value;
+    }
+    if (value > EXP_MAX) {
+      return std::numeric_limits<float>::infinity();
+    }
+    if (value < EXP_MIN) {
+      return 0.0f;
+    }
+    int k = nearestInt(value * LOG2E);
+    float kf = static_cast<float>(k);
+    float r = (value - kf * LN2_HI) - kf * LN2_LO;
+    float p = ((((EXP_P0 * r + EXP_P1) * r + EXP_P2) * r + EXP_P3) * r + EXP_P4) * r + EXP_P5;
+    float result = p * r * r + r + 1.0f;
+    // 2^k en dos factores para que los resultados subnormales (k < -126) no desborden el exponente.
+    int half = k / 2;
+    return result * pow2(half) * pow2(k - half);
+  }
+
+  /**
+   * Calcula el logaritmo natural de un valor.
+   *
+   * Se separa value = m 2^e con m en [sqrt(1/2), sqrt(2)), se evala log(m) con un polinomio
+   * minimax de grado 8 sobre f = m - 1 y se suma e ln2 (ln2 en dos partes). Error mximo medido: 1 ULP.
+   *
+   * @param value Valor.
+   * @return Logaritmo natural; 0 si value <= 0 (como la versin anterior), infinito para infinito.
+   */
+  inline float log(float value) {
+    using namespace MathDetail;
+    if (!(value > 0.0f)) {
+      return value != value ? value : 0.0f;
+    }
+    if (!isFiniteFloat(value)) {
+      return value;
+    }
+    int exponentBias = 0;
+    if (value < 1.17549435e-38f) {
+      value *= 8388608.0f;  // Subnormal: escalar por 2^23 para tener un exponente normal.
+      exponentBias = -23;
+    }
+    uint32_t bits = floatBits(value);
+    int e = static_cast<int>((bits >> 23) & 0xff) - 126 + exponentBias;
+    float m = bitsToFloat((bits & 0x007fffffu) | 0x3f000000u);  // m en [0.5, 1)
+    // Si m < sqrt(1/2) se usa 2m y e - 1; se escribe sin saltos porque m no es predecible.
+    uint32_t low = m < SQRT_HALF ? 1u : 0u;
+    e -= static_cast<int>(low);
+    float f = (m - 1.0f) + bitsToFloat(floatBits(m) & (0u - low));
+    float z = f * f;
+    float p = ((((((((LOG_P0 * f + LOG_P1) * f + LOG_P2) * f + LOG_P3) * f + LOG_P4) * f + LOG_P5) * f
+                + LOG_P6) * f + LOG_P7) * f + LOG_P8);
+    float ef = static_cast<float>(e);
+    float y = f * z * p + ef * LN2_LO - 0.5f * z;
+    return f + y + ef * LN2_HI;
+  }
+
+  /**
+   * Calcula el logaritmo en base 10 de un valor.
+   * @param value Valor.
+   * @return Logaritmo en base 10.
+   */
+  inline float log10(float value) {
+    return log(value) * 0.434294481903251828f;
+  }
+
   /**
    * Calcula el seno hiperblico de un valor.
    * @param value Valor.
@@ -279,7 +631,7 @@ namespace EngineUtilities {
    * @param degrees ngulo en grados.
    * @return ngulo en radianes.
    */
-  inline float radians(float degrees) {
+  constexpr float radians(float degrees) {
     return degrees * PI / 180.0f;
   }
 
@@ -288,53 +640,10 @@ namespace EngineUtilities {
    * @param radians ngulo en radianes.
    * @return ngulo en grados.
    */
-  inline float degrees(float radians) {
+  constexpr float degrees(float radians) {
     return radians * 180.0f / PI;
   }
 
-  // Funciones Exponenciales y Logartmicas
-  /**
-   * Calcula la funcin exponencial e^x.
-   * @param value Exponente.
-   * @return Valor de e^x.
-   */
-  inline float exp(float value) {
-    float result = 1.0f;
-    float term = 1.0f;
-    for (int n = 1; n < 20; ++n) {
-      term *= value / n;
-      result += term;
-    }
-    return result;
-  }
-
-  /**
-   * Calcula el logaritmo natural de un valor.
-   * @param value Valor.
-   * @return Logaritmo natural.
-   */
-  inline float log(float value) {
-    // Aproximacin usando la serie de Taylor
-    if (value <= 0) return 0;
-    float x = (value - 1) / (value + 1);
-    float x2 = x * x;
-    float result = 0.0f;
-    float term = x;
-    for (int n = 1; n < 20; ++n) {
-      result += term / (2 * n - 1);
-      term *= x2;
-    }
-    return 2 * result;
-  }
-
-  /**
-   * Calcula el logaritmo en base 10 de un valor.
-   * @param value Valor.
-   * @return Logaritmo en base 10.
-   */
-  inline float log10(float value) {
-    return log(value) / log(10);
-  }
 
   // Operaciones de Redondeo Avanzadas
   /**
@@ -343,7 +652,7 @@ namespace EngineUtilities {
    * @param b Divisor.
    * @return Mdulo.
    */
-  inline float mod(float a, float b) {
+  constexpr float mod(float a, float b) {
     return a - b * static_cast<int>(a / b);
   }
 
@@ -353,7 +662,7 @@ namespace EngineUtilities {
    * @param radius Radio del crculo.
    * @return rea del crculo.
    */
-  inline float circleArea(float radius) {
+  constexpr float circleArea(float radius) {
     return PI * radius * radius;
   }
 
@@ -362,7 +671,7 @@ namespace EngineUtilities {
    * @param radius Radio del crculo.
    * @return Circunferencia del crculo.
    */
-  inline float circleCircumference(float radius) {
+  constexpr float circleCircumference(float radius) {
     return 2 * PI * radius;
   }
 
@@ -372,7 +681,7 @@ namespace EngineUtilities {
    * @param height Alto del rectngulo.
    * @return rea del rectngulo.
    */
-  inline float rectangleArea(float width, float height) {
+  constexpr float rectangleArea(float width, float height) {
     return width * height;
   }
 
@@ -382,7 +691,7 @@ namespace EngineUtilities {
    * @param height Alto del rectngulo.
    * @return Permetro del rectngulo.
    */
-  inline float rectanglePerimeter(float width, float height) {
+  constexpr float rectanglePerimeter(float width, float height) {
     return 2 * (width + height);
   }
 
@@ -392,7 +701,7 @@ namespace EngineUtilities {
    * @param height Altura del tringulo.
    * @return rea del tringulo.
    */
-  inline float triangleArea(float base, float height) {
+  constexpr float triangleArea(float base, float height) {
     return 0.5f * base * height;
   }
 
@@ -418,7 +727,7 @@ namespace EngineUtilities {
    * @param t Parmetro de interpolacin entre 0 y 1.
    * @return Valor interpolado.
    */
-  inline float lerp(float a, float b, float t) {
+  constexpr float lerp(float a, float b, float t) {
     return a + t * (b - a);
   }
 
@@ -427,7 +736,7 @@ namespace EngineUtilities {
    * @param n Nmero entero no negativo.
    * @return Factorial de n.
    */
-  inline int factorial(int n) {
+  constexpr int factorial(int n) {
     int result = 1;
     for (int i = 2; i <= n; ++i) {
       result *= i;
@@ -442,8 +751,12 @@ namespace EngineUtilities {
    * @param epsilon Margen de error.
    * @return Verdadero si los valores son aproximadamente iguales.
    */
-  inline bool approxEqual(float a, float b, float epsilon) {
+  constexpr bool approxEqual(float a, float b, float epsilon) {
     return fabs(a - b) < epsilon;
   }
 
 }
+
+#if defined(_MSC_VER)
+#pragma float_control(pop)
+#endif
@@ -0,0 +1,380 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+#include <type_traits>
+#include "Utilities/Utilities/EngineMath.h"
+
+// Igual que en EngineMath.h: la reduccin de rango no debe reasociarse con /fp:fast.
+#if defined(_MSC_VER)
+#pragma float_control(precise, on, push)
+#endif
+
+/**
+ * Versiones de sqrt, 1/sqrt, exp, exp2, log, log2, sin y cos con la precisin elegida en tiempo de
+ * compilacin:
+ *
+ *   float s = EngineUtilities::sin<EngineUtilities::Precision::Fast>(angle);
+ *
+ * - Precision::Exact llama a las funciones de EngineMath.h (1-2 ULP).
+ * - Precision::Fast usa rsqrt con un paso de Newton (1/sqrt), exp2/log2 armando los bits del exponente y
+ *   polinomios de grado 4-6: unos 6 dgitos correctos.
+ * - Precision::Fastest usa rsqrt sin refinar y polinomios de grado 2-3: unos 3-4 dgitos, para
+ *   desvanecimientos de partculas, envolventes y otros casos donde el error no se ve.
+ *
+ * La poltica se resuelve con if constexpr, as que no hay ningn salto en tiempo de ejecucin.
+ * Cada poltica declara su presupuesto de error; Benchmarks/EngineMathPrecisionBenchmark.cpp
+ * lo comprueba y termina con error si alguna funcin lo supera.
+ *
+ * Fast y Fastest no comprueban casos especiales: sqrt e inverseSqrt esperan valores positivos
+ * normales, log y log2 valores positivos normales y finitos, exp2 satura fuera de [-126, 127]
+ * (exp fuera de [-87, 88]) y sin/cos mantienen el presupuesto para |angle| <= 1000.
+ */
+namespace EngineUtilities {
+  namespace Precision {
+    /**
+     * Precisin completa: las funciones de EngineMath.h.
+     */
+    struct Exact {
+      static constexpr float SQRT_ERROR = 2.5e-7f;  ///< sqrt e inverseSqrt, error relativo.
+      static constexpr float EXP_ERROR = 2.5e-7f;   ///< exp y exp2, error relativo.
+      static constexpr float LOG_ERROR = 2.5e-7f;   ///< log y log2, error / max(1, |resultado|).
+      static constexpr float TRIG_ERROR = 1.5e-7f;  ///< sin y cos, error absoluto.
+    };
+
+    /**
+     * Unos 6 dgitos: rsqrt + un paso de Newton, polinomios de grado 4 (exp2) a 7 (sin).
+     */
+    struct Fast {
+      static constexpr float SQRT_ERROR = 5.0e-6f;
+      static constexpr float EXP_ERROR = 1.0e-5f;
+      static constexpr float LOG_ERROR = 3.0e-6f;
+      static constexpr float TRIG_ERROR = 1.0e-6f;
+    };
+
+    /**
+     * Unos 3-4 dgitos: rsqrt sin refinar, polinomios de grado 2 (exp2) a 5 (sin).
+     */
+    struct Fastest {
+      static constexpr float SQRT_ERROR = 2.0e-3f;
+      static constexpr float EXP_ERROR = 2.0e-3f;
+      static constexpr float LOG_ERROR = 1.0e-3f;
+      static constexpr float TRIG_ERROR = 1.0e-4f;
+    };
+
+    /**
+     * Verdadero para las tres polticas; evita que un tipo cualquiera caiga en la rama Fastest.
+     */
+    template<typename Policy>
+    constexpr bool IsPolicy = std::is_same_v<Policy, Exact> ||
+                              std::is_same_v<Policy, Fast> ||
+                              std::is_same_v<Policy, Fastest>;
+  }
+
+  namespace MathDetail {
+    // 2^f en [-0.5, 0.5], minimax con error relativo: grado 4 (2.6e-6) y grado 2 (1.7e-3).
+    constexpr float EXP2_FAST_P0 = 0.9999992614f;
+    constexpr float EXP2_FAST_P1 = 0.6931218146f;
+    constexpr float EXP2_FAST_P2 = 0.2402474484f;
+    constexpr float EXP2_FAST_P3 = 0.05591786178f;
+    constexpr float EXP2_FAST_P4 = 0.009570101878f;
+    constexpr float EXP2_FASTEST_P0 = 1.000443147f;
+    constexpr float EXP2_FASTEST_P1 = 0.7034480673f;
+    constexpr float EXP2_FASTEST_P2 = 0.2384289336f;
+
+    // log2(1 + f) = f P(f) con 1 + f en [sqrt(1/2), sqrt(2)): grado 6 (2.1e-6) y grado 3 (8.5e-4).
+    constexpr float LOG2_FAST_P0 = 1.442713482f;
+    constexpr float LOG2_FAST_P1 = -0.7211318571f;
+    constexpr float LOG2_FAST_P2 = 0.4793480077f;
+    constexpr float LOG2_FAST_P3 = -0.3674899955f;
+    constexpr float LOG2_FAST_P4 = 0.3221549239f;
+    constexpr float LOG2_FAST_P5 = -0.2065918204f;
+    constexpr float LOG2_FASTEST_P0 = 1.445152081f;
+    constexpr float LOG2_FASTEST_P1 = -0.7540815459f;
+    constexpr float LOG2_FASTEST_P2 = 0.445070357f;
+
+    // sin(r) = r P(r^2) en [-pi/2, pi/2]: grado 7 (5.9e-7) y grado 5 (6.8e-5).
+    constexpr float SIN_FAST_P0 = 0.9999966159f;
+    constexpr float SIN_FAST_P1 = -0.1666482837f;
+    constexpr float SIN_FAST_P2 = 0.008306325125f;
+    constexpr float SIN_FAST_P3 = -0.0001836365121f;
+    constexpr float SIN_FASTEST_P0 = 0.9996967709f;
+    constexpr float SIN_FASTEST_P1 = -0.1656730744f;
+    constexpr float SIN_FASTEST_P2 = 0.007514375195f;
+
+    // pi en dos partes para la reduccin por medias vueltas; PI_HI * k es exacto para |k| < 2^16.
+    constexpr float INV_PI = 0.318309886183790672f;
+    constexpr float PI_HI = 3.140625f;
+    constexpr float PI_LO = 9.67653589793e-4f;
+    constexpr float SQRT_TWO = 1.41421356237309505f;
+    constexpr float LN2 = 0.693147180559945309f;
+
+    /**
+     * @brief Estimacin de 1/sqrt(value) sin refinar: rsqrtss (error relativo 3.7e-4) o, sin SSE2,
+     * la estimacin por bits con un paso de Newton (1.8e-3).
+     */
+    inline float inverseSqrtEstimate(float value) {
+#if ENGINE_MATH_SSE2
+      return _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(value)));
+#else
+      float y = bitsToFloat(0x5f3759dfu - (floatBits(value) >> 1));
+      return y * (1.5f - 0.5f * value * y * y);
+#endif
+    }
+
+    /**
+     * @brief Seno polinmico de r en [-pi/2, pi/2] con el grado de la poltica.
+     */
+    template<typename Policy>
+    inline float sinPolynomial(float r) {
+      float z = r * r;
+      if constexpr (std::is_same_v<Policy, Precision::Fast>) {
+        return r * (((SIN_FAST_P3 * z + SIN_FAST_P2) * z + SIN_FAST_P1) * z + SIN_FAST_P0);
+      }
+      else {
+        return r * ((SIN_FASTEST_P2 * z + SIN_FASTEST_P1) * z + SIN_FASTEST_P0);
+      }
+    }
+
+    /**
+     * @brief sin(angle) reduciendo por medias vueltas: angle = k pi + r y sin = (-1)^k sin(r).
+     * Para el coseno se pasa halfTurnOffset = 0.5 (angle = (k + 1/2) pi + r, cos = -(-1)^k sin(r)).
+     */
+    template<typename Policy>
+    inline float sinHalfTurns(float angle, float halfTurnOffset, uint32_t signFlip) {
+      int k = nearestInt(angle * INV_PI - halfTurnOffset);
+      float kf = static_cast<float>(k) + halfTurnOffset;
+      float r = (angle - kf * PI_HI) - kf * PI_LO;
+      uint32_t sign = (static_cast<uint32_t>(k) << 31) ^ signFlip;
+      return bitsToFloat(floatBits(sinPolynomial<Policy>(r)) ^ sign);
+    }
+  }
+
+  /**
+   * @brief 1/sqrt(value) con la precisin de la poltica.
+   * @tparam Policy Precision::Exact, Precision::Fast o Precision::Fastest.
+   * @param value Valor positivo.
+   * @return La inversa de la raz cuadrada.
+   */
+  template<typename Policy>
+  inline float inverseSqrt(float value) {
+    static_assert(Precision::IsPolicy<Policy>, "Policy debe ser Precision::Exact, Fast o Fastest");
+    if constexpr (std::is_same_v<Policy, Precision::Exact>) {
+      return 1.0f / sqrt(value);
+    }
+    else if constexpr (std::is_same_v<Policy, Precision::Fast>) {
+      float y = MathDetail::inverseSqrtEstimate(value);
+      y = y * (1.5f - 0.5f * value * y * y);
+#if !ENGINE_MATH_SSE2
+      y = y * (1.5f - 0.5f * value * y * y);  // La estimacin por bits necesita un paso ms.
+#endif
+      return y;
+    }
+    else {
+      return MathDetail::inverseSqrtEstimate(value);
+    }
+  }
+
+  /**
+   * @brief Raz cuadrada con la precisin de la poltica.
+   *
+   * Con SSE2 las tres polticas usan sqrtss: medido, es ms rpido que rsqrtss ms la
+   * multiplicacin, y adems exacto. Sin SSE2, Fast y Fastest calculan value * 1/sqrt(value).
+   *
+   * @tparam Policy Precision::Exact, Precision::Fast o Precision::Fastest.
+   * @param value Valor no negativo.
+   * @return La raz cuadrada.
+   */
+  template<typename Policy>
+  inline float sqrt(float value) {
+    static_assert(Precision::IsPolicy<Policy>, "Policy debe ser Precision::Exact, Fast o Fastest");
+#if ENGINE_MATH_SSE2
+    return sqrt(value);
+#else
+    if constexpr (std::is_same_v<Policy, Precision::Exact>) {
+      return sqrt(value);
+    }
+    else {
+      return value > 0.0f ? value * inverseSqrt<Policy>(value) : 0.0f;
+    }
+#endif
+  }
+
+  /**
+   * @brief 2^value con la precisin de la poltica.
+   *
+   * Se escribe value = k + f con |f| <= 0.5; 2^k se arma en los bits del exponente y 2^f sale de
+   * exp (Exact) o de un polinomio (Fast, Fastest).
+   *
+   * @tparam Policy Precision::Exact, Precision::Fast o Precision::Fastest.
+   * @param value Exponente.
+   * @return 2 elevado a value.
+   */
+  template<typename Policy>
+  inline float exp2(float value) {
+    static_assert(Precision::IsPolicy<Policy>, "Policy debe ser Precision::Exact, Fast o Fastest");
+    using namespace MathDetail;
+    if constexpr (std::is_same_v<Policy, Precision::Exact>) {
+      if (value != value) {
+        return value;
+      }
+      if (value >= 128.0f) {
+        return std::numeric_limits<float>::infinity();
+      }
+      if (value < -150.0f) {
+        return 0.0f;
+      }
+      int k = nearestInt(value);
+      float f = value - static_cast<float>(k);
+      int half = k / 2;
+      return exp(f * LN2) * pow2(half) * pow2(k - half);
+    }
+    else {
+      value = EMin(EMax(value, -126.0f), 127.0f);
+      int k = nearestInt(value);
+      float f = value - static_cast<float>(k);
+      float p;
+      if constexpr (std::is_same_v<Policy, Precision::Fast>) {
+        p = (((EXP2_FAST_P4 * f + EXP2_FAST_P3) * f + EXP2_FAST_P2) * f + EXP2_FAST_P1) * f + EXP2_FAST_P0;
+      }
+      else {
+        p = (EXP2_FASTEST_P2 * f + EXP2_FASTEST_P1) * f + EXP2_FASTEST_P0;
+      }
+      return p * pow2(k);
+    }
+  }
+
+  /**
+   * @brief e^value con la precisin de la poltica (Fast y Fastest: exp2(value * log2(e))).
+   * @tparam Policy Precision::Exact, Precision::Fast o Precision::Fastest.
+   * @param value Exponente.
+   * @return e elevado a value.
+   */
+  template<typename Policy>
+  inline float exp(float value) {
+    static_assert(Precision::IsPolicy<Policy>, "Policy debe ser Precision::Exact, Fast o Fastest");
+    if constexpr (std::is_same_v<Policy, Precision::Exact>) {
+      return exp(value);
+    }
+    else {
+      return exp2<Policy>(value * MathDetail::LOG2E);
+    }
+  }
+
+  /**
+   * @brief Logaritmo en base 2 con la precisin de la poltica.
+   *
+   * Fast y Fastest separan value = m 2^e en los bits, llevan m a [sqrt(1/2), sqrt(2)) y evalan
+   * log2(m) con un polinomio.
+   *
+   * @tparam Policy Precision::Exact, Precision::Fast o Precision::Fastest.
+   * @param value Valor positivo.
+   * @return log2(value).
+   */
+  template<typename Policy>
+  inline float log2(float value) {
+    static_assert(Precision::IsPolicy<Policy>, "Policy debe ser Precision::Exact, Fast o Fastest");
+    using namespace MathDetail;
+    if constexpr (std::is_same_v<Policy, Precision::Exact>) {
+      return log(value) * LOG2E;
+    }
+    else {
+      uint32_t bits = floatBits(value);
+      float m = bitsToFloat((bits & 0x007fffffu) | 0x3f800000u);  // m en [1, 2)
+      float e = static_cast<float>(static_cast<int>(bits >> 23) - 127);
+      bool high = m > SQRT_TWO;
+      m = high ? m * 0.5f : m;
+      e = high ? e + 1.0f : e;
+      float f = m - 1.0f;
+      float p;
+      if constexpr (std::is_same_v<Policy, Precision::Fast>) {
+        p = ((((LOG2_FAST_P5 * f + LOG2_FAST_P4) * f + LOG2_FAST_P3) * f + LOG2_FAST_P2) * f
+             + LOG2_FAST_P1) * f + LOG2_FAST_P0;
+      }
+      else {
+        p = (LOG2_FASTEST_P2 * f + LOG2_FASTEST_P1) * f + LOG2_FASTEST_P0;
+      }
+      return f * p + e;
+    }
+  }
+
+  /**
+   * @brief Logaritmo natural con la precisin de la poltica (Fast y Fastest: log2(value) * ln 2).
+   * @tparam Policy Precision::Exact, Precision::Fast o Precision::Fastest.
+   * @param value Valor positivo.
+   * @return log(value).
+   */
+  template<typename Policy>
+  inline float log(float value) {
+    static_assert(Precision::IsPolicy<Policy>, "Policy debe ser Precision::Exact, Fast o Fastest");
+    if constexpr (std::is_same_v<Policy, Precision::Exact>) {
+      return log(value);
+    }
+    else {
+      return log2<Policy>(value) * MathDetail::LN2;
+    }
+  }
+
+  /**
+   * @brief Seno con la precisin de la poltica.
+   * @tparam Policy Precision::Exact, Precision::Fast o Precision::Fastest.
+   * @param angle ngulo en radianes.
+   * @return El seno del ngulo.
+   */
+  template<typename Policy>
+  inline float sin(float angle) {
+    static_assert(Precision::IsPolicy<Policy>, "Policy debe ser Precision::Exact, Fast o Fastest");
+    if constexpr (std::is_same_v<Policy, Precision::Exact>) {
+      return sin(angle);
+    }
+    else {
+      return MathDetail::sinHalfTurns<Policy>(angle, 0.0f, 0u);
+    }
+  }
+
+  /**
+   * @brief Coseno con la precisin de la poltica.
+   * @tparam Policy Precision::Exact, Precision::Fast o Precision::Fastest.
+   * @param angle ngulo en radianes.
+   * @return El coseno del ngulo.
+   */
+  template<typename Policy>
+  inline float cos(float angle) {
+    static_assert(Precision::IsPolicy<Policy>, "Policy debe ser Precision::Exact, Fast o Fastest");
+    if constexpr (std::is_same_v<Policy, Precision::Exact>) {
+      return cos(angle);
+    }
+    else {
+      return MathDetail::sinHalfTurns<Policy>(angle, 0.5f, 0x80000000u);
+    }
+  }
+}
+
+#if defined(_MSC_VER)
+#pragma float_control(pop)
+#endif
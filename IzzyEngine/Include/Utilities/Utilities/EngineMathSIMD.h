@@ -0,0 +1,363 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+#include <cstddef>
+#include "Utilities/Utilities/EngineMath.h"
+
+#if ENGINE_MATH_SSE2 && defined(__AVX2__)
+#define ENGINE_MATH_AVX2 1
+#include <immintrin.h>
+#else
+#define ENGINE_MATH_AVX2 0
+#endif
+
+// MSVC no define __FMA__; con /arch:AVX2 las instrucciones FMA3 estn garantizadas.
+#if ENGINE_MATH_AVX2 && (defined(__FMA__) || defined(_MSC_VER))
+#define ENGINE_MATH_FMA 1
+#else
+#define ENGINE_MATH_FMA 0
+#endif
+
+// Igual que en EngineMath.h: la reduccin de rango no debe reasociarse con /fp:fast.
+#if defined(_MSC_VER)
+#pragma float_control(precise, on, push)
+#endif
+
+/**
+ * Versiones vectoriales de sin/cos sobre 4 (SSE2) y 8 (AVX2) floats.
+ *
+ * Usan los mismos polinomios minimax que EngineMath.h, pero reducen el rango en float con pi/2 en
+ * tres partes (Cody-Waite), sin pasar a double. Error mximo medido frente a sin/cos en double:
+ * 2 ULP para |x| <= pi y error absoluto menor que 1.2e-7 para |x| <= 8192; cerca de los ceros de
+ * sin/cos lejos del origen el error relativo es mayor que en la versin escalar.
+ * Si algn carril tiene |x| > 8192, infinito o NaN, ese registro completo se calcula con la versin
+ * escalar, as que los resultados fuera de rango coinciden con EngineUtilities::sin/cos.
+ */
+namespace EngineUtilities {
+#if ENGINE_MATH_SSE2
+  namespace MathDetail {
+    inline __m128 mulAdd4(__m128 a, __m128 b, __m128 c) {
+#if ENGINE_MATH_FMA
+      return _mm_fmadd_ps(a, b, c);
+#else
+      return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+    }
+
+    /**
+     * @brief c - a * b.
+     */
+    inline __m128 negMulAdd4(__m128 a, __m128 b, __m128 c) {
+#if ENGINE_MATH_FMA
+      return _mm_fnmadd_ps(a, b, c);
+#else
+      return _mm_sub_ps(c, _mm_mul_ps(a, b));
+#endif
+    }
+
+    /**
+     * @brief Verdadero si algn carril est fuera de [-FLOAT_REDUCTION_LIMIT, FLOAT_REDUCTION_LIMIT] o es NaN.
+     */
+    inline bool needsScalar4(__m128 angle) {
+      __m128 absAngle = _mm_and_ps(angle, _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff)));
+      return _mm_movemask_ps(_mm_cmpnle_ps(absAngle, _mm_set1_ps(FLOAT_REDUCTION_LIMIT))) != 0;
+    }
+
+    /**
+     * @brief Evala los polinomios de seno y coseno sobre angle ya reducido y devuelve el cuadrante.
+     */
+    inline __m128i sinCosKernels4(__m128 angle, __m128& s, __m128& c) {
+      __m128i q = _mm_cvtps_epi32(_mm_mul_ps(angle, _mm_set1_ps(TWO_OVER_PI)));
+      __m128 qf = _mm_cvtepi32_ps(q);
+      __m128 r = negMulAdd4(qf, _mm_set1_ps(PIO2_1), angle);
+      r = negMulAdd4(qf, _mm_set1_ps(PIO2_2), r);
+      r = negMulAdd4(qf, _mm_set1_ps(PIO2_3), r);
+
+      __m128 z = _mm_mul_ps(r, r);
+      __m128 ps = mulAdd4(z, _mm_set1_ps(SIN_S3), _mm_set1_ps(SIN_S2));
+      ps = mulAdd4(z, ps, _mm_set1_ps(SIN_S1));
+      s = mulAdd4(_mm_mul_ps(r, z), ps, r);
+
+      __m128 pc = mulAdd4(z, _mm_set1_ps(COS_C3), _mm_set1_ps(COS_C2));
+      pc = mulAdd4(z, pc, _mm_set1_ps(COS_C1));
+      c = mulAdd4(_mm_mul_ps(z, z), pc, negMulAdd4(_mm_set1_ps(0.5f), z, _mm_set1_ps(1.0f)));
+      return q;
+    }
+
+    inline __m128 select4(__m128 mask, __m128 ifTrue, __m128 ifFalse) {
+      return _mm_or_ps(_mm_and_ps(mask, ifTrue), _mm_andnot_ps(mask, ifFalse));
+    }
+
+    /**
+     * @brief Bit de signo (bit 31) en los carriles donde (q & 2) != 0.
+     */
+    inline __m128 quadrantSign4(__m128i q) {
+      return _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(q, _mm_set1_epi32(2)), 30));
+    }
+
+    inline __m128 oddQuadrantMask4(__m128i q) {
+      __m128i one = _mm_set1_epi32(1);
+      return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(q, one), one));
+    }
+  }
+
+  /**
+   * Calcula el seno y el coseno de 4 ngulos a la vez.
+   * @param angle ngulos en radianes.
+   * @param outSin Senos de los ngulos.
+   * @param outCos Cosenos de los ngulos.
+   */
+  inline void sincos4(__m128 angle, __m128& outSin, __m128& outCos) {
+    using namespace MathDetail;
+    if (needsScalar4(angle)) {
+      alignas(16) float in[4], s[4], c[4];
+      _mm_store_ps(in, angle);
+      for (int i = 0; i < 4; ++i) {
+        sincos(in[i], s[i], c[i]);
+      }
+      outSin = _mm_load_ps(s);
+      outCos = _mm_load_ps(c);
+      return;
+    }
+    __m128 s, c;
+    __m128i q = sinCosKernels4(angle, s, c);
+    __m128 swap = oddQuadrantMask4(q);
+    outSin = _mm_xor_ps(select4(swap, c, s), quadrantSign4(q));
+    outCos = _mm_xor_ps(select4(swap, s, c), quadrantSign4(_mm_add_epi32(q, _mm_set1_epi32(1))));
+  }
+
+  /**
+   * Calcula el seno de 4 ngulos en radianes.
+   * @param angle ngulos en radianes.
+   * @return Senos de los ngulos.
+   */
+  inline __m128 sin4(__m128 angle) {
+    __m128 s, c;
+    sincos4(angle, s, c);
+    return s;
+  }
+
+  /**
+   * Calcula el coseno de 4 ngulos en radianes.
+   * @param angle ngulos en radianes.
+   * @return Cosenos de los ngulos.
+   */
+  inline __m128 cos4(__m128 angle) {
+    __m128 s, c;
+    sincos4(angle, s, c);
+    return c;
+  }
+#endif
+
+#if ENGINE_MATH_AVX2
+  namespace MathDetail {
+    inline __m256 mulAdd8(__m256 a, __m256 b, __m256 c) {
+#if ENGINE_MATH_FMA
+      return _mm256_fmadd_ps(a, b, c);
+#else
+      return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+    }
+
+    /**
+     * @brief c - a * b.
+     */
+    inline __m256 negMulAdd8(__m256 a, __m256 b, __m256 c) {
+#if ENGINE_MATH_FMA
+      return _mm256_fnmadd_ps(a, b, c);
+#else
+      return _mm256_sub_ps(c, _mm256_mul_ps(a, b));
+#endif
+    }
+
+    inline bool needsScalar8(__m256 angle) {
+      __m256 absAngle = _mm256_and_ps(angle, _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff)));
+      return _mm256_movemask_ps(_mm256_cmp_ps(absAngle, _mm256_set1_ps(FLOAT_REDUCTION_LIMIT), _CMP_NLE_UQ)) != 0;
+    }
+
+    inline __m256i sinCosKernels8(__m256 angle, __m256& s, __m256& c) {
+      __m256i q = _mm256_cvtps_epi32(_mm256_mul_ps(angle, _mm256_set1_ps(TWO_OVER_PI)));
+      __m256 qf = _mm256_cvtepi32_ps(q);
+      __m256 r = negMulAdd8(qf, _mm256_set1_ps(PIO2_1), angle);
+      r = negMulAdd8(qf, _mm256_set1_ps(PIO2_2), r);
+      r = negMulAdd8(qf, _mm256_set1_ps(PIO2_3), r);
+
+      __m256 z = _mm256_mul_ps(r, r);
+      __m256 ps = mulAdd8(z, _mm256_set1_ps(SIN_S3), _mm256_set1_ps(SIN_S2));
+      ps = mulAdd8(z, ps, _mm256_set1_ps(SIN_S1));
+      s = mulAdd8(_mm256_mul_ps(r, z), ps, r);
+
+      __m256 pc = mulAdd8(z, _mm256_set1_ps(COS_C3), _mm256_set1_ps(COS_C2));
+      pc = mulAdd8(z, pc, _mm256_set1_ps(COS_C1));
+      c = mulAdd8(_mm256_mul_ps(z, z), pc, negMulAdd8(_mm256_set1_ps(0.5f), z, _mm256_set1_ps(1.0f)));
+      return q;
+    }
+
+    inline __m256 quadrantSign8(__m256i q) {
+      return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(q, _mm256_set1_epi32(2)), 30));
+    }
+
+    inline __m256 oddQuadrantMask8(__m256i q) {
+      __m256i one = _mm256_set1_epi32(1);
+      return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(q, one), one));
+    }
+  }
+
+  /**
+   * Calcula el seno y el coseno de 8 ngulos a la vez.
+   * @param angle ngulos en radianes.
+   * @param outSin Senos de los ngulos.
+   * @param outCos Cosenos de los ngulos.
+   */
+  inline void sincos8(__m256 angle, __m256& outSin, __m256& outCos) {
+    using namespace MathDetail;
+    if (needsScalar8(angle)) {
+      alignas(32) float in[8], s[8], c[8];
+      _mm256_store_ps(in, angle);
+      for (int i = 0; i < 8; ++i) {
+        sincos(in[i], s[i], c[i]);
+      }
+      outSin = _mm256_load_ps(s);
+      outCos = _mm256_load_ps(c);
+      return;
+    }
+    __m256 s, c;
+    __m256i q = sinCosKernels8(angle, s, c);
+    __m256 swap = oddQuadrantMask8(q);
+    outSin = _mm256_xor_ps(_mm256_blendv_ps(s, c, swap), quadrantSign8(q));
+    outCos = _mm256_xor_ps(_mm256_blendv_ps(c, s, swap), quadrantSign8(_mm256_add_epi32(q, _mm256_set1_epi32(1))));
+  }
+
+  /**
+   * Calcula el seno de 8 ngulos en radianes.
+   * @param angle ngulos en radianes.
+   * @return Senos de los ngulos.
+   */
+  inline __m256 sin8(__m256 angle) {
+    __m256 s, c;
+    sincos8(angle, s, c);
+    return s;
+  }
+
+  /**
+   * Calcula el coseno de 8 ngulos en radianes.
+   * @param angle ngulos en radianes.
+   * @return Cosenos de los ngulos.
+   */
+  inline __m256 cos8(__m256 angle) {
+    __m256 s, c;
+    sincos8(angle, s, c);
+    return c;
+  }
+#endif
+
+  /**
+   * Calcula el seno y el coseno de un arreglo de ngulos.
+   *
+   * Procesa 8 valores por iteracin con AVX2, 4 con SSE2 y el resto con la versin escalar.
+   * Los punteros no necesitan alineacin; outSin u outCos pueden ser el mismo arreglo que angles.
+   *
+   * @param angles ngulos en radianes.
+   * @param outSin Arreglo de salida para los senos (count elementos).
+   * @param outCos Arreglo de salida para los cosenos (count elementos).
+   * @param count Nmero de ngulos.
+   */
+  inline void sincosArray(const float* angles, float* outSin, float* outCos, size_t count) {
+    size_t i = 0;
+#if ENGINE_MATH_AVX2
+    for (; count - i >= 8; i += 8) {
+      __m256 s, c;
+      sincos8(_mm256_loadu_ps(angles + i), s, c);
+      _mm256_storeu_ps(outSin + i, s);
+      _mm256_storeu_ps(outCos + i, c);
+    }
+#endif
+#if ENGINE_MATH_SSE2
+    for (; count - i >= 4; i += 4) {
+      __m128 s, c;
+      sincos4(_mm_loadu_ps(angles + i), s, c);
+      _mm_storeu_ps(outSin + i, s);
+      _mm_storeu_ps(outCos + i, c);
+    }
+#endif
+    for (; i < count; ++i) {
+      sincos(angles[i], outSin[i], outCos[i]);
+    }
+  }
+
+  /**
+   * Calcula el seno de un arreglo de ngulos (ver sincosArray).
+   * @param angles ngulos en radianes.
+   * @param out Arreglo de salida (count elementos); puede ser el mismo que angles.
+   * @param count Nmero de ngulos.
+   */
+  inline void sinArray(const float* angles, float* out, size_t count) {
+    size_t i = 0;
+#if ENGINE_MATH_AVX2
+    for (; count - i >= 8; i += 8) {
+      _mm256_storeu_ps(out + i, sin8(_mm256_loadu_ps(angles + i)));
+    }
+#endif
+#if ENGINE_MATH_SSE2
+    for (; count - i >= 4; i += 4) {
+      _mm_storeu_ps(out + i, sin4(_mm_loadu_ps(angles + i)));
+    }
+#endif
+    for (; i < count; ++i) {
+      out[i] = sin(angles[i]);
+    }
+  }
+
+  /**
+   * Calcula el coseno de un arreglo de ngulos (ver sincosArray).
+   * @param angles ngulos en radianes.
+   * @param out Arreglo de salida (count elementos); puede ser el mismo que angles.
+   * @param count Nmero de ngulos.
+   */
+  inline void cosArray(const float* angles, float* out, size_t count) {
+    size_t i = 0;
+#if ENGINE_MATH_AVX2
+    for (; count - i >= 8; i += 8) {
+      _mm256_storeu_ps(out + i, cos8(_mm256_loadu_ps(angles + i)));
+    }
+#endif
+#if ENGINE_MATH_SSE2
+    for (; count - i >= 4; i += 4) {
+      _mm_storeu_ps(out + i, cos4(_mm_loadu_ps(angles + i)));
+    }
+#endif
+    for (; i < count; ++i) {
+      out[i] = cos(angles[i]);
+    }
+  }
+}
+
+#if defined(_MSC_VER)
+#pragma float_control(pop)
+#endif
@@ -0,0 +1,152 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+#include <cstddef>
+#include "Utilities/Utilities/EngineMath.h"
+
+/**
+ * Tabla de senos generada en tiempo de compilacin y funciones tableSin/tableCos que la usan.
+ *
+ * La tabla cubre una vuelta completa con SIN_TABLE_SIZE muestras (ms una de cierre para no
+ * comprobar el borde al interpolar); entre muestras se interpola linealmente. Error absoluto mximo
+ * frente a sin/cos en double: 4.8e-6 para |x| <= 2*pi, y crece con el ngulo porque el ndice se
+ * calcula en float (alrededor de 1e-3 para |x| = 1e4). Es menos precisa que EngineUtilities::sin/cos
+ * pero no tiene reduccin de rango ni polinomio: sirve para osciladores, animacin procedural y
+ * partculas, donde la velocidad importa ms que los ltimos dgitos.
+ *
+ * Todo es constexpr, as que tambin puede usarse para construir otras constantes.
+ */
+namespace EngineUtilities {
+  namespace MathDetail {
+    constexpr double TWO_PI_D = 6.28318530717958647692;
+
+    /**
+     * Seno en double evaluable en tiempo de compilacin: reduce a [-pi, pi] y suma la serie de
+     * Taylor hasta que el trmino deja de aportar. Solo se usa para generar tablas; en tiempo de
+     * ejecucin es mucho ms lento que EngineUtilities::sin.
+     * @param x ngulo en radianes (|x| < 1e15).
+     * @return El seno de x.
+     */
+    constexpr double constexprSin(double x) {
+      double turns = x / TWO_PI_D;
+      long long n = static_cast<long long>(turns < 0.0 ? turns - 0.5 : turns + 0.5);
+      x -= static_cast<double>(n) * TWO_PI_D;
+
+      double term = x;
+      double sum = x;
+      double x2 = x * x;
+      for (int k = 1; k < 30; ++k) {
+        term *= -x2 / ((2 * k) * (2 * k + 1));
+        sum += term;
+      }
+      return sum;
+    }
+  }
+
+  constexpr size_t SIN_TABLE_SIZE = 1024;  ///< Muestras por vuelta; debe ser potencia de 2.
+  static_assert((SIN_TABLE_SIZE & (SIN_TABLE_SIZE - 1)) == 0, "SIN_TABLE_SIZE debe ser potencia de 2");
+
+  /**
+   * Muestras de sin(2*pi*i/SIN_TABLE_SIZE) para i en [0, SIN_TABLE_SIZE].
+   */
+  struct SinTable {
+    float values[SIN_TABLE_SIZE + 1];
+  };
+
+  /**
+   * Genera la tabla de senos.
+   * @return La tabla con SIN_TABLE_SIZE + 1 muestras.
+   */
+  constexpr SinTable makeSinTable() {
+    SinTable table{};
+    for (size_t i = 0; i <= SIN_TABLE_SIZE; ++i) {
+      table.values[i] = static_cast<float>(
+        MathDetail::constexprSin(MathDetail::TWO_PI_D * static_cast<double>(i) / SIN_TABLE_SIZE));
+    }
+    return table;
+  }
+
+  /**
+   * Tabla global; al ser inline constexpr hay una sola copia en el binario y no cuesta nada al
+   * arrancar.
+   */
+  inline constexpr SinTable SIN_TABLE = makeSinTable();
+
+  namespace MathDetail {
+    constexpr float TABLE_STEPS_PER_RADIAN = static_cast<float>(SIN_TABLE_SIZE / TWO_PI_D);
+
+    /**
+     * Busca en la tabla la posicin t (en muestras) e interpola entre las dos vecinas.
+     * @param t Posicin en muestras; puede ser negativa o mayor que una vuelta.
+     * @return El seno interpolado.
+     */
+    constexpr float sampleSinTable(float t) {
+      long long whole = static_cast<long long>(t);
+      if (static_cast<float>(whole) > t) {
+        --whole;  // floor para valores negativos
+      }
+      float frac = t - static_cast<float>(whole);
+      size_t index = static_cast<size_t>(whole) & (SIN_TABLE_SIZE - 1);
+      float a = SIN_TABLE.values[index];
+      float b = SIN_TABLE.values[index + 1];
+      return a + (b - a) * frac;
+    }
+  }
+
+  /**
+   * Seno aproximado por tabla (ver SIN_TABLE para la precisin).
+   * @param angle ngulo en radianes; finito y con |angle| < 1e6.
+   * @return El seno aproximado del ngulo.
+   */
+  constexpr float tableSin(float angle) {
+    return MathDetail::sampleSinTable(angle * MathDetail::TABLE_STEPS_PER_RADIAN);
+  }
+
+  /**
+   * Coseno aproximado por tabla: el seno desplazado un cuarto de vuelta.
+   * @param angle ngulo en radianes; finito y con |angle| < 1e6.
+   * @return El coseno aproximado del ngulo.
+   */
+  constexpr float tableCos(float angle) {
+    return MathDetail::sampleSinTable(angle * MathDetail::TABLE_STEPS_PER_RADIAN +
+                                      static_cast<float>(SIN_TABLE_SIZE / 4));
+  }
+
+  /**
+   * Seno y coseno aproximados por tabla con una sola multiplicacin del ngulo.
+   * @param angle ngulo en radianes; finito y con |angle| < 1e6.
+   * @param outSin Recibe el seno.
+   * @param outCos Recibe el coseno.
+   */
+  constexpr void tableSinCos(float angle, float& outSin, float& outCos) {
+    float t = angle * MathDetail::TABLE_STEPS_PER_RADIAN;
+    outSin = MathDetail::sampleSinTable(t);
+    outCos = MathDetail::sampleSinTable(t + static_cast<float>(SIN_TABLE_SIZE / 4));
+  }
+}
@@ -28,7 +28,9 @@
 */
 #pragma once
 
+#include <cstddef>
 #include "Utilities/Utilities/EngineMath.h"
+#include "Utilities/Matrix/Matrix4x4.h"
 #include "Vector3.h"
 namespace EngineUtilities {
 	/**
@@ -49,7 +51,7 @@ namespace EngineUtilities {
 		 *
 		 * Initializes the quaternion to (1, 0, 0, 0).
 		 */
-		Quaternion() : w(1), x(0), y(0), z(0) {}
+		constexpr Quaternion() : w(1), x(0), y(0), z(0) {}
 
 		/**
 		 * @brief Parameterized constructor.
@@ -61,7 +63,7 @@ namespace EngineUtilities {
 		 * @param y The j component.
 		 * @param z The k component.
 		 */
-		Quaternion(float w, float x, float y, float z) : w(w), x(x), y(y), z(z) {}
+		constexpr Quaternion(float w, float x, float y, float z) : w(w), x(x), y(y), z(z) {}
 
 		/**
 		 * @brief Adds another quaternion to this quaternion.
@@ -69,7 +71,7 @@ namespace EngineUtilities {
 		 * @param other The quaternion to add.
 		 * @return The result of the addition.
 		 */
-		Quaternion operator+(const Quaternion& other) const {
+		constexpr Quaternion operator+(const Quaternion& other) const {
 			return Quaternion(w + other.w, x + other.x, y + other.y, z + other.z);
 		}
 
@@ -79,7 +81,7 @@ namespace EngineUtilities {
 		 * @param other The quaternion to subtract.
 		 * @return The result of the subtraction.
 		 */
-		Quaternion operator-(const Quaternion& other) const {
+		constexpr Quaternion operator-(const Quaternion& other) const {
 			return Quaternion(w - other.w, x - other.x, y - other.y, z - other.z);
 		}
 
@@ -89,7 +91,7 @@ namespace EngineUtilities {
 		 * @param scalar The scalar to multiply by.
 		 * @return The result of the multiplication.
 		 */
-		Quaternion operator*(float scalar) const {
+		constexpr Quaternion operator*(float scalar) const {
 			return Quaternion(w * scalar, x * scalar, y * scalar, z * scalar);
 		}
 
@@ -99,7 +101,7 @@ namespace EngineUtilities {
 		 * @param other The quaternion to multiply by.
 		 * @return The result of the multiplication.
 		 */
-		Quaternion operator*(const Quaternion& other) const {
+		constexpr Quaternion operator*(const Quaternion& other) const {
 			return Quaternion(
 				w * other.w - x * other.x - y * other.y - z * other.z,
 				w * other.x + x * other.w + y * other.z - z * other.y,
@@ -114,7 +116,7 @@ namespace EngineUtilities {
 		 * @param other The quaternion to compare with.
 		 * @return True if the quaternions are equal, false otherwise.
 		 */
-		bool operator==(const Quaternion& other) const {
+		constexpr bool operator==(const Quaternion& other) const {
 			return (w == other.w && x == other.x && y == other.y && z == other.z);
 		}
 
@@ -124,7 +126,7 @@ namespace EngineUtilities {
 		 * @param other The quaternion to compare with.
 		 * @return True if the quaternions are not equal, false otherwise.
 		 */
-		bool operator!=(const Quaternion& other) const {
+		constexpr bool operator!=(const Quaternion& other) const {
 			return !(*this == other);
 		}
 
@@ -147,7 +149,8 @@ namespace EngineUtilities {
 			if (mag == 0) {
 				return Quaternion(1, 0, 0, 0);
 			}
-			return Quaternion(w / mag, x / mag, y / mag, z / mag);
+			float inverse = 1.0f / mag;
+			return Quaternion(w * inverse, x * inverse, y * inverse, z * inverse);
 		}
 
 		/**
@@ -155,7 +158,7 @@ namespace EngineUtilities {
 		 *
 		 * @return The conjugated quaternion.
 		 */
-		Quaternion conjugate() const {
+		constexpr Quaternion conjugate() const {
 			return Quaternion(w, -x, -y, -z);
 		}
 
@@ -204,32 +207,273 @@ namespace EngineUtilities {
 		}
 
 		/**
-		 * @brief Returns a pointer to the quaternion's data.
+		 * @brief Computes the dot product with another quaternion.
 		 *
-		 * @return Pointer to the first element (w, x, y, z).
+		 * @param other The other quaternion.
+		 * @return The dot product.
 		 */
-		const float* data() const {
-			return &w;
+		constexpr float dot(const Quaternion& other) const {
+			return w * other.w + x * other.x + y * other.y + z * other.z;
+		}
+
+		/**
+		 * @brief Constructs a quaternion from Euler angles (in radians).
+		 *
+		 * Uses the same convention as XMMatrixRotationRollPitchYaw: roll about Z first, then
+		 * pitch about X, then yaw about Y.
+		 *
+		 * @param pitch Rotation about the X axis.
+		 * @param yaw Rotation about the Y axis.
+		 * @param roll Rotation about the Z axis.
+		 * @return The quaternion representing the rotation.
+		 */
+		static Quaternion fromEuler(float pitch, float yaw, float roll) {
+			float sp, cp, sy, cy, sr, cr;
+			EngineUtilities::sincos(pitch * 0.5f, sp, cp);
+			EngineUtilities::sincos(yaw * 0.5f, sy, cy);
+			EngineUtilities::sincos(roll * 0.5f, sr, cr);
+			return Quaternion(
+				cr * cp * cy + sr * sp * sy,
+				cr * sp * cy + sr * cp * sy,
+				cr * cp * sy - sr * sp * cy,
+				sr * cp * cy - cr * sp * sy
+			);
 		}
 
 		/**
-		 * @brief Converts the quaternion to a 4x4 rotation matrix.
+		 * @brief Constructs a quaternion from Euler angles stored as (pitch, yaw, roll).
+		 *
+		 * @param euler The angles in radians, in the layout Transform uses for its rotation.
+		 * @return The quaternion representing the rotation.
+		 */
+		static Quaternion fromEuler(const Vector3& euler) {
+			return fromEuler(euler.x, euler.y, euler.z);
+		}
+
+		/**
+		 * @brief Converts a unit quaternion back to Euler angles (see fromEuler).
+		 *
+		 * At +-90 degrees of pitch yaw and roll are not independent; roll is reported as 0.
+		 *
+		 * @return The angles in radians as (pitch, yaw, roll).
+		 */
+		Vector3 toEuler() const {
+			float sinPitch = -2.0f * (y * z - x * w);
+			if (sinPitch > 0.99999f || sinPitch < -0.99999f) {
+				float pitch = sinPitch > 0.0f ? PI / 2 : -PI / 2;
+				float yaw = EngineUtilities::atan2(-2.0f * (x * z - y * w), 1.0f - 2.0f * (y * y + z * z));
+				return Vector3(pitch, yaw, 0.0f);
+			}
+			return Vector3(EngineUtilities::asin(sinPitch),
+			               EngineUtilities::atan2(2.0f * (x * z + y * w), 1.0f - 2.0f * (x * x + y * y)),
+			               EngineUtilities::atan2(2.0f * (x * y + z * w), 1.0f - 2.0f * (x * x + z * z)));
+		}
+
+		/**
+		 * @brief Converts a unit quaternion to a 4x4 rotation matrix.
+		 *
+		 * The matrix follows the Matrix4x4 row-vector convention, so
+		 * toMatrix().transformVector(v) equals rotate(v).
 		 *
 		 * @return The 4x4 matrix representing the rotation.
 		 */
-		/*Matrix4x4 toMatrix() const {
-			Matrix4x4 result;
-			result[0][0] = 1 - 2 * (y * y + z * z);
-			result[0][1] = 2 * (x * y - z * w);
-			result[0][2] = 2 * (x * z + y * w);
-			result[1][0] = 2 * (x * y + z * w);
-			result[1][1] = 1 - 2 * (x * x + z * z);
-			result[1][2] = 2 * (y * z - x * w);
-			result[2][0] = 2 * (x * z - y * w);
-			result[2][1] = 2 * (y * z + x * w);
-			result[2][2] = 1 - 2 * (x * x + y * y);
-			result[3][3] = 1;
-			return result;
-		}*/
+		constexpr Matrix4x4 toMatrix() const {
+			float xx = x * x, yy = y * y, zz = z * z;
+			float xy = x * y, xz = x * z, yz = y * z;
+			float wx = w * x, wy = w * y, wz = w * z;
+			return Matrix4x4(
+				1 - 2 * (yy + zz), 2 * (xy + wz), 2 * (xz - wy), 0,
+				2 * (xy - wz), 1 - 2 * (xx + zz), 2 * (yz + wx), 0,
+				2 * (xz + wy), 2 * (yz - wx), 1 - 2 * (xx + yy), 0,
+				0, 0, 0, 1
+			);
+		}
+
+		/**
+		 * @brief Normalized linear interpolation along the shortest arc.
+		 *
+		 * Cheaper than slerp and accurate enough for blending nearby animation poses; the
+		 * angular speed is not constant over t.
+		 *
+		 * @param a The start rotation.
+		 * @param b The end rotation.
+		 * @param t The interpolation factor, in [0, 1].
+		 * @return The interpolated unit quaternion.
+		 */
+		static Quaternion nlerp(const Quaternion& a, const Quaternion& b, float t) {
+			float tb = a.dot(b) < 0.0f ? -t : t;
+			float ta = 1.0f - t;
+			return Quaternion(a.w * ta + b.w * tb, a.x * ta + b.x * tb,
+			                  a.y * ta + b.y * tb, a.z * ta + b.z * tb).normalize();
+		}
+
+		/**
+		 * @brief Spherical linear interpolation along the shortest arc.
+		 *
+		 * Moves at constant angular speed. Falls back to nlerp when both rotations are almost
+		 * equal, where sin(theta) in the denominator would lose precision.
+		 *
+		 * @param a The start rotation.
+		 * @param b The end rotation.
+		 * @param t The interpolation factor, in [0, 1].
+		 * @return The interpolated unit quaternion.
+		 */
+		static Quaternion slerp(const Quaternion& a, const Quaternion& b, float t) {
+			float cosTheta = a.dot(b);
+			float sign = 1.0f;
+			if (cosTheta < 0.0f) {
+				cosTheta = -cosTheta;
+				sign = -1.0f;
+			}
+			if (cosTheta > 0.9995f) {
+				return nlerp(a, b, t);
+			}
+			float theta = EngineUtilities::acos(cosTheta);
+			float inverseSin = 1.0f / EngineUtilities::sin(theta);
+			float ta = EngineUtilities::sin((1.0f - t) * theta) * inverseSin;
+			float tb = EngineUtilities::sin(t * theta) * inverseSin * sign;
+			return Quaternion(a.w * ta + b.w * tb, a.x * ta + b.x * tb,
+			                  a.y * ta + b.y * tb, a.z * ta + b.z * tb);
+		}
+
+		/**
+		 * @brief Returns a pointer to the quaternion's data.
+		 *
+		 * @return Pointer to the first element (w, x, y, z).
+		 */
+		const float* data() const {
+			return &w;
+		}
 	};
+
+	/**
+	 * @brief Builds the world matrix scale * rotation * translation of one transform.
+	 *
+	 * @param position The translation.
+	 * @param rotation The rotation (must be normalized).
+	 * @param scale The scale along each local axis.
+	 * @return The composed matrix, in the Matrix4x4 row-vector convention.
+	 */
+	inline Matrix4x4 composeTRS(const Vector3& position, const Quaternion& rotation, const Vector3& scale) {
+		Matrix4x4 result = rotation.toMatrix();
+		for (int j = 0; j < 3; ++j) {
+			result.m[0][j] *= scale.x;
+			result.m[1][j] *= scale.y;
+			result.m[2][j] *= scale.z;
+		}
+		result.m[3][0] = position.x;
+		result.m[3][1] = position.y;
+		result.m[3][2] = position.z;
+		return result;
+	}
+
+	/**
+	 * @brief Builds the world matrices of many transforms in one pass (see composeTRS).
+	 *
+	 * With SSE2 four transforms are processed at once: their quaternions are transposed into
+	 * registers of w, x, y and z, the nine rotation terms are computed for all four, and the
+	 * results are transposed back into matrix rows. The remainder goes through composeTRS.
+	 *
+	 * @param positions The translations (count elements).
+	 * @param rotations The normalized rotations (count elements).
+	 * @param scales The scales (count elements).
+	 * @param out The resulting matrices (count elements).
+	 * @param count The number of transforms.
+	 */
+	inline void composeTRSBatch(const Vector3* positions, const Quaternion* rotations, const Vector3* scales,
+	                            Matrix4x4* out, size_t count) {
+		size_t i = 0;
+#if ENGINE_MATH_SSE2
+		__m128 zero = _mm_setzero_ps();
+		__m128 one = _mm_set1_ps(1.0f);
+		for (; count - i >= 4; i += 4) {
+			__m128 qw = _mm_loadu_ps(rotations[i].data());
+			__m128 qx = _mm_loadu_ps(rotations[i + 1].data());
+			__m128 qy = _mm_loadu_ps(rotations[i + 2].data());
+			__m128 qz = _mm_loadu_ps(rotations[i + 3].data());
+			_MM_TRANSPOSE4_PS(qw, qx, qy, qz);
+
+			__m128 x2 = _mm_add_ps(qx, qx), y2 = _mm_add_ps(qy, qy), z2 = _mm_add_ps(qz, qz);
+			__m128 xx = _mm_mul_ps(qx, x2), yy = _mm_mul_ps(qy, y2), zz = _mm_mul_ps(qz, z2);
+			__m128 xy = _mm_mul_ps(qx, y2), xz = _mm_mul_ps(qx, z2), yz = _mm_mul_ps(qy, z2);
+			__m128 wx = _mm_mul_ps(qw, x2), wy = _mm_mul_ps(qw, y2), wz = _mm_mul_ps(qw, z2);
+
+			const Vector3* s = scales + i;
+			__m128 sx = _mm_set_ps(s[3].x, s[2].x, s[1].x, s[0].x);
+			__m128 sy = _mm_set_ps(s[3].y, s[2].y, s[1].y, s[0].y);
+			__m128 sz = _mm_set_ps(s[3].z, s[2].z, s[1].z, s[0].z);
+
+			// Row j of every matrix: the terms of rotation row j scaled by the j-th scale component.
+			__m128 a0 = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(yy, zz)), sx);
+			__m128 a1 = _mm_mul_ps(_mm_add_ps(xy, wz), sx);
+			__m128 a2 = _mm_mul_ps(_mm_sub_ps(xz, wy), sx);
+			__m128 a3 = zero;
+			__m128 b0 = _mm_mul_ps(_mm_sub_ps(xy, wz), sy);
+			__m128 b1 = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, zz)), sy);
+			__m128 b2 = _mm_mul_ps(_mm_add_ps(yz, wx), sy);
+			__m128 b3 = zero;
+			__m128 c0 = _mm_mul_ps(_mm_add_ps(xz, wy), sz);
+			__m128 c1 = _mm_mul_ps(_mm_sub_ps(yz, wx), sz);
+			__m128 c2 = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, yy)), sz);
+			__m128 c3 = zero;
+			_MM_TRANSPOSE4_PS(a0, a1, a2, a3);
+			_MM_TRANSPOSE4_PS(b0, b1, b2, b3);
+			_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+			__m128 translations[4];
+			for (int k = 0; k < 4; ++k) {
+				const Vector3& p = positions[i + k];
+				translations[k] = _mm_set_ps(1.0f, p.z, p.y, p.x);
+			}
+			__m128 rows[4][3] = { { a0, b0, c0 }, { a1, b1, c1 }, { a2, b2, c2 }, { a3, b3, c3 } };
+			for (int k = 0; k < 4; ++k) {
+				out[i + k].setRow(0, rows[k][0]);
+				out[i + k].setRow(1, rows[k][1]);
+				out[i + k].setRow(2, rows[k][2]);
+				out[i + k].setRow(3, translations[k]);
+			}
+		}
+#endif
+		for (; i < count; ++i) {
+			out[i] = composeTRS(positions[i], rotations[i], scales[i]);
+		}
+	}
+
+	/**
+	 * @brief Interpolates many pairs of rotations with nlerp (see Quaternion::nlerp).
+	 *
+	 * Each quaternion occupies one SSE register, so the dot product, the sign flip, the blend
+	 * and the normalization run on all four components at once.
+	 *
+	 * @param a The start rotations (count elements).
+	 * @param b The end rotations (count elements).
+	 * @param t The interpolation factor, shared by all pairs.
+	 * @param out The interpolated rotations (count elements); may alias a or b.
+	 * @param count The number of pairs.
+	 */
+	inline void nlerpBatch(const Quaternion* a, const Quaternion* b, float t, Quaternion* out, size_t count) {
+#if ENGINE_MATH_SSE2
+		__m128 ta = _mm_set1_ps(1.0f - t);
+		__m128 tb = _mm_set1_ps(t);
+		__m128 signBit = _mm_set1_ps(-0.0f);
+		for (size_t i = 0; i < count; ++i) {
+			__m128 qa = _mm_loadu_ps(a[i].data());
+			__m128 qb = _mm_loadu_ps(b[i].data());
+			__m128 d = _mm_mul_ps(qa, qb);
+			d = _mm_add_ps(d, _mm_shuffle_ps(d, d, _MM_SHUFFLE(1, 0, 3, 2)));
+			d = _mm_add_ps(d, _mm_shuffle_ps(d, d, _MM_SHUFFLE(2, 3, 0, 1)));
+			// Flip b onto the same hemisphere as a by copying the sign of the dot product.
+			qb = _mm_xor_ps(qb, _mm_and_ps(d, signBit));
+			__m128 q = MathDetail::mulAdd4(qa, ta, _mm_mul_ps(qb, tb));
+			__m128 lengthSquared = _mm_mul_ps(q, q);
+			lengthSquared = _mm_add_ps(lengthSquared, _mm_shuffle_ps(lengthSquared, lengthSquared, _MM_SHUFFLE(1, 0, 3, 2)));
+			lengthSquared = _mm_add_ps(lengthSquared, _mm_shuffle_ps(lengthSquared, lengthSquared, _MM_SHUFFLE(2, 3, 0, 1)));
+			_mm_storeu_ps(&out[i].w, _mm_div_ps(q, _mm_sqrt_ps(lengthSquared)));
+		}
+#else
+		for (size_t i = 0; i < count; ++i) {
+			out[i] = Quaternion::nlerp(a[i], b[i], t);
+		}
+#endif
+	}
 }
@@ -27,7 +27,7 @@
  * SOFTWARE.
 */
 #pragma once
-#include "Utilities/EngineMath.h"
+#include "Utilities/Utilities/EngineMath.h"
 
 namespace EngineUtilities {
   /**
@@ -47,7 +47,7 @@ namespace EngineUtilities {
      *
      * Initializes the vector to (0, 0).
      */
-    Vector2() : x(0), y(0) {}
+    constexpr Vector2() : x(0), y(0) {}
 
     /**
      * @brief Parameterized constructor.
@@ -57,7 +57,7 @@ namespace EngineUtilities {
      * @param x The x-coordinate.
      * @param y The y-coordinate.
      */
-    Vector2(float x, float y) : x(x), y(y) {}
+    constexpr Vector2(float x, float y) : x(x), y(y) {}
 
     /**
      * @brief Adds another vector to this vector.
@@ -65,7 +65,7 @@ namespace EngineUtilities {
      * @param other The vector to add.
      * @return The result of the addition.
      */
-    Vector2 operator+(const Vector2& other) const {
+    constexpr Vector2 operator+(const Vector2& other) const {
       return Vector2(x + other.x, y + other.y);
     }
 
@@ -75,7 +75,7 @@ namespace EngineUtilities {
      * @param other The vector to subtract.
      * @return The result of the subtraction.
      */
-    Vector2 operator-(const Vector2& other) const {
+    constexpr Vector2 operator-(const Vector2& other) const {
       return Vector2(x - other.x, y - other.y);
     }
 
@@ -85,7 +85,7 @@ namespace EngineUtilities {
      * @param scalar The scalar to multiply by.
      * @return The result of the multiplication.
      */
-    Vector2 operator*(float scalar) const {
+    constexpr Vector2 operator*(float scalar) const {
       return Vector2(x * scalar, y * scalar);
     }
 
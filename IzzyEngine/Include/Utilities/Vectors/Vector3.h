@@ -48,7 +48,7 @@ namespace EngineUtilities {
 		 *
 		 * Initializes the vector to (0, 0, 0).
 		 */
-		Vector3() : x(0), y(0), z(0) {}
+		constexpr Vector3() : x(0), y(0), z(0) {}
 
 		/**
 		 * @brief Parameterized constructor.
@@ -59,7 +59,7 @@ namespace EngineUtilities {
 		 * @param y The y-coordinate.
 		 * @param z The z-coordinate.
 		 */
-		Vector3(float x, float y, float z) : x(x), y(y), z(z) {}
+		constexpr Vector3(float x, float y, float z) : x(x), y(y), z(z) {}
 
 		/**
 		 * @brief Adds another vector to this vector.
@@ -67,7 +67,7 @@ namespace EngineUtilities {
 		 * @param other The vector to add.
 		 * @return The result of the addition.
 		 */
-		Vector3 operator+(const Vector3& other) const {
+		constexpr Vector3 operator+(const Vector3& other) const {
 			return Vector3(x + other.x, y + other.y, z + other.z);
 		}
 
@@ -77,7 +77,7 @@ namespace EngineUtilities {
 		 * @param other The vector to subtract.
 		 * @return The result of the subtraction.
 		 */
-		Vector3 operator-(const Vector3& other) const {
+		constexpr Vector3 operator-(const Vector3& other) const {
 			return Vector3(x - other.x, y - other.y, z - other.z);
 		}
 
@@ -87,10 +87,32 @@ namespace EngineUtilities {
 		 * @param scalar The scalar to multiply by.
 		 * @return The result of the multiplication.
 		 */
-		Vector3 operator*(float scalar) const {
+		constexpr Vector3 operator*(float scalar) const {
 			return Vector3(x * scalar, y * scalar, z * scalar);
 		}
 
+		/**
+		 * @brief Computes the dot product with another vector.
+		 *
+		 * @param other The other vector.
+		 * @return The dot product.
+		 */
+		constexpr float dot(const Vector3& other) const {
+			return x * other.x + y * other.y + z * other.z;
+		}
+
+		/**
+		 * @brief Computes the cross product with another vector.
+		 *
+		 * @param other The other vector.
+		 * @return The cross product (this x other).
+		 */
+		constexpr Vector3 cross(const Vector3& other) const {
+			return Vector3(y * other.z - z * other.y,
+			               z * other.x - x * other.z,
+			               x * other.y - y * other.x);
+		}
+
 		/**
 		 * @brief Calculates the magnitude (length) of the vector.
 		 *
@@ -103,6 +125,9 @@ namespace EngineUtilities {
 		/**
 		 * @brief Normalizes the vector.
 		 *
+		 * Vector3 keeps its packed 12-byte layout (data() is handed out as a float[3]), so
+		 * it stays scalar; batches of vectors should use Vector3x8.
+		 *
 		 * @return The normalized vector.
 		 */
 		Vector3 normalize() const {
@@ -110,17 +135,18 @@ namespace EngineUtilities {
 			if (mag == 0) {
 				return Vector3(0, 0, 0);
 			}
-			return Vector3(x / mag, y / mag, z / mag);
+			float inverse = 1.0f / mag;
+			return Vector3(x * inverse, y * inverse, z * inverse);
 		}
 
 		void
 		zero() {
-			Vector3(0, 0, 0);
+			*this = Vector3(0, 0, 0);
 		}
 
 		void
 		one() {
-			Vector3(1, 1, 1);
+			*this = Vector3(1, 1, 1);
 		}
 
 		// Mtodo para obtener un puntero a los datos como un arreglo
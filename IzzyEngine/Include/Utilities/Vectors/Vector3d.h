@@ -0,0 +1,247 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include "Utilities/Utilities/EngineMathSIMD.h"
+#include "Utilities/Vectors/Vector3.h"
+namespace EngineUtilities {
+	/**
+	 * @brief A 3D vector in double precision, for world positions.
+	 *
+	 * A float has 24 bits of mantissa: 10 km from the origin consecutive values are about 1 mm
+	 * apart, and geometry placed with float world matrices starts to jitter. World positions are
+	 * kept as Vector3d and rebased to the camera (rebasePositions) before anything is rendered, so
+	 * the GPU only ever sees small, camera-relative float coordinates.
+	 *
+	 * The layout is three packed doubles (24 bytes), which rebasePositions relies on.
+	 */
+	class Vector3d {
+	public:
+		double x; /**< The x-coordinate of the vector. */
+		double y; /**< The y-coordinate of the vector. */
+		double z; /**< The z-coordinate of the vector. */
+
+		/**
+		 * @brief Default constructor.
+		 *
+		 * Initializes the vector to (0, 0, 0).
+		 */
+		constexpr Vector3d() : x(0), y(0), z(0) {}
+
+		/**
+		 * @brief Parameterized constructor.
+		 *
+		 * @param x The x-coordinate.
+		 * @param y The y-coordinate.
+		 * @param z The z-coordinate.
+		 */
+		constexpr Vector3d(double x, double y, double z) : x(x), y(y), z(z) {}
+
+		/**
+		 * @brief Widens a float vector (exact, so it is implicit).
+		 *
+		 * @param other The float vector.
+		 */
+		constexpr Vector3d(const Vector3& other) : x(other.x), y(other.y), z(other.z) {}
+
+		/**
+		 * @brief Adds another vector to this vector.
+		 *
+		 * @param other The vector to add.
+		 * @return The result of the addition.
+		 */
+		constexpr Vector3d operator+(const Vector3d& other) const {
+			return Vector3d(x + other.x, y + other.y, z + other.z);
+		}
+
+		/**
+		 * @brief Subtracts another vector from this vector.
+		 *
+		 * @param other The vector to subtract.
+		 * @return The result of the subtraction.
+		 */
+		constexpr Vector3d operator-(const Vector3d& other) const {
+			return Vector3d(x - other.x, y - other.y, z - other.z);
+		}
+
+		/**
+		 * @brief Multiplies this vector by a scalar.
+		 *
+		 * @param scalar The scalar to multiply by.
+		 * @return The result of the multiplication.
+		 */
+		constexpr Vector3d operator*(double scalar) const {
+			return Vector3d(x * scalar, y * scalar, z * scalar);
+		}
+
+		/**
+		 * @brief Adds another vector to this vector in place.
+		 *
+		 * @param other The vector to add.
+		 * @return This vector.
+		 */
+		constexpr Vector3d& operator+=(const Vector3d& other) {
+			x += other.x;
+			y += other.y;
+			z += other.z;
+			return *this;
+		}
+
+		/**
+		 * @brief Subtracts another vector from this vector in place.
+		 *
+		 * @param other The vector to subtract.
+		 * @return This vector.
+		 */
+		constexpr Vector3d& operator-=(const Vector3d& other) {
+			x -= other.x;
+			y -= other.y;
+			z -= other.z;
+			return *this;
+		}
+
+		/**
+		 * @brief Compares two vectors component by component.
+		 */
+		constexpr bool operator==(const Vector3d& other) const {
+			return x == other.x && y == other.y && z == other.z;
+		}
+
+		constexpr bool operator!=(const Vector3d& other) const {
+			return !(*this == other);
+		}
+
+		/**
+		 * @brief Computes the dot product with another vector.
+		 *
+		 * @param other The other vector.
+		 * @return The dot product.
+		 */
+		constexpr double dot(const Vector3d& other) const {
+			return x * other.x + y * other.y + z * other.z;
+		}
+
+		/**
+		 * @brief Calculates the magnitude (length) of the vector.
+		 *
+		 * @return The magnitude of the vector.
+		 */
+		double magnitude() const {
+			return std::sqrt(x * x + y * y + z * z);
+		}
+
+		/**
+		 * @brief Rounds the vector to float precision.
+		 *
+		 * Only meaningful for small values; use relativeTo for world positions.
+		 *
+		 * @return The nearest float vector.
+		 */
+		constexpr Vector3 toVector3() const {
+			return Vector3(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z));
+		}
+
+		/**
+		 * @brief The offset from origin to this position, rounded to float.
+		 *
+		 * The subtraction happens in double, so the result keeps full float precision however far
+		 * both positions are from the world origin.
+		 *
+		 * @param origin The new origin (usually the camera position).
+		 * @return this - origin as a float vector.
+		 */
+		constexpr Vector3 relativeTo(const Vector3d& origin) const {
+			return (*this - origin).toVector3();
+		}
+
+		/**
+		 * @brief Pointer to the components as an array of three doubles.
+		 */
+		double* data() { return &x; }
+		const double* data() const { return &x; }
+	};
+
+	static_assert(sizeof(Vector3d) == 3 * sizeof(double), "Vector3d must be three packed doubles");
+
+	/**
+	 * @brief Rebases many world positions to an origin: out[i] = positions[i].relativeTo(origin).
+	 *
+	 * Used once per frame to bring every actor into camera-relative space. Both arrays are
+	 * packed, so four positions are twelve consecutive doubles in and twelve consecutive floats
+	 * out: with AVX the kernel subtracts the origin from three 4-double registers (the origin is
+	 * pre-arranged as xyzx, yzxy, zxyz) and narrows each one with a single vcvtpd2ps, without
+	 * reshuffling the components. SSE2 does the same with six 2-double registers. The results
+	 * are bit-identical to the scalar conversion.
+	 *
+	 * @param positions The world positions.
+	 * @param origin The new origin.
+	 * @param out The destination (count elements).
+	 * @param count The number of positions.
+	 */
+	inline void rebasePositions(const Vector3d* positions, const Vector3d& origin, Vector3* out, size_t count) {
+		size_t i = 0;
+#if ENGINE_MATH_SSE2
+		size_t simdCount = count - count % 4;
+#endif
+#if ENGINE_MATH_AVX2
+		__m256d o0 = _mm256_setr_pd(origin.x, origin.y, origin.z, origin.x);
+		__m256d o1 = _mm256_setr_pd(origin.y, origin.z, origin.x, origin.y);
+		__m256d o2 = _mm256_setr_pd(origin.z, origin.x, origin.y, origin.z);
+		for (; i < simdCount; i += 4) {
+			const double* p = positions[i].data();
+			float* q = out[i].data();
+			_mm_storeu_ps(q, _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(p), o0)));
+			_mm_storeu_ps(q + 4, _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(p + 4), o1)));
+			_mm_storeu_ps(q + 8, _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(p + 8), o2)));
+		}
+#elif ENGINE_MATH_SSE2
+		__m128d xy = _mm_setr_pd(origin.x, origin.y);
+		__m128d zx = _mm_setr_pd(origin.z, origin.x);
+		__m128d yz = _mm_setr_pd(origin.y, origin.z);
+		for (; i < simdCount; i += 4) {
+			const double* p = positions[i].data();
+			float* q = out[i].data();
+			__m128 a = _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(p), xy));
+			__m128 b = _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(p + 2), zx));
+			__m128 c = _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(p + 4), yz));
+			__m128 d = _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(p + 6), xy));
+			__m128 e = _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(p + 8), zx));
+			__m128 f = _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(p + 10), yz));
+			_mm_storeu_ps(q, _mm_movelh_ps(a, b));
+			_mm_storeu_ps(q + 4, _mm_movelh_ps(c, d));
+			_mm_storeu_ps(q + 8, _mm_movelh_ps(e, f));
+		}
+#endif
+		for (; i < count; ++i) {
+			out[i] = positions[i].relativeTo(origin);
+		}
+	}
+}
@@ -0,0 +1,374 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+
+#include <cstddef>
+#include "Utilities/Utilities/EngineMathSIMD.h"
+#include "Vector3.h"
+namespace EngineUtilities {
+  namespace MathDetail {
+    /**
+     * @brief Eight floats processed together: one AVX2 register, two SSE2 registers or a plain array.
+     *
+     * Only the batch kernels below use it; it keeps one kernel body for the three code paths.
+     */
+#if ENGINE_MATH_AVX2
+    struct Float8 {
+      __m256 v;
+    };
+
+    inline Float8 load8(const float* p) { return { _mm256_load_ps(p) }; }
+    inline void store8(float* p, Float8 a) { _mm256_store_ps(p, a.v); }
+    inline Float8 splat8(float s) { return { _mm256_set1_ps(s) }; }
+    inline Float8 operator+(Float8 a, Float8 b) { return { _mm256_add_ps(a.v, b.v) }; }
+    inline Float8 operator-(Float8 a, Float8 b) { return { _mm256_sub_ps(a.v, b.v) }; }
+    inline Float8 operator*(Float8 a, Float8 b) { return { _mm256_mul_ps(a.v, b.v) }; }
+    inline Float8 mulAdd(Float8 a, Float8 b, Float8 c) { return { mulAdd8(a.v, b.v, c.v) }; }
+    inline Float8 sqrt(Float8 a) { return { _mm256_sqrt_ps(a.v) }; }
+    inline Float8 abs(Float8 a) { return { _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v) }; }
+
+    /**
+     * @brief Bit i is set when lane i is less than zero.
+     */
+    inline unsigned negativeMask(Float8 a) {
+      return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(a.v, _mm256_setzero_ps(), _CMP_LT_OQ)));
+    }
+
+    /**
+     * @brief 1 / sqrt(a), or 0 in the lanes where a is 0.
+     */
+    inline Float8 inverseSqrtOrZero(Float8 a) {
+      __m256 nonZero = _mm256_cmp_ps(a.v, _mm256_setzero_ps(), _CMP_GT_OQ);
+      __m256 inverse = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(a.v));
+      return { _mm256_and_ps(nonZero, inverse) };
+    }
+#elif ENGINE_MATH_SSE2
+    struct Float8 {
+      __m128 lo;
+      __m128 hi;
+    };
+
+    inline Float8 load8(const float* p) { return { _mm_load_ps(p), _mm_load_ps(p + 4) }; }
+    inline void store8(float* p, Float8 a) { _mm_store_ps(p, a.lo); _mm_store_ps(p + 4, a.hi); }
+    inline Float8 splat8(float s) { return { _mm_set1_ps(s), _mm_set1_ps(s) }; }
+    inline Float8 operator+(Float8 a, Float8 b) { return { _mm_add_ps(a.lo, b.lo), _mm_add_ps(a.hi, b.hi) }; }
+    inline Float8 operator-(Float8 a, Float8 b) { return { _mm_sub_ps(a.lo, b.lo), _mm_sub_ps(a.hi, b.hi) }; }
+    inline Float8 operator*(Float8 a, Float8 b) { return { _mm_mul_ps(a.lo, b.lo), _mm_mul_ps(a.hi, b.hi) }; }
+    inline Float8 mulAdd(Float8 a, Float8 b, Float8 c) { return { mulAdd4(a.lo, b.lo, c.lo), mulAdd4(a.hi, b.hi, c.hi) }; }
+    inline Float8 sqrt(Float8 a) { return { _mm_sqrt_ps(a.lo), _mm_sqrt_ps(a.hi) }; }
+    inline Float8 abs(Float8 a) {
+      __m128 sign = _mm_set1_ps(-0.0f);
+      return { _mm_andnot_ps(sign, a.lo), _mm_andnot_ps(sign, a.hi) };
+    }
+    inline unsigned negativeMask(Float8 a) {
+      __m128 zero = _mm_setzero_ps();
+      return static_cast<unsigned>(_mm_movemask_ps(_mm_cmplt_ps(a.lo, zero)) |
+                                   (_mm_movemask_ps(_mm_cmplt_ps(a.hi, zero)) << 4));
+    }
+
+    inline __m128 inverseSqrtOrZero4(__m128 a) {
+      __m128 nonZero = _mm_cmpgt_ps(a, _mm_setzero_ps());
+      return _mm_and_ps(nonZero, _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(a)));
+    }
+
+    inline Float8 inverseSqrtOrZero(Float8 a) {
+      return { inverseSqrtOrZero4(a.lo), inverseSqrtOrZero4(a.hi) };
+    }
+#else
+    struct Float8 {
+      float v[8];
+    };
+
+    inline Float8 load8(const float* p) {
+      Float8 r;
+      for (int i = 0; i < 8; ++i) r.v[i] = p[i];
+      return r;
+    }
+    inline void store8(float* p, Float8 a) {
+      for (int i = 0; i < 8; ++i) p[i] = a.v[i];
+    }
+    inline Float8 splat8(float s) {
+      Float8 r;
+      for (int i = 0; i < 8; ++i) r.v[i] = s;
+      return r;
+    }
+    inline Float8 operator+(Float8 a, Float8 b) {
+      for (int i = 0; i < 8; ++i) a.v[i] += b.v[i];
+      return a;
+    }
+    inline Float8 operator-(Float8 a, Float8 b) {
+      for (int i = 0; i < 8; ++i) a.v[i] -= b.v[i];
+      return a;
+    }
+    inline Float8 operator*(Float8 a, Float8 b) {
+      for (int i = 0; i < 8; ++i) a.v[i] *= b.v[i];
+      return a;
+    }
+    inline Float8 mulAdd(Float8 a, Float8 b, Float8 c) { return a * b + c; }
+    inline Float8 sqrt(Float8 a) {
+      for (int i = 0; i < 8; ++i) a.v[i] = EngineUtilities::sqrt(a.v[i]);
+      return a;
+    }
+    inline Float8 inverseSqrtOrZero(Float8 a) {
+      for (int i = 0; i < 8; ++i) a.v[i] = a.v[i] > 0.0f ? 1.0f / EngineUtilities::sqrt(a.v[i]) : 0.0f;
+      return a;
+    }
+    inline Float8 abs(Float8 a) {
+      for (int i = 0; i < 8; ++i) a.v[i] = EngineUtilities::fabs(a.v[i]);
+      return a;
+    }
+    inline unsigned negativeMask(Float8 a) {
+      unsigned mask = 0;
+      for (int i = 0; i < 8; ++i) mask |= (a.v[i] < 0.0f ? 1u : 0u) << i;
+      return mask;
+    }
+#endif
+  }
+
+  /**
+   * @brief Eight 3D vectors stored as structure of arrays (x[8], y[8], z[8]).
+   *
+   * Large sets of vectors (particles, skinned positions, culling bounds) are kept as an array
+   * of Vector3x8 blocks so the batch kernels below can process a whole block per instruction:
+   * 8 lanes per register with AVX2, two registers with SSE2, and a scalar loop otherwise.
+   * Blocks are 32-byte aligned; TArray honours that alignment.
+   */
+  class alignas(32) Vector3x8 {
+  public:
+    static constexpr size_t Width = 8; /**< Number of vectors per block. */
+
+    float x[Width]; /**< The x-coordinates of the eight vectors. */
+    float y[Width]; /**< The y-coordinates of the eight vectors. */
+    float z[Width]; /**< The z-coordinates of the eight vectors. */
+
+    /**
+     * @brief Default constructor.
+     *
+     * Initializes all eight vectors to (0, 0, 0).
+     */
+    Vector3x8() : x(), y(), z() {}
+
+    /**
+     * @brief Reads one lane as a Vector3.
+     *
+     * @param lane The lane index, in [0, Width).
+     * @return The vector stored in that lane.
+     */
+    Vector3 get(size_t lane) const {
+      return Vector3(x[lane], y[lane], z[lane]);
+    }
+
+    /**
+     * @brief Writes one lane from a Vector3.
+     *
+     * @param lane The lane index, in [0, Width).
+     * @param value The vector to store.
+     */
+    void set(size_t lane, const Vector3& value) {
+      x[lane] = value.x;
+      y[lane] = value.y;
+      z[lane] = value.z;
+    }
+
+    /**
+     * @brief Number of blocks needed to hold a number of vectors.
+     *
+     * @param vectorCount The number of vectors.
+     * @return The number of blocks, rounded up.
+     */
+    static size_t blocksFor(size_t vectorCount) {
+      return (vectorCount + Width - 1) / Width;
+    }
+  };
+
+  /**
+   * @brief Converts an array of Vector3 into SoA blocks.
+   *
+   * The unused lanes of the last block are set to zero.
+   *
+   * @param src The source vectors.
+   * @param count The number of source vectors.
+   * @param dst The destination blocks (Vector3x8::blocksFor(count) elements).
+   */
+  inline void packVector3x8(const Vector3* src, size_t count, Vector3x8* dst) {
+    for (size_t i = 0; i < Vector3x8::blocksFor(count) * Vector3x8::Width; ++i) {
+      dst[i / Vector3x8::Width].set(i % Vector3x8::Width, i < count ? src[i] : Vector3());
+    }
+  }
+
+  /**
+   * @brief Converts SoA blocks back into an array of Vector3.
+   *
+   * @param src The source blocks.
+   * @param count The number of vectors to write.
+   * @param dst The destination vectors (count elements).
+   */
+  inline void unpackVector3x8(const Vector3x8* src, size_t count, Vector3* dst) {
+    for (size_t i = 0; i < count; ++i) {
+      dst[i] = src[i / Vector3x8::Width].get(i % Vector3x8::Width);
+    }
+  }
+
+  // Batch kernels. Every kernel works on whole blocks and allows out to be one of the inputs.
+
+  /**
+   * @brief out = a + b for every vector.
+   *
+   * @param a The first operand blocks.
+   * @param b The second operand blocks.
+   * @param out The result blocks.
+   * @param blockCount The number of blocks.
+   */
+  inline void addBatch(const Vector3x8* a, const Vector3x8* b, Vector3x8* out, size_t blockCount) {
+    using namespace MathDetail;
+    for (size_t i = 0; i < blockCount; ++i) {
+      Float8 x = load8(a[i].x) + load8(b[i].x);
+      Float8 y = load8(a[i].y) + load8(b[i].y);
+      Float8 z = load8(a[i].z) + load8(b[i].z);
+      store8(out[i].x, x);
+      store8(out[i].y, y);
+      store8(out[i].z, z);
+    }
+  }
+
+  /**
+   * @brief out = a * b + c, component-wise, for every vector.
+   *
+   * @param a The first factor blocks.
+   * @param b The second factor blocks.
+   * @param c The addend blocks.
+   * @param out The result blocks.
+   * @param blockCount The number of blocks.
+   */
+  inline void mulAddBatch(const Vector3x8* a, const Vector3x8* b, const Vector3x8* c,
+                          Vector3x8* out, size_t blockCount) {
+    using namespace MathDetail;
+    for (size_t i = 0; i < blockCount; ++i) {
+      Float8 x = mulAdd(load8(a[i].x), load8(b[i].x), load8(c[i].x));
+      Float8 y = mulAdd(load8(a[i].y), load8(b[i].y), load8(c[i].y));
+      Float8 z = mulAdd(load8(a[i].z), load8(b[i].z), load8(c[i].z));
+      store8(out[i].x, x);
+      store8(out[i].y, y);
+      store8(out[i].z, z);
+    }
+  }
+
+  /**
+   * @brief out = a * scalar + c for every vector (e.g. position += velocity * deltaTime).
+   *
+   * @param a The blocks to scale.
+   * @param scalar The scale factor.
+   * @param c The addend blocks.
+   * @param out The result blocks.
+   * @param blockCount The number of blocks.
+   */
+  inline void mulAddBatch(const Vector3x8* a, float scalar, const Vector3x8* c,
+                          Vector3x8* out, size_t blockCount) {
+    using namespace MathDetail;
+    Float8 s = splat8(scalar);
+    for (size_t i = 0; i < blockCount; ++i) {
+      Float8 x = mulAdd(load8(a[i].x), s, load8(c[i].x));
+      Float8 y = mulAdd(load8(a[i].y), s, load8(c[i].y));
+      Float8 z = mulAdd(load8(a[i].z), s, load8(c[i].z));
+      store8(out[i].x, x);
+      store8(out[i].y, y);
+      store8(out[i].z, z);
+    }
+  }
+
+  /**
+   * @brief Dot product of every pair of vectors.
+   *
+   * @param a The first operand blocks.
+   * @param b The second operand blocks.
+   * @param out The results, blockCount * Vector3x8::Width floats aligned to 32 bytes.
+   * @param blockCount The number of blocks.
+   */
+  inline void dotBatch(const Vector3x8* a, const Vector3x8* b, float* out, size_t blockCount) {
+    using namespace MathDetail;
+    for (size_t i = 0; i < blockCount; ++i) {
+      Float8 d = load8(a[i].x) * load8(b[i].x);
+      d = mulAdd(load8(a[i].y), load8(b[i].y), d);
+      d = mulAdd(load8(a[i].z), load8(b[i].z), d);
+      store8(out + i * Vector3x8::Width, d);
+    }
+  }
+
+  /**
+   * @brief Cross product (a x b) of every pair of vectors.
+   *
+   * @param a The first operand blocks.
+   * @param b The second operand blocks.
+   * @param out The result blocks.
+   * @param blockCount The number of blocks.
+   */
+  inline void crossBatch(const Vector3x8* a, const Vector3x8* b, Vector3x8* out, size_t blockCount) {
+    using namespace MathDetail;
+    for (size_t i = 0; i < blockCount; ++i) {
+      Float8 ax = load8(a[i].x), ay = load8(a[i].y), az = load8(a[i].z);
+      Float8 bx = load8(b[i].x), by = load8(b[i].y), bz = load8(b[i].z);
+      store8(out[i].x, ay * bz - az * by);
+      store8(out[i].y, az * bx - ax * bz);
+      store8(out[i].z, ax * by - ay * bx);
+    }
+  }
+
+  /**
+   * @brief Length of every vector.
+   *
+   * @param a The source blocks.
+   * @param out The results, blockCount * Vector3x8::Width floats aligned to 32 bytes.
+   * @param blockCount The number of blocks.
+   */
+  inline void lengthBatch(const Vector3x8* a, float* out, size_t blockCount) {
+    using namespace MathDetail;
+    for (size_t i = 0; i < blockCount; ++i) {
+      Float8 x = load8(a[i].x), y = load8(a[i].y), z = load8(a[i].z);
+      store8(out + i * Vector3x8::Width, sqrt(mulAdd(z, z, mulAdd(y, y, x * x))));
+    }
+  }
+
+  /**
+   * @brief Normalizes every vector; zero-length vectors become (0, 0, 0) like Vector3::normalize.
+   *
+   * @param a The source blocks.
+   * @param out The result blocks.
+   * @param blockCount The number of blocks.
+   */
+  inline void normalizeBatch(const Vector3x8* a, Vector3x8* out, size_t blockCount) {
+    using namespace MathDetail;
+    for (size_t i = 0; i < blockCount; ++i) {
+      Float8 x = load8(a[i].x), y = load8(a[i].y), z = load8(a[i].z);
+      Float8 inverse = inverseSqrtOrZero(mulAdd(z, z, mulAdd(y, y, x * x)));
+      store8(out[i].x, x * inverse);
+      store8(out[i].y, y * inverse);
+      store8(out[i].z, z * inverse);
+    }
+  }
+}
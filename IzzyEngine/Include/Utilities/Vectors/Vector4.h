@@ -28,7 +28,7 @@
 */
 #pragma once
 
-#include "Utilities/EngineMath.h"
+#include "Utilities/Utilities/EngineMath.h"
 namespace EngineUtilities {
   /**
  * @brief A 4D vector class.
@@ -36,8 +36,11 @@ namespace EngineUtilities {
  * This class represents a vector in 4-dimensional space and provides
  * basic vector operations such as addition, subtraction, scalar multiplication,
  * and normalization.
+ *
+ * The vector is 16-byte aligned so that it can be loaded into a single SSE register;
+ * every operation has an SSE2 path and a scalar fallback.
  */
-  class Vector4 {
+  class alignas(16) Vector4 {
   public:
     float x; /**< The x-coordinate of the vector. */
     float y; /**< The y-coordinate of the vector. */
@@ -49,7 +52,7 @@ namespace EngineUtilities {
      *
      * Initializes the vector to (0, 0, 0, 0).
      */
-    Vector4() : x(0), y(0), z(0), w(0) {}
+    constexpr Vector4() : x(0), y(0), z(0), w(0) {}
 
     /**
      * @brief Parameterized constructor.
@@ -61,7 +64,27 @@ namespace EngineUtilities {
      * @param z The z-coordinate.
      * @param w The w-coordinate.
      */
-    Vector4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+    constexpr Vector4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+
+#if ENGINE_MATH_SSE2
+    /**
+     * @brief Constructs the vector from an SSE register (x in the lowest lane).
+     *
+     * @param value The register to store.
+     */
+    explicit Vector4(__m128 value) {
+      _mm_store_ps(&x, value);
+    }
+
+    /**
+     * @brief Loads the vector into an SSE register (x in the lowest lane).
+     *
+     * @return The register holding (x, y, z, w).
+     */
+    __m128 toSIMD() const {
+      return _mm_load_ps(&x);
+    }
+#endif
 
     /**
      * @brief Adds another vector to this vector.
@@ -70,7 +93,11 @@ namespace EngineUtilities {
      * @return The result of the addition.
      */
     Vector4 operator+(const Vector4& other) const {
+#if ENGINE_MATH_SSE2
+      return Vector4(_mm_add_ps(toSIMD(), other.toSIMD()));
+#else
       return Vector4(x + other.x, y + other.y, z + other.z, w + other.w);
+#endif
     }
 
     /**
@@ -80,7 +107,11 @@ namespace EngineUtilities {
      * @return The result of the subtraction.
      */
     Vector4 operator-(const Vector4& other) const {
+#if ENGINE_MATH_SSE2
+      return Vector4(_mm_sub_ps(toSIMD(), other.toSIMD()));
+#else
       return Vector4(x - other.x, y - other.y, z - other.z, w - other.w);
+#endif
     }
 
     /**
@@ -90,7 +121,25 @@ namespace EngineUtilities {
      * @return The result of the multiplication.
      */
     Vector4 operator*(float scalar) const {
+#if ENGINE_MATH_SSE2
+      return Vector4(_mm_mul_ps(toSIMD(), _mm_set1_ps(scalar)));
+#else
       return Vector4(x * scalar, y * scalar, z * scalar, w * scalar);
+#endif
+    }
+
+    /**
+     * @brief Computes the dot product with another vector.
+     *
+     * @param other The other vector.
+     * @return The dot product.
+     */
+    float dot(const Vector4& other) const {
+#if ENGINE_MATH_SSE2
+      return _mm_cvtss_f32(dotSplat(toSIMD(), other.toSIMD()));
+#else
+      return x * other.x + y * other.y + z * other.z + w * other.w;
+#endif
     }
 
     /**
@@ -99,20 +148,56 @@ namespace EngineUtilities {
      * @return The magnitude of the vector.
      */
     float magnitude() const {
+#if ENGINE_MATH_SSE2
+      __m128 v = toSIMD();
+      return _mm_cvtss_f32(_mm_sqrt_ss(dotSplat(v, v)));
+#else
       return EngineUtilities::sqrt(x * x + y * y + z * z + w * w);
+#endif
     }
 
     /**
      * @brief Normalizes the vector.
      *
-     * @return The normalized vector.
+     * @return The normalized vector, or (0, 0, 0, 0) for a zero-length vector.
      */
     Vector4 normalize() const {
+#if ENGINE_MATH_SSE2
+      __m128 v = toSIMD();
+      __m128 lengthSquared = dotSplat(v, v);
+      if (_mm_cvtss_f32(lengthSquared) == 0.0f) {
+        return Vector4(0, 0, 0, 0);
+      }
+      return Vector4(_mm_div_ps(v, _mm_sqrt_ps(lengthSquared)));
+#else
       float mag = magnitude();
       if (mag == 0) {
         return Vector4(0, 0, 0, 0);
       }
-      return Vector4(x / mag, y / mag, z / mag, w / mag);
+      float inverse = 1.0f / mag;
+      return Vector4(x * inverse, y * inverse, z * inverse, w * inverse);
+#endif
+    }
+
+    /**
+     * @brief Returns a pointer to the vector's data.
+     *
+     * @return Pointer to the first element (x, y, z, w).
+     */
+    float* data() { return &x; }
+    const float* data() const { return &x; }
+
+  private:
+#if ENGINE_MATH_SSE2
+    /**
+     * @brief Dot product of a and b broadcast to the four lanes.
+     */
+    static __m128 dotSplat(__m128 a, __m128 b) {
+      __m128 product = _mm_mul_ps(a, b);
+      // (x+z, y+w, ...) and then the sum of both halves in every lane.
+      __m128 pairs = _mm_add_ps(product, _mm_shuffle_ps(product, product, _MM_SHUFFLE(1, 0, 3, 2)));
+      return _mm_add_ps(pairs, _mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(2, 3, 0, 1)));
     }
+#endif
   };
 }
@@ -101,6 +101,10 @@ BaseApp::init() {
   // Initialize the projection matrix
   m_userInterface.init(m_window.m_hWnd, m_device.m_device, m_deviceContext.m_deviceContext);
 
+  // Sistemas del ECS, en orden de dependencia: BoundsSystem lee lo que escribe TransformSystem
+  m_transformSystem = &m_systems.addSystem<TransformSystem>();
+  m_systems.addSystem<BoundsSystem>();
+
   // Load the Texture
   Texture Body;
   Body.init(m_device, "Textures/Body.png", ExtensionType::PNG);
@@ -120,7 +124,7 @@ BaseApp::init() {
 
   // Load Model
   m_psyduck.LoadFBXModel("Models/Psyduck.FBX");
-  APsyduck = EngineUtilities::MakeShared<Actor>(m_device);
+  APsyduck = EngineUtilities::MakeShared<Actor>(EngineUtilities::TSharedPool<Actor>::get(), m_device);
   APsyduck->setName("Psyduck");
   if (!APsyduck.isNull()) {
     // Init Actor Transform
@@ -149,8 +153,8 @@ BaseApp::init() {
 
   //Load Model Warlock
   m_warlock.LoadFBXModel("Models/Warlock.FBX");
-  AWarlock = EngineUtilities::MakeShared<Actor>(m_device);
-  AWarlock = EngineUtilities::MakeShared<Actor>(m_device);
+  AWarlock = EngineUtilities::MakeShared<Actor>(EngineUtilities::TSharedPool<Actor>::get(), m_device);
+  AWarlock = EngineUtilities::MakeShared<Actor>(EngineUtilities::TSharedPool<Actor>::get(), m_device);
   if (!AWarlock.isNull()) {
     AWarlock->setName("Warlock"); // Asignar nombre visible en ImGui
     AWarlock->getComponent<Transform>()->setTransform(EngineUtilities::Vector3(12.0f, -5.0f, 26.0f),
@@ -172,7 +176,7 @@ BaseApp::init() {
 
   // Load Model
   m_objModel.LoadObjModel("Models/goku.obj");
-  AObjModel = EngineUtilities::MakeShared<Actor>(m_device); //Actor de Goku
+  AObjModel = EngineUtilities::MakeShared<Actor>(EngineUtilities::TSharedPool<Actor>::get(), m_device); //Actor de Goku
   AObjModel->setName("Goku chiquito");  //Nombre del actor
   if (!AObjModel.isNull()) {
     // Init Actor Transform
@@ -193,20 +197,32 @@ BaseApp::init() {
     MESSAGE("Actor", "Actor", "Actor resource not found.");
   }
 
+  // Seleccionar el primer actor en el panel de Transform
+  if (!m_actors.empty()) {
+    selectedActor = m_actors.front()->getEntityId();
+  }
+
   return S_OK;
 }
 
 void
 BaseApp::update() {
+  // 0) Cerrar las estadsticas de memoria del frame anterior y liberar la memoria temporal de hace dos frames
+  EngineUtilities::MemoryTracker::get().endFrame();
+  EngineUtilities::FrameAllocator::get().beginFrame();
+
   // 1) Nueva frame de ImGui
   m_userInterface.update();
 
   // 2) Panel de seleccin de actores
-  m_userInterface.actorsWindow(m_actors, selectedActorIndex);
+  m_userInterface.actorsWindow(m_actors, selectedActor);
 
   // 3) Ventana de prueba de docking
   m_userInterface.drawTestDock();
 
+  // Panel de memoria por subsistema
+  m_userInterface.memoryWindow();
+
   // 4) Actualizar tiempo y cmara 
   static float t = 0.0f;
   if (m_swapchain.m_driverType == D3D_DRIVER_TYPE_REFERENCE) {
@@ -234,13 +250,26 @@ BaseApp::update() {
                           0, 
                           0);
 
-  // 5) Actualizar todos los actores
+  // Frustum de la cmara en espacio relativo a la cmara, para descartar las mallas fuera de la vista
+  EngineUtilities::Matrix4x4 viewProjection;
+  XMStoreFloat4x4(reinterpret_cast<XMFLOAT4X4*>(viewProjection.m), XMMatrixMultiply(m_View, m_Projection));
+  EngineUtilities::Frustum frustum = EngineUtilities::Frustum::fromViewProjection(viewProjection);
+
+  // 5) Sistemas del ECS en el ThreadPool: matrices de todos los Transform (relativas a la cmara)
+  // y despus las cajas envolventes, cada uno repartido por chunks entre los hilos
+  m_transformSystem->setRenderOrigin(m_camera.pos);
+  m_systems.update(World::get(), t);
+
+  // 6) Actualizar todos los actores (buffers de constantes: solo desde el hilo principal)
   for (auto& actor : m_actors) {
-    if (actor) actor->update(t, m_deviceContext);
+    if (actor) {
+      actor->setViewFrustum(frustum);
+      actor->update(t, m_deviceContext);
+    }
   }
 
-  // 6) Panel de Transform para el actor seleccionado
-  m_userInterface.transformWindow(m_actors[selectedActorIndex]);
+  // 7) Panel de Transform para el actor seleccionado; si ya no existe, find devuelve nullptr y el panel queda vaco
+  m_userInterface.transformWindow(dynamic_cast<Actor*>(Entity::find(selectedActor)));
 }
 
 void
@@ -332,7 +361,7 @@ BaseApp::InputActionMap(float deltaTime) {
     position.z -= sensibility * deltaTime;
   }*/
 
-  XMVECTOR position = XMLoadFloat3(&m_camera.pos);
+  EngineUtilities::Vector3d position = m_camera.pos;
   XMVECTOR forward = XMLoadFloat3(&m_camera.forward);
   XMVECTOR right = XMLoadFloat3(&m_camera.right);
 
@@ -343,17 +372,18 @@ BaseApp::InputActionMap(float deltaTime) {
   if (keys['A']) pos -= right * moveSpeedCamera;
   if (keys['D']) pos += right * moveSpeedCamera;*/
 
-  XMStoreFloat3(&m_camera.pos, position);
+  m_camera.pos = position;
 
 }
 
 void 
 BaseApp::updateCamera() {
-  XMVECTOR position = XMLoadFloat3(&m_camera.pos);  //posicin de la cmara
   XMVECTOR dir = XMLoadFloat3(&m_camera.forward); //direccin de la cmara
   XMVECTOR up = XMLoadFloat3(&m_camera.up); //vector up de la cmara
 
-  m_View = XMMatrixLookAtLH(position, position + dir, up); //matriz de vista de la cmara
+  // Render relativo a la cmara: la vista solo rota, la posicin de la cmara (m_camera.pos)
+  // se resta en double a la de cada actor antes de construir su matriz de mundo
+  m_View = XMMatrixLookToLH(XMVectorZero(), dir, up); //matriz de vista de la cmara
 
   cbNeverChanges.mView = XMMatrixTranspose(m_View); //matriz de vista
   m_neverChanges.update(m_deviceContext, 0, nullptr, &cbNeverChanges, 0, 0);  //actualiza la matriz de vista
@@ -1,13 +1,14 @@
 #include "ECS/Actor.h"
+#include "ECS/MeshBounds.h"
 #include "MeshComponent.h"
 #include "Device.h"
 
 
 Actor::Actor(Device& device) {
-  // Componentes por defecto
-  EngineUtilities::TSharedPointer<Transform> transform = EngineUtilities::MakeShared<Transform>();
-  addComponent(transform);
-  EngineUtilities::TSharedPointer<MeshComponent> mesh = EngineUtilities::MakeShared<MeshComponent>();
+  // Componentes por defecto. El Transform vive en los chunks del World junto a los de los dems
+  // actores, para que TransformSystem los actualice todos en un barrido lineal; la malla sale de un pool.
+  emplaceComponent<Transform>();
+  EngineUtilities::TSharedPointer<MeshComponent> mesh = EngineUtilities::MakeShared<MeshComponent>(EngineUtilities::TSharedPool<MeshComponent>::get());
   addComponent(mesh);
 
   // Inicializar el actor
@@ -39,11 +40,10 @@ Actor::Actor(Device& device) {
 
 void
 Actor::update(float deltaTime, DeviceContext& deviceContext) {
-  // Update Transform Component
-  getComponent<Transform>()->update(deltaTime);
-
+  // TransformSystem y BoundsSystem ya actualizaron la matriz y las cajas de este frame
   // Update Mesh Component
   m_model.mWorld = XMMatrixTranspose(getComponent<Transform>()->matrix);
+
   // Update the model matrix in the constant buffer
   m_model.vMeshColor = XMFLOAT4(0.7f, 0.7f, 0.7f, 1.0f);
 
@@ -57,8 +57,16 @@ Actor::render(DeviceContext& deviceContext) {
 
   m_sampler.render(deviceContext, 0, 1);
 
+  MeshBounds* bounds = getComponent<MeshBounds>();
+
   // Update buffers for each individual mesh on the actor
   for (unsigned int i = 0; i < m_meshes.size(); i++) {
+    // Omitir las mallas que quedan fuera de la vista
+    if (m_hasViewFrustum && bounds && i < bounds->renderBounds.size() &&
+        !m_viewFrustum.intersects(bounds->renderBounds[i])) {
+      continue;
+    }
+
     m_vertexBuffers[i].render(deviceContext, 0, 1);
     m_indexBuffers[i].render(deviceContext, 0, 1, false, DXGI_FORMAT_R32_UINT);
 
@@ -103,6 +111,17 @@ Actor::destroy() {
 void
 Actor::setMesh(Device& device, std::vector<MeshComponent> meshes) {
   m_meshes = meshes;  // Asignar los meshes al actor
+
+  // Cajas locales de las mallas; BoundsSystem las lleva a espacio de render cada frame
+  MeshBounds* bounds = getComponent<MeshBounds>();
+  if (!bounds) {
+    bounds = emplaceComponent<MeshBounds>();
+  }
+  bounds->localBounds.clear();
+  for (const MeshComponent& mesh : m_meshes) {
+    bounds->localBounds.push_back(mesh.m_bounds);
+  }
+  bounds->transformVersion = 0;  // Las cajas locales cambiaron: BoundsSystem debe recalcular las de mundo
   HRESULT hr;         // Inicializar el resultado de HRESULT
   // Limpiar los buffers de vrtices e ndices
   for (auto& mesh : m_meshes) {
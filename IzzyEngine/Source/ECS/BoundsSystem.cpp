@@ -0,0 +1,29 @@
+#include "ECS\BoundsSystem.h"
+#include "ECS\Transform.h"
+#include "ECS\MeshBounds.h"
+
+BoundsSystem::BoundsSystem() {
+  reads<Transform>();
+  writes<MeshBounds>();
+}
+
+void
+BoundsSystem::update(World& world, float deltaTime) {
+  world.forEachChunkParallel<Transform, MeshBounds>([](size_t count, const EntityId*,
+                                                       Transform* transforms, MeshBounds* bounds) {
+    for (size_t i = 0; i < count; ++i) {
+      // Solo se recalculan las cajas de los Transform cuya matriz cambi
+      if (bounds[i].transformVersion == transforms[i].getWorldVersion()) {
+        continue;
+      }
+      bounds[i].transformVersion = transforms[i].getWorldVersion();
+      EngineUtilities::Matrix4x4 matrix;
+      XMStoreFloat4x4(reinterpret_cast<XMFLOAT4X4*>(matrix.m), transforms[i].matrix);
+      std::vector<EngineUtilities::AABB>& renderBounds = bounds[i].renderBounds;
+      renderBounds.resize(bounds[i].localBounds.size());
+      for (size_t m = 0; m < renderBounds.size(); ++m) {
+        renderBounds[m] = bounds[i].localBounds[m].transformed(matrix);
+      }
+    }
+  });
+}
@@ -5,26 +5,61 @@ void
 Transform::init() {
   scale.one();  // Inicializar escala a 1
   matrix = XMMatrixIdentity();  // Inicializar matriz a identidad
+  markDirty();
 }
 
 void
 Transform::update(float deltaTime) {
-  // Aplicar escala
-  XMMATRIX scaleMatrix = XMMatrixScaling(scale.x, scale.y, scale.z);
-  // Aplicar rotacion
-  XMMATRIX rotationMatrix = XMMatrixRotationRollPitchYaw(rotation.x, rotation.y, rotation.z);
-  // Aplicar traslacion
-  XMMATRIX translationMatrix = XMMatrixTranslation(position.x, position.y, position.z);
-
-  // Componer la matriz final en el orden: scale -> rotation -> translation
-  matrix = scaleMatrix * rotationMatrix * translationMatrix;
+  if (!dirty) {
+    return;
+  }
+  syncOrientation();
+
+  // Componer la matriz local en el orden: scale -> rotation, directamente desde el cuaternion.
+  // La traslacion se queda en double (position); TransformSystem la suma al componer con el padre
+  // y solo la convierte a float relativa a la camara, asi que la matriz nunca contiene coordenadas grandes.
+  localMatrix = EngineUtilities::composeTRS(EngineUtilities::Vector3(), orientation, scale);
+  dirty = false;
+}
+
+const EngineUtilities::Quaternion&
+Transform::getOrientation() {
+  syncOrientation();
+  return orientation;
+}
+
+void
+Transform::setOrientation(const EngineUtilities::Quaternion& newOrientation) {
+  orientation = newOrientation.normalize();
+  rotation = orientation.toEuler();  // Mantener la UI en sincronia
+  orientationEuler = rotation;
+  markDirty();
 }
 
 void
-Transform::setTransform(const EngineUtilities::Vector3& newPos,
+Transform::syncOrientation() {
+  if (rotation.x != orientationEuler.x || rotation.y != orientationEuler.y || rotation.z != orientationEuler.z) {
+    orientation = EngineUtilities::Quaternion::fromEuler(rotation);
+    orientationEuler = rotation;
+  }
+}
+
+void
+Transform::setTransform(const EngineUtilities::Vector3d& newPos,
                         const EngineUtilities::Vector3& newRot,
                         const EngineUtilities::Vector3& newSca) {
   position = newPos;  // Actualizar posicion
   rotation = newRot;  // Actualizar rotacion
   scale = newSca;  // Actualizar escala
+  markDirty();
+}
+
+void
+Transform::setParent(EntityId newParent) {
+  if (newParent == parent) {
+    return;
+  }
+  parent = newParent;
+  markDirty();
+  s_hierarchyVersion.fetch_add(1, std::memory_order_relaxed);  // TransformSystem rehace el orden por profundidad
 }
\ No newline at end of file
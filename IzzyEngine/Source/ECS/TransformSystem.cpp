@@ -0,0 +1,123 @@
+#include "ECS\TransformSystem.h"
+#include "ECS\Transform.h"
+
+TransformSystem::TransformSystem() {
+  writes<Transform>();
+}
+
+void
+TransformSystem::update(World& world, float deltaTime) {
+  bool rebuilt = false;
+  if (!m_built || world.getStructureVersion() != m_structureVersion ||
+      Transform::getHierarchyVersion() != m_hierarchyVersion) {
+    rebuildHierarchy(world);
+    rebuilt = true;
+  }
+  uint32_t changeCount = Transform::getChangeCount();
+  bool transformsChanged = rebuilt || changeCount != m_changeCount;
+  bool originMoved = !(m_renderOrigin == m_appliedOrigin);
+  if (!transformsChanged && !originMoved) {
+    return;  // Nada se movi: el escenario esttico no cuesta nada
+  }
+  m_changeCount = changeCount;
+  m_appliedOrigin = m_renderOrigin;
+
+  EngineUtilities::ThreadPool& pool = EngineUtilities::ThreadPool::get();
+  if (transformsChanged) {
+    m_hierarchy.propagate([&](size_t node, bool parentChanged) {
+      return updateWorld(node, parentChanged || rebuilt, deltaTime);
+    }, pool);
+  }
+
+  size_t count = m_hierarchy.size();
+  if (originMoved || rebuilt) {
+    // La cmara se movi: todas las posiciones relativas cambian, pero solo hace falta rehacer la traslacin
+    EngineUtilities::rebasePositions(m_worldPositions.data(), m_renderOrigin, m_renderPositions.data(), count);
+    pool.parallelFor(count, 1024, [&](size_t begin, size_t end) {
+      for (size_t node = begin; node < end; ++node) {
+        applyRenderPosition(node);
+      }
+    });
+  }
+  else {
+    pool.parallelFor(count, 1024, [&](size_t begin, size_t end) {
+      for (size_t node = begin; node < end; ++node) {
+        if (m_hierarchy.changed(node)) {
+          m_renderPositions[node] = m_worldPositions[node].relativeTo(m_renderOrigin);
+          applyRenderPosition(node);
+        }
+      }
+    });
+  }
+}
+
+void
+TransformSystem::rebuildHierarchy(World& world) {
+  std::vector<EntityId> entities;
+  std::vector<EntityId> parents;
+  std::vector<Transform*> transforms;
+  world.forEachChunk<Transform>([&](size_t count, const EntityId* ids, Transform* chunkTransforms) {
+    for (size_t i = 0; i < count; ++i) {
+      entities.push_back(ids[i]);
+      parents.push_back(chunkTransforms[i].getParent());
+      transforms.push_back(&chunkTransforms[i]);
+    }
+  });
+  m_hierarchy.rebuild(entities.data(), parents.data(), entities.size());
+
+  m_transforms.resize(transforms.size());
+  for (size_t node = 0; node < m_transforms.size(); ++node) {
+    m_transforms[node] = transforms[m_hierarchy.source(node)];
+  }
+  m_worldPositions.resize(m_transforms.size());
+  m_renderPositions.resize(m_transforms.size());
+
+  // Los punteros son vlidos hasta el siguiente cambio estructural del World
+  m_structureVersion = world.getStructureVersion();
+  m_hierarchyVersion = Transform::getHierarchyVersion();
+  m_built = true;
+}
+
+bool
+TransformSystem::updateWorld(size_t node, bool parentChanged, float deltaTime) {
+  Transform& transform = *m_transforms[node];
+  bool localChanged = transform.dirty;
+  if (!localChanged && !parentChanged) {
+    return false;
+  }
+  transform.update(deltaTime);
+
+  uint32_t parent = m_hierarchy.parent(node);
+  if (parent == TransformHierarchy::NoParent) {
+    transform.worldMatrix = transform.localMatrix;
+    transform.worldPosition = transform.position;
+  }
+  else {
+    // p * M con M = local * mundo del padre; la traslacin se suma en double
+    const Transform& parentTransform = *m_transforms[parent];
+    const EngineUtilities::Matrix4x4& parentMatrix = parentTransform.worldMatrix;
+    const EngineUtilities::Vector3d& local = transform.position;
+    transform.worldMatrix = transform.localMatrix * parentMatrix;
+    transform.worldPosition = parentTransform.worldPosition + EngineUtilities::Vector3d(
+      local.x * parentMatrix.m[0][0] + local.y * parentMatrix.m[1][0] + local.z * parentMatrix.m[2][0],
+      local.x * parentMatrix.m[0][1] + local.y * parentMatrix.m[1][1] + local.z * parentMatrix.m[2][1],
+      local.x * parentMatrix.m[0][2] + local.y * parentMatrix.m[1][2] + local.z * parentMatrix.m[2][2]);
+  }
+  m_worldPositions[node] = transform.worldPosition;
+  return true;
+}
+
+void
+TransformSystem::applyRenderPosition(size_t node) {
+  Transform& transform = *m_transforms[node];
+  const EngineUtilities::Vector3& renderPosition = m_renderPositions[node];
+  transform.renderPosition = renderPosition;
+
+  EngineUtilities::Matrix4x4 world = transform.worldMatrix;
+  world.m[3][0] = renderPosition.x;
+  world.m[3][1] = renderPosition.y;
+  world.m[3][2] = renderPosition.z;
+  transform.matrix = XMLoadFloat4x4(reinterpret_cast<const XMFLOAT4X4*>(world.m));
+  // 0 queda reservado para "nunca calculado" (MeshBounds)
+  transform.worldVersion = transform.worldVersion + 1 == 0 ? 1 : transform.worldVersion + 1;
+}
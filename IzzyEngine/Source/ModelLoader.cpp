@@ -90,8 +90,8 @@ ModelLoader::ProcessFBXMesh(FbxNode* node) {
 	FbxMesh* mesh = node->GetMesh();
 	if (!mesh) return;
 
-	std::vector<SimpleVertex> vertices;
-	std::vector<unsigned int> indices;
+	MeshComponent::VertexArray vertices;
+	MeshComponent::IndexArray indices;
 
 	// 02. Process vertices: extract positions from control points.
 	for (int i = 0; i < mesh->GetControlPointsCount(); i++) {
@@ -155,10 +155,11 @@ ModelLoader::ProcessFBXMesh(FbxNode* node) {
 	// 05. Create a MeshComponent to store the processed mesh data.
 	MeshComponent meshData;
 	meshData.m_name = node->GetName();
-	meshData.m_vertex = vertices;
-	meshData.m_index = indices;
 	meshData.m_numVertex = vertices.size();
 	meshData.m_numIndex = indices.size();
+	meshData.m_vertex = std::move(vertices);
+	meshData.m_index = std::move(indices);
+	meshData.computeBounds();
 
 	// 06. Add the processed mesh data to the collection.
 	meshes.push_back(meshData);
@@ -190,8 +191,8 @@ ModelLoader::LoadObjModel(const std::string& filePath){
 	}
 																							
 	for (const auto& mesh : loader.LoadedMeshes) {
-		std::vector<SimpleVertex> vertices;
-		std::vector<unsigned int> indices;
+		MeshComponent::VertexArray vertices;
+		MeshComponent::IndexArray indices;
 
 		for (const auto& vertex : mesh.Vertices) {
 			SimpleVertex v;
@@ -200,14 +201,15 @@ ModelLoader::LoadObjModel(const std::string& filePath){
 			vertices.push_back(v);
 		}
 
-		indices = mesh.Indices;
+		indices.assign(mesh.Indices.begin(), mesh.Indices.end());
 
 		MeshComponent meshData;
 		meshData.m_name = mesh.MeshName;
-		meshData.m_vertex = vertices;
-		meshData.m_index = indices;
 		meshData.m_numVertex = vertices.size();
 		meshData.m_numIndex = indices.size();
+		meshData.m_vertex = std::move(vertices);
+		meshData.m_index = std::move(indices);
+		meshData.computeBounds();
 
 		meshes.push_back(meshData);
 	}
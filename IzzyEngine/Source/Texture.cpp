@@ -1,10 +1,124 @@
 #define STB_IMAGE_IMPLEMENTATION
 
+#include <algorithm>
+#include <atomic>
 #include "stb_image.h"
 #include "Texture.h"
 #include "Device.h"
 #include "DeviceContext.h"
 
+namespace {
+  // Identificador del dato privado con el que cada textura lleva su registro de memoria
+  const GUID TextureMemoryRecordGuid =
+    { 0x5c1d7a0e, 0x3f2b, 0x4e8a, { 0x9b, 0x61, 0x2d, 0x47, 0xc0, 0x8e, 0x13, 0xa5 } };
+
+  /*
+   * @brief Mantiene atribuidos a MemoryTag::Textures los bytes de una textura mientras el recurso exista.
+   *
+   * Se guarda como dato privado del ID3D11Texture2D: D3D11 lo suelta cuando el recurso se destruye de
+   * verdad, aunque haya varias copias de Texture o vistas (RTV, DSV, SRV) que lo referencien.
+   */
+  class TextureMemoryRecord : public IUnknown {
+  public:
+    explicit TextureMemoryRecord(size_t bytes) : m_bytes(bytes), m_refs(1) {
+      EngineUtilities::MemoryTracker::recordAllocation(EngineUtilities::MemoryTag::Textures, m_bytes);
+    }
+
+    HRESULT STDMETHODCALLTYPE
+    QueryInterface(REFIID riid, void** object) override {
+      if (riid == __uuidof(IUnknown)) {
+        *object = static_cast<IUnknown*>(this);
+        AddRef();
+        return S_OK;
+      }
+      *object = nullptr;
+      return E_NOINTERFACE;
+    }
+
+    ULONG STDMETHODCALLTYPE
+    AddRef() override { return ++m_refs; }
+
+    ULONG STDMETHODCALLTYPE
+    Release() override {
+      ULONG refs = --m_refs;
+      if (refs == 0) {
+        EngineUtilities::MemoryTracker::recordFree(EngineUtilities::MemoryTag::Textures, m_bytes);
+        delete this;
+      }
+      return refs;
+    }
+
+  private:
+    size_t m_bytes;
+    std::atomic<ULONG> m_refs;
+  };
+
+  // Bits por pxel de un formato sin comprimir, o bytes por bloque de 4x4 de un formato BC (en negativo)
+  int
+  formatBits(DXGI_FORMAT format) {
+    switch (format) {
+    case DXGI_FORMAT_R32G32B32A32_TYPELESS: case DXGI_FORMAT_R32G32B32A32_FLOAT:
+    case DXGI_FORMAT_R32G32B32A32_UINT: case DXGI_FORMAT_R32G32B32A32_SINT:
+      return 128;
+    case DXGI_FORMAT_R32G32B32_TYPELESS: case DXGI_FORMAT_R32G32B32_FLOAT:
+    case DXGI_FORMAT_R32G32B32_UINT: case DXGI_FORMAT_R32G32B32_SINT:
+      return 96;
+    case DXGI_FORMAT_R16G16B16A16_TYPELESS: case DXGI_FORMAT_R16G16B16A16_FLOAT:
+    case DXGI_FORMAT_R16G16B16A16_UNORM: case DXGI_FORMAT_R16G16B16A16_UINT:
+    case DXGI_FORMAT_R16G16B16A16_SNORM: case DXGI_FORMAT_R16G16B16A16_SINT:
+    case DXGI_FORMAT_R32G32_TYPELESS: case DXGI_FORMAT_R32G32_FLOAT:
+    case DXGI_FORMAT_R32G32_UINT: case DXGI_FORMAT_R32G32_SINT:
+    case DXGI_FORMAT_R32G8X24_TYPELESS: case DXGI_FORMAT_D32_FLOAT_S8X24_UINT:
+    case DXGI_FORMAT_R32_FLOAT_X8X24_TYPELESS: case DXGI_FORMAT_X32_TYPELESS_G8X24_UINT:
+      return 64;
+    case DXGI_FORMAT_R8G8_TYPELESS: case DXGI_FORMAT_R8G8_UNORM: case DXGI_FORMAT_R8G8_UINT:
+    case DXGI_FORMAT_R8G8_SNORM: case DXGI_FORMAT_R8G8_SINT:
+    case DXGI_FORMAT_R16_TYPELESS: case DXGI_FORMAT_R16_FLOAT: case DXGI_FORMAT_D16_UNORM:
+    case DXGI_FORMAT_R16_UNORM: case DXGI_FORMAT_R16_UINT: case DXGI_FORMAT_R16_SNORM:
+    case DXGI_FORMAT_R16_SINT: case DXGI_FORMAT_B5G6R5_UNORM: case DXGI_FORMAT_B5G5R5A1_UNORM:
+      return 16;
+    case DXGI_FORMAT_R8_TYPELESS: case DXGI_FORMAT_R8_UNORM: case DXGI_FORMAT_R8_UINT:
+    case DXGI_FORMAT_R8_SNORM: case DXGI_FORMAT_R8_SINT: case DXGI_FORMAT_A8_UNORM:
+      return 8;
+    case DXGI_FORMAT_BC1_TYPELESS: case DXGI_FORMAT_BC1_UNORM: case DXGI_FORMAT_BC1_UNORM_SRGB:
+    case DXGI_FORMAT_BC4_TYPELESS: case DXGI_FORMAT_BC4_UNORM: case DXGI_FORMAT_BC4_SNORM:
+      return -8;
+    case DXGI_FORMAT_BC2_TYPELESS: case DXGI_FORMAT_BC2_UNORM: case DXGI_FORMAT_BC2_UNORM_SRGB:
+    case DXGI_FORMAT_BC3_TYPELESS: case DXGI_FORMAT_BC3_UNORM: case DXGI_FORMAT_BC3_UNORM_SRGB:
+    case DXGI_FORMAT_BC5_TYPELESS: case DXGI_FORMAT_BC5_UNORM: case DXGI_FORMAT_BC5_SNORM:
+    case DXGI_FORMAT_BC6H_TYPELESS: case DXGI_FORMAT_BC6H_UF16: case DXGI_FORMAT_BC6H_SF16:
+    case DXGI_FORMAT_BC7_TYPELESS: case DXGI_FORMAT_BC7_UNORM: case DXGI_FORMAT_BC7_UNORM_SRGB:
+      return -16;
+    default:
+      // El resto de formatos habituales (RGBA8, R10G10B10A2, R32, D24S8...) ocupan 32 bits
+      return 32;
+    }
+  }
+
+  /*
+   * @brief Atribuye a MemoryTag::Textures el tamao de la textura (todos sus mips, elementos y muestras)
+   * hasta que D3D11 destruya el recurso.
+   */
+  void
+  trackTextureMemory(ID3D11Texture2D* texture) {
+    D3D11_TEXTURE2D_DESC desc;
+    texture->GetDesc(&desc);
+    int bits = formatBits(desc.Format);
+    size_t bytes = 0;
+    for (UINT mip = 0; mip < desc.MipLevels; ++mip) {
+      size_t width = (std::max)(desc.Width >> mip, 1u);
+      size_t height = (std::max)(desc.Height >> mip, 1u);
+      bytes += bits > 0 ? width * height * bits / 8
+                        : ((width + 3) / 4) * ((height + 3) / 4) * size_t(-bits);
+    }
+    bytes *= size_t(desc.ArraySize) * desc.SampleDesc.Count;
+
+    TextureMemoryRecord* record = new TextureMemoryRecord(bytes);
+    texture->SetPrivateDataInterface(TextureMemoryRecordGuid, record);  // La textura toma su propia referencia
+    record->Release();
+  }
+}
+
 HRESULT 
 Texture::init(Device device, 
               const std::string& textureName, 
@@ -28,6 +142,17 @@ Texture::init(Device device,
         ("Failed to load DDS texture. Verify filepath: " + textureName).c_str());
       return hr;
     }
+    {
+      ID3D11Resource* resource = nullptr;
+      m_textureFromImg->GetResource(&resource);
+      ID3D11Texture2D* texture = nullptr;
+      if (resource && SUCCEEDED(resource->QueryInterface(__uuidof(ID3D11Texture2D),
+                                                         reinterpret_cast<void**>(&texture)))) {
+        trackTextureMemory(texture);
+        texture->Release();
+      }
+      SAFE_RELEASE(resource);
+    }
     break;
   case PNG: {
     int width, height, channels;
@@ -62,6 +187,7 @@ Texture::init(Device device,
       ERROR("Texture", "init", "Failed to create texture from PNG data");
       return hr;
     }
+    trackTextureMemory(m_texture);
     D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
     srvDesc.Format = textureDesc.Format;
     srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
@@ -115,6 +241,7 @@ Texture::init(Device device,
     ERROR("Texture", "init", "Failed to create texture with the specified parameters");
     return hr;
   }
+  trackTextureMemory(m_texture);
   return hr;
 }
 void 
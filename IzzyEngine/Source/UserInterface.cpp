@@ -7,11 +7,35 @@ UserInterface::UserInterface() {
 UserInterface::~UserInterface() {
 }
 
+/*
+ * @brief Asignadores de ImGui: guardan el tamao delante del bloque para que el
+ * MemoryTracker pueda atribuir las reservas y liberaciones a la etiqueta UI.
+ */
+static const size_t kImGuiHeaderSize = 16;
+
+static void*
+imguiAlloc(size_t size, void* /*userData*/) {
+  unsigned char* block = static_cast<unsigned char*>(malloc(size + kImGuiHeaderSize));
+  if (!block) return nullptr;
+  *reinterpret_cast<size_t*>(block) = size;
+  EngineUtilities::MemoryTracker::recordAllocation(EngineUtilities::MemoryTag::UI, size);
+  return block + kImGuiHeaderSize;
+}
+
+static void
+imguiFree(void* ptr, void* /*userData*/) {
+  if (!ptr) return;
+  unsigned char* block = static_cast<unsigned char*>(ptr) - kImGuiHeaderSize;
+  EngineUtilities::MemoryTracker::recordFree(EngineUtilities::MemoryTag::UI, *reinterpret_cast<size_t*>(block));
+  free(block);
+}
+
 void 
 UserInterface::init(void* window, 
                     ID3D11Device* device, 
                     ID3D11DeviceContext* deviceContext){
   IMGUI_CHECKVERSION(); // Check ImGui version
+  ImGui::SetAllocatorFunctions(imguiAlloc, imguiFree, nullptr); // Track ImGui memory under MemoryTag::UI
   ImGui::CreateContext(); // Create ImGui context
   ImGuiIO& io = ImGui::GetIO(); // Get ImGui IO
   io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard; // Enable keyboard navigation
@@ -100,29 +124,48 @@ UserInterface::setupStyle(){
 
 void 
 UserInterface::actorsWindow(std::vector<EngineUtilities::TSharedPointer<Actor>>& actors, 
-                            int& selectedIndex){
+                            EntityId& selectedActor){
   ImGui::Begin("Actors");
   for (int i = 0; i < (int)actors.size(); ++i) {
     auto& actor = actors[i];
     if (!actor) continue;
     // "##i" assures that the label is unique
-    std::string label = actor->getName() + "##" + std::to_string(i);
-    bool isSelected = (selectedIndex == i);
+    // La etiqueta vive en el asignador por frame: no hay malloc por actor en cada frame.
+    EngineUtilities::TFrameString label(actor->getName().c_str());
+    label += "##";
+    label += std::to_string(i).c_str();
+    bool isSelected = (selectedActor == actor->getEntityId());
     if (ImGui::Selectable(label.c_str(), isSelected)) {
-      selectedIndex = i;
+      selectedActor = actor->getEntityId();
     }
   }
   ImGui::End();
 }
 
 void 
-UserInterface::transformWindow(EngineUtilities::TSharedPointer<Actor>& actor){
+UserInterface::transformWindow(Actor* actor){
   ImGui::Begin("Transform", nullptr, ImGuiWindowFlags_NoCollapse);
   if (actor) {
     auto tr = actor->getComponent<Transform>();
-    vec3Control("Position", const_cast<float*>(tr->getPosition().data()));  // Get position
-    vec3Control("Rotation", const_cast<float*>(tr->getRotation().data()));  // Get rotation
-    vec3Control("Scale", const_cast<float*>(tr->getScale().data()));  // Get scale
+    // La posicin es double: se edita una copia en float y solo se aplica el cambio,
+    // para no redondear la posicin a float en mundos grandes
+    EngineUtilities::Vector3 position = tr->getPosition().toVector3();
+    EngineUtilities::Vector3 edited = position;
+    vec3Control("Position", edited.data());  // Get position
+    if (edited.x != position.x || edited.y != position.y || edited.z != position.z) {
+      tr->setPosition(tr->getPosition() + (EngineUtilities::Vector3d(edited) - EngineUtilities::Vector3d(position)));
+    }
+    // Rotacin y escala tambin se editan en una copia: los set* marcan el Transform para que se recalcule
+    EngineUtilities::Vector3 rotation = tr->getRotation();
+    vec3Control("Rotation", rotation.data());  // Get rotation
+    if (rotation.x != tr->getRotation().x || rotation.y != tr->getRotation().y || rotation.z != tr->getRotation().z) {
+      tr->setRotation(rotation);
+    }
+    EngineUtilities::Vector3 scale = tr->getScale();
+    vec3Control("Scale", scale.data());  // Get scale
+    if (scale.x != tr->getScale().x || scale.y != tr->getScale().y || scale.z != tr->getScale().z) {
+      tr->setScale(scale);
+    }
   }
   ImGui::End();
 }
@@ -134,6 +177,44 @@ UserInterface::drawTestDock(){
   ImGui::End();
 }
 
+void 
+UserInterface::memoryWindow(){
+  using namespace EngineUtilities;
+  ImGui::Begin("Memory", nullptr, ImGuiWindowFlags_NoCollapse);
+  MemoryTagStats stats[MemoryTracker::TagCount];
+  MemoryTracker::get().snapshot(stats);
+  if (ImGui::BeginTable("MemoryTags", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+    ImGui::TableSetupColumn("Tag");
+    ImGui::TableSetupColumn("Live (KB)");
+    ImGui::TableSetupColumn("Peak (KB)");
+    ImGui::TableSetupColumn("Allocs");
+    ImGui::TableSetupColumn("Allocs/frame");
+    ImGui::TableSetupColumn("KB/frame");
+    ImGui::TableSetupColumn("Budget (KB)");
+    ImGui::TableHeadersRow();
+    for (const MemoryTagStats& tag : stats) {
+      ImGui::TableNextRow();
+      if (tag.OverBudget) {
+        ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.2f, 0.2f, 1.0f));
+      }
+      ImGui::TableNextColumn(); ImGui::TextUnformatted(MemoryTracker::tagName(tag.Tag));
+      ImGui::TableNextColumn(); ImGui::Text("%.1f", tag.LiveBytes / 1024.0);
+      ImGui::TableNextColumn(); ImGui::Text("%.1f", tag.PeakBytes / 1024.0);
+      ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)tag.Allocations);
+      ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)tag.FrameAllocations);
+      ImGui::TableNextColumn(); ImGui::Text("%.1f", tag.FrameBytes / 1024.0);
+      ImGui::TableNextColumn();
+      if (tag.BudgetBytes) ImGui::Text("%.1f", tag.BudgetBytes / 1024.0);
+      else ImGui::TextUnformatted("-");
+      if (tag.OverBudget) {
+        ImGui::PopStyleColor();
+      }
+    }
+    ImGui::EndTable();
+  }
+  ImGui::End();
+}
+
 void 
 UserInterface::vec3Control(std::string label, 
                            float* values, 